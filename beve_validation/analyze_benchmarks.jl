@@ -1,6 +1,6 @@
 # Ensure required packages are available
 using Pkg
-pkgs = ["CSV", "DataFrames", "Plots", "StatsPlots"]
+pkgs = ["CSV", "DataFrames", "JSON3", "Plots", "StatsPlots"]
 for pkg in pkgs
     if !haskey(Pkg.project().dependencies, pkg)
         println("Installing $pkg...")
@@ -10,6 +10,7 @@ end
 
 using CSV
 using DataFrames
+using JSON3
 using Printf
 using Statistics
 using Dates
@@ -17,8 +18,35 @@ using Plots
 using StatsPlots
 gr()
 
+# Flattens the C++ harness output (cpp_benchmark_results.json) into one row per test. The mean and
+# stddev columns keep the names used by the Julia CSV so the two can be joined; percentiles,
+# throughput and hardware counters are C++-only extras.
+function read_cpp_results(path="cpp_benchmark_results.json")
+    report = JSON3.read(read(path, String))
+    ms(ns) = ns / 1e6
+    counter(m, field) = m.counters.valid ? Float64(m.counters[field]) : missing
+    rows = map(report.results) do r
+        w, rd = r.write, r.read
+        (Name = String(r.name),
+         WriteTimeMs = ms(w.mean_ns), ReadTimeMs = ms(rd.mean_ns),
+         WriteStdDevMs = ms(w.stddev_ns), ReadStdDevMs = ms(rd.stddev_ns),
+         DataSizeBytes = Int(r.data_size_bytes), Iterations = Int(rd.samples),
+         WriteP50Ms = ms(w.p50_ns), WriteP99Ms = ms(w.p99_ns), WriteP999Ms = ms(w.p999_ns),
+         ReadP50Ms = ms(rd.p50_ns), ReadP99Ms = ms(rd.p99_ns), ReadP999Ms = ms(rd.p999_ns),
+         WriteGBps = Float64(w.gb_per_s), ReadGBps = Float64(rd.gb_per_s),
+         WriteAllocs = Float64(get(r, :write_allocations, NaN)),
+         ReadAllocs = Float64(get(r, :read_allocations, NaN)),
+         ReadCyclesPerByte = counter(rd, :cycles_per_byte),
+         ReadInstructionsPerByte = counter(rd, :instructions_per_byte),
+         ReadIPC = counter(rd, :instructions_per_cycle),
+         ReadCacheMissesPerByte = counter(rd, :cache_misses_per_byte),
+         ReadBranchMissesPerByte = counter(rd, :branch_misses_per_byte))
+    end
+    return DataFrame(rows), report.metadata
+end
+
 function read_benchmark_results()
-    cpp_results = CSV.read("cpp_benchmark_results.csv", DataFrame)
+    cpp_results, metadata = read_cpp_results()
     julia_results = CSV.read("julia_benchmark_results.csv", DataFrame)
     
     # Join on Name
@@ -34,10 +62,10 @@ function read_benchmark_results()
     results.WriteStdDevPercent_Julia = (results.WriteStdDevMs_1 ./ results.WriteTimeMs_1) .* 100
     results.ReadStdDevPercent_Julia = (results.ReadStdDevMs_1 ./ results.ReadTimeMs_1) .* 100
     
-    return results
+    return results, metadata
 end
 
-function generate_markdown_report(results)
+function generate_markdown_report(results, metadata)
     open("benchmark_results.md", "w") do io
         println(io, "# BEVE Performance Comparison: Julia vs C++ (Glaze)")
         println(io, "")
@@ -102,6 +130,30 @@ function generate_markdown_report(results)
         end
         
         println(io, "")
+        println(io, "## C++ Latency Distribution")
+        println(io, "")
+        println(io, "Per-call times from the C++ harness. Small cases are timed in batches, so their percentiles describe batch means.")
+        println(io, "")
+        println(io, "| Test | Write p50 / p99 / p99.9 (ms) | Write GB/s | Read p50 / p99 / p99.9 (ms) | Read GB/s | Allocs/call (W / R) |")
+        println(io, "|------|------------------------------|------------|-----------------------------|-----------|---------------------|")
+        fmt(x) = @sprintf("%.4f", x)
+        for row in eachrow(results)
+            println(io, "| $(row.Name) | $(fmt(row.WriteP50Ms)) / $(fmt(row.WriteP99Ms)) / $(fmt(row.WriteP999Ms)) | $(round(row.WriteGBps, digits=2)) | $(fmt(row.ReadP50Ms)) / $(fmt(row.ReadP99Ms)) / $(fmt(row.ReadP999Ms)) | $(round(row.ReadGBps, digits=2)) | $(round(row.WriteAllocs, digits=1)) / $(round(row.ReadAllocs, digits=1)) |")
+        end
+        println(io, "")
+        
+        if metadata.hardware_counters
+            println(io, "### C++ Read Hardware Counters (per byte)")
+            println(io, "")
+            println(io, "| Test | Cycles | Instructions | IPC | Cache Misses | Branch Misses |")
+            println(io, "|------|--------|--------------|-----|--------------|---------------|")
+            for row in eachrow(results)
+                ismissing(row.ReadCyclesPerByte) && continue
+                println(io, "| $(row.Name) | $(round(row.ReadCyclesPerByte, digits=3)) | $(round(row.ReadInstructionsPerByte, digits=3)) | $(round(row.ReadIPC, digits=2)) | $(@sprintf("%.2e", row.ReadCacheMissesPerByte)) | $(@sprintf("%.2e", row.ReadBranchMissesPerByte)) |")
+            end
+            println(io, "")
+        end
+        
         println(io, "## Performance Analysis")
         println(io, "")
         
@@ -158,15 +210,17 @@ function generate_markdown_report(results)
         println(io, "")
         println(io, "- **Speed comparisons**: Shows which implementation is faster and by how many times")
         println(io, "- **Standard deviation**: Shown as ± percentage of mean time (e.g., \"1.5 ± 10.2%\" means 1.5ms average with 10.2% variability)")
-        println(io, "- Tests were run with $(results.Iterations[1]) iterations for small data, decreasing for larger datasets")
-        println(io, "- All times are averages across the specified number of iterations")
+        println(io, "- Julia tests were run with $(results.Iterations[1]) iterations for small data, decreasing for larger datasets; C++ used the same number of timed samples")
+        println(io, "- Comparison times are means; see the latency distribution for C++ percentiles")
         println(io, "")
         
         println(io, "## Test Environment")
         println(io, "")
         println(io, "- **Platform**: $(Sys.KERNEL) $(Sys.MACHINE)")
         println(io, "- **Julia Version**: $(VERSION)")
-        println(io, "- **C++ Compiler**: Compiler information available in build logs")
+        println(io, "- **CPU**: $(metadata.cpu) ($(metadata.logical_cores) logical cores)")
+        println(io, "- **C++ Compiler**: $(metadata.compiler) ($(metadata.build_type), C++ $(metadata.cxx_standard))")
+        println(io, "- **C++ Run**: $(metadata.timestamp) on $(metadata.os)")
         println(io, "- **Date**: $(Dates.now())")
     end
 end
@@ -300,13 +354,81 @@ function generate_plots(results)
     println("  - benchmark_performance_vs_size.png")
 end
 
-# Main execution
-if !isfile("cpp_benchmark_results.csv") || !isfile("julia_benchmark_results.csv")
+# Throughput against encoded size from `beve_benchmark --scaling` (and `julia benchmark.jl
+# --scaling` when its CSV is present): one panel per element type with write, read and memcpy
+# curves on a log size axis and the cache sizes as vertical lines, so each cliff lines up with the
+# cache level that ran out. A second figure shows peak RSS and page faults per MB over the same sizes.
+function generate_scaling_plots(cpp_path="cpp_scaling_results.csv", julia_path="julia_scaling_results.csv")
+    println("Generating scaling plots...")
+    cpp = CSV.read(cpp_path, DataFrame)
+    julia = isfile(julia_path) ? CSV.read(julia_path, DataFrame) : nothing
+    caches = [(bytes, label, color) for (bytes, label, color) in
+              ((first(cpp.L1Bytes), "L1d", :orange), (first(cpp.L2Bytes), "L2", :red), (first(cpp.L3Bytes), "L3", :purple))
+              if bytes > 0]
+    types = unique(cpp.Type)
+
+    throughput = map(types) do type
+        rows = sort(cpp[cpp.Type .== type, :], :EncodedBytes)
+        p = plot(rows.EncodedBytes, rows.MemcpyGBps, label="memcpy", color=:gray, linestyle=:dash,
+                 xscale=:log10, title=type, xlabel="Encoded size (bytes)", ylabel="GB/s", legend=:topright)
+        plot!(p, rows.EncodedBytes, rows.WriteGBps, label="C++ write", color=:blue, marker=:circle)
+        plot!(p, rows.EncodedBytes, rows.ReadGBps, label="C++ read", color=:blue, marker=:square, linestyle=:dot)
+        if julia !== nothing
+            jrows = sort(julia[julia.Type .== type, :], :EncodedBytes)
+            if nrow(jrows) > 0
+                plot!(p, jrows.EncodedBytes, jrows.WriteGBps, label="Julia write", color=:green, marker=:circle)
+                plot!(p, jrows.EncodedBytes, jrows.ReadGBps, label="Julia read", color=:green, marker=:square,
+                      linestyle=:dot)
+            end
+        end
+        for (bytes, label, color) in caches
+            vline!(p, [bytes], label=label, color=color, alpha=0.5)
+        end
+        p
+    end
+    p1 = plot(throughput..., layout=length(throughput), size=(1400, 1000), left_margin=10Plots.mm,
+              bottom_margin=10Plots.mm, plot_title="BEVE throughput against size")
+    savefig(p1, "benchmark_scaling_throughput.png")
+
+    rss = plot(xscale=:log10, yscale=:log10, xlabel="Encoded size (bytes)", ylabel="Peak RSS (MB)",
+               title="Peak RSS", legend=:topleft)
+    faults = plot(xscale=:log10, xlabel="Encoded size (bytes)", ylabel="Faults per MB encoded",
+                  title="Page faults (cold write / cold read)", legend=:topright)
+    for type in types
+        rows = sort(cpp[cpp.Type .== type, :], :EncodedBytes)
+        mb = rows.EncodedBytes ./ 2^20
+        plot!(rss, rows.EncodedBytes, rows.PeakRssMB, label=type, marker=:circle)
+        plot!(faults, rows.EncodedBytes, rows.WriteFaults ./ mb, label="$type write", marker=:circle)
+        plot!(faults, rows.EncodedBytes, rows.ReadFaults ./ mb, label="$type read", marker=:square, linestyle=:dot)
+    end
+    p2 = plot(rss, faults, layout=(1, 2), size=(1400, 600), left_margin=10Plots.mm, bottom_margin=10Plots.mm)
+    savefig(p2, "benchmark_scaling_memory.png")
+
+    # How close each type gets to memcpy once the data no longer fits in cache
+    println("C++ throughput at the largest size, as a fraction of memcpy:")
+    for type in types
+        row = last(sort(cpp[cpp.Type .== type, :], :EncodedBytes))
+        @printf("  %-8s %12d elements: write %.2f, read %.2f\n", type, row.Elements,
+                row.WriteGBps / row.MemcpyGBps, row.ReadGBps / row.MemcpyGBps)
+    end
+    println("Plots saved:")
+    println("  - benchmark_scaling_throughput.png")
+    println("  - benchmark_scaling_memory.png")
+end
+
+# Main execution: the C++/Julia comparison when both result files exist, and the scaling curves
+# when `beve_benchmark --scaling` has been run
+has_comparison = isfile("cpp_benchmark_results.json") && isfile("julia_benchmark_results.csv")
+has_scaling = isfile("cpp_scaling_results.csv")
+if !has_comparison && !has_scaling
     println("Error: Benchmark result files not found. Please run both benchmarks first.")
     exit(1)
 end
 
-results = read_benchmark_results()
-generate_markdown_report(results)
-generate_plots(results)
-println("Benchmark analysis complete. Results written to benchmark_results.md and plots generated.")
\ No newline at end of file
+if has_comparison
+    results, metadata = read_benchmark_results()
+    generate_markdown_report(results, metadata)
+    generate_plots(results)
+    println("Benchmark analysis complete. Results written to benchmark_results.md and plots generated.")
+end
+has_scaling && generate_scaling_plots()
\ No newline at end of file
@@ -4,20 +4,144 @@
 #include <fstream>
 #include <vector>
 #include <complex>
+#include <algorithm>
 #include <chrono>
 #include <numeric>
 #include <iomanip>
 #include <unordered_map>
+#include <map>
+#include <atomic>
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory_resource>
+#include <new>
+#include <optional>
+#include <random>
+#include <string_view>
+#include <thread>
+
+#include <sys/resource.h>
+
+#include "benchmark_harness.hpp"
+#include "beve_async_writer.hpp"
+#include "beve_batch.hpp"
+#include "beve_columnar.hpp"
+#include "beve_flat_map.hpp"
+#include "beve_half.hpp"
+#include "beve_http.hpp"
+#include "beve_index.hpp"
+#include "beve_keys.hpp"
+#include "beve_mmap.hpp"
+#include "beve_packed.hpp"
+#include "beve_patch.hpp"
+#include "beve_planar.hpp"
+#include "beve_pointer.hpp"
+#include "beve_parallel_reader.hpp"
+#include "beve_parallel_writer.hpp"
+#include "beve_shm_ring.hpp"
+#include "beve_size.hpp"
+#include "beve_stream_writer.hpp"
+#include "beve_view.hpp"
+#include "validation_types.hpp"
+#if BEVE_HAS_ZSTD
+#include "beve_zstd.hpp"
+#endif
+
+// Every global allocation in this process is counted so that benchmarks can report heap
+// allocations per call. The aligned overloads are left to the implementation.
+namespace alloc_stats {
+   inline std::atomic<uint64_t> count{0};
+   inline std::atomic<uint64_t> bytes{0};
+}
+
+void* operator new(size_t n) {
+   alloc_stats::count.fetch_add(1, std::memory_order_relaxed);
+   alloc_stats::bytes.fetch_add(n, std::memory_order_relaxed);
+   if (void* p = std::malloc(n ? n : 1)) {
+      return p;
+   }
+   throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+struct AllocationRate {
+   double allocations = 0.0;
+   double bytes = 0.0;
+};
+
+// Heap allocations (and bytes) per call of `op`, measured after one call has brought it to steady state
+template <typename Op>
+AllocationRate allocation_rate(Op&& op, size_t calls = 1000) {
+   op();
+   const uint64_t count_before = alloc_stats::count.load(std::memory_order_relaxed);
+   const uint64_t bytes_before = alloc_stats::bytes.load(std::memory_order_relaxed);
+   for (size_t i = 0; i < calls; ++i) {
+      op();
+   }
+   return {double(alloc_stats::count.load(std::memory_order_relaxed) - count_before) / double(calls),
+           double(alloc_stats::bytes.load(std::memory_order_relaxed) - bytes_before) / double(calls)};
+}
 
 struct BenchmarkResult {
    std::string name;
-   double write_time_ms;
-   double read_time_ms;
-   double write_stddev_ms;
-   double read_stddev_ms;
    size_t data_size_bytes;
-   int iterations;
+   beve::bench::measurement write;
+   beve::bench::measurement read;
+   double write_allocations = 0.0; // heap allocations per call, steady state
+   double read_allocations = 0.0;
+};
+
+struct BenchmarkReport {
+   beve::bench::run_metadata metadata;
+   std::vector<BenchmarkResult> results;
+};
+
+template <>
+struct glz::meta<beve::bench::counter_rates> {
+   using T = beve::bench::counter_rates;
+   static constexpr auto value = object("valid", &T::valid, "cycles_per_byte", &T::cycles_per_byte,
+                                        "instructions_per_byte", &T::instructions_per_byte,
+                                        "cache_misses_per_byte", &T::cache_misses_per_byte,
+                                        "branch_misses_per_byte", &T::branch_misses_per_byte,
+                                        "instructions_per_cycle", &T::instructions_per_cycle);
+};
+
+template <>
+struct glz::meta<beve::bench::measurement> {
+   using T = beve::bench::measurement;
+   static constexpr auto value = object("samples", &T::samples, "batch", &T::batch, "bytes_per_op", &T::bytes_per_op,
+                                        "mean_ns", &T::mean_ns, "stddev_ns", &T::stddev_ns, "min_ns", &T::min_ns,
+                                        "p50_ns", &T::p50_ns, "p99_ns", &T::p99_ns, "p999_ns", &T::p999_ns,
+                                        "gb_per_s", &T::gb_per_s, "counters", &T::counters);
+};
+
+template <>
+struct glz::meta<beve::bench::run_metadata> {
+   using T = beve::bench::run_metadata;
+   static constexpr auto value = object("cpu", &T::cpu, "logical_cores", &T::logical_cores, "os", &T::os,
+                                        "compiler", &T::compiler, "build_type", &T::build_type,
+                                        "cxx_standard", &T::cxx_standard, "timestamp", &T::timestamp,
+                                        "hardware_counters", &T::hardware_counters);
+};
+
+template <>
+struct glz::meta<BenchmarkResult> {
+   using T = BenchmarkResult;
+   static constexpr auto value = object("name", &T::name, "data_size_bytes", &T::data_size_bytes,
+                                        "write", &T::write, "read", &T::read,
+                                        "write_allocations", &T::write_allocations,
+                                        "read_allocations", &T::read_allocations);
+};
+
+template <>
+struct glz::meta<BenchmarkReport> {
+   using T = BenchmarkReport;
+   static constexpr auto value = object("metadata", &T::metadata, "results", &T::results);
 };
 
 // Test structures
@@ -33,6 +157,9 @@ struct glz::meta<SmallData> {
    static constexpr auto value = object("id", &T::id, "value", &T::value, "name", &T::name);
 };
 
+inline constexpr auto small_data_columns = beve::columnar_layout{
+   beve::column{"id", &SmallData::id}, beve::column{"value", &SmallData::value}, beve::column{"name", &SmallData::name}};
+
 struct MediumData {
    std::vector<double> values;
    std::unordered_map<std::string, int32_t> lookup;
@@ -53,6 +180,22 @@ struct glz::meta<MediumData> {
    static constexpr auto value = object("values", &T::values, "lookup", &T::lookup, "tags", &T::tags);
 };
 
+// MediumData laid out for a hot loop that decodes the same shape over and over: map nodes are
+// recycled through a pool owned by the object, and the vectors and strings keep their capacity,
+// so a warm instance decodes without touching the global heap.
+struct PooledMediumData {
+   std::pmr::unsynchronized_pool_resource pool;
+   std::vector<double> values;
+   std::pmr::unordered_map<std::pmr::string, int32_t> lookup{&pool};
+   std::vector<std::string> tags;
+};
+
+template <>
+struct glz::meta<PooledMediumData> {
+   using T = PooledMediumData;
+   static constexpr auto value = object("values", &T::values, "lookup", &T::lookup, "tags", &T::tags);
+};
+
 struct LargeFloatArray {
    std::vector<float> data;
    
@@ -88,10 +231,9 @@ struct glz::meta<LargeComplexArray> {
 };
 
 template <typename T>
-BenchmarkResult benchmark_type(const std::string& name, const T& data, int iterations = 100) {
+BenchmarkResult benchmark_type(const std::string& name, const T& data, size_t samples = 100) {
    BenchmarkResult result;
    result.name = name;
-   result.iterations = iterations;
    
    // Warm up
    std::string buffer;
@@ -107,86 +249,2310 @@ BenchmarkResult benchmark_type(const std::string& name, const T& data, int itera
    
    result.data_size_bytes = buffer.size();
    
-   // Benchmark write
-   std::vector<double> write_times;
-   write_times.reserve(iterations);
+   beve::bench::options opts;
+   opts.samples = samples;
    
+   // Errors are reported once rather than per call so that printing never lands inside a timed batch
+   std::string write_buffer;
+   bool write_failed = false;
+   result.write = beve::bench::measure([&] {
+      write_failed |= bool(glz::write_beve(data, write_buffer));
+      beve::bench::do_not_optimize(write_buffer);
+   }, buffer.size(), opts);
+   if (write_failed) {
+      std::cerr << "Write error in " << name << std::endl;
+   }
+   
+   T loaded;
+   bool read_failed = false;
+   result.read = beve::bench::measure([&] {
+      read_failed |= bool(glz::read_beve(loaded, buffer));
+      beve::bench::do_not_optimize(loaded);
+   }, buffer.size(), opts);
+   if (read_failed) {
+      std::cerr << "Read error in " << name << std::endl;
+   }
+   
+   result.write_allocations = allocation_rate([&] { (void)glz::write_beve(data, write_buffer); }, 100).allocations;
+   result.read_allocations = allocation_rate([&] { (void)glz::read_beve(loaded, buffer); }, 100).allocations;
+   
+   return result;
+}
+
+// Same {"data": [...]} object as LargeFloatArray, but with the floats stored as bf16 or f16
+BenchmarkResult benchmark_half(const std::string& name, const LargeFloatArray& data, beve::half_format format,
+                               size_t samples = 100) {
+   BenchmarkResult result;
+   result.name = name;
+   
+   auto write = [&](std::string& out) {
+      out.clear();
+      out.push_back(char(beve::headers::string_object));
+      beve::write_compressed_size(out, 1);
+      beve::write_compressed_size(out, 4);
+      out.append("data");
+      beve::write_half_array(out, data.data, format);
+   };
+   auto read = [](std::string_view bytes, std::vector<float>& out) -> bool {
+      auto field = beve::beve_view{bytes}.find("data");
+      auto array = field ? field->as_typed_array() : std::unexpected(field.error());
+      return array && beve::read_half_array(*array, out);
+   };
+   
+   std::string buffer;
+   write(buffer);
+   std::vector<float> loaded;
+   if (!read(buffer, loaded) || loaded.size() != data.data.size()) {
+      std::cerr << "Warm up read error in " << name << std::endl;
+   }
+   result.data_size_bytes = buffer.size();
+   
+   beve::bench::options opts;
+   opts.samples = samples;
+   
+   std::string write_buffer;
+   result.write = beve::bench::measure([&] {
+      write(write_buffer);
+      beve::bench::do_not_optimize(write_buffer);
+   }, buffer.size(), opts);
+   
+   bool read_failed = false;
+   result.read = beve::bench::measure([&] {
+      read_failed |= !read(buffer, loaded);
+      beve::bench::do_not_optimize(loaded);
+   }, buffer.size(), opts);
+   if (read_failed) {
+      std::cerr << "Read error in " << name << std::endl;
+   }
+   
+   result.write_allocations = allocation_rate([&] { write(write_buffer); }, 100).allocations;
+   result.read_allocations = allocation_rate([&] { (void)read(buffer, loaded); }, 100).allocations;
+   
+   return result;
+}
+
+bool write_results(const BenchmarkReport& report) {
+   std::string json;
+   if (auto ec = glz::write_json(report, json)) {
+      std::cerr << "JSON write error: " << glz::format_error(ec, json) << std::endl;
+      return false;
+   }
+   std::ofstream file("cpp_benchmark_results.json");
+   file << json;
+   return bool(file);
+}
+
+struct FileReadResult {
+   std::string name;
+   size_t file_size_bytes;
+   double istreambuf_ms;
+   double read_syscall_ms;
+   double mmap_ms;
+};
+
+// Times one file-backed load strategy: acquire bytes with `load`, then decode them
+template <typename T, typename Load>
+double time_file_read(const std::string& path, int iterations, Load&& load) {
+   double total_ms = 0.0;
+   T loaded;
    for (int i = 0; i < iterations; ++i) {
       auto start = std::chrono::high_resolution_clock::now();
-      auto ec = glz::write_beve(data, buffer);
+      auto ec = load(path, loaded);
       auto end = std::chrono::high_resolution_clock::now();
-      
       if (ec) {
-         std::cerr << "Write error: " << glz::format_error(ec) << std::endl;
+         std::cerr << "File read error: " << glz::format_error(ec) << std::endl;
          break;
       }
-      
-      auto duration = std::chrono::duration<double, std::milli>(end - start).count();
-      write_times.push_back(duration);
+      total_ms += std::chrono::duration<double, std::milli>(end - start).count();
    }
+   return total_ms / iterations;
+}
+
+template <typename T>
+FileReadResult benchmark_file_read(const std::string& name, const T& data, int iterations = 20) {
+   const std::string path = (std::filesystem::temp_directory_path() / "beve_file_io_bench.beve").string();
    
-   // Benchmark read
-   std::vector<double> read_times;
-   read_times.reserve(iterations);
+   std::string encoded;
+   if (auto ec = glz::write_beve(data, encoded)) {
+      std::cerr << "Write error: " << glz::format_error(ec) << std::endl;
+   }
+   {
+      std::ofstream out(path, std::ios::binary);
+      out.write(encoded.data(), encoded.size());
+   }
    
-   T loaded;
-   for (int i = 0; i < iterations; ++i) {
+   FileReadResult result;
+   result.name = name;
+   result.file_size_bytes = encoded.size();
+   
+   result.istreambuf_ms = time_file_read<T>(path, iterations, [](const std::string& p, T& value) {
+      std::ifstream file(p, std::ios::binary);
+      std::string buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+      return glz::read_beve(value, buffer);
+   });
+   
+   result.read_syscall_ms = time_file_read<T>(path, iterations, [](const std::string& p, T& value) {
+      std::string buffer;
+      beve::read_file(p, buffer);
+      return glz::read_beve(value, buffer);
+   });
+   
+   result.mmap_ms = time_file_read<T>(path, iterations, [](const std::string& p, T& value) {
+      beve::mapped_file file(p);
+      return glz::read_beve(value, file.view());
+   });
+   
+   std::remove(path.c_str());
+   return result;
+}
+
+int run_file_io_benchmarks() {
+   std::cout << "C++ BEVE File Read Benchmark (istreambuf vs read() vs mmap)\n";
+   std::cout << "===========================================================\n\n";
+   
+   std::vector<FileReadResult> results;
+   for (size_t n : {size_t(10000), size_t(100000), size_t(1000000)}) {
+      const std::string label = n >= 1000000 ? std::to_string(n / 1000000) + "M" : std::to_string(n / 1000) + "K";
+      std::cout << "Benchmarking file reads (" << label << ")..." << std::endl;
+      results.push_back(benchmark_file_read("Float Array " + label, LargeFloatArray(n)));
+      results.push_back(benchmark_file_read("Complex Array " + label, LargeComplexArray(n)));
+   }
+   
+   std::cout << "\nResults (page cache warm, mean ms per load + decode):\n";
+   std::cout << std::left << std::setw(20) << "Test"
+             << std::right << std::setw(15) << "Size (bytes)"
+             << std::setw(15) << "istreambuf"
+             << std::setw(15) << "read()"
+             << std::setw(15) << "mmap\n";
+   std::cout << std::string(80, '-') << "\n";
+   
+   std::ofstream csv("cpp_file_io_results.csv");
+   csv << "Name,DataSizeBytes,IstreambufMs,ReadSyscallMs,MmapMs\n";
+   for (const auto& r : results) {
+      std::cout << std::left << std::setw(20) << r.name
+                << std::right << std::setw(15) << r.file_size_bytes
+                << std::setw(15) << std::fixed << std::setprecision(3) << r.istreambuf_ms
+                << std::setw(15) << r.read_syscall_ms
+                << std::setw(15) << r.mmap_ms << "\n";
+      csv << r.name << "," << r.file_size_bytes << "," << r.istreambuf_ms << ","
+          << r.read_syscall_ms << "," << r.mmap_ms << "\n";
+   }
+   std::cout << "\nResults written to cpp_file_io_results.csv\n";
+   return 0;
+}
+
+struct ViewRecord {
+   int32_t id{};
+   std::string label;
+   std::vector<double> samples;
+};
+
+template <>
+struct glz::meta<ViewRecord> {
+   using T = ViewRecord;
+   static constexpr auto value = object("id", &T::id, "label", &T::label, "samples", &T::samples);
+};
+
+// Fetches one field out of a large object: lazy beve_view vs. full decode into glz::json_t
+int run_view_benchmarks(size_t target_mb) {
+   std::cout << "C++ BEVE Lazy View Benchmark (one field from a " << target_mb << " MB object)\n";
+   std::cout << "==================================================================\n\n";
+   
+   constexpr size_t samples_per_record = 1000;
+   const size_t record_count = std::max<size_t>(1, target_mb * 1024 * 1024 / (samples_per_record * sizeof(double)));
+   
+   std::map<std::string, ViewRecord> records;
+   char key[32];
+   for (size_t i = 0; i < record_count; ++i) {
+      std::snprintf(key, sizeof(key), "record_%08zu", i);
+      ViewRecord& r = records[key];
+      r.id = static_cast<int32_t>(i);
+      r.label = "label " + std::to_string(i);
+      r.samples.resize(samples_per_record);
+      for (size_t j = 0; j < samples_per_record; ++j) {
+         r.samples[j] = static_cast<double>(i) + static_cast<double>(j) * 1e-3;
+      }
+   }
+   
+   std::string buffer;
+   if (auto ec = glz::write_beve(records, buffer)) {
+      std::cerr << "Write error: " << glz::format_error(ec) << std::endl;
+      return 1;
+   }
+   records.clear();
+   std::snprintf(key, sizeof(key), "record_%08zu", record_count / 2);
+   std::cout << "Encoded " << record_count << " records, " << buffer.size() / (1024.0 * 1024.0) << " MB\n";
+   std::cout << "Fetching /" << key << "/samples\n\n";
+   
+   auto elapsed_ms = [](auto start) {
+      return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+   };
+   
+   // Lazy view: index the top-level object, then read only the target array
+   constexpr int view_iterations = 20;
+   double view_ms = 0.0;
+   double view_checksum = 0.0;
+   for (int i = 0; i < view_iterations; ++i) {
       auto start = std::chrono::high_resolution_clock::now();
-      auto ec = glz::read_beve(loaded, buffer);
-      auto end = std::chrono::high_resolution_clock::now();
+      beve::beve_view root{buffer};
+      auto record = root.find(key);
+      auto samples = record ? record->find("samples") : record;
+      auto array = samples ? samples->as_typed_array() : std::unexpected(samples.error());
+      if (!array) {
+         std::cerr << "View error: " << beve::to_string(array.error()) << std::endl;
+         return 1;
+      }
+      std::vector<double> out(array->count);
+      array->copy_to(std::span<double>(out));
+      view_ms += elapsed_ms(start);
+      view_checksum = out.back();
+   }
+   view_ms /= view_iterations;
+   
+   // Second lookup on an already indexed view only pays for the nested object
+   beve::beve_view indexed{buffer};
+   (void)indexed.find(key);
+   auto start = std::chrono::high_resolution_clock::now();
+   auto warm = indexed.find(key)->find("samples")->as_typed_array();
+   const double warm_ms = elapsed_ms(start);
+   (void)warm;
+   
+   // Full decode: materialize every value as a json_t node, then look up the field
+   start = std::chrono::high_resolution_clock::now();
+   glz::json_t all;
+   if (auto ec = glz::read_beve(all, buffer)) {
+      std::cerr << "Read error: " << glz::format_error(ec) << std::endl;
+      return 1;
+   }
+   const auto& json_samples = all[key]["samples"].get_array();
+   const double json_checksum = json_samples.back().get_number();
+   const double json_ms = elapsed_ms(start);
+   
+   std::cout << std::left << std::setw(36) << "Method" << std::right << std::setw(15) << "Time (ms)" << "\n";
+   std::cout << std::string(51, '-') << "\n";
+   std::cout << std::fixed << std::setprecision(3);
+   std::cout << std::left << std::setw(36) << "beve_view (cold, builds index)" << std::right << std::setw(15) << view_ms << "\n";
+   std::cout << std::left << std::setw(36) << "beve_view (warm index)" << std::right << std::setw(15) << warm_ms << "\n";
+   std::cout << std::left << std::setw(36) << "glz::read_beve into json_t" << std::right << std::setw(15) << json_ms << "\n";
+   std::cout << "\nSpeedup (cold view vs json_t): " << std::setprecision(1) << json_ms / view_ms << "x\n";
+   
+   if (view_checksum != json_checksum) {
+      std::cerr << "Mismatch between view and json_t results" << std::endl;
+      return 1;
+   }
+   return 0;
+}
+
+// Steady-state heap allocations when decoding the same MediumData payload repeatedly
+int run_allocation_benchmark() {
+   std::cout << "C++ BEVE Allocation Benchmark (MediumData, steady state)\n";
+   std::cout << "========================================================\n\n";
+   
+   const MediumData source;
+   std::string buffer;
+   if (auto ec = glz::write_beve(source, buffer)) {
+      std::cerr << "Write error: " << glz::format_error(ec) << std::endl;
+      return 1;
+   }
+   
+   struct Case {
+      std::string name;
+      double allocations;
+      double bytes;
+      double p50_ns;
+   };
+   std::vector<Case> cases;
+   auto run_case = [&](const std::string& name, auto&& op) {
+      const auto rate = allocation_rate(op);
+      const auto timing = beve::bench::measure(op, buffer.size());
+      cases.push_back({name, rate.allocations, rate.bytes, timing.p50_ns});
+   };
+   
+   std::string write_buffer;
+   run_case("write (reused buffer)", [&] { (void)glz::write_beve(source, write_buffer); });
+   
+   MediumData reused;
+   run_case("read (reused std::unordered_map)", [&] { (void)glz::read_beve(reused, buffer); });
+   
+   PooledMediumData pooled;
+   if (auto ec = glz::read_beve(pooled, buffer)) {
+      std::cerr << "Pooled read error: " << glz::format_error(ec, buffer) << std::endl;
+      return 1;
+   }
+   run_case("read (pooled)", [&] { (void)glz::read_beve(pooled, buffer); });
+   
+   std::cout << std::left << std::setw(36) << "Case"
+             << std::right << std::setw(14) << "Allocs/call"
+             << std::setw(14) << "Bytes/call"
+             << std::setw(12) << "p50 (ns)\n";
+   std::cout << std::string(76, '-') << "\n";
+   for (const auto& c : cases) {
+      std::cout << std::left << std::setw(36) << c.name
+                << std::right << std::fixed << std::setprecision(2) << std::setw(14) << c.allocations
+                << std::setprecision(1) << std::setw(14) << c.bytes
+                << std::setw(12) << c.p50_ns << "\n";
+   }
+   
+   const bool pooled_matches = pooled.values == source.values && pooled.tags == source.tags &&
+                               pooled.lookup.size() == source.lookup.size();
+   const bool zero_alloc = cases.back().allocations == 0.0;
+   std::cout << "\nPooled decode round trip: " << (pooled_matches ? "✓" : "✗") << "\n";
+   std::cout << "Pooled decode allocation free: " << (zero_alloc ? "✓" : "✗") << "\n";
+   return pooled_matches && zero_alloc ? 0 : 1;
+}
+
+// Peak resident set size of this process so far, in MB
+double peak_rss_mb() {
+   rusage usage{};
+   getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+   return usage.ru_maxrss / (1024.0 * 1024.0); // bytes on macOS
+#else
+   return usage.ru_maxrss / 1024.0; // kilobytes on Linux
+#endif
+}
+
+#if BEVE_HAS_ZSTD
+// Compression ratio against compress / decompress throughput across zstd levels. Throughput is
+// in MB of uncompressed BEVE per second; "read" is decompression plus glz::read_beve, i.e. what
+// read_beve_zstd_file costs on an already cached file.
+template <typename T>
+bool zstd_level_sweep(const std::string& name, const T& data, const std::vector<int>& levels) {
+   std::string raw;
+   if (auto ec = glz::write_beve(data, raw)) {
+      std::cerr << "Write error: " << glz::format_error(ec) << std::endl;
+      return false;
+   }
+   
+   beve::bench::options opts;
+   opts.samples = 7; // high levels take seconds per call on the larger sets
+   opts.warmup_samples = 1;
+   opts.hardware_counters = false;
+   
+   std::cout << name << " (" << raw.size() << " bytes uncompressed)\n";
+   std::cout << std::right << std::setw(8) << "Level" << std::setw(14) << "Size (B)" << std::setw(10) << "Ratio"
+             << std::setw(18) << "Compress MB/s" << std::setw(20) << "Decompress MB/s" << std::setw(14) << "Read MB/s\n";
+   std::cout << std::string(84, '-') << "\n";
+   
+   beve::zstd_codec codec;
+   std::string compressed, scratch;
+   T loaded;
+   bool ok = true;
+   for (int level : levels) {
+      if (!codec.compress(raw, compressed, level)) {
+         std::cerr << "Compress error at level " << level << ": " << codec.error() << std::endl;
+         return false;
+      }
+      const size_t compressed_size = compressed.size();
       
-      if (ec) {
-         std::cerr << "Read error: " << glz::format_error(ec) << std::endl;
+      const auto comp = beve::bench::measure([&] {
+         ok &= codec.compress(raw, scratch, level);
+         beve::bench::do_not_optimize(scratch);
+      }, raw.size(), opts);
+      const auto decomp = beve::bench::measure([&] {
+         ok &= codec.decompress(compressed, scratch);
+         beve::bench::do_not_optimize(scratch);
+      }, raw.size(), opts);
+      const auto read = beve::bench::measure([&] {
+         ok &= codec.read(loaded, compressed);
+         beve::bench::do_not_optimize(loaded);
+      }, raw.size(), opts);
+      ok &= codec.last_beve() == raw;
+      
+      auto mb_per_s = [](const beve::bench::measurement& m) { return m.gb_per_s * 1e9 / (1024.0 * 1024.0); };
+      std::cout << std::setw(8) << level << std::setw(14) << compressed_size << std::fixed << std::setprecision(2)
+                << std::setw(10) << double(raw.size()) / double(compressed_size) << std::setprecision(1)
+                << std::setw(18) << mb_per_s(comp) << std::setw(20) << mb_per_s(decomp) << std::setw(14)
+                << mb_per_s(read) << "\n";
+   }
+   std::cout << std::endl;
+   if (!ok) {
+      std::cerr << "Round-trip failure in " << name << std::endl;
+   }
+   return ok;
+}
+
+int run_zstd_benchmark() {
+   std::cout << "C++ BEVE zstd Level Sweep\n";
+   std::cout << "=========================\n\n";
+   
+   const std::vector<int> levels{1, 3, 6, 9, 12, 15, 19};
+   bool ok = zstd_level_sweep("Float Array 1M", LargeFloatArray(1000000), levels);
+   ok &= zstd_level_sweep("Complex Array 100K", LargeComplexArray(100000), levels);
+   ok &= zstd_level_sweep("Medium Data", MediumData{}, levels);
+   return ok ? 0 : 1;
+}
+#endif
+
+// Streams `count` floats to disk through a fixed buffer; memory must stay flat regardless of count
+int run_stream_benchmark(size_t count) {
+   std::cout << "C++ BEVE Streaming Writer Benchmark\n";
+   std::cout << "===================================\n\n";
+   
+   const std::string path = (std::filesystem::temp_directory_path() / "beve_stream_bench.beve").string();
+   constexpr size_t chunk_elements = 64 * 1024;
+   std::vector<float> chunk(chunk_elements);
+   
+   const double rss_before = peak_rss_mb();
+   auto start = std::chrono::high_resolution_clock::now();
+   
+   beve::stream_writer out;
+   if (!out.open(path)) {
+      std::cerr << "Stream error: " << out.error() << std::endl;
+      return 1;
+   }
+   out.begin_object(2);
+   out.key("sample_rate");
+   out.value(48000.0);
+   out.key("data");
+   out.begin_typed_array<float>(count);
+   for (size_t i = 0; i < count; i += chunk_elements) {
+      const size_t n = std::min(chunk_elements, count - i);
+      for (size_t j = 0; j < n; ++j) {
+         chunk[j] = static_cast<float>(i + j) * 0.1f;
+      }
+      out.push(std::span<const float>(chunk.data(), n));
+   }
+   if (!out.close()) {
+      std::cerr << "Stream error: " << out.error() << std::endl;
+      return 1;
+   }
+   
+   const double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+   const double mb = out.bytes_written() / (1024.0 * 1024.0);
+   const double rss_after = peak_rss_mb();
+   
+   // Validate the result without loading it: check the declared length and the last element
+   beve::mapped_file file(path);
+   beve::beve_view root{file.view()};
+   auto data = root.find("data");
+   auto array = data ? data->as_typed_array() : std::unexpected(data.error());
+   const bool valid = array && array->count == count &&
+                      (count == 0 || array->get<float>(count - 1) == static_cast<float>(count - 1) * 0.1f);
+   file.close();
+   std::remove(path.c_str());
+   
+   std::cout << std::fixed << std::setprecision(1);
+   std::cout << "Elements:        " << count << " floats\n";
+   std::cout << "Bytes written:   " << mb << " MB\n";
+   std::cout << "Buffer size:     " << beve::stream_writer::default_buffer_size / 1024 << " KB\n";
+   std::cout << "Throughput:      " << mb / seconds << " MB/s\n";
+   std::cout << "Peak RSS:        " << rss_after << " MB (" << rss_after - rss_before << " MB above baseline)\n";
+   std::cout << "Verification:    " << (valid ? "✓" : "✗") << "\n";
+   return valid ? 0 : 1;
+}
+
+// LargeArrayTypes from main.cpp, for decoding the slice benchmark file in full
+struct SliceArrays {
+   std::vector<float> large_float_vec;
+   std::vector<double> large_double_vec;
+   std::vector<std::complex<float>> large_complex_float_vec;
+   std::vector<std::complex<double>> large_complex_double_vec;
+};
+
+template <>
+struct glz::meta<SliceArrays> {
+   using T = SliceArrays;
+   static constexpr auto value = object("large_float_vec", &T::large_float_vec, "large_double_vec", &T::large_double_vec,
+                                        "large_complex_float_vec", &T::large_complex_float_vec,
+                                        "large_complex_double_vec", &T::large_complex_double_vec);
+};
+
+template <typename T>
+T slice_value(size_t i) {
+   if constexpr (beve::is_complex<T>::value) {
+      using V = typename T::value_type;
+      return T(static_cast<V>(i), static_cast<V>(i) * V(0.5));
+   }
+   else {
+      return static_cast<T>(i);
+   }
+}
+
+// Streams one LargeArrayTypes field of `count` elements, filled chunk by chunk
+template <typename T>
+void stream_slice_field(beve::stream_writer& out, std::string_view key, size_t count) {
+   constexpr size_t chunk_elements = 64 * 1024;
+   std::vector<T> chunk(std::min(chunk_elements, count));
+   out.key(key);
+   if constexpr (beve::is_complex<T>::value) {
+      out.template begin_complex_array<typename T::value_type>(count);
+   }
+   else {
+      out.template begin_typed_array<T>(count);
+   }
+   for (size_t i = 0; i < count; i += chunk_elements) {
+      const size_t n = std::min(chunk_elements, count - i);
+      for (size_t j = 0; j < n; ++j) {
+         chunk[j] = slice_value<T>(i + j);
+      }
+      out.push(std::span<const T>(chunk.data(), n));
+   }
+}
+
+// Reads element ranges of a LargeArrayTypes-shaped file through its sidecar index, against
+// decoding the file in full
+int run_slice_benchmark(size_t count, size_t slice) {
+   std::cout << "C++ BEVE Indexed Slice Benchmark\n";
+   std::cout << "================================\n\n";
+   slice = std::min(slice, count);
+   
+   const std::string path = (std::filesystem::temp_directory_path() / "beve_slice_bench.beve").string();
+   auto start = std::chrono::high_resolution_clock::now();
+   {
+      beve::stream_writer out;
+      if (!out.open(path)) {
+         std::cerr << "Stream error: " << out.error() << std::endl;
+         return 1;
+      }
+      out.begin_object(4);
+      stream_slice_field<float>(out, "large_float_vec", count);
+      stream_slice_field<double>(out, "large_double_vec", count);
+      stream_slice_field<std::complex<float>>(out, "large_complex_float_vec", count);
+      stream_slice_field<std::complex<double>>(out, "large_complex_double_vec", count);
+      if (!out.close()) {
+         std::cerr << "Stream error: " << out.error() << std::endl;
+         return 1;
+      }
+   }
+   const double write_s = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+   const auto file_bytes = std::filesystem::file_size(path);
+   
+   start = std::chrono::high_resolution_clock::now();
+   std::string error;
+   if (!beve::write_index(path, error)) {
+      std::cerr << error << std::endl;
+      return 1;
+   }
+   const double index_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+   
+   beve::indexed_file file;
+   if (!file.open(path)) {
+      std::cerr << file.error() << std::endl;
+      return 1;
+   }
+   std::cout << "Elements per array: " << count << "\n";
+   std::cout << "File size:          " << std::fixed << std::setprecision(1) << file_bytes / (1024.0 * 1024.0)
+             << " MB (written in " << write_s << " s)\n";
+   std::cout << "Index:              " << file.index().entries.size() << " arrays, built in " << std::setprecision(3)
+             << index_ms << " ms, " << std::filesystem::file_size(beve::index_path(path)) << " bytes\n\n";
+   
+   bool ok = true;
+   std::cout << std::left << std::setw(28) << "Slice (" + std::to_string(slice) + " elements)" << std::right
+             << std::setw(14) << "warm p50 us" << std::setw(14) << "warm p99 us" << std::setw(14) << "cold us"
+             << std::setw(10) << "GB/s" << "\n";
+   std::cout << std::string(80, '-') << "\n";
+   auto slice_case = [&]<typename T>(std::string_view pointer, std::type_identity<T>) {
+      const uint64_t first = (count - slice) / 2;
+      std::vector<T> out(slice);
+      beve::bench::options opts;
+      opts.samples = 100;
+      const auto warm = beve::bench::measure([&] {
+         ok &= file.read_range(pointer, first, std::span<T>(out));
+         beve::bench::do_not_optimize(out);
+      }, slice * sizeof(T), opts);
+      
+      // Cold: evict the file from the page cache first so the pread goes to the device
+      double cold_us = 0.0;
+#if defined(POSIX_FADV_DONTNEED)
+      constexpr int cold_runs = 5;
+      for (int i = 0; i < cold_runs; ++i) {
+         if (const int fd = ::open(path.c_str(), O_RDONLY); fd >= 0) {
+            ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+            ::close(fd);
+         }
+         const auto t0 = std::chrono::high_resolution_clock::now();
+         ok &= file.read_range(pointer, first, std::span<T>(out));
+         cold_us += std::chrono::duration<double, std::micro>(std::chrono::high_resolution_clock::now() - t0).count();
+      }
+      cold_us /= cold_runs;
+#endif
+      ok &= out.empty() || out.front() == slice_value<T>(first);
+      std::cout << std::left << std::setw(28) << pointer << std::right << std::fixed << std::setprecision(1)
+                << std::setw(14) << warm.p50_ns / 1e3 << std::setw(14) << warm.p99_ns / 1e3 << std::setw(14)
+                << cold_us << std::setprecision(2) << std::setw(10) << warm.gb_per_s << "\n";
+   };
+   slice_case("/large_float_vec", std::type_identity<float>{});
+   slice_case("/large_complex_double_vec", std::type_identity<std::complex<double>>{});
+   if (!ok) {
+      std::cerr << "Slice read failed: " << file.error() << std::endl;
+   }
+   
+   // Without an index the same elements cost a decode of the whole file
+   constexpr uint64_t full_decode_limit = uint64_t(2) << 30;
+   std::cout << "\nFull decode (glz::read_beve of all four arrays): ";
+   if (file_bytes <= full_decode_limit) {
+      beve::mapped_file mapped(path);
+      SliceArrays all;
+      start = std::chrono::high_resolution_clock::now();
+      ok &= !glz::read_beve(all, mapped.view());
+      const double full_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+      std::cout << std::setprecision(1) << full_ms << " ms (warm page cache)\n";
+   }
+   else {
+      std::cout << "skipped, " << file_bytes / double(1 << 30) << " GB exceeds the "
+                << full_decode_limit / double(1 << 30) << " GB memory budget\n";
+   }
+   
+   file.close();
+   std::remove(beve::index_path(path).c_str());
+   std::remove(path.c_str());
+   return ok ? 0 : 1;
+}
+
+// Validates a synthetic corpus with 1, 2, 4, ... threads and reports speedup over one thread
+int run_batch_scaling_benchmark(size_t file_count) {
+   std::cout << "C++ BEVE Batch Validation Scaling Benchmark\n";
+   std::cout << "===========================================\n\n";
+   
+   const auto dir = std::filesystem::temp_directory_path() / "beve_batch_corpus";
+   std::filesystem::remove_all(dir);
+   std::filesystem::create_directories(dir);
+   
+   // Mostly small records with a tail of larger arrays, roughly like an archive of captures
+   const SmallData small;
+   const MediumData medium;
+   const LargeFloatArray floats10k(10000);
+   const LargeFloatArray floats200k(200000);
+   std::string buffer;
+   for (size_t i = 0; i < file_count; ++i) {
+      glz::error_ctx ec;
+      switch (i % 20) {
+      case 0:
+         ec = glz::write_beve(floats200k, buffer);
+         break;
+      case 1: case 2: case 3: case 4:
+         ec = glz::write_beve(floats10k, buffer);
+         break;
+      case 5: case 6: case 7: case 8: case 9:
+         ec = glz::write_beve(medium, buffer);
          break;
+      default:
+         ec = glz::write_beve(small, buffer);
+         break;
+      }
+      if (ec) {
+         std::cerr << "Write error: " << glz::format_error(ec) << std::endl;
+         return 1;
+      }
+      char name[32];
+      std::snprintf(name, sizeof(name), "file_%06zu.beve", i);
+      std::ofstream out(dir / name, std::ios::binary);
+      out.write(buffer.data(), buffer.size());
+   }
+   
+   const auto paths = beve::collect_beve_files(dir);
+   beve::validate_batch(paths, {}); // warm the page cache
+   
+   std::vector<size_t> thread_counts;
+   const size_t max_threads = beve::thread_pool::default_threads();
+   for (size_t t = 1; t < max_threads; t *= 2) {
+      thread_counts.push_back(t);
+   }
+   thread_counts.push_back(max_threads);
+   
+   std::cout << "Corpus: " << paths.size() << " files in " << dir.string() << "\n\n";
+   std::cout << std::right << std::setw(8) << "Threads"
+             << std::setw(12) << "Time (ms)"
+             << std::setw(12) << "MB/s"
+             << std::setw(12) << "Files/s"
+             << std::setw(10) << "Speedup"
+             << std::setw(12) << "Efficiency\n";
+   std::cout << std::string(66, '-') << "\n";
+   
+   double single_thread_seconds = 0.0;
+   bool all_ok = true;
+   for (size_t threads : thread_counts) {
+      // Best of three runs, to keep scheduler noise out of the scaling curve
+      beve::batch_report best;
+      for (int run = 0; run < 3; ++run) {
+         auto report = beve::validate_batch(paths, {.threads = threads});
+         all_ok &= report.failures == 0;
+         if (run == 0 || report.seconds < best.seconds) {
+            best = std::move(report);
+         }
+      }
+      if (threads == 1) {
+         single_thread_seconds = best.seconds;
+      }
+      const double speedup = single_thread_seconds / best.seconds;
+      std::cout << std::setw(8) << threads
+                << std::fixed << std::setprecision(1)
+                << std::setw(12) << best.seconds * 1000.0
+                << std::setw(12) << best.bytes_per_second() / (1024.0 * 1024.0)
+                << std::setw(12) << paths.size() / best.seconds
+                << std::setprecision(2) << std::setw(10) << speedup
+                << std::setprecision(0) << std::setw(10) << 100.0 * speedup / threads << "%\n";
+   }
+   
+   std::filesystem::remove_all(dir);
+   if (!all_ok) {
+      std::cerr << "Some corpus files failed validation" << std::endl;
+      return 1;
+   }
+   return 0;
+}
+
+// Serializes 4-64 fields of `elements` doubles with glz::write_beve and with object_writer on
+// 1, 2, 4, ... threads, and reports the speedup of the field-parallel writer
+int run_parallel_write_benchmark(size_t elements) {
+   std::cout << "C++ BEVE Field-Parallel Write Benchmark\n";
+   std::cout << "=======================================\n\n";
+   
+   std::vector<size_t> thread_counts;
+   const size_t max_threads = beve::thread_pool::default_threads();
+   for (size_t t = 1; t < max_threads; t *= 2) {
+      thread_counts.push_back(t);
+   }
+   thread_counts.push_back(max_threads);
+   
+   // The fields, the sequential output, the per-field segments and the spliced output are all live at once
+   const double physical_bytes = double(::sysconf(_SC_PHYS_PAGES)) * double(::sysconf(_SC_PAGESIZE));
+   const double field_bytes = double(elements) * sizeof(double);
+   std::cout << "Fields of " << elements << " doubles (" << std::fixed << std::setprecision(1)
+             << field_bytes / (1024.0 * 1024.0) << " MB each), " << max_threads << " hardware threads\n\n";
+   std::cout << std::right << std::setw(8) << "Fields"
+             << std::setw(10) << "Threads"
+             << std::setw(12) << "Time (ms)"
+             << std::setw(10) << "GB/s"
+             << std::setw(10) << "Speedup\n";
+   std::cout << std::string(49, '-') << "\n";
+   
+   bool all_ok = true;
+   for (size_t field_count : {4, 8, 16, 32, 64}) {
+      if (4.0 * field_bytes * double(field_count) > 0.8 * physical_bytes) {
+         std::cout << std::setw(8) << field_count << "   skipped: needs "
+                   << std::setprecision(1) << 4.0 * field_bytes * double(field_count) / (1024.0 * 1024.0 * 1024.0)
+                   << " GB of RAM\n";
+         continue;
       }
       
-      auto duration = std::chrono::duration<double, std::milli>(end - start).count();
-      read_times.push_back(duration);
+      // A std::map serializes as an object with its keys in order, so it doubles as the reference
+      std::map<std::string, std::vector<double>> fields;
+      for (size_t f = 0; f < field_count; ++f) {
+         char key[16];
+         std::snprintf(key, sizeof(key), "field_%02zu", f);
+         auto& v = fields[key];
+         v.resize(elements);
+         for (size_t i = 0; i < elements; ++i) {
+            v[i] = double(f) + double(i) * 0.5;
+         }
+      }
+      const double total_gb = field_bytes * double(field_count) / (1024.0 * 1024.0 * 1024.0);
+      
+      std::string reference;
+      double sequential_seconds = 0.0;
+      for (int run = 0; run < 3; ++run) {
+         const auto start = std::chrono::steady_clock::now();
+         if (auto ec = glz::write_beve(fields, reference)) {
+            std::cerr << "Write error: " << glz::format_error(ec) << std::endl;
+            return 1;
+         }
+         const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+         sequential_seconds = run == 0 ? seconds : std::min(sequential_seconds, seconds);
+      }
+      std::cout << std::setw(8) << field_count << std::setw(10) << "glz"
+                << std::setprecision(1) << std::setw(12) << sequential_seconds * 1000.0
+                << std::setprecision(2) << std::setw(10) << total_gb / sequential_seconds
+                << std::setw(10) << 1.0 << "\n";
+      
+      beve::object_writer writer;
+      for (const auto& [key, values] : fields) {
+         writer.field(key, values);
+      }
+      std::string out;
+      for (size_t threads : thread_counts) {
+         beve::thread_pool pool(threads);
+         double best = 0.0;
+         for (int run = 0; run < 3; ++run) {
+            const auto start = std::chrono::steady_clock::now();
+            if (!writer.write(out, pool)) {
+               std::cerr << "Parallel write error: " << writer.error() << std::endl;
+               return 1;
+            }
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            best = run == 0 ? seconds : std::min(best, seconds);
+         }
+         const bool identical = out == reference;
+         all_ok &= identical;
+         std::cout << std::setw(8) << field_count << std::setw(10) << threads
+                   << std::setprecision(1) << std::setw(12) << best * 1000.0
+                   << std::setprecision(2) << std::setw(10) << total_gb / best
+                   << std::setw(10) << sequential_seconds / best
+                   << (identical ? "" : "  output differs from glz::write_beve!") << "\n";
+      }
    }
    
-   // Calculate average times
-   result.write_time_ms = std::accumulate(write_times.begin(), write_times.end(), 0.0) / write_times.size();
-   result.read_time_ms = std::accumulate(read_times.begin(), read_times.end(), 0.0) / read_times.size();
+   if (!all_ok) {
+      std::cerr << "object_writer output did not match glz::write_beve" << std::endl;
+      return 1;
+   }
+   return 0;
+}
+
+// Decodes `records` with glz::read_beve and with scan_array + read_array_parallel on 1, 2, 4, ...
+// threads; both results must re-encode to the same bytes
+template <class T>
+bool run_parallel_read_case(const std::string& label, const std::vector<T>& records,
+                            const std::vector<size_t>& thread_counts) {
+   std::string encoded;
+   if (auto ec = glz::write_beve(records, encoded)) {
+      std::cerr << "Write error: " << glz::format_error(ec) << std::endl;
+      return false;
+   }
+   const double mb = encoded.size() / (1024.0 * 1024.0);
+   std::cout << label << ": " << records.size() << " records, " << std::fixed << std::setprecision(1) << mb
+             << " MB\n";
    
-   // Calculate standard deviations
-   double write_variance = 0.0;
-   double read_variance = 0.0;
+   std::vector<T> sequential;
+   double sequential_seconds = 0.0;
+   for (int run = 0; run < 3; ++run) {
+      sequential.clear();
+      const auto start = std::chrono::steady_clock::now();
+      if (auto ec = glz::read_beve(sequential, encoded)) {
+         std::cerr << "Read error: " << glz::format_error(ec, encoded) << std::endl;
+         return false;
+      }
+      const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      sequential_seconds = run == 0 ? seconds : std::min(sequential_seconds, seconds);
+   }
+   std::string reference;
+   (void)glz::write_beve(sequential, reference);
+   
+   std::cout << std::right << std::setw(10) << "Threads"
+             << std::setw(13) << "Scan (ms)"
+             << std::setw(13) << "Total (ms)"
+             << std::setw(10) << "MB/s"
+             << std::setw(10) << "Speedup\n";
+   std::cout << std::string(55, '-') << "\n";
+   std::cout << std::setw(10) << "glz" << std::setw(13) << "-"
+             << std::setprecision(1) << std::setw(13) << sequential_seconds * 1000.0
+             << std::setprecision(0) << std::setw(10) << mb / sequential_seconds
+             << std::setprecision(2) << std::setw(10) << 1.0 << "\n";
    
-   for (double t : write_times) {
-      write_variance += (t - result.write_time_ms) * (t - result.write_time_ms);
+   bool ok = true;
+   std::vector<T> parallel;
+   std::string error;
+   for (size_t threads : thread_counts) {
+      beve::thread_pool pool(threads);
+      double best_scan = 0.0;
+      double best_total = 0.0;
+      for (int run = 0; run < 3; ++run) {
+         parallel.clear();
+         const auto start = std::chrono::steady_clock::now();
+         auto tape = beve::scan_array(encoded);
+         const auto scanned = std::chrono::steady_clock::now();
+         if (!tape || !beve::read_array_parallel(parallel, *tape, pool, error)) {
+            std::cerr << "Parallel read error: " << (tape ? error : std::string(beve::to_string(tape.error())))
+                      << std::endl;
+            return false;
+         }
+         const auto end = std::chrono::steady_clock::now();
+         const double scan = std::chrono::duration<double>(scanned - start).count();
+         const double total = std::chrono::duration<double>(end - start).count();
+         if (run == 0 || total < best_total) {
+            best_scan = scan;
+            best_total = total;
+         }
+      }
+      std::string check;
+      (void)glz::write_beve(parallel, check);
+      ok &= check == reference;
+      std::cout << std::setw(10) << threads
+                << std::setprecision(1) << std::setw(13) << best_scan * 1000.0
+                << std::setw(13) << best_total * 1000.0
+                << std::setprecision(0) << std::setw(10) << mb / best_total
+                << std::setprecision(2) << std::setw(10) << sequential_seconds / best_total
+                << (check == reference ? "" : "  result differs from glz::read_beve!") << "\n";
    }
-   write_variance /= write_times.size();
-   result.write_stddev_ms = std::sqrt(write_variance);
+   std::cout << "\n";
+   return ok;
+}
+
+int run_parallel_read_benchmark(size_t records) {
+   std::cout << "C++ BEVE Two-Stage Parallel Read Benchmark\n";
+   std::cout << "==========================================\n\n";
    
-   for (double t : read_times) {
-      read_variance += (t - result.read_time_ms) * (t - result.read_time_ms);
+   std::vector<size_t> thread_counts;
+   const size_t max_threads = beve::thread_pool::default_threads();
+   for (size_t t = 1; t < max_threads; t *= 2) {
+      thread_counts.push_back(t);
    }
-   read_variance /= read_times.size();
-   result.read_stddev_ms = std::sqrt(read_variance);
+   thread_counts.push_back(max_threads);
    
-   return result;
+   bool ok = true;
+   {
+      std::vector<SmallData> small(records);
+      for (size_t i = 0; i < records; ++i) {
+         small[i].id = int32_t(i);
+         small[i].value = double(i) * 0.25;
+         small[i].name = "record " + std::to_string(i);
+      }
+      ok &= run_parallel_read_case("SmallData", small, thread_counts);
+   }
+   {
+      // Roughly 1 KB of nested objects, maps, variants and optionals per element
+      std::vector<AllTypes> deep(std::max<size_t>(records / 10, 1));
+      for (size_t i = 0; i < deep.size(); ++i) {
+         deep[i].basic.i64 = int64_t(i);
+         deep[i].nested.extra = int32_t(i);
+      }
+      ok &= run_parallel_read_case("AllTypes", deep, thread_counts);
+   }
+   
+   if (!ok) {
+      std::cerr << "Parallel decode did not match glz::read_beve" << std::endl;
+      return 1;
+   }
+   return 0;
+}
+
+// Seconds per call of `f`, best of three timings each averaged over `reps` calls
+template <class F>
+double best_seconds_per_call(size_t reps, F&& f) {
+   double best = 0.0;
+   for (int run = 0; run < 3; ++run) {
+      const auto start = std::chrono::steady_clock::now();
+      for (size_t r = 0; r < reps; ++r) {
+         f();
+      }
+      const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / reps;
+      best = run == 0 ? seconds : std::min(best, seconds);
+   }
+   return best;
 }
 
-void write_results(const std::vector<BenchmarkResult>& results) {
-   std::ofstream file("cpp_benchmark_results.csv");
-   file << "Name,WriteTimeMs,ReadTimeMs,WriteStdDevMs,ReadStdDevMs,DataSizeBytes,Iterations\n";
+// Size, encode and decode throughput of one series as a raw typed array, as packed arrays with
+// each codec and, when built with zstd, as zstd-compressed BEVE at the default level. GB/s are
+// of the raw values, so the columns compare directly.
+template <class T>
+bool packed_comparison(const std::string& name, const std::vector<T>& values) {
+   const size_t raw_bytes = values.size() * sizeof(T);
+   beve::bench::options opts;
+   opts.samples = 30;
+   opts.hardware_counters = false;
    
-   for (const auto& r : results) {
-      file << r.name << ","
-           << r.write_time_ms << ","
-           << r.read_time_ms << ","
-           << r.write_stddev_ms << ","
-           << r.read_stddev_ms << ","
-           << r.data_size_bytes << ","
-           << r.iterations << "\n";
+   std::cout << name << " (" << values.size() << " values, " << raw_bytes << " bytes)\n";
+   std::cout << std::right << std::setw(14) << "Encoding" << std::setw(14) << "Size (B)" << std::setw(10) << "Ratio"
+             << std::setw(15) << "Encode GB/s" << std::setw(15) << "Decode GB/s\n";
+   std::cout << std::string(67, '-') << "\n";
+   auto row = [&](std::string_view encoding, size_t size, const beve::bench::measurement& encode,
+                  const beve::bench::measurement& decode) {
+      std::cout << std::setw(14) << encoding << std::setw(14) << size << std::fixed << std::setprecision(2)
+                << std::setw(10) << double(raw_bytes) / double(size) << std::setw(15) << encode.gb_per_s
+                << std::setw(15) << decode.gb_per_s << "\n";
+   };
+   
+   bool ok = true;
+   std::string encoded, scratch;
+   std::vector<T> decoded;
+   
+   (void)glz::write_beve(values, encoded);
+   const auto raw_write = beve::bench::measure([&] {
+      (void)glz::write_beve(values, scratch);
+      beve::bench::do_not_optimize(scratch);
+   }, raw_bytes, opts);
+   const auto raw_read = beve::bench::measure([&] {
+      ok &= !glz::read_beve(decoded, encoded);
+      beve::bench::do_not_optimize(decoded);
+   }, raw_bytes, opts);
+   ok &= decoded == values;
+   row("typed array", encoded.size(), raw_write, raw_read);
+   
+   for (auto codec : {beve::pack_codec::xor_previous, beve::pack_codec::delta}) {
+      std::string packed;
+      beve::write_packed_array(packed, std::span<const T>(values), codec);
+      const auto write = beve::bench::measure([&] {
+         scratch.clear();
+         beve::write_packed_array(scratch, std::span<const T>(values), codec);
+         beve::bench::do_not_optimize(scratch);
+      }, raw_bytes, opts);
+      const auto read = beve::bench::measure([&] {
+         ok &= bool(beve::read_packed_array(std::string_view(packed), decoded));
+         beve::bench::do_not_optimize(decoded);
+      }, raw_bytes, opts);
+      ok &= decoded == values;
+      row(codec == beve::pack_codec::xor_previous ? "packed xor" : "packed delta", packed.size(), write, read);
+   }
+   
+#if BEVE_HAS_ZSTD
+   beve::zstd_codec zstd;
+   std::string compressed;
+   ok &= zstd.compress(encoded, compressed);
+   const auto zstd_write = beve::bench::measure([&] {
+      ok &= zstd.compress(encoded, scratch);
+      beve::bench::do_not_optimize(scratch);
+   }, raw_bytes, opts);
+   const auto zstd_read = beve::bench::measure([&] {
+      ok &= zstd.read(decoded, compressed);
+      beve::bench::do_not_optimize(decoded);
+   }, raw_bytes, opts);
+   ok &= decoded == values;
+   row("zstd", compressed.size(), zstd_write, zstd_read);
+#endif
+   std::cout << std::endl;
+   if (!ok) {
+      std::cerr << "Round-trip failure in " << name << std::endl;
+   }
+   return ok;
+}
+
+// Packed arrays against raw typed arrays and zstd on telemetry-like series of `count` values
+int run_packed_benchmark(size_t count) {
+   std::cout << "C++ BEVE Packed Array Benchmark\n";
+   std::cout << "===============================\n\n";
+   
+   std::vector<float> ramp(count);
+   std::vector<double> wave(count);
+   std::vector<int64_t> timestamps(count);
+   for (size_t i = 0; i < count; ++i) {
+      ramp[i] = float(i) * 0.1f; // LargeFloatArray's data
+      wave[i] = std::round(std::sin(double(i) / 500.0) * 1e4) / 100.0; // a sensor quantized to 0.01
+      timestamps[i] = 1'700'000'000'000 + int64_t(i) * 1000 + int64_t(i % 7); // ms clock with jitter
    }
+   bool ok = packed_comparison("Float ramp i * 0.1f", ramp);
+   ok &= packed_comparison("Quantized sine (double)", wave);
+   ok &= packed_comparison("Millisecond timestamps (int64)", timestamps);
+   return ok ? 0 : 1;
+}
+
+// Row-wise (glz::write_beve of std::vector<SmallData>) against columnar (one typed array per
+// member) size and throughput from 1K to `max_records` records
+int run_columnar_benchmark(size_t max_records) {
+   std::cout << "C++ BEVE Row-wise vs Columnar Record Batches\n";
+   std::cout << "============================================\n\n";
+   std::cout << std::right << std::setw(10) << "Records"
+             << std::setw(10) << "Layout"
+             << std::setw(12) << "Bytes/rec"
+             << std::setw(14) << "Write Mrec/s"
+             << std::setw(13) << "Read Mrec/s"
+             << std::setw(12) << "Write MB/s"
+             << std::setw(11) << "Read MB/s\n";
+   std::cout << std::string(81, '-') << "\n";
+   
+   bool ok = true;
+   for (size_t count = 1000; count <= max_records; count *= 10) {
+      std::vector<SmallData> records(count);
+      for (size_t i = 0; i < count; ++i) {
+         records[i].id = int32_t(i);
+         records[i].value = double(i) * 0.25;
+         records[i].name = "record " + std::to_string(i);
+      }
+      const size_t reps = std::max<size_t>(1, 2'000'000 / count);
+      
+      std::string rows;
+      std::vector<SmallData> rows_back;
+      const double row_write = best_seconds_per_call(reps, [&] { (void)glz::write_beve(records, rows); });
+      const double row_read = best_seconds_per_call(reps, [&] { (void)glz::read_beve(rows_back, rows); });
+      
+      std::string columns;
+      std::vector<SmallData> columns_back;
+      const double col_write = best_seconds_per_call(
+         reps, [&] { beve::write_columnar(std::span<const SmallData>(records), small_data_columns, columns); });
+      bool read_ok = true;
+      const double col_read = best_seconds_per_call(
+         reps, [&] { read_ok &= bool(beve::read_columnar(columns_back, columns, small_data_columns)); });
+      
+      ok &= read_ok && columns_back.size() == count && rows_back.size() == count &&
+            columns_back.back().name == records.back().name && columns_back.back().value == records.back().value;
+      
+      auto row = [&](std::string_view layout, size_t bytes, double write, double read) {
+         const double mb = bytes / (1024.0 * 1024.0);
+         std::cout << std::setw(10) << count << std::setw(10) << layout
+                   << std::fixed << std::setprecision(2) << std::setw(12) << double(bytes) / count
+                   << std::setw(14) << count / write / 1e6
+                   << std::setw(13) << count / read / 1e6
+                   << std::setprecision(0) << std::setw(12) << mb / write
+                   << std::setw(11) << mb / read << "\n";
+      };
+      row("rows", rows.size(), row_write, row_read);
+      row("columns", columns.size(), col_write, col_read);
+   }
+   
+   if (!ok) {
+      std::cerr << "Columnar round trip did not reproduce the records" << std::endl;
+      return 1;
+   }
+   return 0;
+}
+
+// Latency of SmallData handoffs over the shared-memory ring: the producer serializes and pushes
+// a frame, the consumer decodes it and pushes its id back on `ack`. Half of each round trip is
+// reported as the one-way latency, serialization and decoding included.
+std::vector<double> ring_latencies(beve::shm_ring& out, beve::shm_ring& ack, size_t count) {
+   std::vector<double> one_way;
+   one_way.reserve(count);
+   SmallData message;
+   std::string frame;
+   for (size_t i = 0; i < count; ++i) {
+      message.id = int32_t(i);
+      const auto start = std::chrono::steady_clock::now();
+      (void)glz::write_beve(message, frame);
+      out.push(frame);
+      (void)ack.wait_front();
+      ack.pop();
+      const auto stop = std::chrono::steady_clock::now();
+      one_way.push_back(std::chrono::duration<double, std::nano>(stop - start).count() / 2.0);
+   }
+   std::sort(one_way.begin(), one_way.end());
+   return one_way;
+}
+
+void print_ring_latency(const std::vector<double>& sorted) {
+   if (sorted.empty()) {
+      return;
+   }
+   std::cout << "SmallData one-way latency (" << sorted.size() << " round trips): " << std::fixed
+             << std::setprecision(2) << "median " << beve::bench::percentile(sorted, 0.5) / 1000.0 << " us, p99 "
+             << beve::bench::percentile(sorted, 0.99) / 1000.0 << " us, max " << sorted.back() / 1000.0 << " us\n";
+}
+
+// Streams `count` SmallData frames and `float_frames` 1 MB float frames through the ring
+void push_ring_stream(beve::shm_ring& out, size_t count, size_t float_frames) {
+   SmallData message;
+   std::string frame;
+   for (size_t i = 0; i < count; ++i) {
+      message.id = int32_t(i);
+      (void)glz::write_beve(message, frame);
+      out.push(frame);
+   }
+   std::vector<float> floats(256 * 1024);
+   for (size_t i = 0; i < float_frames; ++i) {
+      floats[0] = float(i);
+      (void)glz::write_beve(floats, frame);
+      out.push(frame);
+   }
+}
+
+// Handoff latency and streaming throughput between two threads, each with its own mapping of
+// the segments as separate processes would have
+int run_ring_benchmark(size_t count) {
+   std::cout << "C++ BEVE Shared-Memory Ring Benchmark\n";
+   std::cout << "=====================================\n\n";
+   const char* data_name = "/beve_bench_ring";
+   const char* ack_name = "/beve_bench_ring_ack";
+   beve::shm_ring out, ack;
+   if (!out.create(data_name, size_t(1) << 24) || !ack.create(ack_name, size_t(1) << 16)) {
+      std::cerr << "Failed to create the rings: " << out.error() << ack.error() << std::endl;
+      return 1;
+   }
+   const size_t float_frames = std::max<size_t>(1, count / 100);
+   std::atomic<bool> ok{true};
+   std::chrono::steady_clock::time_point small_done, floats_done;
+   
+   std::thread consumer([&] {
+      beve::shm_ring in, back;
+      if (!in.open(data_name) || !back.open(ack_name)) {
+         ok = false;
+         return;
+      }
+      SmallData message;
+      std::string reply;
+      for (size_t i = 0; i < count; ++i) {
+         auto frame = in.wait_front();
+         ok = ok && frame && !glz::read_beve(message, *frame) && message.id == int32_t(i);
+         in.pop();
+         (void)glz::write_beve(message.id, reply);
+         back.push(reply);
+      }
+      for (size_t i = 0; i < count; ++i) {
+         auto frame = in.wait_front();
+         ok = ok && frame && !glz::read_beve(message, *frame);
+         in.pop();
+      }
+      small_done = std::chrono::steady_clock::now();
+      std::vector<float> floats;
+      for (size_t i = 0; i < float_frames; ++i) {
+         auto frame = in.wait_front();
+         ok = ok && frame && !glz::read_beve(floats, *frame) && floats[0] == float(i);
+         in.pop();
+      }
+      floats_done = std::chrono::steady_clock::now();
+   });
+   
+   print_ring_latency(ring_latencies(out, ack, count));
+   const auto start = std::chrono::steady_clock::now();
+   push_ring_stream(out, count, float_frames);
+   out.close_writer();
+   consumer.join();
+   beve::shm_ring::unlink(data_name);
+   beve::shm_ring::unlink(ack_name);
+   
+   const double small_seconds = std::chrono::duration<double>(small_done - start).count();
+   const double float_seconds = std::chrono::duration<double>(floats_done - small_done).count();
+   std::cout << "SmallData stream: " << std::fixed << std::setprecision(2) << count / small_seconds / 1e6
+             << " M frames/s (write, push, decode)\n";
+   std::cout << "1 MB float frames: " << float_frames / float_seconds << " frames/s, "
+             << float_frames * 1.0 / 1024.0 / float_seconds << " GB/s\n";
+   if (!ok) {
+      std::cerr << "Frames did not arrive intact" << std::endl;
+      return 1;
+   }
+   return 0;
+}
+
+// The producer half of the cross-language benchmark, for `julia benchmark.jl --ring <name>`:
+// a config frame {"small_frames", "float_frames"}, `count` SmallData round trips (Julia echoes
+// each id on `<name>_ack`), then the same stream as run_ring_benchmark
+int run_ring_producer(const std::string& name, size_t count) {
+   beve::shm_ring out, ack;
+   if (!out.create(name, size_t(1) << 24) || !ack.create(name + "_ack", size_t(1) << 16)) {
+      std::cerr << "Failed to create the rings: " << out.error() << ack.error() << std::endl;
+      return 1;
+   }
+   const size_t float_frames = std::max<size_t>(1, count / 100);
+   std::map<std::string, uint64_t> config{{"small_frames", count}, {"float_frames", float_frames}};
+   std::string frame;
+   (void)glz::write_beve(config, frame);
+   out.push(frame);
+   std::cout << "Waiting for `julia benchmark.jl --ring " << name << "`..." << std::endl;
+   
+   print_ring_latency(ring_latencies(out, ack, count));
+   push_ring_stream(out, count, float_frames);
+   out.close_writer();
+   std::cout << "Streamed " << count << " SmallData and " << float_frames << " float frames" << std::endl;
+   // The consumer unlinks the segments once it has drained them
+   return 0;
 }
 
-int main() {
+struct PointerEmployee {
+   std::string name;
+   double salary{};
+   std::vector<std::string> skills;
+};
+
+template <>
+struct glz::meta<PointerEmployee> {
+   using T = PointerEmployee;
+   static constexpr auto value = object("name", &T::name, "salary", &T::salary, "skills", &T::skills);
+};
+
+struct PointerCompany {
+   std::string name;
+   std::vector<float> history;
+   std::vector<PointerEmployee> employees;
+   std::map<std::string, double> metrics;
+};
+
+template <>
+struct glz::meta<PointerCompany> {
+   using T = PointerCompany;
+   static constexpr auto value =
+      object("name", &T::name, "history", &T::history, "employees", &T::employees, "metrics", &T::metrics);
+};
+
+// One field of a large object by JSON pointer: beve::resolve_pointer on the encoded bytes plus a
+// decode of just the target, against decoding everything (into the struct, and into json_t as a
+// schema-less reader would) and then indexing
+int run_pointer_benchmark(size_t employee_count) {
+   std::cout << "C++ BEVE JSON Pointer Benchmark\n";
+   std::cout << "===============================\n\n";
+   PointerCompany company;
+   company.name = "Acme";
+   company.history.resize(size_t(16) << 20);
+   std::iota(company.history.begin(), company.history.end(), 0.0f);
+   company.employees.resize(employee_count);
+   for (size_t i = 0; i < employee_count; ++i) {
+      company.employees[i] = {"employee " + std::to_string(i), 1000.0 + double(i), {"c++", "julia", "beve"}};
+   }
+   for (int i = 0; i < 1000; ++i) {
+      company.metrics["metric_" + std::to_string(i)] = i * 0.5;
+   }
+   std::string buffer;
+   if (auto ec = glz::write_beve(company, buffer)) {
+      std::cerr << "Write error: " << glz::format_error(ec) << std::endl;
+      return 1;
+   }
+   company = {};
+   std::cout << "Encoded " << employee_count << " employees and 16M history floats, " << std::fixed
+             << std::setprecision(1) << buffer.size() / (1024.0 * 1024.0) << " MB\n\n";
+
+   const std::string last = std::to_string(employee_count - 1);
+   const std::string middle = std::to_string(employee_count / 2);
+   const std::vector<std::string> pointers{"/name",
+                                           "/history/12345678",
+                                           "/employees/0/salary",
+                                           "/employees/" + middle + "/salary",
+                                           "/employees/" + last + "/skills/2",
+                                           "/metrics/metric_999"};
+
+   beve::bench::options fast;
+   fast.samples = 50;
+   std::cout << std::left << std::setw(40) << "Pointer" << std::right << std::setw(12) << "Depth" << std::setw(16)
+             << "resolve (us)" << std::setw(18) << "+ decode (us)" << "\n";
+   std::cout << std::string(86, '-') << "\n";
+   bool ok = true;
+   for (const auto& pointer : pointers) {
+      const auto depth = std::count(pointer.begin(), pointer.end(), '/');
+      const auto resolve = beve::bench::measure(
+         [&] { beve::bench::do_not_optimize(beve::resolve_pointer(buffer, pointer)); }, 0, fast);
+      glz::json_t value;
+      const auto decode = beve::bench::measure(
+         [&] {
+            auto target = beve::resolve_pointer(buffer, pointer);
+            ok &= target && !glz::read_beve(value, target->encoded(buffer));
+            beve::bench::do_not_optimize(value);
+         },
+         0, fast);
+      std::cout << std::left << std::setw(40) << pointer << std::right << std::setw(12) << depth << std::setprecision(2)
+                << std::setw(16) << resolve.p50_ns / 1000.0 << std::setw(18) << decode.p50_ns / 1000.0 << "\n";
+   }
+
+   beve::bench::options slow;
+   slow.samples = 5;
+   slow.warmup_samples = 1;
+   slow.hardware_counters = false;
+   PointerCompany typed;
+   const auto full_struct = beve::bench::measure(
+      [&] {
+         ok &= !glz::read_beve(typed, buffer);
+         beve::bench::do_not_optimize(typed.employees.back().salary);
+      },
+      buffer.size(), slow);
+   glz::json_t generic;
+   const auto full_json = beve::bench::measure(
+      [&] {
+         ok &= !glz::read_beve(generic, buffer);
+         beve::bench::do_not_optimize(generic["employees"].get_array()[employee_count - 1]["salary"].get_number());
+      },
+      buffer.size(), slow);
+   std::cout << "\nFull decode, then index:\n";
+   std::cout << std::left << std::setw(40) << "glz::read_beve into PointerCompany" << std::right << std::setw(12)
+             << std::setprecision(2) << full_struct.p50_ns / 1e6 << " ms\n";
+   std::cout << std::left << std::setw(40) << "glz::read_beve into json_t" << std::right << std::setw(12)
+             << full_json.p50_ns / 1e6 << " ms\n";
+   if (!ok) {
+      std::cerr << "A pointer lookup or decode failed" << std::endl;
+      return 1;
+   }
+   return 0;
+}
+
+struct PatchState {
+   std::string status;
+   std::vector<double> samples;
+   std::map<std::string, uint64_t> counters;
+};
+
+template <>
+struct glz::meta<PatchState> {
+   using T = PatchState;
+   static constexpr auto value = object("status", &T::status, "samples", &T::samples, "counters", &T::counters);
+};
+
+// One counter in a large state blob: beve::patch_number (resolve + overwrite in place), an
+// overwrite through a cached target, a resized string (a splice of everything after it) and an
+// inserted member, against re-serializing the whole state after each update
+int run_patch_benchmark(size_t megabytes) {
+   std::cout << "C++ BEVE Patch Benchmark\n";
+   std::cout << "========================\n\n";
+   PatchState state;
+   state.status = "ok";
+   state.samples.resize((megabytes << 20) / sizeof(double));
+   std::iota(state.samples.begin(), state.samples.end(), 0.0);
+   for (int i = 0; i < 100; ++i) {
+      state.counters["counter_" + std::to_string(i)] = uint64_t(i);
+   }
+   std::string buffer;
+   if (auto ec = glz::write_beve(state, buffer)) {
+      std::cerr << "Write error: " << glz::format_error(ec) << std::endl;
+      return 1;
+   }
+   std::cout << "State blob: " << std::fixed << std::setprecision(1) << buffer.size() / (1024.0 * 1024.0)
+             << " MB, counters after the samples\n\n";
+
+   bool ok = true;
+   uint64_t n = 0;
+   beve::bench::options fast;
+   fast.samples = 50;
+   const auto patch = beve::bench::measure(
+      [&] { ok &= beve::patch_number(buffer, "/counters/counter_99", ++n).has_value(); }, 0, fast);
+
+   const auto target = beve::resolve_pointer(buffer, "/counters/counter_99");
+   char encoded[9];
+   encoded[0] = char(beve::number_header<uint64_t>());
+   const auto cached = beve::bench::measure(
+      [&] {
+         ++n;
+         std::memcpy(encoded + 1, &n, sizeof(n));
+         ok &= target && beve::overwrite_value(buffer, *target, std::string_view(encoded, sizeof(encoded))).has_value();
+      },
+      0, fast);
+
+   beve::bench::options slow;
+   slow.samples = 10;
+   slow.warmup_samples = 1;
+   slow.hardware_counters = false;
+   const std::string statuses[2] = {"ok", "degraded"};
+   std::string status;
+   const auto splice = beve::bench::measure(
+      [&] {
+         status.clear();
+         status.push_back(char(beve::headers::string));
+         beve::write_compressed_size(status, statuses[n % 2].size());
+         status += statuses[n++ % 2];
+         ok &= beve::patch_value(buffer, "/status", status).has_value();
+      },
+      buffer.size(), slow);
+   const auto insert = beve::bench::measure(
+      [&] {
+         const std::string pointer = "/counters/new_" + std::to_string(++n);
+         ok &= beve::patch_number(buffer, pointer, n).has_value();
+      },
+      0, fast);
+
+   std::string out;
+   out.reserve(buffer.size() * 2);
+   const auto rewrite = beve::bench::measure(
+      [&] {
+         state.counters["counter_99"] = ++n;
+         ok &= !glz::write_beve(state, out);
+         beve::bench::do_not_optimize(out.data());
+      },
+      buffer.size(), slow);
+
+   std::cout << std::left << std::setw(48) << "Update" << std::right << std::setw(14) << "p50 (us)" << std::setw(16)
+             << "updates/s" << "\n";
+   std::cout << std::string(78, '-') << "\n";
+   auto row = [](std::string_view name, const auto& r) {
+      std::cout << std::left << std::setw(48) << name << std::right << std::setprecision(2) << std::setw(14)
+                << r.p50_ns / 1000.0 << std::setprecision(0) << std::setw(16) << 1e9 / r.p50_ns << "\n";
+   };
+   row("patch_number (resolve + overwrite)", patch);
+   row("overwrite_value (cached target)", cached);
+   row("patch_value, resized string before samples", splice);
+   row("patch_number, inserted counter", insert);
+   row("glz::write_beve of the whole state", rewrite);
+   std::cout << "\nSpeedup of patch_number over re-serialization: " << std::setprecision(0)
+             << rewrite.p50_ns / patch.p50_ns << "x\n";
+   if (!ok) {
+      std::cerr << "A patch or write failed" << std::endl;
+      return 1;
+   }
+   return 0;
+}
+
+// Dictionary-encoded keys on record batches: size and decode time of `records` SmallData (and
+// records / 100 MediumData, whose 100 lookup keys repeat across the batch) with string keys
+// against the same batch through beve::encode_keys. glaze reads plain BEVE only, so the keyed
+// decode is beve::expand_keys followed by glz::read_beve.
+template <class T>
+bool compare_key_encodings(std::string_view label, const std::vector<T>& batch) {
+   bool ok = true;
+   std::string plain;
+   if (auto ec = glz::write_beve(batch, plain)) {
+      std::cerr << "Write error: " << glz::format_error(ec) << std::endl;
+      return false;
+   }
+   auto keyed = beve::encode_keys(plain);
+   if (!keyed) {
+      std::cerr << "encode_keys failed: " << beve::to_string(keyed.error()) << std::endl;
+      return false;
+   }
+
+   beve::bench::options slow;
+   slow.samples = 10;
+   slow.warmup_samples = 1;
+   slow.hardware_counters = false;
+   std::vector<T> decoded;
+   std::string expanded;
+   const auto read_plain = beve::bench::measure(
+      [&] {
+         ok &= !glz::read_beve(decoded, plain);
+         beve::bench::do_not_optimize(decoded.data());
+      },
+      plain.size(), slow);
+   const auto expand = beve::bench::measure(
+      [&] {
+         expanded.clear();
+         beve::key_table table;
+         ok &= beve::expand_keys(*keyed, expanded, table).has_value();
+         beve::bench::do_not_optimize(expanded.data());
+      },
+      keyed->size(), slow);
+   const auto read_keyed = beve::bench::measure(
+      [&] {
+         expanded.clear();
+         beve::key_table table;
+         ok &= beve::expand_keys(*keyed, expanded, table).has_value() && !glz::read_beve(decoded, expanded);
+         beve::bench::do_not_optimize(decoded.data());
+      },
+      keyed->size(), slow);
+   std::string encoded;
+   const auto encode = beve::bench::measure(
+      [&] {
+         encoded.clear();
+         beve::key_table table;
+         ok &= beve::encode_keys(plain, encoded, table).has_value();
+         beve::bench::do_not_optimize(encoded.data());
+      },
+      plain.size(), slow);
+
+   std::cout << label << " (" << batch.size() << " records)\n";
+   std::cout << "  string keys:  " << std::setw(10) << std::setprecision(2) << plain.size() / (1024.0 * 1024.0)
+             << " MB\n";
+   std::cout << "  keyed:        " << std::setw(10) << keyed->size() / (1024.0 * 1024.0) << " MB ("
+             << std::setprecision(1) << 100.0 * double(keyed->size()) / double(plain.size()) << "%)\n";
+   auto row = [](std::string_view name, const auto& r) {
+      std::cout << "  " << std::left << std::setw(44) << name << std::right << std::setprecision(2) << std::setw(10)
+                << r.p50_ns / 1e6 << " ms\n";
+   };
+   row("glz::read_beve, string keys", read_plain);
+   row("expand_keys", expand);
+   row("expand_keys + glz::read_beve, keyed", read_keyed);
+   row("encode_keys", encode);
+   std::cout << "\n";
+   return ok;
+}
+
+int run_keys_benchmark(size_t records) {
+   std::cout << "C++ BEVE Key Dictionary Benchmark\n";
+   std::cout << "=================================\n\n";
+   std::cout << std::fixed;
+   std::vector<SmallData> small(records);
+   for (size_t i = 0; i < records; ++i) {
+      small[i].id = int32_t(i);
+      small[i].value = double(i) * 0.5;
+      small[i].name = "item" + std::to_string(i);
+   }
+   const std::vector<MediumData> medium(std::max<size_t>(records / 100, 1));
+   const bool ok = compare_key_encodings("SmallData", small) && compare_key_encodings("MediumData", medium);
+   if (!ok) {
+      std::cerr << "A key encoding or decode failed" << std::endl;
+      return 1;
+   }
+   return 0;
+}
+
+// Growth-based writing (glz::write_beve into an empty buffer) against sizing LargeArrayTypes
+// with beve::size_of first and writing once, into memory or straight into a mapped file. Peak
+// RSS only ever grows, so the writers run from the smallest expected footprint to the largest
+// and the column shows where the high-water mark stood after each.
+int run_exact_size_benchmark(size_t megabytes) {
+   std::cout << "C++ BEVE Exact-Size Write Benchmark\n";
+   std::cout << "===================================\n\n";
+   constexpr size_t element_bytes =
+      sizeof(float) + sizeof(double) + sizeof(std::complex<float>) + sizeof(std::complex<double>);
+   const LargeArrayTypes data(megabytes * 1024 * 1024 / element_bytes);
+   const size_t encoded = beve::size_of(data);
+   const std::string path = (std::filesystem::temp_directory_path() / "beve_exact_size_bench.beve").string();
+   constexpr int samples = 3;
+
+   std::cout << std::fixed << std::setprecision(1);
+   std::cout << "Elements:        " << data.large_float_vec.size() << " per field\n";
+   std::cout << "Encoded size:    " << encoded / (1024.0 * 1024.0) << " MB\n";
+   std::cout << "Baseline RSS:    " << peak_rss_mb() << " MB (the value itself)\n\n";
+   std::cout << std::left << std::setw(34) << "Writer" << std::right << std::setw(12) << "Best (ms)" << std::setw(10)
+             << "GB/s" << std::setw(16) << "Peak RSS (MB)" << "\n";
+   std::cout << std::string(72, '-') << "\n";
+
+   bool ok = true;
+   auto row = [&](const char* name, auto&& write) {
+      double best = 1e300;
+      for (int i = 0; i < samples; ++i) {
+         const auto start = std::chrono::steady_clock::now();
+         write();
+         best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+      }
+      std::cout << std::left << std::setw(34) << name << std::right << std::setw(12) << best * 1e3 << std::setw(10)
+                << encoded / best / 1e9 << std::setw(16) << peak_rss_mb() << "\n";
+   };
+
+   row("write_file_exact (mapped file)", [&] { ok &= beve::write_file_exact(data, path); });
+   row("write_exact (one allocation)", [&] {
+      std::string out;
+      beve::write_exact(data, out);
+      beve::bench::do_not_optimize(out);
+   });
+   std::string reused;
+   row("write_exact (reused buffer)", [&] {
+      beve::write_exact(data, reused);
+      beve::bench::do_not_optimize(reused);
+   });
+   reused = {};
+   row("glz::write_beve (growing buffer)", [&] {
+      std::string out;
+      ok &= !glz::write_beve(data, out);
+      beve::bench::do_not_optimize(out);
+   });
+   row("glz::write_beve + ofstream", [&] {
+      std::string out;
+      ok &= !glz::write_beve(data, out);
+      std::ofstream(path, std::ios::binary).write(out.data(), std::streamsize(out.size()));
+   });
+
+   // The exact writers must produce glaze's bytes
+   std::string exact, grown;
+   beve::write_exact(data, exact);
+   ok &= !glz::write_beve(data, grown) && exact == grown;
+   grown = {};
+   ok &= beve::write_file_exact(data, path);
+   {
+      beve::mapped_file file(path);
+      ok &= file.view() == exact;
+   }
+   std::remove(path.c_str());
+   std::cout << "\nMatches glz::write_beve: " << (ok ? "✓" : "✗") << "\n";
+   return ok ? 0 : 1;
+}
+
+// Checkpoint wall time: `files` LargeArrayTypes objects of `megabytes` each, written one after
+// another with glz::write_beve + ofstream, then through beve::async_file_writer, which encodes
+// each object into a staging buffer while the kernel writes the previous ones. Without fsync the
+// buffered rows finish once the page cache holds the data; the O_DIRECT rows reach the device.
+int run_async_write_benchmark(size_t files, size_t megabytes) {
+   std::cout << "C++ BEVE Async Checkpoint Benchmark\n";
+   std::cout << "===================================\n\n";
+   constexpr size_t element_bytes =
+      sizeof(float) + sizeof(double) + sizeof(std::complex<float>) + sizeof(std::complex<double>);
+   const LargeArrayTypes data(megabytes * 1024 * 1024 / element_bytes);
+   const size_t encoded = beve::size_of(data);
+   const auto dir = std::filesystem::temp_directory_path() / "beve_async_bench";
+   std::filesystem::create_directories(dir);
+   auto path = [&](size_t i) { return (dir / ("checkpoint_" + std::to_string(i) + ".beve")).string(); };
+
+   bool direct_supported = false;
+#if defined(O_DIRECT)
+   const int probe = ::open(path(0).c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, 0644);
+   direct_supported = probe >= 0;
+   if (probe >= 0) {
+      ::close(probe);
+   }
+#endif
+
+   std::cout << std::fixed << std::setprecision(1);
+   std::cout << "Checkpoint:      " << files << " files x " << encoded / (1024.0 * 1024.0) << " MB in " << dir.string()
+             << "\n\n";
+   std::cout << std::left << std::setw(40) << "Writer" << std::right << std::setw(12) << "Wall (ms)" << std::setw(10)
+             << "GB/s" << "\n";
+   std::cout << std::string(62, '-') << "\n";
+
+   bool ok = true;
+   auto row = [&](const std::string& name, auto&& checkpoint) {
+      double best = 1e300;
+      for (int i = 0; i < 3; ++i) {
+         const auto start = std::chrono::steady_clock::now();
+         checkpoint();
+         best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+      }
+      std::cout << std::left << std::setw(40) << name << std::right << std::setw(12) << best * 1e3 << std::setw(10)
+                << double(files * encoded) / best / 1e9 << "\n";
+   };
+
+   row("glz::write_beve + ofstream (sync)", [&] {
+      std::string out;
+      for (size_t i = 0; i < files; ++i) {
+         ok &= !glz::write_beve(data, out);
+         std::ofstream(path(i), std::ios::binary | std::ios::trunc).write(out.data(), std::streamsize(out.size()));
+      }
+   });
+
+   auto async_row = [&](const std::string& name, beve::async_write_options options) {
+      beve::async_file_writer probe_writer(options);
+      if (options.use_io_uring && !probe_writer.using_io_uring()) {
+         std::cout << std::left << std::setw(40) << name << "  io_uring unavailable\n";
+         return;
+      }
+      const std::string label = name + (options.register_buffers && !probe_writer.registered() ? " (unregistered)" : "");
+      row(label, [&] {
+         beve::async_file_writer writer(options);
+         for (size_t i = 0; i < files; ++i) {
+            writer.write_value(path(i), data);
+         }
+         ok &= writer.finish();
+      });
+   };
+
+   beve::async_write_options pool;
+   pool.use_io_uring = false;
+   async_row("async_file_writer (thread pool)", pool);
+   beve::async_write_options uring;
+   async_row("async_file_writer (io_uring)", uring);
+   uring.register_buffers = true;
+   async_row("async_file_writer (io_uring, registered)", uring);
+   if (direct_supported) {
+      auto direct_pool = pool;
+      direct_pool.direct = true;
+      async_row("async_file_writer (thread pool, O_DIRECT)", direct_pool);
+      uring.direct = true;
+      async_row("async_file_writer (io_uring, registered, O_DIRECT)", uring);
+   }
+   else {
+      std::cout << "(O_DIRECT unsupported in " << dir.string() << ", skipped)\n";
+   }
+
+   // The last checkpoint must hold glaze's bytes
+   std::string expected;
+   ok &= !glz::write_beve(data, expected);
+   for (size_t i = 0; i < files; ++i) {
+      std::string file;
+      ok &= beve::read_file(path(i), file) && file == expected;
+   }
+   std::filesystem::remove_all(dir);
+   std::cout << "\nFiles match glz::write_beve: " << (ok ? "✓" : "✗") << "\n";
+   return ok ? 0 : 1;
+}
+
+struct ScalingResult {
+   std::string type;
+   size_t elements = 0;
+   size_t encoded_bytes = 0;
+   double write_gbps = 0.0;
+   double read_gbps = 0.0;
+   double memcpy_gbps = 0.0; // copying the encoded bytes: the bandwidth ceiling at this size
+   double peak_rss_mb = 0.0;
+   uint64_t write_faults = 0; // minor + major faults of one cold write into an empty buffer
+   uint64_t read_faults = 0; // the same for one cold read into an empty vector
+   double read_cache_misses_per_byte = 0.0; // 0 without hardware counters
+};
+
+// One size of one element type. `bytes_per_element` estimates source plus encoded bytes; cases
+// whose source, encoded copy, decoded copy and memcpy target would not fit in available memory
+// are skipped rather than pushed into swap.
+template <typename T, typename Make>
+std::optional<ScalingResult> scaling_case(const std::string& type, size_t n, size_t bytes_per_element, Make&& make,
+                                          bool& ok) {
+   const size_t available = beve::bench::available_memory();
+   if (available && double(n) * double(bytes_per_element) * 2.5 > double(available) * 0.8) {
+      return std::nullopt;
+   }
+   beve::bench::reset_peak_rss();
+   auto faults = [] {
+      const auto m = beve::bench::current_memory();
+      return m.minor_faults + m.major_faults;
+   };
+   
+   std::vector<T> data = make(n);
+   ScalingResult r{type, n};
+   
+   uint64_t before = faults();
+   std::string buffer;
+   ok &= !glz::write_beve(data, buffer);
+   r.write_faults = faults() - before;
+   r.encoded_bytes = buffer.size();
+   
+   before = faults();
+   std::vector<T> loaded;
+   ok &= !glz::read_beve(loaded, buffer);
+   r.read_faults = faults() - before;
+   ok &= loaded == data;
+   
+   // About 2 GB of traffic per measurement, between 3 and 50 samples
+   beve::bench::options opts;
+   opts.samples = std::clamp<size_t>(size_t(2e9 / double(std::max<size_t>(buffer.size(), 1))), 3, 50);
+   opts.warmup_samples = 1;
+   
+   const auto write = beve::bench::measure([&] {
+      ok &= !glz::write_beve(data, buffer);
+      beve::bench::do_not_optimize(buffer);
+   }, buffer.size(), opts);
+   const auto read = beve::bench::measure([&] {
+      ok &= !glz::read_beve(loaded, buffer);
+      beve::bench::do_not_optimize(loaded);
+   }, buffer.size(), opts);
+   std::string target(buffer.size(), '\0');
+   const auto copy = beve::bench::measure([&] {
+      std::memcpy(target.data(), buffer.data(), buffer.size());
+      beve::bench::do_not_optimize(target);
+   }, buffer.size(), opts);
+   
+   r.write_gbps = write.gb_per_s;
+   r.read_gbps = read.gb_per_s;
+   r.memcpy_gbps = copy.gb_per_s;
+   r.read_cache_misses_per_byte = read.counters.cache_misses_per_byte;
+   r.peak_rss_mb = beve::bench::current_memory().peak_rss_bytes / (1024.0 * 1024.0);
+   return r;
+}
+
+// Write and read throughput of bare float, double, complex and string arrays from 10K elements
+// up to `max_elements` in 1-3-10 steps, next to a memcpy of the same bytes, so the curves show
+// where each cache level runs out and how close the codec gets to memory bandwidth beyond it.
+// Results go to cpp_scaling_results.csv for analyze_benchmarks.jl.
+int run_scaling_benchmark(size_t max_elements) {
+   std::cout << "C++ BEVE Scaling Benchmark\n";
+   std::cout << "==========================\n\n";
+   const auto caches = beve::bench::detect_caches();
+   std::cout << "Caches: L1d " << caches.l1d / 1024 << " KB, L2 " << caches.l2 / 1024 << " KB, L3 "
+             << caches.l3 / (1024 * 1024) << " MB; available memory "
+             << beve::bench::available_memory() / (1024 * 1024) << " MB\n";
+   if (!beve::bench::reset_peak_rss()) {
+      std::cout << "(peak RSS cannot be reset here; the column is cumulative)\n";
+   }
+   std::cout << "\n";
+   
+   std::vector<size_t> sizes;
+   for (size_t decade = 10'000; decade <= max_elements; decade *= 10) {
+      sizes.push_back(decade);
+      if (decade * 3 <= max_elements) {
+         sizes.push_back(decade * 3);
+      }
+   }
+   
+   std::cout << std::left << std::setw(10) << "Type" << std::right << std::setw(14) << "Elements" << std::setw(12)
+             << "Size (MB)" << std::setw(10) << "Write" << std::setw(10) << "Read" << std::setw(10) << "memcpy"
+             << std::setw(10) << "W/memcpy" << std::setw(10) << "R/memcpy" << std::setw(12) << "Peak RSS"
+             << std::setw(12) << "W faults" << std::setw(12) << "R faults" << "\n";
+   std::cout << std::left << std::setw(46) << "" << std::right << std::setw(30) << "(GB/s)" << std::setw(44) << "(MB)"
+             << "\n";
+   std::cout << std::string(122, '-') << "\n";
+   
+   std::ofstream csv("cpp_scaling_results.csv");
+   csv << "Type,Elements,EncodedBytes,WriteGBps,ReadGBps,MemcpyGBps,PeakRssMB,WriteFaults,ReadFaults,"
+          "ReadCacheMissesPerByte,L1Bytes,L2Bytes,L3Bytes\n";
+   
+   bool ok = true;
+   auto report = [&](const std::string& type, size_t n, std::optional<ScalingResult> r) {
+      if (!r) {
+         std::cout << std::left << std::setw(10) << type << std::right << std::setw(14) << n
+                   << "  skipped: would not fit in available memory\n";
+         return;
+      }
+      std::cout << std::left << std::setw(10) << r->type << std::right << std::setw(14) << r->elements << std::fixed
+                << std::setprecision(2) << std::setw(12) << r->encoded_bytes / (1024.0 * 1024.0) << std::setw(10)
+                << r->write_gbps << std::setw(10) << r->read_gbps << std::setw(10) << r->memcpy_gbps << std::setw(10)
+                << r->write_gbps / r->memcpy_gbps << std::setw(10) << r->read_gbps / r->memcpy_gbps
+                << std::setprecision(1) << std::setw(12) << r->peak_rss_mb << std::setw(12) << r->write_faults
+                << std::setw(12) << r->read_faults << "\n";
+      csv << r->type << "," << r->elements << "," << r->encoded_bytes << "," << r->write_gbps << "," << r->read_gbps
+          << "," << r->memcpy_gbps << "," << r->peak_rss_mb << "," << r->write_faults << "," << r->read_faults << ","
+          << r->read_cache_misses_per_byte << "," << caches.l1d << "," << caches.l2 << "," << caches.l3 << "\n";
+      csv.flush();
+   };
+   
+   for (size_t n : sizes) {
+      report("float", n, scaling_case<float>("float", n, 2 * sizeof(float), [](size_t count) {
+         std::vector<float> v(count);
+         for (size_t i = 0; i < count; ++i) {
+            v[i] = float(i) * 0.1f;
+         }
+         return v;
+      }, ok));
+   }
+   for (size_t n : sizes) {
+      report("double", n, scaling_case<double>("double", n, 2 * sizeof(double), [](size_t count) {
+         std::vector<double> v(count);
+         for (size_t i = 0; i < count; ++i) {
+            v[i] = double(i) * 0.1;
+         }
+         return v;
+      }, ok));
+   }
+   for (size_t n : sizes) {
+      report("complex", n, scaling_case<std::complex<float>>("complex", n, 2 * sizeof(std::complex<float>),
+                                                              [](size_t count) {
+         std::vector<std::complex<float>> v(count);
+         for (size_t i = 0; i < count; ++i) {
+            v[i] = {float(i), float(i) * 0.5f};
+         }
+         return v;
+      }, ok));
+   }
+   // Up to 15 characters, so every string fits std::string's inline buffer and the curve measures
+   // the codec rather than the allocator
+   for (size_t n : sizes) {
+      report("string", n, scaling_case<std::string>("string", n, sizeof(std::string) + 12, [](size_t count) {
+         std::vector<std::string> v(count);
+         for (size_t i = 0; i < count; ++i) {
+            v[i] = "s" + std::to_string(i % 10'000'000);
+         }
+         return v;
+      }, ok));
+   }
+   
+   std::cout << "\nResults written to cpp_scaling_results.csv\n";
+   std::cout << "Round trips: " << (ok ? "✓" : "✗") << "\n";
+   return ok ? 0 : 1;
+}
+
+// Integer-keyed objects (U32_OBJECT => f64) decoded into the three container choices: std::map
+// and std::unordered_map through glz::read_beve, and beve::flat_map through read_flat_map. Each
+// size is decoded from key order, as glaze writes a std::map, and from hash order, as BEVE.jl
+// writes a Dict; lookups probe every key once in a shuffled order.
+int run_flat_map_benchmark(size_t max_keys) {
+   std::cout << "C++ BEVE Flat Map Benchmark\n";
+   std::cout << "===========================\n\n";
+   std::cout << std::fixed;
+   std::cout << std::left << std::setw(10) << "Keys" << std::setw(8) << "Input" << std::setw(16) << "Container"
+             << std::right << std::setw(14) << "Decode (ms)" << std::setw(14) << "ns / key" << std::setw(16)
+             << "Lookup (ns)" << "\n";
+   std::cout << std::string(78, '-') << "\n";
+
+   bool ok = true;
+   for (size_t n = 1000; n <= max_keys; n *= 10) {
+      // Multiplying by an odd constant permutes uint32_t, so the keys are distinct and scattered
+      std::map<uint32_t, double> tree;
+      std::unordered_map<uint32_t, double> hashed;
+      hashed.reserve(n);
+      for (size_t i = 0; i < n; ++i) {
+         const uint32_t key = uint32_t(i) * 2654435761u;
+         tree.emplace(key, double(i) * 0.5);
+         hashed.emplace(key, double(i) * 0.5);
+      }
+      std::vector<uint32_t> probes;
+      probes.reserve(n);
+      for (const auto& [k, v] : tree) {
+         probes.push_back(k);
+      }
+      std::shuffle(probes.begin(), probes.end(), std::mt19937(42));
+
+      std::string key_order, hash_order;
+      beve::write_exact(tree, key_order);
+      beve::write_exact(hashed, hash_order);
+      tree = {};
+      hashed = {};
+
+      beve::bench::options slow;
+      slow.samples = n >= 1'000'000 ? 5 : 20;
+      slow.warmup_samples = 1;
+      slow.hardware_counters = false;
+      beve::bench::options fast;
+      fast.samples = 20;
+      fast.hardware_counters = false;
+
+      for (const auto* input : {&key_order, &hash_order}) {
+         const char* order = input == &key_order ? "sorted" : "hashed";
+         auto row = [&](const char* container, const beve::bench::measurement& decode, auto&& find) {
+            size_t j = 0;
+            double sum = 0.0;
+            const auto lookup = beve::bench::measure(
+               [&] {
+                  sum += find(probes[j]);
+                  j = j + 1 == probes.size() ? 0 : j + 1;
+               },
+               0, fast);
+            beve::bench::do_not_optimize(sum);
+            std::cout << std::left << std::setw(10) << n << std::setw(8) << order << std::setw(16) << container
+                      << std::right << std::setprecision(3) << std::setw(14) << decode.p50_ns / 1e6
+                      << std::setprecision(1) << std::setw(14) << decode.p50_ns / double(n) << std::setw(16)
+                      << lookup.p50_ns << "\n";
+         };
+
+         std::map<uint32_t, double> as_map;
+         const auto map_decode = beve::bench::measure(
+            [&] {
+               as_map.clear();
+               ok &= !glz::read_beve(as_map, *input);
+            },
+            input->size(), slow);
+         ok &= as_map.size() == n;
+         row("std::map", map_decode, [&](uint32_t key) { return as_map.find(key)->second; });
+         as_map = {};
+
+         std::unordered_map<uint32_t, double> as_hash;
+         const auto hash_decode = beve::bench::measure(
+            [&] {
+               as_hash = {};
+               ok &= !glz::read_beve(as_hash, *input);
+            },
+            input->size(), slow);
+         ok &= as_hash.size() == n;
+         row("unordered_map", hash_decode, [&](uint32_t key) { return as_hash.find(key)->second; });
+         as_hash = {};
+
+         beve::flat_map<uint32_t, double> as_flat;
+         const auto flat_decode = beve::bench::measure(
+            [&] { ok &= beve::read_flat_map(*input, as_flat).has_value(); }, input->size(), slow);
+         ok &= as_flat.size() == n;
+         row("flat_map", flat_decode, [&](uint32_t key) { return (*as_flat.find(key)).second; });
+      }
+   }
+   std::cout << "\nDecoded sizes: " << (ok ? "✓" : "✗") << "\n";
+   return ok ? 0 : 1;
+}
+
+// Planar complex arrays against today's interleaved path, for complex<float> and complex<double>
+// arrays from 1M elements up to `max_elements`. An FFT consumer wants split real/imaginary
+// buffers: today that is glz::read_beve followed by a deinterleave loop, against
+// read_split_complex of interleaved bytes (one SIMD pass) or of planar bytes (two copies). Every
+// buffer is reused across samples, so the times are conversions rather than page faults.
+template <class T>
+bool planar_case(const char* type, size_t n) {
+   std::vector<std::complex<T>> values(n);
+   std::vector<T> re(n), im(n);
+   for (size_t i = 0; i < n; ++i) {
+      values[i] = {T(i) * T(0.5), T(1) - T(i)};
+      re[i] = values[i].real();
+      im[i] = values[i].imag();
+   }
+   std::string interleaved, planar;
+   bool ok = !glz::write_beve(values, interleaved);
+   beve::write_planar_complex_array<T>(planar, values);
+   const double bytes = double(interleaved.size());
+   const int samples = n >= 50'000'000 ? 3 : 10;
+
+   auto row = [&](const char* name, auto&& op) {
+      op();
+      double best = 1e300;
+      for (int i = 0; i < samples; ++i) {
+         const auto start = std::chrono::steady_clock::now();
+         op();
+         best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+      }
+      std::cout << std::left << std::setw(9) << type << std::right << std::setw(12) << n << "  " << std::left
+                << std::setw(44) << name << std::right << std::setw(10) << best * 1e3 << std::setw(10)
+                << bytes / best / 1e9 << "\n";
+   };
+
+   std::string out;
+   out.reserve(interleaved.size());
+   row("write: glz::write_beve (interleaved)", [&] {
+      out.clear();
+      ok &= !glz::write_beve(values, out);
+   });
+   row("write: planar from std::complex (SIMD)", [&] {
+      out.clear();
+      beve::write_planar_complex_array<T>(out, values);
+   });
+   row("write: planar from split buffers", [&] {
+      out.clear();
+      beve::write_planar_complex_array<T>(out, re, im);
+   });
+
+   std::vector<std::complex<T>> decoded(n);
+   std::vector<T> split_re(n), split_im(n);
+   row("split: glz::read_beve + deinterleave loop", [&] {
+      ok &= !glz::read_beve(decoded, interleaved);
+      for (size_t i = 0; i < decoded.size(); ++i) {
+         split_re[i] = decoded[i].real();
+         split_im[i] = decoded[i].imag();
+      }
+   });
+   row("split: read_split_complex, interleaved", [&] {
+      ok &= beve::read_split_complex<T>(interleaved, split_re, split_im).has_value();
+   });
+   row("split: read_split_complex, planar", [&] {
+      ok &= beve::read_split_complex<T>(planar, split_re, split_im).has_value();
+   });
+   ok &= split_re == re && split_im == im;
+
+   row("complex: glz::read_beve (interleaved)", [&] { ok &= !glz::read_beve(decoded, interleaved); });
+   row("complex: read_complex_array, planar (SIMD)", [&] {
+      ok &= beve::read_complex_array<T>(planar, decoded).has_value();
+   });
+   ok &= decoded == values;
+   beve::bench::do_not_optimize(out.data());
+   return ok;
+}
+
+int run_planar_benchmark(size_t max_elements) {
+   std::cout << "C++ BEVE Planar Complex Benchmark\n";
+   std::cout << "=================================\n\n";
+   std::cout << std::fixed << std::setprecision(2);
+   std::cout << std::left << std::setw(9) << "Type" << std::right << std::setw(12) << "Elements" << "  " << std::left
+             << std::setw(44) << "Path" << std::right << std::setw(10) << "Best (ms)" << std::setw(10) << "GB/s"
+             << "\n";
+   std::cout << std::string(87, '-') << "\n";
+   bool ok = true;
+   for (size_t n = 1'000'000; n <= max_elements; n *= 10) {
+      // values, split copies of them, two encodings and the decode targets: about 6 copies
+      if (6 * n * sizeof(std::complex<float>) > beve::bench::available_memory()) {
+         std::cout << n << " elements skipped: would not fit in available memory\n";
+         continue;
+      }
+      ok &= planar_case<float>("float", n);
+      if (6 * n * sizeof(std::complex<double>) <= beve::bench::available_memory()) {
+         ok &= planar_case<double>("double", n);
+      }
+      std::cout << "\n";
+   }
+   std::cout << "Decoded values match: " << (ok ? "✓" : "✗") << "\n";
+   return ok ? 0 : 1;
+}
+
+// Closed-loop HTTP load: each connection keeps `pipeline` GETs of `path` in flight, sending the
+// next batch once the previous one is answered. Latency is measured from the write of a batch
+// to the arrival of each response in it.
+struct http_load_result {
+   size_t requests = 0;
+   size_t bytes = 0;
+   double seconds = 0;
+   std::vector<double> latencies_ns;
+   bool ok = true;
+};
+
+http_load_result http_load(uint16_t port, const std::string& path, size_t connections, size_t pipeline, double seconds) {
+   std::vector<http_load_result> per_connection(connections);
+   std::vector<std::thread> threads;
+   const auto start = std::chrono::steady_clock::now();
+   const auto deadline = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                    std::chrono::duration<double>(seconds));
+   for (size_t c = 0; c < connections; ++c) {
+      threads.emplace_back([&, c] {
+         auto& result = per_connection[c];
+         beve::http_client client;
+         if (!client.connect("127.0.0.1", port)) {
+            result.ok = false;
+            return;
+         }
+         while (result.ok && std::chrono::steady_clock::now() < deadline) {
+            const auto sent = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < pipeline && result.ok; ++i) {
+               result.ok = client.send("GET", path);
+            }
+            for (size_t i = 0; i < pipeline && result.ok; ++i) {
+               auto response = client.receive();
+               result.ok = response && response->status == 200;
+               if (result.ok) {
+                  result.bytes += response->body.size();
+                  result.latencies_ns.push_back(
+                     std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - sent).count());
+               }
+            }
+            result.requests += pipeline;
+         }
+      });
+   }
+   for (auto& t : threads) {
+      t.join();
+   }
+   http_load_result total;
+   total.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+   for (auto& r : per_connection) {
+      total.requests += r.requests;
+      total.bytes += r.bytes;
+      total.ok &= r.ok;
+      total.latencies_ns.insert(total.latencies_ns.end(), r.latencies_ns.begin(), r.latencies_ns.end());
+   }
+   std::sort(total.latencies_ns.begin(), total.latencies_ns.end());
+   return total;
+}
+
+// /small (SmallData) and /large (256K floats, 1 MB), first whole, then /small's "name" field
+// through a JSON pointer in the path
+int run_http_load(uint16_t port, size_t connections, size_t pipeline, double seconds) {
+   std::cout << connections << " connections, " << pipeline << " requests in flight per connection, " << seconds
+             << " s per case\n\n";
+   std::cout << std::left << std::setw(18) << "Request" << std::right << std::setw(14) << "req/s" << std::setw(12)
+             << "MB/s" << std::setw(12) << "p50 (us)" << std::setw(12) << "p99 (us)\n";
+   bool ok = true;
+   for (const char* path : {"/small", "/small/name", "/large"}) {
+      const auto r = http_load(port, path, connections, pipeline, seconds);
+      ok &= r.ok && !r.latencies_ns.empty();
+      if (r.latencies_ns.empty()) {
+         std::cout << std::left << std::setw(18) << path << "  failed\n";
+         continue;
+      }
+      std::cout << std::left << std::setw(18) << path << std::right << std::fixed << std::setprecision(0)
+                << std::setw(14) << r.requests / r.seconds << std::setw(12) << r.bytes / r.seconds / 1e6
+                << std::setprecision(1) << std::setw(12) << beve::bench::percentile(r.latencies_ns, 0.5) / 1000.0
+                << std::setw(12) << beve::bench::percentile(r.latencies_ns, 0.99) / 1000.0 << "\n";
+   }
+   if (!ok) {
+      std::cerr << "Some requests failed" << std::endl;
+      return 1;
+   }
+   return 0;
+}
+
+// Serves the load's objects from beve::http_server in this process. `julia benchmark.jl
+// --http-server <port>` serves the same objects from HTTPExt for `--http-load <port>`.
+int run_http_benchmark(size_t connections, size_t pipeline, double seconds) {
+   std::cout << "C++ BEVE HTTP Server Benchmark\n";
+   std::cout << "==============================\n\n";
+   beve::http_server_options options;
+   options.threads = connections;
+   beve::http_server server(options);
+   std::string small, large;
+   (void)glz::write_beve(SmallData{}, small);
+   std::vector<float> floats(256 * 1024);
+   std::iota(floats.begin(), floats.end(), 0.0f);
+   (void)glz::write_beve(floats, large);
+   server.register_object("/small", std::move(small));
+   server.register_object("/large", std::move(large));
+   if (!server.start("127.0.0.1", 0)) {
+      std::cerr << "Failed to start the server: " << server.error() << std::endl;
+      return 1;
+   }
+   const int result = run_http_load(server.port(), connections, pipeline, seconds);
+   server.stop();
+   return result;
+}
+
+int main(int argc, char* argv[]) {
+   if (argc > 1 && std::string_view(argv[1]) == "--file-io") {
+      return run_file_io_benchmarks();
+   }
+   if (argc > 1 && std::string_view(argv[1]) == "--stream") {
+      return run_stream_benchmark(argc > 2 ? std::stoull(argv[2]) : 100'000'000);
+   }
+   if (argc > 1 && std::string_view(argv[1]) == "--batch-scaling") {
+      return run_batch_scaling_benchmark(argc > 2 ? std::stoul(argv[2]) : 5000);
+   }
+   if (argc > 1 && std::string_view(argv[1]) == "--parallel-write") {
+      return run_parallel_write_benchmark(argc > 2 ? std::stoull(argv[2]) : 10'000'000);
+   }
+   if (argc > 1 && std::string_view(argv[1]) == "--parallel-read") {
+      return run_parallel_read_benchmark(argc > 2 ? std::stoull(argv[2]) : 1'000'000);
+   }
+   if (argc > 1 && std::string_view(argv[1]) == "--columnar") {
+      return run_columnar_benchmark(argc > 2 ? std::stoull(argv[2]) : 10'000'000);
+   }
+   if (argc > 1 && std::string_view(argv[1]) == "--packed") {
+      return run_packed_benchmark(argc > 2 ? std::stoull(argv[2]) : 1'000'000);
+   }
+   if (argc > 1 && std::string_view(argv[1]) == "--ring") {
+      return run_ring_benchmark(argc > 2 ? std::stoull(argv[2]) : 100'000);
+   }
+   if (argc > 2 && std::string_view(argv[1]) == "--ring-producer") {
+      return run_ring_producer(argv[2], argc > 3 ? std::stoull(argv[3]) : 100'000);
+   }
+   if (argc > 1 && std::string_view(argv[1]) == "--pointer") {
+      return run_pointer_benchmark(argc > 2 ? std::stoull(argv[2]) : 200'000);
+   }
+   if (argc > 1 && std::string_view(argv[1]) == "--patch") {
+      return run_patch_benchmark(argc > 2 ? std::stoull(argv[2]) : 100);
+   }
+   if (argc > 1 && std::string_view(argv[1]) == "--keys") {
+      return run_keys_benchmark(argc > 2 ? std::stoull(argv[2]) : 1'000'000);
+   }
+   if (argc > 1 && std::string_view(argv[1]) == "--exact-size") {
+      return run_exact_size_benchmark(argc > 2 ? std::stoull(argv[2]) : 1024);
+   }
+   if (argc > 1 && std::string_view(argv[1]) == "--async-write") {
+      return run_async_write_benchmark(argc > 2 ? std::stoull(argv[2]) : 8, argc > 3 ? std::stoull(argv[3]) : 100);
+   }
+   if (argc > 1 && std::string_view(argv[1]) == "--flat-map") {
+      return run_flat_map_benchmark(argc > 2 ? std::stoull(argv[2]) : 10'000'000);
+   }
+   if (argc > 1 && std::string_view(argv[1]) == "--planar") {
+      return run_planar_benchmark(argc > 2 ? std::stoull(argv[2]) : 100'000'000);
+   }
+   if (argc > 1 && std::string_view(argv[1]) == "--scaling") {
+      return run_scaling_benchmark(argc > 2 ? std::stoull(argv[2]) : 1'000'000'000);
+   }
+   if (argc > 1 && std::string_view(argv[1]) == "--http") {
+      return run_http_benchmark(argc > 2 ? std::stoul(argv[2]) : 4, argc > 3 ? std::stoul(argv[3]) : 16,
+                                argc > 4 ? std::stod(argv[4]) : 3.0);
+   }
+   if (argc > 2 && std::string_view(argv[1]) == "--http-load") {
+      std::cout << "BEVE HTTP Load against port " << argv[2] << "\n\n";
+      return run_http_load(uint16_t(std::stoul(argv[2])), argc > 3 ? std::stoul(argv[3]) : 4,
+                           argc > 4 ? std::stoul(argv[4]) : 16, argc > 5 ? std::stod(argv[5]) : 3.0);
+   }
+   if (argc > 1 && std::string_view(argv[1]) == "--alloc") {
+      return run_allocation_benchmark();
+   }
+   if (argc > 1 && std::string_view(argv[1]) == "--view") {
+      return run_view_benchmarks(argc > 2 ? std::stoul(argv[2]) : 500);
+   }
+   if (argc > 1 && std::string_view(argv[1]) == "--slice") {
+      return run_slice_benchmark(argc > 2 ? std::stoull(argv[2]) : 1'000'000'000, argc > 3 ? std::stoull(argv[3]) : 100'000);
+   }
+   if (argc > 1 && std::string_view(argv[1]) == "--zstd") {
+#if BEVE_HAS_ZSTD
+      return run_zstd_benchmark();
+#else
+      std::cerr << "beve_benchmark was built without zstd" << std::endl;
+      return 1;
+#endif
+   }
+   
    std::cout << "C++ BEVE Benchmark (Glaze)\n";
    std::cout << "==========================\n\n";
    
-   std::vector<BenchmarkResult> results;
+   BenchmarkReport report;
+   report.metadata = beve::bench::collect_metadata();
+   auto& results = report.results;
    
    // Small data
    std::cout << "Benchmarking small data..." << std::endl;
@@ -213,6 +2579,11 @@ int main() {
    LargeFloatArray large1m(1000000);
    results.push_back(benchmark_type("Float Array 1M", large1m, 100));
    
+   // The same 1M floats stored at half the size
+   std::cout << "Benchmarking bf16 and f16 float arrays (1M)..." << std::endl;
+   results.push_back(benchmark_half("Float Array 1M bf16", large1m, beve::half_format::bf16, 100));
+   results.push_back(benchmark_half("Float Array 1M f16", large1m, beve::half_format::f16, 100));
+   
    // Complex array (10K)
    std::cout << "Benchmarking complex array (10K)..." << std::endl;
    LargeComplexArray complex10k(10000);
@@ -224,24 +2595,71 @@ int main() {
    results.push_back(benchmark_type("Complex Array 100K", complex100k, 100));
    
    // Print results
-   std::cout << "\nResults:\n";
+   std::cout << "\nResults (per call, ns):\n";
    std::cout << std::left << std::setw(20) << "Test"
-             << std::right << std::setw(15) << "Write (ms)"
-             << std::setw(15) << "Read (ms)"
-             << std::setw(15) << "Size (bytes)"
-             << std::setw(15) << "Iterations\n";
-   std::cout << std::string(80, '-') << "\n";
+             << std::right << std::setw(12) << "Size (B)"
+             << std::setw(12) << "Write p50"
+             << std::setw(12) << "Write p99"
+             << std::setw(10) << "GB/s"
+             << std::setw(12) << "Read p50"
+             << std::setw(12) << "Read p99"
+             << std::setw(10) << "GB/s"
+             << std::setw(8) << "Batch\n";
+   std::cout << std::string(108, '-') << "\n";
    
-   for (const auto& r : results) {
+   for (const auto& r : report.results) {
       std::cout << std::left << std::setw(20) << r.name
-                << std::right << std::setw(15) << std::fixed << std::setprecision(3) << r.write_time_ms
-                << std::setw(15) << r.read_time_ms
-                << std::setw(15) << r.data_size_bytes
-                << std::setw(15) << r.iterations << "\n";
+                << std::right << std::setw(12) << r.data_size_bytes
+                << std::fixed << std::setprecision(1)
+                << std::setw(12) << r.write.p50_ns
+                << std::setw(12) << r.write.p99_ns
+                << std::setprecision(2) << std::setw(10) << r.write.gb_per_s
+                << std::setprecision(1)
+                << std::setw(12) << r.read.p50_ns
+                << std::setw(12) << r.read.p99_ns
+                << std::setprecision(2) << std::setw(10) << r.read.gb_per_s
+                << std::setw(8) << r.read.batch << "\n";
    }
    
-   write_results(results);
-   std::cout << "\nResults written to cpp_benchmark_results.csv\n";
+   std::cout << "\nHeap allocations per call (steady state):\n";
+   std::cout << std::left << std::setw(20) << "Test"
+             << std::right << std::setw(12) << "Write"
+             << std::setw(12) << "Read\n";
+   for (const auto& r : report.results) {
+      std::cout << std::left << std::setw(20) << r.name
+                << std::right << std::setprecision(2)
+                << std::setw(12) << r.write_allocations
+                << std::setw(12) << r.read_allocations << "\n";
+   }
+   
+   if (report.metadata.hardware_counters) {
+      std::cout << "\nHardware counters (read, per byte):\n";
+      std::cout << std::left << std::setw(20) << "Test"
+                << std::right << std::setw(12) << "cycles"
+                << std::setw(12) << "instr"
+                << std::setw(12) << "IPC"
+                << std::setw(14) << "cache miss"
+                << std::setw(14) << "branch miss\n";
+      for (const auto& r : report.results) {
+         const auto& c = r.read.counters;
+         std::cout << std::left << std::setw(20) << r.name
+                   << std::right << std::setprecision(3)
+                   << std::setw(12) << c.cycles_per_byte
+                   << std::setw(12) << c.instructions_per_byte
+                   << std::setw(12) << c.instructions_per_cycle
+                   << std::setprecision(5)
+                   << std::setw(14) << c.cache_misses_per_byte
+                   << std::setw(14) << c.branch_misses_per_byte << "\n";
+      }
+   }
+   else {
+      std::cout << "\nHardware counters unavailable (perf_event_open denied or unsupported)\n";
+   }
+   
+   if (!write_results(report)) {
+      return 1;
+   }
+   std::cout << "\nResults written to cpp_benchmark_results.json\n";
    
    return 0;
 }
\ No newline at end of file
@@ -4,6 +4,14 @@ using BEVE
 using Statistics
 using Printf
 
+# to_beve_zstd lives in a package extension; the packed comparison skips zstd without it
+const HAS_ZSTD = try
+    @eval using CodecZstd
+    true
+catch
+    false
+end
+
 struct BenchmarkResult
     name::String
     write_time_ms::Float64
@@ -52,9 +60,9 @@ function create_large_complex_array(size::Int)
     LargeComplexArray(data)
 end
 
-function benchmark_type(name::String, data, iterations::Int)
+function benchmark_type(name::String, data, iterations::Int; float32_as::Symbol = :f32)
     # Warm up
-    buffer = to_beve(data)
+    buffer = to_beve(data; float32_as = float32_as)
     _ = deser_beve(typeof(data), buffer)
     
     data_size_bytes = length(buffer)
@@ -68,7 +76,7 @@ function benchmark_type(name::String, data, iterations::Int)
     
     for _ in 1:iterations
         t0 = time()
-        buffer = to_beve!(io_buffer, data)
+        buffer = to_beve!(io_buffer, data; float32_as = float32_as)
         t1 = time()
         push!(write_times, (t1 - t0) * 1000)  # Convert to ms
     end
@@ -135,6 +143,11 @@ function main()
     large1m = create_large_float_array(1000000)
     push!(results, benchmark_type("Float Array 1M", large1m, 100))
     
+    # The same 1M floats stored at half the size
+    println("Benchmarking bf16 and f16 float arrays (1M)...")
+    push!(results, benchmark_type("Float Array 1M bf16", large1m, 100; float32_as = :bf16))
+    push!(results, benchmark_type("Float Array 1M f16", large1m, 100; float32_as = :f16))
+    
     # Complex array (10K)
     println("Benchmarking complex array (10K)...")
     complex10k = create_large_complex_array(10000)
@@ -159,5 +172,459 @@ function main()
     println("\nResults written to julia_benchmark_results.csv")
 end
 
-# Run the benchmark
-main()
\ No newline at end of file
+# Row-wise (a generic array of objects) against columnar (one typed array per field) batches
+# of SmallData, from 1K records up to `max_records`
+function benchmark_columnar(max_records::Int)
+    println("Julia BEVE Row-wise vs Columnar Record Batches")
+    println("==============================================\n")
+    @printf("%10s %10s %12s %14s %13s\n", "Records", "Layout", "Bytes/rec", "Write Mrec/s", "Read Mrec/s")
+    println("-" ^ 63)
+
+    count = 1000
+    while count <= max_records
+        records = [SmallData(Int32(i), i * 0.25, "record $i") for i in 0:count - 1]
+        reps = max(1, 200_000 ÷ count)
+        for (layout, write) in (("rows", to_beve), ("columns", to_beve_columnar))
+            bytes = write(records)
+            back = deser_beve(Vector{SmallData}, bytes)
+            back == records || error("$layout round trip did not reproduce the records")
+            write_time = minimum(@elapsed(for _ in 1:reps; write(records); end) for _ in 1:3) / reps
+            read_time = minimum(@elapsed(for _ in 1:reps; deser_beve(Vector{SmallData}, bytes); end) for _ in 1:3) / reps
+            @printf("%10d %10s %12.2f %14.2f %13.2f\n", count, layout, length(bytes) / count,
+                    count / write_time / 1e6, count / read_time / 1e6)
+        end
+        count *= 10
+    end
+end
+
+# Size and decode throughput of one series as a typed array, a packed array and (with
+# CodecZstd) zstd-compressed BEVE. GB/s are of the raw values, so the columns compare directly.
+function packed_comparison(name::String, values::Vector)
+    raw_bytes = sizeof(values)
+    println("$name ($(length(values)) values, $raw_bytes bytes)")
+    @printf("%14s %14s %10s %15s %15s\n", "Encoding", "Size (B)", "Ratio", "Encode GB/s", "Decode GB/s")
+    println("-" ^ 72)
+    encodings = Any[("typed array", v -> to_beve(v), from_beve),
+                    ("packed", v -> to_beve(v; pack_arrays = true), from_beve)]
+    HAS_ZSTD && push!(encodings, ("zstd", v -> to_beve_zstd(v), from_beve_zstd))
+    for (label, encode, decode) in encodings
+        bytes = encode(values)
+        decode(bytes) == values || error("$label round trip did not reproduce the values")
+        reps = max(1, 50_000_000 ÷ raw_bytes)
+        encode_time = minimum(@elapsed(for _ in 1:reps; encode(values); end) for _ in 1:3) / reps
+        decode_time = minimum(@elapsed(for _ in 1:reps; decode(bytes); end) for _ in 1:3) / reps
+        @printf("%14s %14d %10.2f %15.2f %15.2f\n", label, length(bytes), raw_bytes / length(bytes),
+                raw_bytes / encode_time / 1e9, raw_bytes / decode_time / 1e9)
+    end
+    println()
+end
+
+# The series of beve_benchmark --packed: LargeFloatArray's ramp, a quantized sensor reading and
+# a millisecond clock with jitter
+function benchmark_packed(count::Int)
+    println("Julia BEVE Packed Array Benchmark")
+    println("=================================\n")
+    packed_comparison("Float ramp i * 0.1f", Float32[i * 0.1f0 for i in 0:count - 1])
+    packed_comparison("Quantized sine (double)", [round(sin(i / 500) * 1e4) / 100 for i in 0:count - 1])
+    packed_comparison("Millisecond timestamps (int64)", Int64[1_700_000_000_000 + 1000i + i % 7 for i in 0:count - 1])
+end
+
+# The consumer half of `beve_benchmark --ring-producer <name> [count]`: echoes the id of each
+# SmallData frame of the latency phase on `<name>_ack` (beve_benchmark reports the one-way
+# latency), then times decoding the SmallData and 1 MB float streams straight from the ring
+function benchmark_ring(name::String)
+    println("Julia BEVE Shared-Memory Ring Consumer")
+    println("======================================\n")
+    ring, ack = nothing, nothing
+    while ring === nothing || ack === nothing
+        try
+            ring = open_beve_ring(name)
+            ack = open_beve_ring(name * "_ack")
+        catch
+            sleep(0.01)  # the producer has not created the segments yet
+        end
+    end
+    config = read_beve_frame(ring)
+    small_frames, float_frames = Int(config["small_frames"]), Int(config["float_frames"])
+
+    for i in 0:small_frames - 1
+        message = deser_beve_frame(SmallData, ring)
+        message.id == i || error("SmallData frame $i arrived out of order")
+        write_beve_frame(ack, message.id)
+    end
+
+    start = time_ns()
+    for _ in 1:small_frames
+        deser_beve_frame(SmallData, ring)
+    end
+    small_seconds = (time_ns() - start) / 1e9
+    start = time_ns()
+    for i in 0:float_frames - 1
+        floats = read_beve_frame(ring)::Vector{Float32}
+        floats[1] == i || error("Float frame $i arrived out of order")
+    end
+    float_seconds = (time_ns() - start) / 1e9
+    read_beve_frame(ring) === nothing || error("Unexpected frames after the float stream")
+
+    @printf("SmallData stream: %.3f M frames/s (deser_beve_frame)\n", small_frames / small_seconds / 1e6)
+    @printf("1 MB float frames: %.1f frames/s, %.2f GB/s (read_beve_frame)\n",
+            float_frames / float_seconds, float_frames / 1024 / float_seconds)
+    close(ring)
+    close(ack)
+    unlink_beve_ring(name)
+    unlink_beve_ring(name * "_ack")
+end
+
+# JSON pointer lookups on the encoded bytes (from_beve_at) against decoding everything with
+# from_beve and indexing, at several depths into a company with `employees` employees
+struct PointerEmployee
+    name::String
+    salary::Float64
+    skills::Vector{String}
+end
+
+struct PointerCompany
+    name::String
+    history::Vector{Float32}
+    employees::Vector{PointerEmployee}
+    metrics::Dict{String, Float64}
+end
+
+function benchmark_pointer(employees::Int)
+    println("Julia BEVE JSON Pointer Benchmark")
+    println("=================================\n")
+    company = PointerCompany("Acme", Float32.(0:(16 << 20) - 1),
+                             [PointerEmployee("employee $i", 1000.0 + i, ["c++", "julia", "beve"]) for i in 0:employees - 1],
+                             Dict("metric_$i" => i * 0.5 for i in 0:999))
+    bytes = to_beve(company)
+    company = nothing
+    @printf("Encoded %d employees and 16M history floats, %.1f MB\n\n", employees, length(bytes) / 2^20)
+
+    pointers = ["/name", "/history/12345678", "/employees/0/salary", "/employees/$(employees ÷ 2)/salary",
+                "/employees/$(employees - 1)/skills/2", "/metrics/metric_999"]
+    @printf("%-40s %6s %16s %18s\n", "Pointer", "Depth", "resolve (us)", "+ decode (us)")
+    println("-"^83)
+    for pointer in pointers
+        resolve_beve_pointer(bytes, pointer)
+        from_beve_at(bytes, pointer)
+        resolve_time = minimum(@elapsed(resolve_beve_pointer(bytes, pointer)) for _ in 1:50)
+        decode_time = minimum(@elapsed(from_beve_at(bytes, pointer)) for _ in 1:50)
+        @printf("%-40s %6d %16.2f %18.2f\n", pointer, count(==('/'), pointer), resolve_time * 1e6, decode_time * 1e6)
+    end
+
+    from_beve(bytes)
+    full_time = minimum(@elapsed(from_beve(bytes)["employees"][end]["salary"]) for _ in 1:3)
+    typed_time = minimum(@elapsed(deser_beve(PointerCompany, bytes).employees[end].salary) for _ in 1:3)
+    println("\nFull decode, then index:")
+    @printf("%-40s %10.2f ms\n", "from_beve", full_time * 1e3)
+    @printf("%-40s %10.2f ms\n", "deser_beve(PointerCompany, ...)", typed_time * 1e3)
+end
+
+# One counter in a large state blob, as in `beve_benchmark --patch`: patch_beve! (resolve and
+# overwrite in place), a resized string (a splice of everything after it) and an inserted member, against re-serializing the whole state after each update
+function benchmark_patch(megabytes::Int)
+    println("Julia BEVE Patch Benchmark")
+    println("==========================\n")
+    state = Dict{String, Any}("status" => "ok", "samples" => collect(1.0:(megabytes << 17)),
+                              "counters" => Dict("counter_$i" => UInt64(i) for i in 0:99))
+    bytes = to_beve(state)
+    @printf("State blob: %.1f MB\n\n", length(bytes) / 2^20)
+
+    n = UInt64(0)
+    patch_beve!(bytes, "/counters/counter_99", n)
+    patch_time = minimum(@elapsed(patch_beve!(bytes, "/counters/counter_99", n += 1)) for _ in 1:1000)
+    encoded = to_beve(n)
+    encoded_time = minimum(@elapsed(patch_beve_encoded!(bytes, "/counters/counter_99", encoded)) for _ in 1:1000)
+    statuses = ("ok", "degraded")
+    splice_time = minimum(@elapsed(patch_beve!(bytes, "/status", statuses[(n += 1) % 2 + 1])) for _ in 1:10)
+    insert_time = minimum(@elapsed(patch_beve!(bytes, "/counters/new_$(n += 1)", n)) for _ in 1:100)
+    to_beve(state)
+    rewrite_time = minimum(begin
+        state["counters"]["counter_99"] = (n += 1)
+        @elapsed(to_beve(state))
+    end for _ in 1:5)
+
+    @printf("%-48s %14s %16s\n", "Update", "min (us)", "updates/s")
+    println("-"^80)
+    for (name, t) in (("patch_beve! (resolve + overwrite)", patch_time),
+                      ("patch_beve_encoded! (pre-encoded value)", encoded_time),
+                      ("patch_beve!, resized string", splice_time),
+                      ("patch_beve!, inserted counter", insert_time),
+                      ("to_beve of the whole state", rewrite_time))
+        @printf("%-48s %14.2f %16.0f\n", name, t * 1e6, 1 / t)
+    end
+    @printf("\nSpeedup of patch_beve! over re-serialization: %.0fx\n", rewrite_time / patch_time)
+end
+
+# Size and decode time of `records` SmallData (and records ÷ 100 MediumData) with string keys
+# against `dict_keys = true`, which writes each key once and refers to it by index
+function benchmark_keys(records::Int)
+    println("Julia BEVE Key Dictionary Benchmark")
+    println("===================================\n")
+    small = [SmallData(Int32(i), i * 0.5, "item$i") for i in 0:records - 1]
+    medium = [create_medium_data() for _ in 1:max(records ÷ 100, 1)]
+    for (label, batch) in (("SmallData", small), ("MediumData", medium))
+        T = eltype(batch)
+        plain = to_beve(batch)
+        keyed = to_beve(batch; dict_keys = true)
+        from_beve(keyed) == from_beve(plain) || error("Keyed $label batch does not round trip")
+        best(f) = minimum(@elapsed(f()) for _ in 1:3)
+        write_plain = best(() -> to_beve(batch))
+        write_keyed = best(() -> to_beve(batch; dict_keys = true))
+        read_plain = best(() -> deser_beve(Vector{T}, plain))
+        read_keyed = best(() -> deser_beve(Vector{T}, keyed))
+
+        println("$label ($(length(batch)) records)")
+        @printf("  %-36s %10.2f MB\n", "string keys", length(plain) / 2^20)
+        @printf("  %-36s %10.2f MB (%.1f%%)\n", "keyed", length(keyed) / 2^20, 100 * length(keyed) / length(plain))
+        for (name, t) in (("to_beve, string keys", write_plain), ("to_beve, dict_keys = true", write_keyed),
+                          ("deser_beve, string keys", read_plain), ("deser_beve, keyed", read_keyed))
+            @printf("  %-36s %10.2f ms\n", name, t * 1e3)
+        end
+        println()
+    end
+end
+
+# Serves the objects of `beve_benchmark --http` from HTTPExt, so `beve_benchmark --http-load
+# <port>` measures the Julia server under the same load as the C++ one. Blocks until interrupted.
+function benchmark_http_server(port::Int)
+    @eval using HTTP
+    register_object("/small", SmallData(Int32(42), 3.14159, "benchmark"))
+    register_object("/large", Float32.(0:256 * 1024 - 1))
+    println("Serving /small and /large on port $port; run `beve_benchmark --http-load $port`")
+    Base.invokelatest(start_server, "127.0.0.1", port)
+end
+
+# LargeArrayTypes from main.cpp
+struct LargeArrayTypes
+    large_float_vec::Vector{Float32}
+    large_double_vec::Vector{Float64}
+    large_complex_float_vec::Vector{ComplexF32}
+    large_complex_double_vec::Vector{ComplexF64}
+end
+
+# Growth-based writing (an empty IOBuffer, as before exact sizing) against to_beve and
+# write_beve_file with `exact_size = true`, which size the value with beve_size_of and allocate
+# once, for LargeArrayTypes
+# scaled to `megabytes`. Sys.maxrss only grows, so the writers run from the smallest expected
+# footprint to the largest.
+function benchmark_exact_size(megabytes::Int)
+    println("Julia BEVE Exact-Size Write Benchmark")
+    println("=====================================\n")
+    n = megabytes * 2^20 ÷ (4 + 8 + 8 + 16)
+    data = LargeArrayTypes(Float32.(0:n - 1) .* 0.1f0, collect((0:n - 1) .* 0.01),
+                           [ComplexF32(i, i * 0.5f0) for i in 0:n - 1], [ComplexF64(i * 0.1, i * 0.2) for i in 0:n - 1])
+    encoded = beve_size_of(data)
+    path = joinpath(tempdir(), "beve_exact_size_bench.beve")
+    grow() = (io = IOBuffer(); BEVE.beve_value!(BEVE.BeveSerializer(io), data); take!(io))
+    @printf("Elements:        %d per field\n", n)
+    @printf("Encoded size:    %.1f MB\n", encoded / 2^20)
+    @printf("beve_size_of:    %.2f us\n", minimum(@elapsed(beve_size_of(data)) for _ in 1:100) * 1e6)
+    @printf("Baseline RSS:    %.1f MB (the value itself)\n\n", Sys.maxrss() / 2^20)
+
+    @printf("%-36s %12s %10s %14s %16s\n", "Writer", "Best (ms)", "GB/s", "Allocated (MB)", "Peak RSS (MB)")
+    println("-"^92)
+    for (name, f) in (("write_beve_file, mmap = true", () -> write_beve_file(path, data; mmap = true)),
+                      ("to_beve (one allocation)", () -> to_beve(data; exact_size = true)),
+                      ("write_beve_file (one allocation)", () -> write_beve_file(path, data; exact_size = true)),
+                      ("IOBuffer() + beve_value! (growing)", grow))
+        f()
+        allocated = @allocated f()
+        best = minimum(@elapsed(f()) for _ in 1:3)
+        GC.gc()
+        @printf("%-36s %12.1f %10.2f %14.1f %16.1f\n", name, best * 1e3, encoded / best / 1e9, allocated / 2^20,
+                Sys.maxrss() / 2^20)
+    end
+
+    grow() == to_beve(data) == read(path) || error("Exact-size output differs from the growing writer")
+    rm(path; force = true)
+    println("\nMatches the growing writer: ✓")
+end
+
+# Minor and major page faults of this process so far (fields 10 and 12 of /proc/self/stat)
+function page_faults()
+    Sys.islinux() || return 0
+    stat = read("/proc/self/stat", String)
+    fields = split(stat[findlast(')', stat) + 2:end])
+    return parse(Int, fields[8]) + parse(Int, fields[10])
+end
+
+# Peak RSS in bytes since the last reset: VmHWM, which `reset_peak_rss` lowers to the current RSS
+function peak_rss_bytes()
+    if Sys.islinux()
+        for line in eachline("/proc/self/status")
+            startswith(line, "VmHWM:") && return parse(Int, split(line)[2]) * 1024
+        end
+    end
+    return Int(Sys.maxrss())
+end
+
+function reset_peak_rss()
+    Sys.islinux() || return false
+    try
+        write("/proc/self/clear_refs", "5")
+        return true
+    catch
+        return false
+    end
+end
+
+# The scaling tier of `beve_benchmark --scaling`: to_beve and from_beve of bare float, double,
+# complex and string arrays from 10K elements up to `max_elements` in 1-3-10 steps, next to a
+# copy of the encoded bytes. Sizes that would not fit in free memory are skipped. Results go to
+# julia_scaling_results.csv, which analyze_benchmarks.jl plots alongside the C++ curves.
+function benchmark_scaling(max_elements::Int)
+    println("Julia BEVE Scaling Benchmark")
+    println("============================\n")
+    sizes = Int[]
+    decade = 10_000
+    while decade <= max_elements
+        push!(sizes, decade)
+        3decade <= max_elements && push!(sizes, 3decade)
+        decade *= 10
+    end
+    makers = (("float", n -> Float32.(0:n - 1) .* 0.1f0, 8),
+              ("double", n -> collect((0:n - 1) .* 0.1), 16),
+              ("complex", n -> [ComplexF32(i, i * 0.5f0) for i in 0:n - 1], 16),
+              ("string", n -> ["s$(i % 10_000_000)" for i in 0:n - 1], 40))
+
+    @printf("%-10s %14s %12s %10s %10s %10s %12s %12s %12s\n", "Type", "Elements", "Size (MB)", "Write",
+            "Read", "copy", "Peak RSS", "W faults", "R faults")
+    println("-"^108)
+    open("julia_scaling_results.csv", "w") do csv
+        println(csv, "Type,Elements,EncodedBytes,WriteGBps,ReadGBps,MemcpyGBps,PeakRssMB,WriteFaults,ReadFaults")
+        for (type, make, bytes_per_element) in makers, n in sizes
+            if 2.5 * n * bytes_per_element > 0.8 * Sys.free_memory()
+                @printf("%-10s %14d  skipped: would not fit in free memory\n", type, n)
+                continue
+            end
+            GC.gc()
+            reset_peak_rss()
+            data = make(n)
+            before = page_faults()
+            bytes = to_beve(data)
+            write_faults = page_faults() - before
+            before = page_faults()
+            loaded = from_beve(bytes)
+            read_faults = page_faults() - before
+            loaded == data || error("$type array of $n elements does not round trip")
+
+            # About 2 GB of traffic per measurement, between 3 and 50 samples
+            samples = clamp(round(Int, 2e9 / length(bytes)), 3, 50)
+            target = similar(bytes)
+            gbps(f) = length(bytes) / median(@elapsed(f()) for _ in 1:samples) / 1e9
+            write_gbps = gbps(() -> to_beve(data))
+            read_gbps = gbps(() -> from_beve(bytes))
+            copy_gbps = gbps(() -> copyto!(target, bytes))
+            peak_mb = peak_rss_bytes() / 2^20
+            @printf("%-10s %14d %12.2f %10.2f %10.2f %10.2f %12.1f %12d %12d\n", type, n, length(bytes) / 2^20,
+                    write_gbps, read_gbps, copy_gbps, peak_mb, write_faults, read_faults)
+            println(csv, join((type, n, length(bytes), write_gbps, read_gbps, copy_gbps, peak_mb, write_faults,
+                               read_faults), ","))
+            flush(csv)
+        end
+    end
+    println("\nResults written to julia_scaling_results.csv (throughput in GB/s, RSS in MB)")
+end
+
+# Decode time and lookup latency of a UInt32 => Float64 integer-keyed object as a Dict (the
+# default) and as a BeveSortedDict (`sorted_int_keys = true`), from 1K keys up to `max_keys`.
+# Each size is decoded from key order, as glaze writes a std::map, and from hash order, as
+# to_beve writes a Dict; lookups probe every key once in a shuffled order.
+function benchmark_flat_map(max_keys::Int)
+    println("Julia BEVE Flat Map Benchmark")
+    println("=============================\n")
+    @printf("%-10s %-8s %-16s %14s %14s %16s\n", "Keys", "Input", "Container", "Decode (ms)", "ns / key", "Lookup (ns)")
+    println("-"^83)
+    n = 1000
+    while n <= max_keys
+        # Multiplying by an odd constant permutes UInt32, so the keys are distinct and scattered
+        d = Dict{UInt32, Float64}(UInt32(i) * 0x9e3779b1 => i * 0.5 for i in 0:n - 1)
+        probes = collect(keys(d))[sortperm(rand(n))]
+        samples = n >= 1_000_000 ? 5 : 20
+        for (order, bytes) in (("sorted", to_beve(BeveSortedDict(d))), ("hashed", to_beve(d)))
+            for (container, sorted) in (("Dict", false), ("BeveSortedDict", true))
+                table = from_beve(bytes; sorted_int_keys = sorted)
+                length(table) == n || error("$container decoded $(length(table)) of $n keys")
+                decode = median(@elapsed(from_beve(bytes; sorted_int_keys = sorted)) for _ in 1:samples)
+                lookup = lookup_time(table, probes)
+                @printf("%-10d %-8s %-16s %14.3f %14.1f %16.1f\n", n, order, container, decode * 1e3, decode / n * 1e9,
+                        lookup * 1e9)
+            end
+        end
+        n *= 10
+    end
+end
+
+# Median time of one lookup, over passes through `probes`; a function barrier so the table's
+# concrete type drives the loop
+function lookup_time(table, probes)
+    pass() = (s = 0.0; for k in probes; s += table[k]; end; s)
+    pass()
+    return median(@elapsed(pass()) for _ in 1:5) / length(probes)
+end
+
+# Decode and encode time of ComplexF32 and ComplexF64 vectors written interleaved (the default)
+# and planar (`planar_complex = true`), from 1M elements up to `max_elements`. FFT consumers that
+# want split buffers get them from a planar decode with `real.(v)`/`imag.(v)` as well, so the
+# split column adds that step to both layouts.
+function benchmark_planar(max_elements::Int)
+    println("Julia BEVE Planar Complex Benchmark")
+    println("===================================\n")
+    @printf("%-12s %-12s %-12s %14s %14s %14s %10s\n", "Type", "Elements", "Layout", "Write (ms)", "Read (ms)",
+            "Split (ms)", "GB/s read")
+    println("-"^96)
+    n = 1_000_000
+    while n <= max_elements
+        for T in (ComplexF32, ComplexF64)
+            values = [T(i * 0.5, 1 - i) for i in 0:n - 1]
+            samples = n >= 50_000_000 ? 3 : 10
+            for (layout, planar) in (("interleaved", false), ("planar", true))
+                bytes = to_beve(values; planar_complex = planar)
+                from_beve(bytes) == values || error("$layout $T did not round trip")
+                write = minimum(@elapsed(to_beve(values; planar_complex = planar)) for _ in 1:samples)
+                read = minimum(@elapsed(from_beve(bytes)) for _ in 1:samples)
+                split = minimum(@elapsed((v = from_beve(bytes); (real.(v), imag.(v)))) for _ in 1:samples)
+                @printf("%-12s %-12d %-12s %14.2f %14.2f %14.2f %10.2f\n", T, n, layout, write * 1e3, read * 1e3,
+                        split * 1e3, length(bytes) / read / 1e9)
+            end
+        end
+        n *= 10
+    end
+end
+
+# Run the benchmark (`julia benchmark.jl --columnar [max_records]` for the record batch
+# comparison, `--packed [count]` for packed arrays against typed arrays and zstd, `--ring <name>`
+# to consume `beve_benchmark --ring-producer <name>`, `--pointer [employees]` for JSON pointer
+# lookups against full decode, `--patch [megabytes]` for in-place patches against
+# re-serialization, `--keys [records]` for dictionary-encoded keys against string keys,
+# `--exact-size [megabytes]` for single-allocation writes against a growing buffer,
+# `--scaling [max_elements]` for throughput, peak RSS and page faults from 10K to 1B elements,
+# `--flat-map [max_keys]` for integer-keyed objects as a Dict against a BeveSortedDict,
+# `--planar [max_elements]` for planar complex arrays against interleaved ones,
+# `--http-server <port>` to serve the HTTP load of `beve_benchmark --http-load <port>`)
+if !isempty(ARGS) && ARGS[1] == "--columnar"
+    benchmark_columnar(length(ARGS) > 1 ? parse(Int, ARGS[2]) : 1_000_000)
+elseif length(ARGS) > 1 && ARGS[1] == "--ring"
+    benchmark_ring(ARGS[2])
+elseif !isempty(ARGS) && ARGS[1] == "--pointer"
+    benchmark_pointer(length(ARGS) > 1 ? parse(Int, ARGS[2]) : 200_000)
+elseif !isempty(ARGS) && ARGS[1] == "--patch"
+    benchmark_patch(length(ARGS) > 1 ? parse(Int, ARGS[2]) : 100)
+elseif !isempty(ARGS) && ARGS[1] == "--keys"
+    benchmark_keys(length(ARGS) > 1 ? parse(Int, ARGS[2]) : 1_000_000)
+elseif !isempty(ARGS) && ARGS[1] == "--exact-size"
+    benchmark_exact_size(length(ARGS) > 1 ? parse(Int, ARGS[2]) : 1024)
+elseif !isempty(ARGS) && ARGS[1] == "--scaling"
+    benchmark_scaling(length(ARGS) > 1 ? parse(Int, ARGS[2]) : 1_000_000_000)
+elseif !isempty(ARGS) && ARGS[1] == "--flat-map"
+    benchmark_flat_map(length(ARGS) > 1 ? parse(Int, ARGS[2]) : 10_000_000)
+elseif !isempty(ARGS) && ARGS[1] == "--planar"
+    benchmark_planar(length(ARGS) > 1 ? parse(Int, ARGS[2]) : 100_000_000)
+elseif length(ARGS) > 1 && ARGS[1] == "--http-server"
+    benchmark_http_server(parse(Int, ARGS[2]))
+elseif !isempty(ARGS) && ARGS[1] == "--packed"
+    benchmark_packed(length(ARGS) > 1 ? parse(Int, ARGS[2]) : 1_000_000)
+else
+    main()
+end
\ No newline at end of file
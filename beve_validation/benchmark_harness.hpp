@@ -0,0 +1,402 @@
+#pragma once
+
+// Measurement harness for the BEVE benchmarks.
+//
+// `measure` times an operation as a series of samples. Operations shorter than
+// `options::min_sample_ns` are repeated in batches so that each sample is long enough for the
+// clock to resolve; the per-operation time of a sample is the batch time divided by the batch
+// size (so for batched cases the percentiles describe batch means, not single calls). Results
+// carry p50/p99/p99.9, throughput and, where the kernel allows it, hardware counters read
+// through perf_event_open and normalized per byte. `memory_usage` and `cache_sizes` describe
+// the process footprint and the cache hierarchy for the large-scale tiers.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <ctime>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/utsname.h>
+#include <unistd.h>
+#define BEVE_HAS_PERF_EVENTS 1
+#else
+#define BEVE_HAS_PERF_EVENTS 0
+#endif
+
+namespace beve::bench
+{
+   // Keeps the compiler from discarding a result that is otherwise unused
+   template <class T>
+   inline void do_not_optimize(const T& value)
+   {
+#if defined(__GNUC__) || defined(__clang__)
+      asm volatile("" : : "r,m"(value) : "memory");
+#else
+      static volatile const void* sink;
+      sink = &value;
+#endif
+   }
+
+   struct options
+   {
+      size_t samples = 200;
+      double min_sample_ns = 20'000.0; // batch operations until one sample lasts at least this long
+      size_t max_batch = size_t(1) << 20;
+      size_t warmup_samples = 3;
+      bool hardware_counters = true;
+   };
+
+   // Hardware counters normalized per byte processed (per operation when no byte count is given)
+   struct counter_rates
+   {
+      bool valid = false;
+      double cycles_per_byte = 0.0;
+      double instructions_per_byte = 0.0;
+      double cache_misses_per_byte = 0.0;
+      double branch_misses_per_byte = 0.0;
+      double instructions_per_cycle = 0.0;
+   };
+
+   struct measurement
+   {
+      size_t samples = 0;
+      size_t batch = 1; // operations per sample
+      size_t bytes_per_op = 0;
+      double mean_ns = 0.0;
+      double stddev_ns = 0.0;
+      double min_ns = 0.0;
+      double p50_ns = 0.0;
+      double p99_ns = 0.0;
+      double p999_ns = 0.0;
+      double gb_per_s = 0.0; // bytes_per_op at the median time
+      counter_rates counters;
+   };
+
+   // Linear interpolation between closest ranks; `sorted` must be ascending and non-empty
+   inline double percentile(const std::vector<double>& sorted, double p)
+   {
+      const double rank = p * double(sorted.size() - 1);
+      const size_t lo = size_t(rank);
+      const size_t hi = std::min(lo + 1, sorted.size() - 1);
+      return sorted[lo] + (sorted[hi] - sorted[lo]) * (rank - double(lo));
+   }
+
+   // A group of cycles / instructions / cache-miss / branch-miss counters for this thread.
+   // Opening fails quietly (e.g. perf_event_paranoid, containers, non-Linux) and leaves the
+   // group unavailable, in which case measurements simply carry no counter data.
+   class perf_counters
+   {
+     public:
+      static constexpr size_t event_count = 4;
+
+      perf_counters()
+      {
+#if BEVE_HAS_PERF_EVENTS
+         constexpr std::array<uint64_t, event_count> configs{
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES,
+            PERF_COUNT_HW_BRANCH_MISSES};
+         for (size_t i = 0; i < event_count; ++i) {
+            perf_event_attr attr{};
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = configs[i];
+            attr.disabled = i == 0 ? 1 : 0; // the leader gates the whole group
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format =
+               PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            const int fd = int(::syscall(SYS_perf_event_open, &attr, 0, -1, i == 0 ? -1 : fds_[0], 0));
+            if (fd < 0) {
+               close_all();
+               return;
+            }
+            fds_[i] = fd;
+         }
+#endif
+      }
+
+      ~perf_counters() { close_all(); }
+
+      perf_counters(const perf_counters&) = delete;
+      perf_counters& operator=(const perf_counters&) = delete;
+
+      bool available() const noexcept { return fds_[0] >= 0; }
+
+      void start() noexcept
+      {
+#if BEVE_HAS_PERF_EVENTS
+         if (available()) {
+            ::ioctl(fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ::ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+         }
+#endif
+      }
+
+      // Stops counting and returns the counts, scaled up if the kernel multiplexed the group
+      std::array<double, event_count> stop() noexcept
+      {
+         std::array<double, event_count> out{};
+#if BEVE_HAS_PERF_EVENTS
+         if (!available()) {
+            return out;
+         }
+         ::ioctl(fds_[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+         struct
+         {
+            uint64_t nr;
+            uint64_t time_enabled;
+            uint64_t time_running;
+            uint64_t values[event_count];
+         } data{};
+         if (::read(fds_[0], &data, sizeof(data)) <= 0 || data.nr != event_count || data.time_running == 0) {
+            return out;
+         }
+         const double scale = double(data.time_enabled) / double(data.time_running);
+         for (size_t i = 0; i < event_count; ++i) {
+            out[i] = double(data.values[i]) * scale;
+         }
+#endif
+         return out;
+      }
+
+     private:
+      void close_all() noexcept
+      {
+#if BEVE_HAS_PERF_EVENTS
+         for (auto& fd : fds_) {
+            if (fd >= 0) {
+               ::close(fd);
+               fd = -1;
+            }
+         }
+#endif
+      }
+
+      std::array<int, event_count> fds_{-1, -1, -1, -1};
+   };
+
+   // Times `op` (called with no arguments) as described at the top of this file.
+   // `bytes_per_op` is the payload processed per call and drives GB/s and the per-byte counters.
+   template <class Op>
+   measurement measure(Op&& op, size_t bytes_per_op, const options& opts = {})
+   {
+      using clock = std::chrono::steady_clock;
+      auto run_batch = [&](size_t batch) {
+         const auto start = clock::now();
+         for (size_t i = 0; i < batch; ++i) {
+            op();
+         }
+         return std::chrono::duration<double, std::nano>(clock::now() - start).count();
+      };
+
+      // Calibrate: grow the batch until a single sample is long enough to time reliably
+      size_t batch = 1;
+      for (double t = run_batch(batch); t < opts.min_sample_ns && batch < opts.max_batch; t = run_batch(batch)) {
+         const double grow = t > 0.0 ? std::ceil(opts.min_sample_ns / t) : 10.0;
+         batch = std::min(opts.max_batch, batch * size_t(std::clamp(grow, 2.0, 10.0)));
+      }
+      for (size_t i = 0; i < opts.warmup_samples; ++i) {
+         run_batch(batch);
+      }
+
+      std::vector<double> per_op(std::max<size_t>(opts.samples, 1));
+      perf_counters counters;
+      const bool counting = opts.hardware_counters && counters.available();
+      if (counting) {
+         counters.start();
+      }
+      for (auto& t : per_op) {
+         t = run_batch(batch) / double(batch);
+      }
+      const auto counts = counting ? counters.stop() : std::array<double, perf_counters::event_count>{};
+
+      measurement m;
+      m.samples = per_op.size();
+      m.batch = batch;
+      m.bytes_per_op = bytes_per_op;
+      double sum = 0.0;
+      for (double t : per_op) {
+         sum += t;
+      }
+      m.mean_ns = sum / double(per_op.size());
+      double variance = 0.0;
+      for (double t : per_op) {
+         variance += (t - m.mean_ns) * (t - m.mean_ns);
+      }
+      m.stddev_ns = std::sqrt(variance / double(per_op.size()));
+
+      std::sort(per_op.begin(), per_op.end());
+      m.min_ns = per_op.front();
+      m.p50_ns = percentile(per_op, 0.50);
+      m.p99_ns = percentile(per_op, 0.99);
+      m.p999_ns = percentile(per_op, 0.999);
+      m.gb_per_s = m.p50_ns > 0.0 ? double(bytes_per_op) / m.p50_ns : 0.0; // bytes per ns == GB/s
+
+      if (counting && counts[0] > 0.0) {
+         const double units = double(m.samples * batch) * double(std::max<size_t>(bytes_per_op, 1));
+         m.counters.valid = true;
+         m.counters.cycles_per_byte = counts[0] / units;
+         m.counters.instructions_per_byte = counts[1] / units;
+         m.counters.cache_misses_per_byte = counts[2] / units;
+         m.counters.branch_misses_per_byte = counts[3] / units;
+         m.counters.instructions_per_cycle = counts[1] / counts[0];
+      }
+      return m;
+   }
+
+   // Resident memory and page faults of this process so far
+   struct memory_usage
+   {
+      double peak_rss_bytes = 0.0; // high-water mark since start or the last reset_peak_rss()
+      double rss_bytes = 0.0; // current resident set (Linux only; 0 elsewhere)
+      uint64_t minor_faults = 0;
+      uint64_t major_faults = 0;
+   };
+
+   inline memory_usage current_memory()
+   {
+      memory_usage m;
+#if defined(__linux__)
+      rusage usage{};
+      ::getrusage(RUSAGE_SELF, &usage);
+      m.minor_faults = uint64_t(usage.ru_minflt);
+      m.major_faults = uint64_t(usage.ru_majflt);
+      m.peak_rss_bytes = double(usage.ru_maxrss) * 1024.0; // kilobytes on Linux
+      // VmHWM follows reset_peak_rss(); ru_maxrss never goes down
+      std::ifstream status("/proc/self/status");
+      for (std::string line; std::getline(status, line);) {
+         if (line.rfind("VmHWM:", 0) == 0) {
+            m.peak_rss_bytes = std::stod(line.substr(6)) * 1024.0;
+         }
+         else if (line.rfind("VmRSS:", 0) == 0) {
+            m.rss_bytes = std::stod(line.substr(6)) * 1024.0;
+         }
+      }
+#endif
+      return m;
+   }
+
+   // Lowers the peak RSS back to the current RSS, so each case reports its own high-water mark.
+   // Returns false where the kernel does not support it; peaks are then cumulative.
+   inline bool reset_peak_rss()
+   {
+#if defined(__linux__)
+      std::ofstream clear_refs("/proc/self/clear_refs");
+      clear_refs << "5";
+      clear_refs.flush();
+      return bool(clear_refs);
+#else
+      return false;
+#endif
+   }
+
+   // Data cache sizes in bytes, 0 where unknown
+   struct cache_sizes
+   {
+      size_t l1d = 0;
+      size_t l2 = 0;
+      size_t l3 = 0;
+   };
+
+   inline cache_sizes detect_caches()
+   {
+      cache_sizes c;
+#if defined(_SC_LEVEL1_DCACHE_SIZE) && defined(_SC_LEVEL2_CACHE_SIZE) && defined(_SC_LEVEL3_CACHE_SIZE)
+      c.l1d = size_t(std::max(::sysconf(_SC_LEVEL1_DCACHE_SIZE), 0L));
+      c.l2 = size_t(std::max(::sysconf(_SC_LEVEL2_CACHE_SIZE), 0L));
+      c.l3 = size_t(std::max(::sysconf(_SC_LEVEL3_CACHE_SIZE), 0L));
+#endif
+      return c;
+   }
+
+   // Bytes the kernel could hand out without swapping (MemAvailable), 0 where unknown
+   inline size_t available_memory()
+   {
+#if defined(__linux__)
+      std::ifstream meminfo("/proc/meminfo");
+      for (std::string line; std::getline(meminfo, line);) {
+         if (line.rfind("MemAvailable:", 0) == 0) {
+            return size_t(std::stoull(line.substr(13))) * 1024;
+         }
+      }
+#endif
+      return 0;
+   }
+
+   // Describes the machine and build a result set came from
+   struct run_metadata
+   {
+      std::string cpu;
+      size_t logical_cores = 0;
+      std::string os;
+      std::string compiler;
+      std::string build_type;
+      long cxx_standard = 0;
+      std::string timestamp; // UTC, ISO 8601
+      bool hardware_counters = false;
+   };
+
+   inline run_metadata collect_metadata()
+   {
+      run_metadata md;
+      md.cpu = "unknown";
+#if defined(__linux__)
+      std::ifstream cpuinfo("/proc/cpuinfo");
+      for (std::string line; std::getline(cpuinfo, line);) {
+         if (line.rfind("model name", 0) == 0) {
+            if (const auto colon = line.find(':'); colon != std::string::npos) {
+               md.cpu = line.substr(line.find_first_not_of(' ', colon + 1));
+            }
+            break;
+         }
+      }
+      md.logical_cores = size_t(::sysconf(_SC_NPROCESSORS_ONLN));
+      utsname uts{};
+      if (::uname(&uts) == 0) {
+         md.os = std::string(uts.sysname) + " " + uts.release + " " + uts.machine;
+      }
+#elif defined(__APPLE__)
+      md.os = "Darwin";
+#elif defined(_WIN32)
+      md.os = "Windows";
+#endif
+
+#if defined(__clang__)
+      md.compiler = "clang " __clang_version__;
+#elif defined(__GNUC__)
+      md.compiler = "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+      md.compiler = "msvc " + std::to_string(_MSC_VER);
+#else
+      md.compiler = "unknown";
+#endif
+#ifdef NDEBUG
+      md.build_type = "release";
+#else
+      md.build_type = "debug";
+#endif
+      md.cxx_standard = long(__cplusplus);
+
+      const std::time_t now = std::time(nullptr);
+      std::tm utc{};
+#if defined(_WIN32)
+      gmtime_s(&utc, &now);
+#else
+      gmtime_r(&now, &utc);
+#endif
+      char stamp[32];
+      std::strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%SZ", &utc);
+      md.timestamp = stamp;
+      md.hardware_counters = perf_counters{}.available();
+      return md;
+   }
+}
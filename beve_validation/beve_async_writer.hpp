@@ -0,0 +1,734 @@
+#pragma once
+
+// Asynchronous batch file writer for checkpoints made of many large BEVE files.
+//
+// write() queues one file and returns as soon as its writes are submitted, so the caller
+// serializes the next object while the kernel writes the previous ones; finish() waits for the
+// batch. At most `max_in_flight` files are queued at once, and write() first waits for the
+// oldest beyond that, which bounds memory to that many buffers.
+//
+// On Linux the writes go through an io_uring, set up with raw syscalls (no liburing). A file is
+// split into `chunk_size` writes that are submitted together, completions are reaped on later
+// calls, short writes are resubmitted, and `fsync` becomes one more queued operation per file.
+// Where io_uring is missing (other systems, kernels before 5.6, seccomp filters) a thread pool
+// runs blocking pwrite loops instead; the results are identical.
+//
+// `direct` opens files with O_DIRECT, bypassing the page cache: data is staged in buffers
+// aligned to `direct_alignment`, written padded to a multiple of it, and the file is truncated
+// to its real length afterwards. `register_buffers` registers those staging buffers with the
+// ring (IORING_REGISTER_BUFFERS), so the kernel pins their pages once instead of on every write.
+// Both are hints: registration that the kernel refuses falls back to plain writes (see
+// registered()), and a file system without O_DIRECT makes write() fail.
+//
+//    beve::async_file_writer writer;
+//    for (const auto& [path, snapshot] : checkpoint) {
+//       writer.write_value(path, snapshot);                // beve::layout types (beve_size.hpp)
+//    }
+//    std::string bytes;
+//    (void)glz::write_beve(other, bytes);
+//    writer.write("other.beve", std::move(bytes));         // anything already encoded
+//    if (!writer.finish()) { std::cerr << writer.error(); }
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "beve_size.hpp"
+#include "beve_thread_pool.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#define BEVE_HAS_PWRITE 1
+#else
+#define BEVE_HAS_PWRITE 0
+#endif
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#define BEVE_HAS_IO_URING 1
+#else
+#define BEVE_HAS_IO_URING 0
+#endif
+
+namespace beve
+{
+   struct async_write_options
+   {
+      size_t max_in_flight = 4; // files queued before write() waits for the oldest
+      size_t chunk_size = size_t(1) << 20; // bytes per write request
+      unsigned queue_depth = 64; // io_uring submission queue entries
+      size_t threads = 4; // workers of the thread-pool fallback
+      bool use_io_uring = true; // false forces the thread-pool fallback
+      bool direct = false; // O_DIRECT, with aligned and padded staging buffers
+      bool register_buffers = false; // register the staging buffers with the ring
+      bool fsync = false; // fdatasync every file before it counts as written
+      size_t direct_alignment = 4096; // buffer, offset and length alignment for O_DIRECT
+   };
+
+   namespace detail
+   {
+      // Heap buffer aligned for O_DIRECT; growing discards the contents
+      class aligned_buffer
+      {
+        public:
+         char* data() const noexcept { return data_.get(); }
+         size_t capacity() const noexcept { return capacity_; }
+
+         // Returns true when the buffer was reallocated
+         bool reserve(size_t n, size_t alignment)
+         {
+            if (n <= capacity_ && data_) {
+               return false;
+            }
+            const size_t rounded = std::max((n + alignment - 1) / alignment * alignment, alignment);
+            data_.reset(static_cast<char*>(std::aligned_alloc(alignment, rounded)));
+            if (!data_) {
+               throw std::bad_alloc();
+            }
+            capacity_ = rounded;
+            return true;
+         }
+
+        private:
+         struct release
+         {
+            void operator()(char* p) const noexcept { std::free(p); }
+         };
+         std::unique_ptr<char, release> data_;
+         size_t capacity_ = 0;
+      };
+
+#if BEVE_HAS_IO_URING
+      // The submission and completion rings of one io_uring instance
+      class uring
+      {
+        public:
+         uring() = default;
+         ~uring() { close(); }
+
+         uring(const uring&) = delete;
+         uring& operator=(const uring&) = delete;
+
+         bool open(unsigned entries)
+         {
+            io_uring_params p{};
+            fd_ = int(::syscall(__NR_io_uring_setup, entries, &p));
+            if (fd_ < 0) {
+               return false;
+            }
+            // IORING_OP_WRITE arrived in 5.6, together with IORING_FEAT_RW_CUR_POS
+            if (!(p.features & IORING_FEAT_RW_CUR_POS)) {
+               close();
+               return false;
+            }
+            sq_len_ = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+            cq_len_ = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+            single_mmap_ = p.features & IORING_FEAT_SINGLE_MMAP;
+            if (single_mmap_) {
+               sq_len_ = cq_len_ = std::max(sq_len_, cq_len_);
+            }
+            sq_ring_ = map(sq_len_, IORING_OFF_SQ_RING);
+            cq_ring_ = single_mmap_ ? sq_ring_ : map(cq_len_, IORING_OFF_CQ_RING);
+            sqes_len_ = p.sq_entries * sizeof(io_uring_sqe);
+            void* sqes = map(sqes_len_, IORING_OFF_SQES);
+            if (!sq_ring_ || !cq_ring_ || !sqes) {
+               sqes_ = static_cast<io_uring_sqe*>(sqes);
+               close();
+               return false;
+            }
+            char* sq = static_cast<char*>(sq_ring_);
+            char* cq = static_cast<char*>(cq_ring_);
+            sq_head_ = reinterpret_cast<unsigned*>(sq + p.sq_off.head);
+            sq_tail_ = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+            sq_mask_ = *reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+            sq_array_ = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+            cq_head_ = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+            cq_tail_ = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+            cq_mask_ = *reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+            cqes_ = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+            sqes_ = static_cast<io_uring_sqe*>(sqes);
+            sq_entries_ = p.sq_entries;
+            cq_entries_ = p.cq_entries;
+            tail_ = submitted_ = *sq_tail_;
+            return true;
+         }
+
+         void close() noexcept
+         {
+            if (sqes_) {
+               ::munmap(sqes_, sqes_len_);
+            }
+            if (cq_ring_ && !single_mmap_) {
+               ::munmap(cq_ring_, cq_len_);
+            }
+            if (sq_ring_) {
+               ::munmap(sq_ring_, sq_len_);
+            }
+            if (fd_ >= 0) {
+               ::close(fd_);
+            }
+            sqes_ = nullptr;
+            sq_ring_ = cq_ring_ = nullptr;
+            fd_ = -1;
+         }
+
+         unsigned cq_entries() const noexcept { return cq_entries_; }
+
+         // A cleared entry to fill, or nullptr when the submission queue is full
+         io_uring_sqe* next() noexcept
+         {
+            const unsigned head = std::atomic_ref<unsigned>(*sq_head_).load(std::memory_order_acquire);
+            if (tail_ - head >= sq_entries_) {
+               return nullptr;
+            }
+            const unsigned slot = tail_ & sq_mask_;
+            sq_array_[slot] = slot;
+            ++tail_;
+            std::memset(&sqes_[slot], 0, sizeof(io_uring_sqe));
+            return &sqes_[slot];
+         }
+
+         // Submits the queued entries and, with `wait`, blocks until at least one completes
+         bool enter(bool wait) noexcept
+         {
+            std::atomic_ref<unsigned>(*sq_tail_).store(tail_, std::memory_order_release);
+            const unsigned count = tail_ - submitted_;
+            while (true) {
+               const int r = int(::syscall(__NR_io_uring_enter, fd_, count, wait ? 1u : 0u,
+                                           wait ? IORING_ENTER_GETEVENTS : 0u, nullptr, 0));
+               if (r >= 0) {
+                  submitted_ += unsigned(r);
+                  return true;
+               }
+               if (errno != EINTR) {
+                  return false;
+               }
+            }
+         }
+
+         // Calls `handle(user_data, res)` for every available completion
+         template <class Handle>
+         size_t reap(Handle&& handle)
+         {
+            unsigned head = *cq_head_;
+            const unsigned tail = std::atomic_ref<unsigned>(*cq_tail_).load(std::memory_order_acquire);
+            size_t n = 0;
+            for (; head != tail; ++head, ++n) {
+               const io_uring_cqe& cqe = cqes_[head & cq_mask_];
+               const uint64_t user_data = cqe.user_data;
+               const int32_t res = cqe.res;
+               std::atomic_ref<unsigned>(*cq_head_).store(head + 1, std::memory_order_release);
+               handle(user_data, res);
+            }
+            return n;
+         }
+
+         bool register_buffers(const std::vector<iovec>& buffers) noexcept
+         {
+            return ::syscall(__NR_io_uring_register, fd_, IORING_REGISTER_BUFFERS, buffers.data(),
+                             unsigned(buffers.size())) == 0;
+         }
+
+         void unregister_buffers() noexcept { ::syscall(__NR_io_uring_register, fd_, IORING_UNREGISTER_BUFFERS, nullptr, 0); }
+
+        private:
+         void* map(size_t length, off_t offset) noexcept
+         {
+            void* p = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, offset);
+            return p == MAP_FAILED ? nullptr : p;
+         }
+
+         int fd_ = -1;
+         bool single_mmap_ = false;
+         void* sq_ring_ = nullptr;
+         void* cq_ring_ = nullptr;
+         size_t sq_len_ = 0;
+         size_t cq_len_ = 0;
+         size_t sqes_len_ = 0;
+         unsigned* sq_head_ = nullptr;
+         unsigned* sq_tail_ = nullptr;
+         unsigned* sq_array_ = nullptr;
+         unsigned sq_mask_ = 0;
+         unsigned sq_entries_ = 0;
+         unsigned* cq_head_ = nullptr;
+         unsigned* cq_tail_ = nullptr;
+         unsigned cq_mask_ = 0;
+         unsigned cq_entries_ = 0;
+         io_uring_sqe* sqes_ = nullptr;
+         io_uring_cqe* cqes_ = nullptr;
+         unsigned tail_ = 0; // entries filled
+         unsigned submitted_ = 0; // entries handed to the kernel
+      };
+#endif
+   }
+
+   class async_file_writer
+   {
+     public:
+      explicit async_file_writer(async_write_options options = {}) : options_(options)
+      {
+         options_.max_in_flight = std::max<size_t>(options_.max_in_flight, 1);
+         options_.direct_alignment = std::max<size_t>(options_.direct_alignment, 512);
+         options_.chunk_size = std::max(options_.chunk_size / options_.direct_alignment, size_t(1)) *
+                               options_.direct_alignment; // whole blocks, so O_DIRECT offsets stay aligned
+#if !defined(O_DIRECT)
+         options_.direct = false;
+#endif
+         staging_.resize(options_.max_in_flight);
+         staging_busy_.assign(options_.max_in_flight, false);
+#if BEVE_HAS_IO_URING
+         if (options_.use_io_uring && ring_.open(std::max(options_.queue_depth, 2u))) {
+            uring_ = true;
+            if (options_.register_buffers) {
+               for (auto& b : staging_) {
+                  b.reserve(options_.direct_alignment, options_.direct_alignment);
+               }
+               register_staging();
+            }
+         }
+#endif
+         if (!uring_) {
+            pool_ = std::make_unique<thread_pool>(options_.threads);
+         }
+      }
+
+      ~async_file_writer() { finish(); }
+
+      async_file_writer(const async_file_writer&) = delete;
+      async_file_writer& operator=(const async_file_writer&) = delete;
+
+      // Queues `bytes` to be written to `path`; the writer keeps them until the file is written
+      bool write(std::string path, std::string bytes)
+      {
+         wait_for_slot();
+         if (!options_.direct) {
+            job* j = open_job(std::move(path), bytes.size(), -1);
+            if (!j) {
+               return false;
+            }
+            j->owned = std::move(bytes);
+            j->data = j->owned.data();
+            start(*j);
+            return true;
+         }
+         const int staging = stage(bytes.size());
+         job* j = open_job(std::move(path), bytes.size(), staging);
+         if (!j) {
+            return false;
+         }
+         std::memcpy(staging_[staging].data(), bytes.data(), bytes.size());
+         pad(*j);
+         start(*j);
+         return true;
+      }
+
+      // Encodes `value` (see beve_size.hpp) straight into a staging buffer and queues it
+      template <class T>
+      bool write_value(std::string path, const T& value)
+      {
+         wait_for_slot();
+         const size_t n = size_of(value);
+         const int staging = stage(n);
+         job* j = open_job(std::move(path), n, staging);
+         if (!j) {
+            return false;
+         }
+         write_to(value, staging_[staging].data());
+         pad(*j);
+         start(*j);
+         return true;
+      }
+
+      // Waits for every queued file; false when any file since the last finish() failed
+      bool finish()
+      {
+         while (!jobs_.empty()) {
+            wait_any();
+         }
+         const bool ok = !failed_;
+         failed_ = false;
+         return ok;
+      }
+
+      const std::string& error() const noexcept { return error_; }
+      bool using_io_uring() const noexcept { return uring_; }
+      bool registered() const noexcept { return registered_; }
+      size_t files_written() const noexcept { return files_written_; }
+      size_t bytes_written() const noexcept { return bytes_written_; }
+
+     private:
+      struct job;
+
+      // One queued write (or the final fsync) of a job
+      struct op
+      {
+         job* owner = nullptr;
+         size_t offset = 0;
+         size_t length = 0;
+         bool sync = false;
+      };
+
+      struct job
+      {
+         std::string path;
+         int fd = -1;
+         std::string owned; // bytes handed to write()
+         int staging = -1; // staging buffer holding the bytes, if any
+         const char* data = nullptr;
+         size_t size = 0; // file length
+         size_t padded = 0; // bytes written: `size` rounded up to whole blocks with O_DIRECT
+         size_t pending = 0; // ops not yet complete
+         std::vector<op> ops;
+         bool done = false; // set by the thread pool
+         std::string error;
+      };
+
+      void wait_for_slot()
+      {
+#if BEVE_HAS_IO_URING
+         if (uring_) {
+            pump(false); // keeps the previous files' remaining chunks moving
+         }
+#endif
+         collect();
+         while (jobs_.size() >= options_.max_in_flight) {
+            wait_any();
+         }
+      }
+
+      // A free staging buffer with room for `n` bytes plus padding
+      int stage(size_t n)
+      {
+         const int i = int(std::find(staging_busy_.begin(), staging_busy_.end(), false) - staging_busy_.begin());
+         auto& buffer = staging_[i];
+         if (buffer.capacity() < n + options_.direct_alignment && registered_) {
+            // Registered buffers cannot move while writes use them: drain, grow, register again
+            while (!jobs_.empty()) {
+               wait_any();
+            }
+         }
+         if (buffer.reserve(n + options_.direct_alignment, options_.direct_alignment) && options_.register_buffers) {
+            register_staging();
+         }
+         staging_busy_[i] = true;
+         return i;
+      }
+
+      job* open_job(std::string path, size_t size, int staging)
+      {
+         auto j = std::make_unique<job>();
+         j->path = std::move(path);
+         j->size = size;
+         j->padded = options_.direct ? (size + options_.direct_alignment - 1) / options_.direct_alignment *
+                                          options_.direct_alignment
+                                     : size;
+         j->staging = staging;
+         if (staging >= 0) {
+            j->data = staging_[staging].data();
+         }
+#if BEVE_HAS_PWRITE
+         int flags = O_WRONLY | O_CREAT | O_TRUNC;
+#if defined(O_DIRECT)
+         if (options_.direct) {
+            flags |= O_DIRECT;
+         }
+#endif
+         j->fd = ::open(j->path.c_str(), flags, 0644);
+         if (j->fd < 0) {
+            fail(j->path + ": " + std::strerror(errno));
+            if (staging >= 0) {
+               staging_busy_[staging] = false;
+            }
+            return nullptr;
+         }
+#endif
+         jobs_.push_back(std::move(j));
+         return jobs_.back().get();
+      }
+
+      void pad(job& j) const noexcept
+      {
+         if (j.padded > j.size) {
+            std::memset(staging_[j.staging].data() + j.size, 0, j.padded - j.size);
+         }
+      }
+
+      void start(job& j)
+      {
+#if BEVE_HAS_IO_URING
+         if (uring_) {
+            const size_t chunks = (j.padded + options_.chunk_size - 1) / options_.chunk_size;
+            j.ops.reserve(chunks + 1); // ops are referenced by address from the ring
+            for (size_t offset = 0; offset < j.padded; offset += options_.chunk_size) {
+               j.ops.push_back({&j, offset, std::min(options_.chunk_size, j.padded - offset), false});
+               pending_.push_back(&j.ops.back());
+            }
+            j.pending = j.ops.size();
+            if (j.pending == 0) {
+               finish_writes(j);
+            }
+            pump(false);
+            return;
+         }
+#endif
+         pool_->submit([this, &j] {
+            write_blocking(j);
+            // Notified under the lock: once the caller sees `done` the writer may be destroyed
+            std::lock_guard lock(done_mutex_);
+            j.done = true;
+            done_.notify_all();
+         });
+      }
+
+      void write_blocking(job& j)
+      {
+#if BEVE_HAS_PWRITE
+         size_t offset = 0;
+         while (offset < j.padded) {
+            const ssize_t n = ::pwrite(j.fd, j.data + offset, std::min(j.padded - offset, options_.chunk_size),
+                                       off_t(offset));
+            if (n < 0 && errno == EINTR) {
+               continue;
+            }
+            if (n <= 0) {
+               j.error = std::strerror(n < 0 ? errno : EIO);
+               return;
+            }
+            offset += size_t(n);
+         }
+         if (j.padded != j.size && ::ftruncate(j.fd, off_t(j.size)) != 0) {
+            j.error = std::strerror(errno);
+            return;
+         }
+         if (options_.fsync && ::fdatasync(j.fd) != 0) {
+            j.error = std::strerror(errno);
+         }
+#else
+         std::ofstream file(j.path, std::ios::binary | std::ios::trunc);
+         file.write(j.data, std::streamsize(j.size));
+         if (!file) {
+            j.error = "failed to write file";
+         }
+#endif
+      }
+
+      // All writes of `j` are done: trim O_DIRECT padding, then queue the fsync or complete
+      void finish_writes(job& j)
+      {
+#if BEVE_HAS_PWRITE
+         if (j.error.empty() && j.padded != j.size && ::ftruncate(j.fd, off_t(j.size)) != 0) {
+            j.error = std::strerror(errno);
+         }
+#endif
+         if (j.error.empty() && options_.fsync) {
+            j.ops.push_back({&j, 0, 0, true});
+            pending_.push_back(&j.ops.back());
+            j.pending = 1;
+            return;
+         }
+         j.done = true;
+      }
+
+#if BEVE_HAS_IO_URING
+      // Moves queued ops into the ring while it has room and submits them
+      void pump(bool wait)
+      {
+         if (broken_) {
+            return;
+         }
+         while (!pending_.empty() && in_ring_ < ring_.cq_entries()) {
+            io_uring_sqe* sqe = ring_.next();
+            if (!sqe) {
+               break;
+            }
+            op& o = *pending_.front();
+            pending_.pop_front();
+            sqe->fd = o.owner->fd;
+            sqe->user_data = reinterpret_cast<uint64_t>(&o);
+            if (o.sync) {
+               sqe->opcode = IORING_OP_FSYNC;
+               sqe->fsync_flags = IORING_FSYNC_DATASYNC;
+            }
+            else {
+               sqe->opcode = registered_ && o.owner->staging >= 0 ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+               sqe->buf_index = uint16_t(std::max(o.owner->staging, 0));
+               sqe->addr = reinterpret_cast<uint64_t>(o.owner->data + o.offset);
+               sqe->len = unsigned(o.length);
+               sqe->off = o.offset;
+            }
+            ++in_ring_;
+         }
+         if (!ring_.enter(wait && in_ring_ > 0)) {
+            // Ops the kernel may still hold point into the jobs, so those are kept until destruction
+            fail(std::string("io_uring_enter: ") + std::strerror(errno));
+            broken_ = true;
+            return;
+         }
+         ring_.reap([this](uint64_t user_data, int32_t res) { complete(*reinterpret_cast<op*>(user_data), res); });
+      }
+
+      void complete(op& o, int32_t res)
+      {
+         --in_ring_;
+         job& j = *o.owner;
+         if (res == -EINTR || res == -EAGAIN) {
+            pending_.push_back(&o);
+            return;
+         }
+         if (res < 0) {
+            j.error = std::strerror(-res);
+         }
+         else if (!o.sync && size_t(res) < o.length) {
+            if (res == 0) {
+               j.error = std::strerror(EIO);
+            }
+            else {
+               // A short write: queue the rest of the chunk
+               o.offset += size_t(res);
+               o.length -= size_t(res);
+               pending_.push_back(&o);
+               return;
+            }
+         }
+         if (--j.pending == 0) {
+            if (o.sync) {
+               j.done = true;
+            }
+            else {
+               finish_writes(j); // a queued fsync goes out with the next pump
+            }
+         }
+      }
+
+      void register_staging()
+      {
+         if (registered_) {
+            ring_.unregister_buffers();
+            registered_ = false;
+         }
+         std::vector<iovec> buffers;
+         for (auto& b : staging_) {
+            buffers.push_back({b.data(), b.capacity()});
+         }
+         // Refusals (memlock limits, buffers over 1 GB) leave plain writes in place
+         registered_ = ring_.register_buffers(buffers);
+      }
+      // After a failed io_uring_enter: gives up on every queued file
+      void abandon()
+      {
+         for (auto& j : jobs_) {
+            if (j->fd >= 0) {
+               ::close(j->fd);
+            }
+            abandoned_.push_back(std::move(j));
+         }
+         jobs_.clear();
+         pending_.clear();
+         std::fill(staging_busy_.begin(), staging_busy_.end(), false);
+      }
+#else
+      void register_staging() {}
+#endif
+
+      // Blocks until at least one queued file completes, then retires the completed ones
+      void wait_any()
+      {
+         const size_t before = jobs_.size();
+         while (jobs_.size() == before) {
+#if BEVE_HAS_IO_URING
+            if (uring_) {
+               if (broken_) {
+                  abandon();
+                  return;
+               }
+               pump(true);
+               collect();
+               continue;
+            }
+#endif
+            {
+               std::unique_lock lock(done_mutex_);
+               done_.wait(lock, [this] {
+                  return std::any_of(jobs_.begin(), jobs_.end(), [](const auto& j) { return j->done; });
+               });
+            }
+            collect();
+         }
+      }
+
+      // Retires completed files: closes them, frees their buffers and records failures
+      void collect()
+      {
+         std::lock_guard lock(done_mutex_);
+         for (auto it = jobs_.begin(); it != jobs_.end();) {
+            job& j = **it;
+            if (!j.done) {
+               ++it;
+               continue;
+            }
+#if BEVE_HAS_PWRITE
+            if (::close(j.fd) != 0 && j.error.empty()) {
+               j.error = std::strerror(errno);
+            }
+#endif
+            if (j.staging >= 0) {
+               staging_busy_[j.staging] = false;
+            }
+            if (j.error.empty()) {
+               ++files_written_;
+               bytes_written_ += j.size;
+            }
+            else {
+               fail(j.path + ": " + j.error);
+            }
+            it = jobs_.erase(it);
+         }
+      }
+
+      void fail(std::string message)
+      {
+         if (!failed_) {
+            error_ = std::move(message);
+         }
+         failed_ = true;
+      }
+
+      async_write_options options_;
+      std::vector<detail::aligned_buffer> staging_;
+      std::vector<bool> staging_busy_;
+      std::deque<std::unique_ptr<job>> jobs_;
+      std::unique_ptr<thread_pool> pool_;
+      std::mutex done_mutex_;
+      std::condition_variable done_;
+#if BEVE_HAS_IO_URING
+      detail::uring ring_;
+      std::deque<op*> pending_; // ops waiting for room in the ring
+      unsigned in_ring_ = 0; // ops submitted and not yet completed
+      bool broken_ = false; // io_uring_enter failed; nothing more is submitted
+      std::vector<std::unique_ptr<job>> abandoned_;
+#endif
+      bool uring_ = false;
+      bool registered_ = false;
+      bool failed_ = false;
+      std::string error_;
+      size_t files_written_ = 0;
+      size_t bytes_written_ = 0;
+   };
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+// Parallel validation of many BEVE files.
+//
+// Each file is memory mapped, walked structurally (every header and size is checked, and the
+// root value must span the whole file) while counting header bytes, and then decoded with
+// glz::read_beve into a generic value. Files are scheduled largest first on a work-stealing
+// pool so a few large files do not leave the tail of the batch running on one core.
+
+#include <glaze/glaze.hpp>
+#include <glaze/beve.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <numeric>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "beve_core.hpp"
+#include "beve_mmap.hpp"
+#include "beve_thread_pool.hpp"
+
+namespace beve
+{
+   struct batch_options
+   {
+      size_t threads = thread_pool::default_threads();
+      bool decode = true; // also run glz::read_beve after the structural walk
+   };
+
+   struct file_status
+   {
+      std::string path;
+      size_t bytes = 0;
+      bool ok = false;
+      std::string error;
+   };
+
+   struct batch_report
+   {
+      std::vector<file_status> files; // in the order the paths were given
+      std::array<uint64_t, 256> header_counts{}; // values seen per header byte, across all valid files
+      uint64_t total_bytes = 0;
+      size_t failures = 0;
+      size_t threads = 0;
+      double seconds = 0.0;
+
+      double bytes_per_second() const noexcept { return seconds > 0.0 ? double(total_bytes) / seconds : 0.0; }
+   };
+
+   // All regular `.beve` files below `dir`, sorted by path
+   inline std::vector<std::string> collect_beve_files(const std::filesystem::path& dir)
+   {
+      std::vector<std::string> out;
+      std::error_code ec;
+      for (auto it = std::filesystem::recursive_directory_iterator(dir, ec);
+           !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+         if (it->is_regular_file(ec) && it->path().extension() == ".beve") {
+            out.push_back(it->path().string());
+         }
+      }
+      std::sort(out.begin(), out.end());
+      return out;
+   }
+
+   // Validates one file, adding its header counts to `counts`
+   inline file_status validate_file(const std::string& path, bool decode, std::array<uint64_t, 256>& counts)
+   {
+      file_status status;
+      status.path = path;
+
+      mapped_file file;
+      if (!file.open(path)) {
+         status.error = "open failed: " + file.error();
+         return status;
+      }
+      status.bytes = file.size();
+
+      const auto bytes = file.view();
+      if (bytes.empty()) {
+         status.error = "empty file";
+         return status;
+      }
+      auto count = [&](uint8_t h) { ++counts[h]; };
+      auto end = walk_value(bytes, 0, count);
+      if (!end) {
+         status.error = std::string(to_string(end.error()));
+         return status;
+      }
+      if (*end != bytes.size()) {
+         status.error = std::to_string(bytes.size() - *end) + " trailing bytes after the root value";
+         return status;
+      }
+
+      if (decode) {
+         glz::json_t value{};
+         if (auto ec = glz::read_beve(value, bytes)) {
+            status.error = "decode failed: " + glz::format_error(ec, bytes);
+            return status;
+         }
+      }
+      status.ok = true;
+      return status;
+   }
+
+   inline batch_report validate_batch(const std::vector<std::string>& paths, const batch_options& options = {})
+   {
+      batch_report report;
+      report.files.resize(paths.size());
+      report.threads = std::max<size_t>(options.threads, 1);
+
+      // Largest first: the long poles start early and small files fill in around them
+      std::vector<size_t> order(paths.size());
+      std::vector<uintmax_t> sizes(paths.size());
+      for (size_t i = 0; i < paths.size(); ++i) {
+         std::error_code ec;
+         sizes[i] = std::filesystem::file_size(paths[i], ec);
+      }
+      std::iota(order.begin(), order.end(), size_t(0));
+      std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return sizes[a] > sizes[b]; });
+
+      std::array<std::atomic<uint64_t>, 256> counts{};
+      const auto start = std::chrono::steady_clock::now();
+      {
+         thread_pool pool(report.threads);
+         for (size_t i : order) {
+            pool.submit([&, i] {
+               std::array<uint64_t, 256> local{};
+               report.files[i] = validate_file(paths[i], options.decode, local);
+               if (!report.files[i].ok) {
+                  return; // a partial walk would skew the histogram
+               }
+               for (size_t h = 0; h < local.size(); ++h) {
+                  if (local[h]) {
+                     counts[h].fetch_add(local[h], std::memory_order_relaxed);
+                  }
+               }
+            });
+         }
+         pool.wait();
+      }
+      report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+      for (size_t h = 0; h < counts.size(); ++h) {
+         report.header_counts[h] = counts[h].load(std::memory_order_relaxed);
+      }
+      for (const auto& f : report.files) {
+         report.total_bytes += f.bytes;
+         report.failures += f.ok ? 0 : 1;
+      }
+      return report;
+   }
+}
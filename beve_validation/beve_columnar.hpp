@@ -0,0 +1,255 @@
+#pragma once
+
+// Struct-of-arrays (columnar) encoding of record batches.
+//
+// glz::write_beve writes a std::vector<Record> as a generic array in which every element repeats
+// its object header, count, keys and per-value headers. `write_columnar` writes the same batch as
+// one object holding one typed array per member instead:
+//
+//    {"id": i32[n], "value": f64[n], "name": string[n]}
+//
+// so every key and header is paid once per batch, numeric columns are contiguous and each column
+// decodes as a single typed array. `read_columnar` scatters such an object back into records,
+// and BEVE.jl rebuilds `Vector{Record}` from it with `deser_beve` (see `to_beve_columnar`).
+//
+// The columns are described once per record type:
+//
+//    inline constexpr auto small_data_columns = beve::columnar_layout{
+//       beve::column{"id", &SmallData::id}, beve::column{"value", &SmallData::value},
+//       beve::column{"name", &SmallData::name}};
+//
+// Columns may be arithmetic, bool, std::complex or std::string members.
+
+#include <complex>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "beve_core.hpp"
+
+namespace beve
+{
+   template <class Record, class Member>
+   struct column
+   {
+      std::string_view key;
+      Member Record::*member;
+   };
+
+   template <class Record, class... Members>
+   struct columnar_layout
+   {
+      std::tuple<column<Record, Members>...> columns;
+
+      constexpr columnar_layout(column<Record, Members>... c) : columns(c...) {}
+   };
+
+   namespace detail
+   {
+      template <class M>
+      inline constexpr bool columnar_supported =
+         std::is_arithmetic_v<M> || is_complex<M>::value || std::is_same_v<M, std::string>;
+
+      template <class Record, class M>
+      void write_column(std::span<const Record> records, const column<Record, M>& c, std::string& out)
+      {
+         static_assert(columnar_supported<M>, "columns must be arithmetic, bool, complex or std::string");
+         write_compressed_size(out, c.key.size());
+         out.append(c.key);
+
+         const size_t n = records.size();
+         if constexpr (std::is_same_v<M, bool>) {
+            out.push_back(char(headers::bool_array));
+            write_compressed_size(out, n);
+            const size_t at = out.size();
+            out.resize(at + (n + 7) / 8);
+            for (size_t i = 0; i < n; ++i) {
+               if (records[i].*c.member) {
+                  out[at + i / 8] = char(uint8_t(out[at + i / 8]) | uint8_t(1u << (i % 8)));
+               }
+            }
+         }
+         else if constexpr (std::is_same_v<M, std::string>) {
+            size_t bytes = 0;
+            for (const auto& r : records) {
+               bytes += compressed_size_width((r.*c.member).size()) + (r.*c.member).size();
+            }
+            out.reserve(out.size() + 1 + compressed_size_width(n) + bytes);
+            out.push_back(char(headers::string_array));
+            write_compressed_size(out, n);
+            for (const auto& r : records) {
+               write_compressed_size(out, (r.*c.member).size());
+               out.append(r.*c.member);
+            }
+         }
+         else {
+            if constexpr (is_complex<M>::value) {
+               out.push_back(char(headers::complex));
+               out.push_back(char(complex_array_header<typename M::value_type>()));
+            }
+            else {
+               out.push_back(char(typed_array_header<M>()));
+            }
+            write_compressed_size(out, n);
+            const size_t at = out.size();
+            out.resize(at + n * sizeof(M));
+            char* dst = out.data() + at;
+            for (size_t i = 0; i < n; ++i) {
+               std::memcpy(dst + i * sizeof(M), &(records[i].*c.member), sizeof(M));
+            }
+         }
+      }
+
+      // Reads one column whose header is at `pos`. The first column read sizes `records`; every
+      // later one must agree with it.
+      template <class Record, class M>
+      std::expected<void, view_error> read_column(std::string_view b, size_t& pos, const column<Record, M>& c,
+                                                  std::vector<Record>& records, bool& sized)
+      {
+         if (pos >= b.size()) {
+            return std::unexpected(view_error::unexpected_end);
+         }
+         const uint8_t h = uint8_t(b[pos++]);
+         if constexpr (std::is_same_v<M, bool>) {
+            if (h != headers::bool_array) {
+               return std::unexpected(view_error::type_mismatch);
+            }
+         }
+         else if constexpr (std::is_same_v<M, std::string>) {
+            if (h != headers::string_array) {
+               return std::unexpected(view_error::type_mismatch);
+            }
+         }
+         else if constexpr (is_complex<M>::value) {
+            if (h != headers::complex || pos >= b.size() ||
+                uint8_t(b[pos++]) != complex_array_header<typename M::value_type>()) {
+               return std::unexpected(view_error::type_mismatch);
+            }
+         }
+         else if (h != typed_array_header<M>()) {
+            return std::unexpected(view_error::type_mismatch);
+         }
+
+         auto count = read_compressed_size(b, pos);
+         if (!count) {
+            return std::unexpected(count.error());
+         }
+         // Every element occupies at least one bit, which bounds the resize by the input size
+         if (*count > 8 * (b.size() - pos)) {
+            return std::unexpected(view_error::size_overflow);
+         }
+         if (!sized) {
+            records.resize(size_t(*count));
+            sized = true;
+         }
+         else if (*count != records.size()) {
+            return std::unexpected(view_error::extent_mismatch);
+         }
+         const size_t n = records.size();
+
+         if constexpr (std::is_same_v<M, bool>) {
+            const size_t start = pos;
+            if (auto r = advance(b, pos, (n + 7) / 8); !r) {
+               return r;
+            }
+            for (size_t i = 0; i < n; ++i) {
+               records[i].*c.member = (uint8_t(b[start + i / 8]) >> (i % 8)) & 1;
+            }
+         }
+         else if constexpr (std::is_same_v<M, std::string>) {
+            for (size_t i = 0; i < n; ++i) {
+               auto len = read_compressed_size(b, pos);
+               if (!len) {
+                  return std::unexpected(len.error());
+               }
+               const size_t start = pos;
+               if (auto r = advance(b, pos, *len); !r) {
+                  return r;
+               }
+               (records[i].*c.member).assign(b.data() + start, size_t(*len));
+            }
+         }
+         else {
+            const size_t start = pos;
+            if (auto r = advance_elements(b, pos, n, sizeof(M)); !r) {
+               return r;
+            }
+            const char* src = b.data() + start;
+            for (size_t i = 0; i < n; ++i) {
+               std::memcpy(&(records[i].*c.member), src + i * sizeof(M), sizeof(M));
+            }
+         }
+         return {};
+      }
+   }
+
+   // Writes `records` as one object of typed arrays, replacing the contents of `out`
+   template <class Record, class... Members>
+   void write_columnar(std::span<const Record> records, const columnar_layout<Record, Members...>& layout,
+                       std::string& out)
+   {
+      out.clear();
+      out.push_back(char(headers::string_object));
+      write_compressed_size(out, sizeof...(Members));
+      std::apply([&](const auto&... c) { (detail::write_column(records, c, out), ...); }, layout.columns);
+   }
+
+   // Reads a columnar object into `records`. Columns the layout does not know are skipped; members
+   // whose column is absent keep their default value.
+   template <class Record, class... Members>
+   std::expected<void, view_error> read_columnar(std::vector<Record>& records, std::string_view bytes,
+                                                 const columnar_layout<Record, Members...>& layout)
+   {
+      records.clear();
+      if (bytes.empty()) {
+         return std::unexpected(view_error::unexpected_end);
+      }
+      if (uint8_t(bytes[0]) != headers::string_object) {
+         return std::unexpected(view_error::type_mismatch);
+      }
+      size_t pos = 1;
+      auto count = read_compressed_size(bytes, pos);
+      if (!count) {
+         return std::unexpected(count.error());
+      }
+      bool sized = false;
+      for (uint64_t k = 0; k < *count; ++k) {
+         auto len = read_compressed_size(bytes, pos);
+         if (!len) {
+            return std::unexpected(len.error());
+         }
+         const size_t key_start = pos;
+         if (auto r = detail::advance(bytes, pos, *len); !r) {
+            return r;
+         }
+         const std::string_view key = bytes.substr(key_start, size_t(*len));
+
+         bool matched = false;
+         std::expected<void, view_error> result{};
+         auto try_column = [&](const auto& c) {
+            if (!matched && c.key == key) {
+               matched = true;
+               result = detail::read_column(bytes, pos, c, records, sized);
+            }
+         };
+         std::apply([&](const auto&... c) { (try_column(c), ...); }, layout.columns);
+         if (!result) {
+            return result;
+         }
+         if (!matched) {
+            auto end = skip_value(bytes, pos, 1);
+            if (!end) {
+               return std::unexpected(end.error());
+            }
+            pos = *end;
+         }
+      }
+      return {};
+   }
+}
@@ -0,0 +1,626 @@
+#pragma once
+
+// BEVE format primitives shared by the C++ tooling: header constants (mirroring
+// src/Headers.jl), compressed-size encoding/decoding and a bounds-checked value skipper.
+
+#include <array>
+#include <bit>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace beve
+{
+   // Header constants, mirroring src/Headers.jl
+   namespace headers
+   {
+      inline constexpr uint8_t null = 0x00;
+      inline constexpr uint8_t boolean_false = 0x08;
+      inline constexpr uint8_t boolean_true = 0x18;
+
+      inline constexpr uint8_t bf16 = 0x01;
+      inline constexpr uint8_t f16 = 0x21;
+      inline constexpr uint8_t f32 = 0x41;
+      inline constexpr uint8_t f64 = 0x61;
+      inline constexpr uint8_t i8 = 0x09;
+      inline constexpr uint8_t i16 = 0x29;
+      inline constexpr uint8_t i32 = 0x49;
+      inline constexpr uint8_t i64 = 0x69;
+      inline constexpr uint8_t u8 = 0x11;
+      inline constexpr uint8_t u16 = 0x31;
+      inline constexpr uint8_t u32 = 0x51;
+      inline constexpr uint8_t u64 = 0x71;
+
+      inline constexpr uint8_t string = 0x02;
+
+      inline constexpr uint8_t string_object = 0x03;
+      inline constexpr uint8_t i8_object = 0x0b;
+      inline constexpr uint8_t i16_object = 0x2b;
+      inline constexpr uint8_t i32_object = 0x4b;
+      inline constexpr uint8_t i64_object = 0x6b;
+      inline constexpr uint8_t u8_object = 0x13;
+      inline constexpr uint8_t u16_object = 0x33;
+      inline constexpr uint8_t u32_object = 0x53;
+      inline constexpr uint8_t u64_object = 0x73;
+
+      inline constexpr uint8_t bf16_array = 0x04;
+      inline constexpr uint8_t f16_array = 0x24;
+      inline constexpr uint8_t f32_array = 0x44;
+      inline constexpr uint8_t f64_array = 0x64;
+      inline constexpr uint8_t i8_array = 0x0c;
+      inline constexpr uint8_t i16_array = 0x2c;
+      inline constexpr uint8_t i32_array = 0x4c;
+      inline constexpr uint8_t i64_array = 0x6c;
+      inline constexpr uint8_t u8_array = 0x14;
+      inline constexpr uint8_t u16_array = 0x34;
+      inline constexpr uint8_t u32_array = 0x54;
+      inline constexpr uint8_t u64_array = 0x74;
+      inline constexpr uint8_t bool_array = 0x1c;
+      inline constexpr uint8_t string_array = 0x3c;
+      inline constexpr uint8_t generic_array = 0x05;
+
+      inline constexpr uint8_t delimiter = 0x06;
+      inline constexpr uint8_t tag = 0x0e;
+      inline constexpr uint8_t matrix = 0x16;
+      inline constexpr uint8_t complex = 0x1e;
+      inline constexpr uint8_t packed_array = 0x26; // delta/XOR block-packed numbers (beve_packed.hpp)
+      inline constexpr uint8_t key_table = 0x2e; // object key dictionary for the value that follows (beve_keys.hpp)
+      inline constexpr uint8_t keyed_object = 0x36; // object whose keys are key_table indices
+   }
+
+   // The low three bits of every header select the value family
+   enum class value_type : uint8_t {
+      null_or_bool = 0,
+      number = 1,
+      string = 2,
+      object = 3,
+      typed_array = 4,
+      generic_array = 5,
+      extension = 6,
+      reserved = 7
+   };
+
+   inline constexpr value_type type_of(uint8_t header) noexcept { return value_type(header & 0b111); }
+
+   // Numbers, integer object keys and numeric typed arrays store log2(byte width) in bits 5-7,
+   // except bf16, which takes the otherwise unused one-byte float slot
+   inline constexpr size_t byte_count(uint8_t header) noexcept
+   {
+      if (header == headers::bf16 || header == headers::bf16_array) {
+         return 2;
+      }
+      return size_t(1) << ((header >> 5) & 0b111);
+   }
+
+   enum class view_error : uint8_t {
+      unexpected_end,
+      invalid_header,
+      size_overflow,
+      depth_exceeded,
+      type_mismatch,
+      key_not_found,
+      index_out_of_range,
+      extent_mismatch,
+      misaligned,
+      trailing_bytes,
+      planar_layout
+   };
+
+   inline constexpr std::string_view to_string(view_error e) noexcept
+   {
+      switch (e) {
+      case view_error::unexpected_end:
+         return "unexpected end of buffer";
+      case view_error::invalid_header:
+         return "invalid header";
+      case view_error::size_overflow:
+         return "size exceeds buffer";
+      case view_error::depth_exceeded:
+         return "maximum nesting depth exceeded";
+      case view_error::type_mismatch:
+         return "type mismatch";
+      case view_error::key_not_found:
+         return "key not found";
+      case view_error::index_out_of_range:
+         return "index out of range";
+      case view_error::extent_mismatch:
+         return "matrix extents do not match the element count";
+      case view_error::misaligned:
+         return "payload is not aligned for the element type";
+      case view_error::trailing_bytes:
+         return "bytes follow the end of the value";
+      case view_error::planar_layout:
+         return "planar complex payload cannot be viewed in place";
+      }
+      return "unknown error";
+   }
+
+   // Human readable name of a header byte, for diagnostics and histograms
+   inline constexpr std::string_view header_name(uint8_t h) noexcept
+   {
+      switch (h) {
+      case headers::null: return "null";
+      case headers::boolean_false: return "false";
+      case headers::boolean_true: return "true";
+      case headers::bf16: return "bf16";
+      case headers::f16: return "f16";
+      case headers::f32: return "f32";
+      case headers::f64: return "f64";
+      case headers::i8: return "i8";
+      case headers::i16: return "i16";
+      case headers::i32: return "i32";
+      case headers::i64: return "i64";
+      case headers::u8: return "u8";
+      case headers::u16: return "u16";
+      case headers::u32: return "u32";
+      case headers::u64: return "u64";
+      case headers::string: return "string";
+      case headers::string_object: return "string_object";
+      case headers::i8_object: return "i8_object";
+      case headers::i16_object: return "i16_object";
+      case headers::i32_object: return "i32_object";
+      case headers::i64_object: return "i64_object";
+      case headers::u8_object: return "u8_object";
+      case headers::u16_object: return "u16_object";
+      case headers::u32_object: return "u32_object";
+      case headers::u64_object: return "u64_object";
+      case headers::bf16_array: return "bf16_array";
+      case headers::f16_array: return "f16_array";
+      case headers::f32_array: return "f32_array";
+      case headers::f64_array: return "f64_array";
+      case headers::i8_array: return "i8_array";
+      case headers::i16_array: return "i16_array";
+      case headers::i32_array: return "i32_array";
+      case headers::i64_array: return "i64_array";
+      case headers::u8_array: return "u8_array";
+      case headers::u16_array: return "u16_array";
+      case headers::u32_array: return "u32_array";
+      case headers::u64_array: return "u64_array";
+      case headers::bool_array: return "bool_array";
+      case headers::string_array: return "string_array";
+      case headers::generic_array: return "generic_array";
+      case headers::delimiter: return "delimiter";
+      case headers::tag: return "tag";
+      case headers::matrix: return "matrix";
+      case headers::complex: return "complex";
+      case headers::packed_array: return "packed_array";
+      case headers::key_table: return "key_table";
+      case headers::keyed_object: return "keyed_object";
+      default: return "unknown";
+      }
+   }
+
+   inline constexpr size_t max_depth = 512;
+
+   // How a walker has to treat each of the 256 possible header bytes. Looking this up replaces
+   // re-deriving the family, subtype and validity from the header bits on every value.
+   enum class header_kind : uint8_t {
+      invalid,
+      fixed, // null, booleans and numbers: `width` payload bytes follow
+      string,
+      object, // `width` bytes per integer key, 0 for string keys
+      typed_array, // `width` bytes per element
+      bool_array,
+      string_array,
+      generic_array,
+      delimiter,
+      tag,
+      matrix,
+      complex,
+      packed_array,
+      key_table,
+      keyed_object
+   };
+
+   struct header_traits
+   {
+      header_kind kind = header_kind::invalid;
+      uint8_t width = 0;
+   };
+
+   inline constexpr std::array<header_traits, 256> header_table = [] {
+      std::array<header_traits, 256> table{};
+      for (size_t i = 0; i < table.size(); ++i) {
+         const uint8_t h = uint8_t(i);
+         const uint8_t width = uint8_t(byte_count(h));
+         auto& t = table[i];
+         switch (type_of(h)) {
+         case value_type::null_or_bool:
+            if (h == headers::null || h == headers::boolean_false || h == headers::boolean_true) {
+               t = {header_kind::fixed, 0};
+            }
+            break;
+         case value_type::number:
+            t = {header_kind::fixed, width};
+            break;
+         case value_type::string:
+            t = {header_kind::string, 0};
+            break;
+         case value_type::object:
+            t = {header_kind::object, uint8_t(((h >> 3) & 0b11) == 0 ? 0 : width)};
+            break;
+         case value_type::typed_array:
+            if (((h >> 3) & 0b11) < 3) {
+               t = {header_kind::typed_array, width};
+            }
+            else if (h == headers::bool_array) {
+               t = {header_kind::bool_array, 0};
+            }
+            else if (h == headers::string_array) {
+               t = {header_kind::string_array, 0};
+            }
+            break;
+         case value_type::generic_array:
+            t = {header_kind::generic_array, 0};
+            break;
+         case value_type::extension:
+            if (h == headers::delimiter) {
+               t = {header_kind::delimiter, 0};
+            }
+            else if (h == headers::tag) {
+               t = {header_kind::tag, 0};
+            }
+            else if (h == headers::matrix) {
+               t = {header_kind::matrix, 0};
+            }
+            else if (h == headers::complex) {
+               t = {header_kind::complex, 0};
+            }
+            else if (h == headers::packed_array) {
+               t = {header_kind::packed_array, 0};
+            }
+            else if (h == headers::key_table) {
+               t = {header_kind::key_table, 0};
+            }
+            else if (h == headers::keyed_object) {
+               t = {header_kind::keyed_object, 0};
+            }
+            break;
+         case value_type::reserved:
+            break;
+         }
+      }
+      return table;
+   }();
+
+   // Decodes a compressed size (low two bits select a 1/2/4/8 byte little-endian word) at `pos`
+   // and advances `pos` past it. Single-byte sizes (the overwhelming majority) take a predictable
+   // early exit; wider sizes are decoded without branching on the width, by one unaligned 64-bit
+   // load masked down to the encoded width, whenever eight bytes remain.
+   inline std::expected<uint64_t, view_error> read_compressed_size(std::string_view b, size_t& pos) noexcept
+   {
+      if (pos >= b.size()) {
+         return std::unexpected(view_error::unexpected_end);
+      }
+      const uint8_t first = uint8_t(b[pos]);
+      if ((first & 0b11) == 0) {
+         ++pos;
+         return first >> 2;
+      }
+      uint64_t word = 0;
+      if (b.size() - pos >= 8) {
+         std::memcpy(&word, b.data() + pos, 8);
+         if constexpr (std::endian::native == std::endian::big) {
+            word = std::byteswap(word);
+         }
+         const unsigned bytes = 1u << (first & 0b11);
+         pos += bytes;
+         return (word & (~uint64_t(0) >> (64 - 8 * bytes))) >> 2;
+      }
+      const size_t n = size_t(1) << (first & 0b11);
+      if (b.size() - pos < n) {
+         return std::unexpected(view_error::unexpected_end);
+      }
+      std::memcpy(&word, b.data() + pos, n);
+      if constexpr (std::endian::native == std::endian::big) {
+         word = std::byteswap(word) >> (64 - 8 * n);
+      }
+      pos += n;
+      return word >> 2;
+   }
+
+   inline constexpr uint64_t max_compressed_size = (uint64_t(1) << 62) - 1;
+
+   // Number of bytes the compressed-size encoding of `n` occupies
+   inline constexpr size_t compressed_size_width(uint64_t n) noexcept
+   {
+      return n < (uint64_t(1) << 6) ? 1 : n < (uint64_t(1) << 14) ? 2 : n < (uint64_t(1) << 30) ? 4 : 8;
+   }
+
+   // Encodes `n` (which must not exceed max_compressed_size) into `out`, returning the bytes written
+   inline size_t encode_compressed_size(char* out, uint64_t n) noexcept
+   {
+      const size_t width = compressed_size_width(n);
+      uint64_t word = (n << 2) | uint64_t(std::countr_zero(width));
+      if constexpr (std::endian::native == std::endian::big) {
+         word = std::byteswap(word) >> (64 - 8 * width);
+      }
+      std::memcpy(out, &word, width);
+      return width;
+   }
+
+   inline void write_compressed_size(std::string& out, uint64_t n)
+   {
+      char bytes[8];
+      out.append(bytes, encode_compressed_size(bytes, n));
+   }
+
+   // Typed array header for an arithmetic element type (bool arrays are bit packed and handled separately)
+   template <class T>
+   inline constexpr uint8_t typed_array_header() noexcept
+   {
+      static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "numeric element type required");
+      constexpr uint8_t width_bits = uint8_t(std::countr_zero(sizeof(T)) << 5);
+      if constexpr (std::is_floating_point_v<T>) {
+         return uint8_t(0b100 | (0 << 3) | width_bits);
+      }
+      else if constexpr (std::is_signed_v<T>) {
+         return uint8_t(0b100 | (1 << 3) | width_bits);
+      }
+      else {
+         return uint8_t(0b100 | (2 << 3) | width_bits);
+      }
+   }
+
+   // Scalar number header for an arithmetic type
+   template <class T>
+   inline constexpr uint8_t number_header() noexcept
+   {
+      return uint8_t((typed_array_header<T>() & ~uint8_t(0b111)) | 0b001);
+   }
+
+   template <class T>
+   struct is_complex : std::false_type
+   {};
+
+   template <class T>
+   struct is_complex<std::complex<T>> : std::true_type
+   {};
+
+   // Component header that follows headers::complex for an array of std::complex<T>
+   template <class T>
+   inline constexpr uint8_t complex_array_header() noexcept
+   {
+      return uint8_t((typed_array_header<T>() & ~uint8_t(0b111)) | 0b001);
+   }
+
+   // Component header of a planar complex array (beve_planar.hpp): bit 1 set, and the payload holds
+   // every real part, then every imaginary part
+   template <class T>
+   inline constexpr uint8_t planar_complex_array_header() noexcept
+   {
+      return uint8_t(complex_array_header<T>() | 0b010);
+   }
+
+   // Whether typed array elements described by `header` (and, for complex arrays, the component
+   // header after it) are exactly T
+   template <class T>
+   inline constexpr bool element_matches(uint8_t header, uint8_t complex_header) noexcept
+   {
+      if constexpr (is_complex<T>::value) {
+         return header == headers::complex && complex_header == complex_array_header<typename T::value_type>();
+      }
+      else {
+         return header == typed_array_header<T>();
+      }
+   }
+
+   namespace detail
+   {
+      inline std::expected<void, view_error> advance(std::string_view b, size_t& pos, uint64_t n) noexcept
+      {
+         if (n > b.size() - pos) {
+            return std::unexpected(view_error::size_overflow);
+         }
+         pos += size_t(n);
+         return {};
+      }
+
+      // Advances over `count` fixed-width elements, guarding the multiplication against overflow
+      inline std::expected<void, view_error> advance_elements(std::string_view b, size_t& pos, uint64_t count,
+                                                              size_t width) noexcept
+      {
+         if (count > (b.size() - pos) / width) {
+            return std::unexpected(view_error::size_overflow);
+         }
+         pos += size_t(count) * width;
+         return {};
+      }
+
+      inline std::expected<void, view_error> skip_string_body(std::string_view b, size_t& pos) noexcept
+      {
+         auto n = read_compressed_size(b, pos);
+         if (!n) {
+            return std::unexpected(n.error());
+         }
+         return advance(b, pos, *n);
+      }
+   }
+
+   // Walks the value whose header is at `pos`, calling `on_header(header)` for it and for every
+   // nested value, and returns the position one past its end. Typed array and string payloads
+   // are skipped in O(1); only containers are walked.
+   template <class OnHeader>
+   std::expected<size_t, view_error> walk_value(std::string_view b, size_t pos, OnHeader& on_header,
+                                                size_t depth = 0) noexcept
+   {
+      using namespace detail;
+      if (depth > max_depth) {
+         return std::unexpected(view_error::depth_exceeded);
+      }
+      if (pos >= b.size()) {
+         return std::unexpected(view_error::unexpected_end);
+      }
+      const uint8_t h = uint8_t(b[pos++]);
+      on_header(h);
+
+      auto ok = [&](std::expected<void, view_error> r) -> std::expected<size_t, view_error> {
+         if (!r) {
+            return std::unexpected(r.error());
+         }
+         return pos;
+      };
+
+      const header_traits traits = header_table[h];
+      switch (traits.kind) {
+      case header_kind::fixed:
+         return ok(advance(b, pos, traits.width));
+      case header_kind::string:
+         return ok(skip_string_body(b, pos));
+      case header_kind::object: {
+         auto count = read_compressed_size(b, pos);
+         if (!count) {
+            return std::unexpected(count.error());
+         }
+         for (uint64_t i = 0; i < *count; ++i) {
+            if (traits.width == 0) {
+               if (auto r = skip_string_body(b, pos); !r) {
+                  return std::unexpected(r.error());
+               }
+            }
+            else if (auto r = advance(b, pos, traits.width); !r) {
+               return std::unexpected(r.error());
+            }
+            auto next = walk_value(b, pos, on_header, depth + 1);
+            if (!next) {
+               return next;
+            }
+            pos = *next;
+         }
+         return pos;
+      }
+      case header_kind::typed_array: {
+         auto count = read_compressed_size(b, pos);
+         if (!count) {
+            return std::unexpected(count.error());
+         }
+         return ok(advance_elements(b, pos, *count, traits.width));
+      }
+      case header_kind::bool_array: {
+         auto count = read_compressed_size(b, pos);
+         if (!count) {
+            return std::unexpected(count.error());
+         }
+         return ok(advance(b, pos, (*count + 7) / 8));
+      }
+      case header_kind::string_array: {
+         auto count = read_compressed_size(b, pos);
+         if (!count) {
+            return std::unexpected(count.error());
+         }
+         for (uint64_t i = 0; i < *count; ++i) {
+            if (auto r = skip_string_body(b, pos); !r) {
+               return std::unexpected(r.error());
+            }
+         }
+         return pos;
+      }
+      case header_kind::generic_array: {
+         auto count = read_compressed_size(b, pos);
+         if (!count) {
+            return std::unexpected(count.error());
+         }
+         for (uint64_t i = 0; i < *count; ++i) {
+            auto next = walk_value(b, pos, on_header, depth + 1);
+            if (!next) {
+               return next;
+            }
+            pos = *next;
+         }
+         return pos;
+      }
+      case header_kind::delimiter:
+         return pos;
+      case header_kind::tag: {
+         auto index = read_compressed_size(b, pos);
+         if (!index) {
+            return std::unexpected(index.error());
+         }
+         return walk_value(b, pos, on_header, depth + 1);
+      }
+      case header_kind::matrix: {
+         if (auto r = advance(b, pos, 1); !r) { // layout byte
+            return std::unexpected(r.error());
+         }
+         auto extents_end = walk_value(b, pos, on_header, depth + 1);
+         if (!extents_end) {
+            return extents_end;
+         }
+         return walk_value(b, *extents_end, on_header, depth + 1);
+      }
+      case header_kind::complex: {
+         if (pos >= b.size()) {
+            return std::unexpected(view_error::unexpected_end);
+         }
+         const uint8_t ch = uint8_t(b[pos++]);
+         const size_t width = 2 * byte_count(ch);
+         if ((ch & 0b111) == 0) {
+            return ok(advance(b, pos, width));
+         }
+         auto count = read_compressed_size(b, pos);
+         if (!count) {
+            return std::unexpected(count.error());
+         }
+         return ok(advance_elements(b, pos, *count, width));
+      }
+      case header_kind::packed_array: {
+         if (auto r = advance(b, pos, 2); !r) { // codec and element header
+            return std::unexpected(r.error());
+         }
+         auto count = read_compressed_size(b, pos);
+         if (!count) {
+            return std::unexpected(count.error());
+         }
+         auto length = read_compressed_size(b, pos);
+         if (!length) {
+            return std::unexpected(length.error());
+         }
+         return ok(advance(b, pos, *length));
+      }
+      case header_kind::key_table: {
+         auto count = read_compressed_size(b, pos);
+         if (!count) {
+            return std::unexpected(count.error());
+         }
+         for (uint64_t i = 0; i < *count; ++i) {
+            if (auto r = skip_string_body(b, pos); !r) {
+               return std::unexpected(r.error());
+            }
+         }
+         return walk_value(b, pos, on_header, depth + 1);
+      }
+      case header_kind::keyed_object: {
+         auto count = read_compressed_size(b, pos);
+         if (!count) {
+            return std::unexpected(count.error());
+         }
+         for (uint64_t i = 0; i < *count; ++i) {
+            if (auto index = read_compressed_size(b, pos); !index) {
+               return std::unexpected(index.error());
+            }
+            auto next = walk_value(b, pos, on_header, depth + 1);
+            if (!next) {
+               return next;
+            }
+            pos = *next;
+         }
+         return pos;
+      }
+      case header_kind::invalid:
+      default:
+         return std::unexpected(view_error::invalid_header);
+      }
+   }
+
+   // Returns the position one past the end of the value whose header is at `pos`
+   inline std::expected<size_t, view_error> skip_value(std::string_view b, size_t pos, size_t depth = 0) noexcept
+   {
+      auto ignore = [](uint8_t) {};
+      return walk_value(b, pos, ignore, depth);
+   }
+}
@@ -0,0 +1,300 @@
+#pragma once
+
+// Integer-keyed objects (I*_OBJECT / U*_OBJECT) decoded into flat sorted-vector maps.
+//
+// std::map and std::unordered_map spend one node allocation per key, which dominates decoding
+// lookup tables with millions of entries. `read_flat_map` instead fills two contiguous vectors,
+// one of keys and one of values, and hands them to `beve::flat_map`: std::flat_map where the
+// standard library has it (C++23), and otherwise a minimal stand-in with the same layout and the
+// same member names (keys(), values(), find, contains, at, replace). Lookups are binary searches
+// over the key vector.
+//
+// glaze writes std::map in key order, and BEVE.jl writes a Dict in hash order unless it is given
+// a sorted dictionary. Sortedness is checked while decoding, and only unsorted input pays for a
+// sort (by index, then one gather of each vector); repeated keys keep their last value, as
+// inserting into std::map through glaze would. Values are numbers, bools, std::string, std::string_view (zero
+// copy, pointing into the encoded buffer) or std::vector of numbers, so with numeric or
+// string_view values a decode performs exactly two allocations however many keys it holds.
+//
+//    beve::flat_map<uint32_t, double> table;
+//    if (auto r = beve::read_flat_map(bytes, table); !r) { ... beve::to_string(r.error()) ... }
+//    if (auto it = table.find(42); it != table.end()) { use((*it).second); }
+//
+// A flat_map is map-like for beve_size.hpp, so beve::write_exact writes one back.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <version>
+
+#if defined(__cpp_lib_flat_map)
+#include <flat_map>
+#endif
+
+#include "beve_core.hpp"
+
+namespace beve
+{
+#if defined(__cpp_lib_flat_map)
+   template <class K, class V>
+   using flat_map = std::flat_map<K, V>;
+#else
+   // The part of std::flat_map<K, V> this repository uses: sorted unique keys and their values in
+   // two parallel vectors
+   template <class K, class V>
+   class flat_map
+   {
+     public:
+      using key_type = K;
+      using mapped_type = V;
+      using key_container_type = std::vector<K>;
+      using mapped_container_type = std::vector<V>;
+      using size_type = size_t;
+
+      class const_iterator
+      {
+        public:
+         using iterator_category = std::forward_iterator_tag;
+         using value_type = std::pair<K, V>;
+         using reference = std::pair<const K&, typename std::vector<V>::const_reference>;
+         using difference_type = std::ptrdiff_t;
+
+         const_iterator() = default;
+         const_iterator(const flat_map* map, size_t i) noexcept : map_(map), i_(i) {}
+
+         reference operator*() const noexcept { return {map_->keys_[i_], map_->values_[i_]}; }
+         const_iterator& operator++() noexcept
+         {
+            ++i_;
+            return *this;
+         }
+         const_iterator operator++(int) noexcept
+         {
+            auto old = *this;
+            ++i_;
+            return old;
+         }
+         bool operator==(const const_iterator& other) const noexcept { return i_ == other.i_; }
+
+        private:
+         const flat_map* map_ = nullptr;
+         size_t i_ = 0;
+      };
+      using iterator = const_iterator;
+
+      size_t size() const noexcept { return keys_.size(); }
+      bool empty() const noexcept { return keys_.empty(); }
+      void clear() noexcept
+      {
+         keys_.clear();
+         values_.clear();
+      }
+
+      const std::vector<K>& keys() const noexcept { return keys_; }
+      const std::vector<V>& values() const noexcept { return values_; }
+
+      // Adopts both containers; `keys` must be sorted and unique and as long as `values`
+      void replace(std::vector<K>&& keys, std::vector<V>&& values)
+      {
+         keys_ = std::move(keys);
+         values_ = std::move(values);
+      }
+
+      const_iterator begin() const noexcept { return {this, 0}; }
+      const_iterator end() const noexcept { return {this, keys_.size()}; }
+
+      const_iterator lower_bound(const K& key) const noexcept
+      {
+         return {this, size_t(std::lower_bound(keys_.begin(), keys_.end(), key) - keys_.begin())};
+      }
+
+      const_iterator find(const K& key) const noexcept
+      {
+         const size_t i = size_t(std::lower_bound(keys_.begin(), keys_.end(), key) - keys_.begin());
+         return {this, i < keys_.size() && keys_[i] == key ? i : keys_.size()};
+      }
+
+      bool contains(const K& key) const noexcept { return std::binary_search(keys_.begin(), keys_.end(), key); }
+      size_t count(const K& key) const noexcept { return contains(key) ? 1 : 0; }
+
+      const V& at(const K& key) const
+      {
+         const size_t i = size_t(std::lower_bound(keys_.begin(), keys_.end(), key) - keys_.begin());
+         if (i == keys_.size() || keys_[i] != key) {
+            throw std::out_of_range("beve::flat_map::at");
+         }
+         return values_[i];
+      }
+
+     private:
+      std::vector<K> keys_;
+      std::vector<V> values_;
+   };
+#endif
+
+   namespace detail
+   {
+      template <class T>
+      struct is_std_vector : std::false_type
+      {};
+      template <class T>
+      struct is_std_vector<std::vector<T>> : std::true_type
+      {};
+
+      // I*_OBJECT / U*_OBJECT header for integer keys of type K
+      template <class K>
+      inline constexpr uint8_t integer_object_header() noexcept
+      {
+         return uint8_t((typed_array_header<K>() & ~uint8_t(0b111)) | 0b011);
+      }
+
+      // Decodes the value at `pos` into `out` and advances past it
+      template <class V>
+      std::expected<void, view_error> read_flat_value(std::string_view b, size_t& pos, V& out)
+      {
+         if (pos >= b.size()) {
+            return std::unexpected(view_error::unexpected_end);
+         }
+         const uint8_t h = uint8_t(b[pos]);
+         if constexpr (std::is_same_v<V, bool>) {
+            if (h != headers::boolean_true && h != headers::boolean_false) {
+               return std::unexpected(view_error::type_mismatch);
+            }
+            out = h == headers::boolean_true;
+            ++pos;
+         }
+         else if constexpr (std::is_arithmetic_v<V>) {
+            if (h != number_header<V>()) {
+               return std::unexpected(view_error::type_mismatch);
+            }
+            if (b.size() - pos - 1 < sizeof(V)) {
+               return std::unexpected(view_error::unexpected_end);
+            }
+            std::memcpy(&out, b.data() + pos + 1, sizeof(V));
+            pos += 1 + sizeof(V);
+         }
+         else if constexpr (std::is_same_v<V, std::string> || std::is_same_v<V, std::string_view>) {
+            if (h != headers::string) {
+               return std::unexpected(view_error::type_mismatch);
+            }
+            ++pos;
+            auto n = read_compressed_size(b, pos);
+            if (!n) {
+               return std::unexpected(n.error());
+            }
+            if (*n > b.size() - pos) {
+               return std::unexpected(view_error::size_overflow);
+            }
+            out = V(b.substr(pos, size_t(*n)));
+            pos += size_t(*n);
+         }
+         else if constexpr (is_std_vector<V>::value && std::is_arithmetic_v<typename V::value_type> &&
+                            !std::is_same_v<typename V::value_type, bool>) {
+            using T = typename V::value_type;
+            if (h != typed_array_header<T>()) {
+               return std::unexpected(view_error::type_mismatch);
+            }
+            ++pos;
+            auto n = read_compressed_size(b, pos);
+            if (!n) {
+               return std::unexpected(n.error());
+            }
+            if (*n > (b.size() - pos) / sizeof(T)) {
+               return std::unexpected(view_error::size_overflow);
+            }
+            out.resize(size_t(*n));
+            if (*n > 0) {
+               std::memcpy(out.data(), b.data() + pos, size_t(*n) * sizeof(T));
+            }
+            pos += size_t(*n) * sizeof(T);
+         }
+         else {
+            static_assert(sizeof(V) == 0, "read_flat_map values are numbers, bools, strings or numeric vectors");
+         }
+         return {};
+      }
+
+      // Orders `keys` and `values` by key, keeping the last value of each repeated key
+      template <class K, class V>
+      void sort_by_key(std::vector<K>& keys, std::vector<V>& values)
+      {
+         std::vector<size_t> order(keys.size());
+         std::iota(order.begin(), order.end(), size_t(0));
+         std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return keys[a] < keys[b]; });
+         std::vector<K> sorted_keys;
+         std::vector<V> sorted_values;
+         sorted_keys.reserve(keys.size());
+         sorted_values.reserve(values.size());
+         for (size_t i = 0; i < order.size(); ++i) {
+            if (i + 1 < order.size() && keys[order[i + 1]] == keys[order[i]]) {
+               continue; // a later duplicate follows
+            }
+            sorted_keys.push_back(keys[order[i]]);
+            sorted_values.push_back(std::move(values[order[i]]));
+         }
+         keys = std::move(sorted_keys);
+         values = std::move(sorted_values);
+      }
+   }
+
+   // Decodes the integer-keyed object at the start of `bytes` into `out`; the key width and
+   // signedness must match K. Returns the encoded length of the object.
+   template <class K, class V>
+   std::expected<size_t, view_error> read_flat_map(std::string_view bytes, flat_map<K, V>& out)
+   {
+      static_assert(std::is_integral_v<K> && !std::is_same_v<K, bool>, "read_flat_map keys are integers");
+      if (bytes.empty()) {
+         return std::unexpected(view_error::unexpected_end);
+      }
+      if (uint8_t(bytes[0]) != detail::integer_object_header<K>()) {
+         return std::unexpected(view_error::type_mismatch);
+      }
+      size_t pos = 1;
+      auto count = read_compressed_size(bytes, pos);
+      if (!count) {
+         return std::unexpected(count.error());
+      }
+      // Every entry takes at least its key and a one-byte value, which bounds a hostile count
+      if (*count > (bytes.size() - pos) / (sizeof(K) + 1)) {
+         return std::unexpected(view_error::size_overflow);
+      }
+
+      const size_t n = size_t(*count);
+      std::vector<K> keys(n);
+      std::vector<V> values(n);
+      bool sorted = true;
+      for (size_t i = 0; i < n; ++i) {
+         if (bytes.size() - pos < sizeof(K)) {
+            return std::unexpected(view_error::unexpected_end);
+         }
+         std::memcpy(&keys[i], bytes.data() + pos, sizeof(K));
+         pos += sizeof(K);
+         sorted = sorted && (i == 0 || keys[i - 1] < keys[i]);
+         if constexpr (std::is_same_v<V, bool>) {
+            bool value{}; // std::vector<bool> hands out proxies rather than bool&
+            if (auto r = detail::read_flat_value(bytes, pos, value); !r) {
+               return std::unexpected(r.error());
+            }
+            values[i] = value;
+         }
+         else if (auto r = detail::read_flat_value(bytes, pos, values[i]); !r) {
+            return std::unexpected(r.error());
+         }
+      }
+      if (!sorted) {
+         detail::sort_by_key(keys, values);
+      }
+      out.replace(std::move(keys), std::move(values));
+      return pos;
+   }
+}
@@ -0,0 +1,266 @@
+#pragma once
+
+// Reduced-precision typed arrays: BEVE's BF16_ARRAY (0x04) and F16_ARRAY (0x24).
+//
+// Neither Glaze nor std::vector<float> has a 16-bit float to hand these to, so this header keeps
+// values as float in memory and converts at the array boundary: `write_half_array` stores a span
+// of float as bf16 or f16 (half the bytes of F32_ARRAY), and `read_half_array` widens either
+// format back to float. BEVE.jl reads F16 arrays as Vector{Float16} and BF16 arrays as
+// Vector{Float32}, and writes them with `to_beve(data; float32_as = :bf16 | :f16)`.
+//
+// Narrowing rounds to nearest even; NaNs stay (quiet) NaNs and values beyond the f16 range become
+// infinities. The bulk conversions pick a vector path at run time: F16C for f16 in both
+// directions, AVX-512 BF16 for narrowing to bf16 (which, as the instruction does, flushes
+// subnormal inputs to zero), and otherwise AVX2-targeted loops the compiler vectorizes.
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <span>
+#include <string>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <cpuid.h>
+#include <immintrin.h>
+#define BEVE_HALF_X86 1
+#else
+#define BEVE_HALF_X86 0
+#endif
+
+#include "beve_core.hpp"
+#include "beve_view.hpp"
+
+namespace beve
+{
+   enum class half_format : uint8_t { bf16, f16 };
+
+   inline constexpr uint8_t half_array_header(half_format format) noexcept
+   {
+      return format == half_format::bf16 ? headers::bf16_array : headers::f16_array;
+   }
+
+   inline uint16_t float_to_bf16(float f) noexcept
+   {
+      const uint32_t x = std::bit_cast<uint32_t>(f);
+      const uint16_t rounded = uint16_t((x + 0x7fff + ((x >> 16) & 1)) >> 16);
+      const uint16_t quiet_nan = uint16_t((x >> 16) | 0x0040);
+      return (x & 0x7fffffff) > 0x7f800000 ? quiet_nan : rounded;
+   }
+
+   inline float bf16_to_float(uint16_t h) noexcept { return std::bit_cast<float>(uint32_t(h) << 16); }
+
+   inline uint16_t float_to_f16(float f) noexcept
+   {
+      uint32_t x = std::bit_cast<uint32_t>(f);
+      const uint32_t sign = (x >> 16) & 0x8000;
+      x &= 0x7fffffff;
+      if (x >= 0x47800000) { // at least 2^16: infinity, or NaN
+         return uint16_t(sign | (x > 0x7f800000 ? 0x7e00 : 0x7c00));
+      }
+      if (x < 0x38800000) { // below 2^-14: let an FP add align and round the subnormal mantissa
+         const float aligned = std::bit_cast<float>(x) + 0.5f;
+         return uint16_t(sign | (std::bit_cast<uint32_t>(aligned) - 0x3f000000));
+      }
+      const uint32_t odd = (x >> 13) & 1;
+      x += 0xc8000fff + odd; // rebias the exponent from 127 to 15 and round the mantissa
+      return uint16_t(sign | (x >> 13));
+   }
+
+   inline float f16_to_float(uint16_t h) noexcept
+   {
+      const uint32_t sign = uint32_t(h & 0x8000) << 16;
+      uint32_t x = uint32_t(h & 0x7fff) << 13;
+      const uint32_t exponent = x & 0x0f800000;
+      x += (127 - 15) << 23;
+      if (exponent == 0x0f800000) { // infinity or NaN
+         x += (128 - 16) << 23;
+      }
+      else if (exponent == 0) { // zero or subnormal: renormalize through an FP subtract
+         x += 1 << 23;
+         x = std::bit_cast<uint32_t>(std::bit_cast<float>(x) - std::bit_cast<float>(uint32_t(113) << 23));
+      }
+      return std::bit_cast<float>(x | sign);
+   }
+
+   namespace detail
+   {
+      // Portable loops over little-endian payload bytes, shaped so the compiler can vectorize them
+      inline void narrow_bf16_loop(const float* in, size_t n, char* out) noexcept
+      {
+         for (size_t i = 0; i < n; ++i) {
+            const uint16_t h = float_to_bf16(in[i]);
+            std::memcpy(out + 2 * i, &h, 2);
+         }
+      }
+
+      inline void widen_bf16_loop(const char* in, size_t n, float* out) noexcept
+      {
+         for (size_t i = 0; i < n; ++i) {
+            uint16_t h;
+            std::memcpy(&h, in + 2 * i, 2);
+            out[i] = bf16_to_float(h);
+         }
+      }
+
+      inline void narrow_f16_loop(const float* in, size_t n, char* out) noexcept
+      {
+         for (size_t i = 0; i < n; ++i) {
+            const uint16_t h = float_to_f16(in[i]);
+            std::memcpy(out + 2 * i, &h, 2);
+         }
+      }
+
+      inline void widen_f16_loop(const char* in, size_t n, float* out) noexcept
+      {
+         for (size_t i = 0; i < n; ++i) {
+            uint16_t h;
+            std::memcpy(&h, in + 2 * i, 2);
+            out[i] = f16_to_float(h);
+         }
+      }
+
+#if BEVE_HALF_X86
+      struct half_cpu
+      {
+         bool avx2 = false;
+         bool f16c = false;
+         bool avx512bf16 = false;
+      };
+
+      inline const half_cpu& cpu() noexcept
+      {
+         static const half_cpu features = [] {
+            half_cpu c;
+            __builtin_cpu_init();
+            c.avx2 = __builtin_cpu_supports("avx2");
+            c.f16c = c.avx2 && __builtin_cpu_supports("f16c");
+            unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+            // CPUID leaf 7, subleaf 1, EAX bit 5: AVX512_BF16. avx512f also confirms OS zmm support.
+            c.avx512bf16 = __builtin_cpu_supports("avx512f") && __get_cpuid_count(7, 1, &eax, &ebx, &ecx, &edx) &&
+                           (eax & (1u << 5));
+            return c;
+         }();
+         return features;
+      }
+
+      __attribute__((target("avx2"))) inline void narrow_bf16_avx2(const float* in, size_t n, char* out) noexcept
+      {
+         narrow_bf16_loop(in, n, out);
+      }
+
+      __attribute__((target("avx2"))) inline void widen_bf16_avx2(const char* in, size_t n, float* out) noexcept
+      {
+         widen_bf16_loop(in, n, out);
+      }
+
+      __attribute__((target("avx512f,avx512bf16"))) inline void narrow_bf16_avx512(const float* in, size_t n,
+                                                                                 char* out) noexcept
+      {
+         size_t i = 0;
+         for (; i + 16 <= n; i += 16) {
+            const __m256bh h = _mm512_cvtneps_pbh(_mm512_loadu_ps(in + i));
+            std::memcpy(out + 2 * i, &h, sizeof(h));
+         }
+         narrow_bf16_loop(in + i, n - i, out + 2 * i);
+      }
+
+      __attribute__((target("avx2,f16c"))) inline void narrow_f16_f16c(const float* in, size_t n, char* out) noexcept
+      {
+         size_t i = 0;
+         for (; i + 8 <= n; i += 8) {
+            const __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i), h);
+         }
+         narrow_f16_loop(in + i, n - i, out + 2 * i);
+      }
+
+      __attribute__((target("avx2,f16c"))) inline void widen_f16_f16c(const char* in, size_t n, float* out) noexcept
+      {
+         size_t i = 0;
+         for (; i + 8 <= n; i += 8) {
+            const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 2 * i));
+            _mm256_storeu_ps(out + i, _mm256_cvtph_ps(h));
+         }
+         widen_f16_loop(in + 2 * i, n - i, out + i);
+      }
+#endif
+   }
+
+   // Converts `in` to `format`, writing 2 * in.size() little-endian bytes to `out`
+   inline void narrow_to_half(std::span<const float> in, char* out, half_format format) noexcept
+   {
+      static_assert(std::endian::native == std::endian::little, "half conversions assume a little-endian host");
+#if BEVE_HALF_X86
+      const auto& c = detail::cpu();
+      if (format == half_format::f16 && c.f16c) {
+         return detail::narrow_f16_f16c(in.data(), in.size(), out);
+      }
+      if (format == half_format::bf16 && c.avx512bf16) {
+         return detail::narrow_bf16_avx512(in.data(), in.size(), out);
+      }
+      if (format == half_format::bf16 && c.avx2) {
+         return detail::narrow_bf16_avx2(in.data(), in.size(), out);
+      }
+#endif
+      if (format == half_format::f16) {
+         detail::narrow_f16_loop(in.data(), in.size(), out);
+      }
+      else {
+         detail::narrow_bf16_loop(in.data(), in.size(), out);
+      }
+   }
+
+   // Widens out.size() little-endian `format` values starting at `in` into `out`
+   inline void widen_from_half(const char* in, std::span<float> out, half_format format) noexcept
+   {
+#if BEVE_HALF_X86
+      const auto& c = detail::cpu();
+      if (format == half_format::f16 && c.f16c) {
+         return detail::widen_f16_f16c(in, out.size(), out.data());
+      }
+      if (format == half_format::bf16 && c.avx2) {
+         return detail::widen_bf16_avx2(in, out.size(), out.data());
+      }
+#endif
+      if (format == half_format::f16) {
+         detail::widen_f16_loop(in, out.size(), out.data());
+      }
+      else {
+         detail::widen_bf16_loop(in, out.size(), out.data());
+      }
+   }
+
+   // Appends `values` to `out` as a BF16_ARRAY or F16_ARRAY, converting straight into the buffer
+   inline void write_half_array(std::string& out, std::span<const float> values, half_format format)
+   {
+      out.push_back(char(half_array_header(format)));
+      write_compressed_size(out, values.size());
+      const size_t at = out.size();
+      out.resize(at + 2 * values.size());
+      narrow_to_half(values, out.data() + at, format);
+   }
+
+   // Widens a bf16 or f16 typed array into `out` (resized to match)
+   inline std::expected<void, view_error> read_half_array(const typed_array_view& array, std::vector<float>& out)
+   {
+      if (array.header != headers::bf16_array && array.header != headers::f16_array) {
+         return std::unexpected(view_error::type_mismatch);
+      }
+      out.resize(array.count);
+      widen_from_half(array.data, out,
+                      array.header == headers::bf16_array ? half_format::bf16 : half_format::f16);
+      return {};
+   }
+
+   inline std::expected<void, view_error> read_half_array(std::string_view bytes, std::vector<float>& out)
+   {
+      auto array = beve_view{bytes}.as_typed_array();
+      if (!array) {
+         return std::unexpected(array.error());
+      }
+      return read_half_array(*array, out);
+   }
+}
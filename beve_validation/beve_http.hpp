@@ -0,0 +1,716 @@
+#pragma once
+
+// BEVE over HTTP/1.1, the C++ counterpart of ext/HTTPExt.jl. `http_server` serves registered
+// BEVE values with the same paths and JSON-pointer semantics as `start_server`, so a Julia
+// `BeveHttpClient` can read C++ state and the other way around:
+//
+//    GET  /                              plain-text list of registered paths
+//    GET  <path>                         the whole value at <path> (application/x-beve)
+//    GET  <path>/a/0   or   <path>?pointer=/a/0
+//                                        the value the JSON pointer selects
+//    POST <path>                         replaces (or creates) the value with the BEVE body
+//    POST <path>?pointer=/a/0            replaces the selected value inside it (or adds a
+//                                        missing last key, or appends with /-)
+//
+// Values are stored encoded, and pointers are resolved on the encoded bytes, so a GET of a
+// field never decodes the rest of the object and a POST to one patches it in place
+// (beve_patch.hpp). Connections are HTTP/1.1 keep-alive and
+// pipelined requests are answered in order, one batched write per read. Each open connection
+// occupies one worker of a `thread_pool`; idle keep-alive connections are closed after
+// `keep_alive_seconds` so that connections queued behind them get a worker.
+//
+// `http_client` is a minimal keep-alive client for tests and load generation; `send` and
+// `receive` are separate so requests can be pipelined.
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "beve_core.hpp"
+#include "beve_patch.hpp"
+#include "beve_pointer.hpp"
+#include "beve_thread_pool.hpp"
+
+namespace beve
+{
+   struct http_request
+   {
+      std::string method;
+      std::string path; // target without the query string
+      std::string pointer; // decoded `pointer` query parameter, empty when absent
+      std::string body;
+      bool keep_alive = true;
+   };
+
+   struct http_response
+   {
+      int status = 200;
+      std::string content_type = "text/plain";
+      std::string body;
+      // Whole-value GETs share the stored bytes instead of copying them into `body`
+      std::shared_ptr<const std::string> shared_body;
+      std::string extra_headers; // complete "Name: value\r\n" lines
+
+      std::string_view payload() const noexcept { return shared_body ? *shared_body : std::string_view(body); }
+   };
+
+   namespace detail
+   {
+      inline std::string url_decode(std::string_view in)
+      {
+         std::string out;
+         out.reserve(in.size());
+         for (size_t i = 0; i < in.size(); ++i) {
+            if (in[i] == '%' && i + 2 < in.size()) {
+               unsigned value = 0;
+               auto [p, ec] = std::from_chars(in.data() + i + 1, in.data() + i + 3, value, 16);
+               if (ec == std::errc{} && p == in.data() + i + 3) {
+                  out.push_back(char(value));
+                  i += 2;
+                  continue;
+               }
+            }
+            out.push_back(in[i] == '+' ? ' ' : in[i]);
+         }
+         return out;
+      }
+
+      inline std::string url_encode(std::string_view in)
+      {
+         static constexpr char hex[] = "0123456789ABCDEF";
+         std::string out;
+         for (const unsigned char c : in) {
+            if (std::isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~') {
+               out.push_back(char(c));
+            }
+            else {
+               out.push_back('%');
+               out.push_back(hex[c >> 4]);
+               out.push_back(hex[c & 15]);
+            }
+         }
+         return out;
+      }
+
+      inline bool iequals(std::string_view a, std::string_view b) noexcept
+      {
+         return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+                   return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+                });
+      }
+   }
+
+   namespace detail
+   {
+      // Parses one request at the start of `in`. Returns the bytes it took, 0 when the request
+      // is not complete yet, or nullopt when it is malformed.
+      inline std::optional<size_t> parse_request(std::string_view in, http_request& out, size_t max_body)
+      {
+         const size_t head_end = in.find("\r\n\r\n");
+         if (head_end == std::string_view::npos) {
+            return in.size() > 64 * 1024 ? std::nullopt : std::optional<size_t>(0);
+         }
+         std::string_view head = in.substr(0, head_end);
+         const size_t line_end = head.find("\r\n");
+         const std::string_view line = head.substr(0, line_end);
+         const size_t sp1 = line.find(' ');
+         const size_t sp2 = line.rfind(' ');
+         if (sp1 == std::string_view::npos || sp2 <= sp1) {
+            return std::nullopt;
+         }
+         out = http_request{};
+         out.method = line.substr(0, sp1);
+         const std::string_view target = line.substr(sp1 + 1, sp2 - sp1 - 1);
+         const std::string_view version = line.substr(sp2 + 1);
+         out.keep_alive = version != "HTTP/1.0";
+
+         const size_t q = target.find('?');
+         out.path = target.substr(0, q);
+         if (q != std::string_view::npos) {
+            std::string_view query = target.substr(q + 1);
+            while (!query.empty()) {
+               const size_t amp = query.find('&');
+               const std::string_view param = query.substr(0, amp);
+               const size_t eq = param.find('=');
+               if (param.substr(0, eq) == "pointer" && eq != std::string_view::npos) {
+                  out.pointer = url_decode(param.substr(eq + 1));
+               }
+               query = amp == std::string_view::npos ? std::string_view{} : query.substr(amp + 1);
+            }
+         }
+
+         size_t content_length = 0;
+         std::string_view headers_text = line_end == std::string_view::npos ? "" : head.substr(line_end + 2);
+         while (!headers_text.empty()) {
+            const size_t end = headers_text.find("\r\n");
+            const std::string_view header = headers_text.substr(0, end);
+            headers_text = end == std::string_view::npos ? std::string_view{} : headers_text.substr(end + 2);
+            const size_t colon = header.find(':');
+            if (colon == std::string_view::npos) {
+               return std::nullopt;
+            }
+            const std::string_view name = header.substr(0, colon);
+            std::string_view value = header.substr(colon + 1);
+            while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) {
+               value.remove_prefix(1);
+            }
+            if (iequals(name, "Content-Length")) {
+               auto [p, ec] = std::from_chars(value.data(), value.data() + value.size(), content_length);
+               if (ec != std::errc{} || content_length > max_body) {
+                  return std::nullopt;
+               }
+            }
+            else if (iequals(name, "Connection")) {
+               if (iequals(value, "close")) {
+                  out.keep_alive = false;
+               }
+               else if (iequals(value, "keep-alive")) {
+                  out.keep_alive = true;
+               }
+            }
+            else if (iequals(name, "Transfer-Encoding")) {
+               return std::nullopt; // BEVE clients send sized bodies; chunked uploads are not supported
+            }
+         }
+         const size_t body_begin = head_end + 4;
+         if (in.size() - body_begin < content_length) {
+            return size_t(0);
+         }
+         out.body = in.substr(body_begin, content_length);
+         return body_begin + content_length;
+      }
+
+      inline std::string_view status_text(int status) noexcept
+      {
+         switch (status) {
+         case 200: return "OK";
+         case 201: return "Created";
+         case 400: return "Bad Request";
+         case 404: return "Not Found";
+         case 405: return "Method Not Allowed";
+         case 500: return "Internal Server Error";
+         default: return "Unknown";
+         }
+      }
+
+      inline bool send_all(int fd, std::vector<iovec>& parts)
+      {
+         size_t first = 0;
+         while (first < parts.size()) {
+            msghdr msg{};
+            msg.msg_iov = parts.data() + first;
+            msg.msg_iovlen = std::min<size_t>(parts.size() - first, IOV_MAX);
+            ssize_t n = ::sendmsg(fd, &msg, MSG_NOSIGNAL);
+            if (n < 0) {
+               if (errno == EINTR) {
+                  continue;
+               }
+               return false;
+            }
+            while (n > 0 && first < parts.size()) {
+               const size_t take = std::min<size_t>(size_t(n), parts[first].iov_len);
+               parts[first].iov_base = static_cast<char*>(parts[first].iov_base) + take;
+               parts[first].iov_len -= take;
+               n -= ssize_t(take);
+               if (parts[first].iov_len == 0) {
+                  ++first;
+               }
+            }
+            while (first < parts.size() && parts[first].iov_len == 0) {
+               ++first;
+            }
+         }
+         return true;
+      }
+
+      inline int connect_tcp(const std::string& host, uint16_t port, std::string& error)
+      {
+         sockaddr_in addr{};
+         addr.sin_family = AF_INET;
+         addr.sin_port = htons(port);
+         if (::inet_pton(AF_INET, host == "localhost" ? "127.0.0.1" : host.c_str(), &addr.sin_addr) != 1) {
+            error = "not an IPv4 address: " + host;
+            return -1;
+         }
+         const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+         if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            error = std::strerror(errno);
+            if (fd >= 0) {
+               ::close(fd);
+            }
+            return -1;
+         }
+         const int one = 1;
+         ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+         return fd;
+      }
+   }
+
+   struct http_server_options
+   {
+      size_t threads = thread_pool::default_threads(); // concurrent connections served
+      int keep_alive_seconds = 5; // idle connections are closed after this long
+      size_t max_body_bytes = size_t(1) << 30;
+   };
+
+   class http_server
+   {
+     public:
+      explicit http_server(http_server_options options = {}) : options_(options), pool_(options.threads) {}
+      ~http_server() { stop(); }
+
+      http_server(const http_server&) = delete;
+      http_server& operator=(const http_server&) = delete;
+
+      // Serves `beve` (one encoded value, e.g. from glz::write_beve) at `path`
+      void register_object(std::string_view path, std::string beve)
+      {
+         auto value = std::make_shared<std::string>(std::move(beve));
+         std::unique_lock lock(registry_mutex_);
+         registry_[normalize(path)] = std::move(value);
+      }
+
+      bool unregister_object(std::string_view path)
+      {
+         std::unique_lock lock(registry_mutex_);
+         return registry_.erase(normalize(path)) > 0;
+      }
+
+      // The current encoded value at `path` (updated by POSTs), or null
+      std::shared_ptr<const std::string> object(std::string_view path) const
+      {
+         std::shared_lock lock(registry_mutex_);
+         auto it = registry_.find(normalize(path));
+         return it == registry_.end() ? nullptr : it->second;
+      }
+
+      // Listens on `host`:`port` (port 0 picks a free one; see port()) and serves until stop()
+      bool start(const std::string& host = "127.0.0.1", uint16_t port = 8080)
+      {
+         stop();
+         sockaddr_in addr{};
+         addr.sin_family = AF_INET;
+         addr.sin_port = htons(port);
+         if (::inet_pton(AF_INET, host == "localhost" ? "127.0.0.1" : host.c_str(), &addr.sin_addr) != 1) {
+            error_ = "not an IPv4 address: " + host;
+            return false;
+         }
+         listen_fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+         const int one = 1;
+         ::setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+         socklen_t len = sizeof(addr);
+         if (listen_fd_ < 0 || ::bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+             ::listen(listen_fd_, SOMAXCONN) != 0 ||
+             ::getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&addr), &len) != 0) {
+            error_ = std::strerror(errno);
+            if (listen_fd_ >= 0) {
+               ::close(listen_fd_);
+               listen_fd_ = -1;
+            }
+            return false;
+         }
+         port_ = ntohs(addr.sin_port);
+         stopping_ = false;
+         acceptor_ = std::thread([this] { accept_loop(); });
+         return true;
+      }
+
+      // Stops accepting, closes every connection and waits for their workers to finish
+      void stop()
+      {
+         if (listen_fd_ < 0) {
+            return;
+         }
+         stopping_ = true;
+         ::shutdown(listen_fd_, SHUT_RDWR);
+         acceptor_.join();
+         ::close(listen_fd_);
+         listen_fd_ = -1;
+         {
+            std::lock_guard lock(connections_mutex_);
+            for (const int fd : connections_) {
+               ::shutdown(fd, SHUT_RDWR);
+            }
+         }
+         pool_.wait();
+      }
+
+      uint16_t port() const noexcept { return port_; }
+      const std::string& error() const noexcept { return error_; }
+
+      // Answers one request; the socket loop calls this for every parsed request
+      http_response handle(const http_request& request)
+      {
+         if (request.method == "GET") {
+            return get(request);
+         }
+         if (request.method == "POST") {
+            return post(request);
+         }
+         if (request.method == "OPTIONS") {
+            http_response r;
+            r.extra_headers = "Access-Control-Allow-Origin: *\r\n"
+                              "Access-Control-Allow-Methods: GET, POST, PUT, DELETE, OPTIONS\r\n"
+                              "Access-Control-Allow-Headers: Content-Type\r\n";
+            return r;
+         }
+         return text(405, "Method not allowed: " + request.method);
+      }
+
+     private:
+      static std::string normalize(std::string_view path)
+      {
+         return path.starts_with('/') ? std::string(path) : "/" + std::string(path);
+      }
+
+      static http_response text(int status, std::string body)
+      {
+         http_response r;
+         r.status = status;
+         r.body = std::move(body);
+         return r;
+      }
+
+      std::string available_paths() const
+      {
+         std::string out;
+         for (const auto& [path, value] : registry_) {
+            out += out.empty() ? path : ", " + path;
+         }
+         return out;
+      }
+
+      http_response get(const http_request& request)
+      {
+         std::shared_lock lock(registry_mutex_);
+         if (request.path == "/") {
+            if (registry_.empty()) {
+               return text(200, "BEVE HTTP Server - No registered objects\n");
+            }
+            std::string listing = "BEVE HTTP Server - Available endpoints:\n\n";
+            for (const auto& [path, value] : registry_) {
+               listing += "- " + path + "\n";
+            }
+            listing += "\nUsage:\n- GET <path> - retrieve entire object\n"
+                       "- GET <path>?pointer=/field - retrieve specific field using JSON pointer\n";
+            return text(200, std::move(listing));
+         }
+
+         // The exact path, or the longest registered prefix with the rest of the path taken as
+         // the leading part of the JSON pointer
+         auto it = registry_.find(request.path);
+         std::string pointer = request.pointer;
+         if (it == registry_.end()) {
+            for (auto candidate = registry_.begin(); candidate != registry_.end(); ++candidate) {
+               const std::string& path = candidate->first;
+               if (request.path.starts_with(path) && request.path[path.size()] == '/' &&
+                   (it == registry_.end() || path.size() > it->first.size())) {
+                  it = candidate;
+               }
+            }
+            if (it == registry_.end()) {
+               return text(404, "Object not found at path: " + request.path + "\n\nAvailable paths: " +
+                                   available_paths());
+            }
+            pointer = request.path.substr(it->first.size()) + pointer;
+         }
+         auto value = it->second;
+         lock.unlock();
+
+         http_response r;
+         r.content_type = "application/x-beve";
+         if (pointer.empty()) {
+            r.shared_body = std::move(value);
+            return r;
+         }
+         auto target = resolve_pointer(*value, pointer);
+         if (!target) {
+            return text(400, "JSON pointer resolution error: " + std::string(to_string(target.error())));
+         }
+         r.body = target->encoded(*value);
+         return r;
+      }
+
+      http_response post(const http_request& request)
+      {
+         auto end = skip_value(request.body, 0);
+         if (request.body.empty() || !end || *end != request.body.size()) {
+            return text(400, "Body is not a single BEVE value");
+         }
+         const std::string path = request.path;
+         std::unique_lock lock(registry_mutex_);
+         if (request.pointer.empty()) {
+            registry_[path] = std::make_shared<std::string>(request.body);
+            return text(201, "Object created/updated at path: " + path);
+         }
+         auto it = registry_.find(path);
+         if (it == registry_.end()) {
+            return text(404, "Object not found at path: " + path);
+         }
+         // Patch the stored bytes in place unless a response still shares them; then patch a copy
+         // (the lock keeps new readers out; the fence orders our writes after a released reader's)
+         std::shared_ptr<std::string>& stored = it->second;
+         const bool unshared = stored.use_count() == 1;
+         std::atomic_thread_fence(std::memory_order_acquire);
+         std::shared_ptr<std::string> value = unshared ? stored : std::make_shared<std::string>(*stored);
+         auto patched = patch_value(*value, request.pointer, request.body);
+         if (!patched) {
+            return text(400, "JSON pointer update error: " + std::string(to_string(patched.error())));
+         }
+         stored = std::move(value);
+         return text(200, "Object updated at path: " + path + request.pointer);
+      }
+
+      void accept_loop()
+      {
+         while (!stopping_) {
+            const int fd = ::accept(listen_fd_, nullptr, nullptr);
+            if (fd < 0) {
+               if (errno == EINTR || errno == ECONNABORTED) {
+                  continue;
+               }
+               return; // the listening socket was shut down
+            }
+            const int one = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+            timeval timeout{options_.keep_alive_seconds, 0};
+            ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+            {
+               std::lock_guard lock(connections_mutex_);
+               if (stopping_) {
+                  ::close(fd);
+                  return;
+               }
+               connections_.insert(fd);
+            }
+            pool_.submit([this, fd] { serve(fd); });
+         }
+      }
+
+      // One connection: read, answer every complete request in the buffer, write the answers in
+      // one batch, repeat until the client closes, asks to close or goes idle
+      void serve(int fd)
+      {
+         std::string in;
+         std::vector<http_response> responses;
+         std::vector<std::string> heads;
+         std::vector<iovec> parts;
+         char chunk[64 * 1024];
+         bool open = true;
+         while (open && !stopping_) {
+            const ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+            if (n <= 0) {
+               if (n < 0 && errno == EINTR) {
+                  continue;
+               }
+               break;
+            }
+            in.append(chunk, size_t(n));
+            responses.clear();
+            size_t used = 0;
+            while (open) {
+               http_request request;
+               auto taken = detail::parse_request(std::string_view(in).substr(used), request,
+                                                  options_.max_body_bytes);
+               if (!taken) {
+                  responses.push_back(text(400, "Malformed request"));
+                  open = false;
+                  break;
+               }
+               if (*taken == 0) {
+                  break;
+               }
+               used += *taken;
+               responses.push_back(handle(request));
+               open = request.keep_alive;
+            }
+            in.erase(0, used);
+
+            heads.clear();
+            parts.clear();
+            heads.reserve(responses.size());
+            for (const auto& r : responses) {
+               const auto body = r.payload();
+               heads.push_back("HTTP/1.1 " + std::to_string(r.status) + " " +
+                               std::string(detail::status_text(r.status)) + "\r\nContent-Type: " + r.content_type +
+                               "\r\nContent-Length: " + std::to_string(body.size()) + "\r\n" + r.extra_headers +
+                               (open ? "Connection: keep-alive\r\n\r\n" : "Connection: close\r\n\r\n"));
+            }
+            for (size_t i = 0; i < responses.size(); ++i) {
+               const auto body = responses[i].payload();
+               parts.push_back({heads[i].data(), heads[i].size()});
+               if (!body.empty()) {
+                  parts.push_back({const_cast<char*>(body.data()), body.size()});
+               }
+            }
+            if (!parts.empty() && !detail::send_all(fd, parts)) {
+               break;
+            }
+         }
+         {
+            std::lock_guard lock(connections_mutex_);
+            connections_.erase(fd);
+         }
+         ::close(fd);
+      }
+
+      http_server_options options_;
+      thread_pool pool_;
+      mutable std::shared_mutex registry_mutex_;
+      std::map<std::string, std::shared_ptr<std::string>, std::less<>> registry_;
+      std::mutex connections_mutex_;
+      std::unordered_set<int> connections_;
+      std::thread acceptor_;
+      std::atomic<bool> stopping_{false};
+      int listen_fd_ = -1;
+      uint16_t port_ = 0;
+      std::string error_;
+   };
+
+   class http_client
+   {
+     public:
+      http_client() = default;
+      ~http_client() { close(); }
+
+      http_client(const http_client&) = delete;
+      http_client& operator=(const http_client&) = delete;
+
+      bool connect(const std::string& host, uint16_t port)
+      {
+         close();
+         host_ = host;
+         fd_ = detail::connect_tcp(host, port, error_);
+         return fd_ >= 0;
+      }
+
+      void close() noexcept
+      {
+         if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+         }
+         in_.clear();
+      }
+
+      // Sends one request without waiting for the answer. `pointer` becomes the query string.
+      bool send(std::string_view method, std::string_view path, std::string_view body = {},
+                std::string_view pointer = {})
+      {
+         std::string head;
+         head.reserve(128);
+         head.append(method).append(" ").append(path);
+         if (!pointer.empty()) {
+            head.append("?pointer=").append(detail::url_encode(pointer));
+         }
+         head.append(" HTTP/1.1\r\nHost: ").append(host_).append("\r\nAccept: application/x-beve\r\n");
+         if (!body.empty() || method == "POST") {
+            head.append("Content-Type: application/x-beve\r\nContent-Length: ").append(std::to_string(body.size()));
+            head.append("\r\n");
+         }
+         head.append("\r\n");
+         std::vector<iovec> parts{{head.data(), head.size()}};
+         if (!body.empty()) {
+            parts.push_back({const_cast<char*>(body.data()), body.size()});
+         }
+         if (!detail::send_all(fd_, parts)) {
+            error_ = std::strerror(errno);
+            return false;
+         }
+         return true;
+      }
+
+      // Reads the next response (answers arrive in the order the requests were sent)
+      std::optional<http_response> receive()
+      {
+         char chunk[64 * 1024];
+         while (true) {
+            const size_t head_end = in_.find("\r\n\r\n");
+            if (head_end != std::string::npos) {
+               http_response r;
+               const std::string_view head = std::string_view(in_).substr(0, head_end);
+               if (head.size() < 12 || !head.starts_with("HTTP/1.")) {
+                  error_ = "malformed response";
+                  return std::nullopt;
+               }
+               std::from_chars(head.data() + 9, head.data() + 12, r.status);
+               size_t length = 0;
+               std::string_view rest = head;
+               while (!rest.empty()) {
+                  const size_t end = rest.find("\r\n");
+                  std::string_view line = rest.substr(0, end);
+                  rest = end == std::string_view::npos ? std::string_view{} : rest.substr(end + 2);
+                  const size_t colon = line.find(':');
+                  if (colon == std::string_view::npos) {
+                     continue;
+                  }
+                  std::string_view value = line.substr(colon + 1);
+                  while (!value.empty() && value.front() == ' ') {
+                     value.remove_prefix(1);
+                  }
+                  if (detail::iequals(line.substr(0, colon), "Content-Length")) {
+                     std::from_chars(value.data(), value.data() + value.size(), length);
+                  }
+                  else if (detail::iequals(line.substr(0, colon), "Content-Type")) {
+                     r.content_type = value;
+                  }
+               }
+               if (in_.size() - (head_end + 4) >= length) {
+                  r.body = in_.substr(head_end + 4, length);
+                  in_.erase(0, head_end + 4 + length);
+                  return r;
+               }
+            }
+            const ssize_t n = ::recv(fd_, chunk, sizeof(chunk), 0);
+            if (n <= 0) {
+               if (n < 0 && errno == EINTR) {
+                  continue;
+               }
+               error_ = n == 0 ? "connection closed" : std::strerror(errno);
+               return std::nullopt;
+            }
+            in_.append(chunk, size_t(n));
+         }
+      }
+
+      std::optional<http_response> request(std::string_view method, std::string_view path,
+                                           std::string_view body = {}, std::string_view pointer = {})
+      {
+         if (!send(method, path, body, pointer)) {
+            return std::nullopt;
+         }
+         return receive();
+      }
+
+      const std::string& error() const noexcept { return error_; }
+
+     private:
+      int fd_ = -1;
+      std::string host_;
+      std::string in_;
+      std::string error_;
+   };
+}
@@ -0,0 +1,467 @@
+#pragma once
+
+// Sidecar index for random access into large typed arrays and matrices.
+//
+// BEVE typed arrays are fixed stride, so element i of an array whose payload starts at byte
+// `offset` lives at `offset + i * element_size`. `build_index` walks a file once (headers and
+// sizes only, payloads are skipped) and records, for every numeric typed array, complex array
+// and matrix whose payload is at least `min_bytes`, its JSON pointer, payload offset, element
+// count and element type. The index is stored next to the data as `<file>.index`, itself a BEVE
+// object, so the data file stays plain BEVE and BEVE.jl (`write_beve_index`, `read_beve_slice`)
+// reads and writes the same sidecar. Keyed objects (beve_keys.hpp) are walked through their key
+// table, so their arrays are indexed under the same pointers as in plain BEVE.
+//
+// `indexed_file` then serves any element range of an indexed array with a single pread (two for
+// a planar complex array, one from each half), without mapping or walking the data file.
+//
+//    beve::indexed_file f;
+//    f.open("capture.beve");
+//    std::vector<float> slice(100'000);
+//    f.read_range("/large_float_vec", 500'000, std::span(slice));
+
+#include <glaze/glaze.hpp>
+#include <glaze/beve.hpp>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <fstream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "beve_core.hpp"
+#include "beve_keys.hpp"
+#include "beve_mmap.hpp"
+#include "beve_planar.hpp"
+#include "beve_view.hpp"
+
+namespace beve
+{
+   struct index_entry
+   {
+      std::string pointer; // JSON pointer of the array or matrix, e.g. "/large_float_vec"
+      uint64_t offset = 0; // byte offset of the first element in the data file
+      uint64_t count = 0;
+      uint8_t header = 0; // typed array header, or headers::complex
+      uint8_t complex_header = 0; // component header for complex payloads
+      uint64_t element_size = 0;
+      std::vector<int64_t> extents; // matrices only
+      bool column_major = false; // matrices only
+   };
+
+   struct file_index
+   {
+      uint32_t version = 1;
+      uint64_t file_size = 0; // size of the indexed file, to detect a stale sidecar
+      std::vector<index_entry> entries;
+
+      const index_entry* find(std::string_view pointer) const noexcept
+      {
+         for (const auto& e : entries) {
+            if (e.pointer == pointer) {
+               return &e;
+            }
+         }
+         return nullptr;
+      }
+   };
+}
+
+template <>
+struct glz::meta<beve::index_entry>
+{
+   using T = beve::index_entry;
+   static constexpr auto value = object("pointer", &T::pointer, "offset", &T::offset, "count", &T::count,
+                                        "header", &T::header, "complex_header", &T::complex_header,
+                                        "element_size", &T::element_size, "extents", &T::extents,
+                                        "column_major", &T::column_major);
+};
+
+template <>
+struct glz::meta<beve::file_index>
+{
+   using T = beve::file_index;
+   static constexpr auto value = object("version", &T::version, "file_size", &T::file_size, "entries", &T::entries);
+};
+
+namespace beve
+{
+   inline constexpr uint64_t default_index_min_bytes = uint64_t(1) << 20;
+
+   inline std::string index_path(const std::string& path) { return path + ".index"; }
+
+   namespace detail
+   {
+      // Appends `key` to `pointer` with the RFC 6901 escapes for '~' and '/'
+      inline std::string child_pointer(const std::string& pointer, std::string_view key)
+      {
+         std::string out = pointer;
+         out.push_back('/');
+         for (char c : key) {
+            if (c == '~') {
+               out += "~0";
+            }
+            else if (c == '/') {
+               out += "~1";
+            }
+            else {
+               out.push_back(c);
+            }
+         }
+         return out;
+      }
+
+      inline void add_entry(std::string_view b, const std::string& pointer, const typed_array_view& data,
+                            uint64_t min_bytes, file_index& index)
+      {
+         if (data.size_bytes() < min_bytes) {
+            return;
+         }
+         index_entry e;
+         e.pointer = pointer;
+         e.offset = uint64_t(data.data - b.data());
+         e.count = data.count;
+         e.header = data.header;
+         e.complex_header = data.complex_header;
+         e.element_size = data.element_size;
+         index.entries.push_back(std::move(e));
+      }
+
+      // `keys` is the key table in effect for keyed objects (beve_keys.hpp), if any
+      inline std::expected<size_t, view_error> index_value(std::string_view b, size_t pos, const std::string& pointer,
+                                                           uint64_t min_bytes, file_index& index, size_t depth,
+                                                           const key_table* keys = nullptr)
+      {
+         if (depth > max_depth) {
+            return std::unexpected(view_error::depth_exceeded);
+         }
+         if (pos >= b.size()) {
+            return std::unexpected(view_error::unexpected_end);
+         }
+         const uint8_t h = uint8_t(b[pos]);
+         const auto at = beve_view{b.substr(pos)};
+         switch (type_of(h)) {
+         case value_type::object: {
+            size_t p = pos + 1;
+            auto count = read_compressed_size(b, p);
+            if (!count) {
+               return std::unexpected(count.error());
+            }
+            for (uint64_t i = 0; i < *count; ++i) {
+               std::string key;
+               if (h == headers::string_object) {
+                  auto n = read_compressed_size(b, p);
+                  if (!n) {
+                     return std::unexpected(n.error());
+                  }
+                  if (*n > b.size() - p) {
+                     return std::unexpected(view_error::size_overflow);
+                  }
+                  key.assign(b.data() + p, size_t(*n));
+                  p += size_t(*n);
+               }
+               else {
+                  const size_t width = byte_count(h);
+                  if (width > 8 || width > b.size() - p) {
+                     return std::unexpected(view_error::unexpected_end);
+                  }
+                  uint64_t raw = 0;
+                  std::memcpy(&raw, b.data() + p, width);
+                  p += width;
+                  const bool is_signed = ((h >> 3) & 0b11) == 1;
+                  if (is_signed && width < 8 && (raw >> (8 * width - 1))) {
+                     raw |= ~uint64_t(0) << (8 * width); // sign extend
+                  }
+                  key = is_signed ? std::to_string(int64_t(raw)) : std::to_string(raw);
+               }
+               auto end = index_value(b, p, child_pointer(pointer, key), min_bytes, index, depth + 1, keys);
+               if (!end) {
+                  return end;
+               }
+               p = *end;
+            }
+            return p;
+         }
+         case value_type::generic_array: {
+            size_t p = pos + 1;
+            auto count = read_compressed_size(b, p);
+            if (!count) {
+               return std::unexpected(count.error());
+            }
+            for (uint64_t i = 0; i < *count; ++i) {
+               auto end =
+                  index_value(b, p, child_pointer(pointer, std::to_string(i)), min_bytes, index, depth + 1, keys);
+               if (!end) {
+                  return end;
+               }
+               p = *end;
+            }
+            return p;
+         }
+         case value_type::typed_array:
+            if (auto data = at.as_typed_array()) {
+               add_entry(b, pointer, *data, min_bytes, index);
+            }
+            return skip_value(b, pos, depth);
+         case value_type::extension:
+            if (h == headers::matrix) {
+               if (auto m = at.as_matrix(); m && m->data.size_bytes() >= min_bytes) {
+                  add_entry(b, pointer, m->data, min_bytes, index);
+                  auto& e = index.entries.back();
+                  e.column_major = m->column_major;
+                  e.extents.assign(m->extents.begin(), m->extents.end());
+               }
+            }
+            else if (h == headers::complex) {
+               if (auto data = at.as_typed_array()) {
+                  add_entry(b, pointer, *data, min_bytes, index);
+               }
+            }
+            else if (h == headers::tag) {
+               // A variant: index the tagged value under the same pointer
+               size_t p = pos + 1;
+               if (auto tag = read_compressed_size(b, p); !tag) {
+                  return std::unexpected(tag.error());
+               }
+               return index_value(b, p, pointer, min_bytes, index, depth + 1, keys);
+            }
+            else if (h == headers::key_table) {
+               // The table covers the value that follows it
+               size_t p = pos;
+               key_table table;
+               if (auto r = read_key_table(b, p, table); !r) {
+                  return std::unexpected(r.error());
+               }
+               return index_value(b, p, pointer, min_bytes, index, depth + 1, &table);
+            }
+            else if (h == headers::keyed_object) {
+               size_t p = pos + 1;
+               auto count = read_compressed_size(b, p);
+               if (!count) {
+                  return std::unexpected(count.error());
+               }
+               for (uint64_t i = 0; i < *count; ++i) {
+                  auto key = read_compressed_size(b, p);
+                  if (!key) {
+                     return std::unexpected(key.error());
+                  }
+                  if (!keys || *key >= keys->size()) {
+                     return std::unexpected(view_error::index_out_of_range);
+                  }
+                  auto end = index_value(b, p, child_pointer(pointer, (*keys)[size_t(*key)]), min_bytes, index,
+                                         depth + 1, keys);
+                  if (!end) {
+                     return end;
+                  }
+                  p = *end;
+               }
+               return p;
+            }
+            return skip_value(b, pos, depth);
+         default:
+            return skip_value(b, pos, depth);
+         }
+      }
+   }
+
+   // Indexes the value that spans `bytes` (typically a mapped file). A truncated value, or bytes
+   // after its end, is an error rather than a partial index.
+   inline std::expected<file_index, view_error> build_index(std::string_view bytes,
+                                                            uint64_t min_bytes = default_index_min_bytes)
+   {
+      file_index index;
+      index.file_size = bytes.size();
+      auto end = detail::index_value(bytes, 0, "", min_bytes, index, 0);
+      if (!end) {
+         return std::unexpected(end.error());
+      }
+      if (*end != bytes.size()) {
+         return std::unexpected(view_error::trailing_bytes);
+      }
+      return index;
+   }
+
+   // Builds the index of `path` and writes it to index_path(path)
+   inline bool write_index(const std::string& path, std::string& error,
+                           uint64_t min_bytes = default_index_min_bytes)
+   {
+      // Only headers are touched, so read-ahead would mostly fetch payload bytes we skip
+      mapped_file file;
+      if (!file.open(path, map_options{.sequential = false, .huge_pages = false})) {
+         error = "failed to open " + path + ": " + file.error();
+         return false;
+      }
+      auto index = build_index(file.view(), min_bytes);
+      if (!index) {
+         error = "failed to index " + path + ": " + std::string(to_string(index.error()));
+         return false;
+      }
+      std::string encoded;
+      if (auto ec = glz::write_beve(*index, encoded)) {
+         error = "failed to encode index: " + glz::format_error(ec);
+         return false;
+      }
+      std::ofstream out(index_path(path), std::ios::binary);
+      if (!out.write(encoded.data(), std::streamsize(encoded.size()))) {
+         error = "failed to write " + index_path(path);
+         return false;
+      }
+      return true;
+   }
+
+   // A data file opened for ranged reads through its sidecar index
+   class indexed_file
+   {
+     public:
+      indexed_file() = default;
+      ~indexed_file() { close(); }
+
+      indexed_file(const indexed_file&) = delete;
+      indexed_file& operator=(const indexed_file&) = delete;
+
+      bool open(const std::string& path)
+      {
+         close();
+         std::string encoded;
+         if (!read_file(index_path(path), encoded)) {
+            return fail("no index at " + index_path(path));
+         }
+         index_ = {};
+         if (auto ec = glz::read_beve(index_, encoded)) {
+            return fail("failed to decode " + index_path(path) + ": " + glz::format_error(ec, encoded));
+         }
+#if BEVE_HAS_MMAP
+         fd_ = ::open(path.c_str(), O_RDONLY);
+         struct stat st{};
+         if (fd_ < 0 || ::fstat(fd_, &st) != 0) {
+            return fail("failed to open " + path + ": " + std::strerror(errno));
+         }
+         const uint64_t size = uint64_t(st.st_size);
+#else
+         stream_.open(path, std::ios::binary | std::ios::ate);
+         if (!stream_) {
+            return fail("failed to open " + path);
+         }
+         const uint64_t size = uint64_t(stream_.tellg());
+#endif
+         if (size != index_.file_size) {
+            return fail("index is stale: " + path + " changed size since it was indexed");
+         }
+         error_.clear();
+         return true;
+      }
+
+      void close() noexcept
+      {
+#if BEVE_HAS_MMAP
+         if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+         }
+#else
+         stream_.close();
+#endif
+      }
+
+      const file_index& index() const noexcept { return index_; }
+
+      // Reads elements [first, first + out.size()) of the array at `pointer` into `out`. Planar
+      // complex arrays (beve_planar.hpp) are read back interleaved.
+      template <class T>
+      bool read_range(std::string_view pointer, uint64_t first, std::span<T> out)
+      {
+         const index_entry* e = index_.find(pointer);
+         if (!e) {
+            return fail("no indexed array at " + std::string(pointer));
+         }
+         const bool planar = planar_matches<T>(e->header, e->complex_header);
+         if ((!planar && !element_matches<T>(e->header, e->complex_header)) || e->element_size != sizeof(T)) {
+            return fail("element type mismatch at " + std::string(pointer));
+         }
+         if (first > e->count || out.size() > e->count - first) {
+            return fail("range exceeds the " + std::to_string(e->count) + " elements at " + std::string(pointer));
+         }
+         if constexpr (detail::planar_complex<T>) {
+            if (planar) {
+               return read_planar_range(*e, first, out);
+            }
+         }
+         return read_at(e->offset + first * sizeof(T), reinterpret_cast<char*>(out.data()), out.size_bytes());
+      }
+
+      template <class T>
+      std::vector<T> read_range(std::string_view pointer, uint64_t first, uint64_t count)
+      {
+         std::vector<T> out(count);
+         if (!read_range(pointer, first, std::span<T>(out))) {
+            out.clear();
+         }
+         return out;
+      }
+
+      const std::string& error() const noexcept { return error_; }
+
+     private:
+      // A planar array holds every real part and then every imaginary part: one read from each
+      // half into scratch, then one interleave pass into `out`
+      template <class T>
+      bool read_planar_range(const index_entry& e, uint64_t first, std::span<T> out)
+      {
+         using U = typename T::value_type;
+         const size_t n = out.size();
+         std::vector<U> parts(2 * n);
+         char* re = reinterpret_cast<char*>(parts.data());
+         char* im = re + n * sizeof(U);
+         if (!read_at(e.offset + first * sizeof(U), re, n * sizeof(U)) ||
+             !read_at(e.offset + (e.count + first) * sizeof(U), im, n * sizeof(U))) {
+            return false;
+         }
+         interleave<U>(re, im, n, reinterpret_cast<char*>(out.data()));
+         return true;
+      }
+
+      bool read_at(uint64_t offset, char* dst, size_t n)
+      {
+#if BEVE_HAS_MMAP
+         // One pread in practice; the loop only covers signals and short reads
+         while (n > 0) {
+            const auto got = ::pread(fd_, dst, n, off_t(offset));
+            if (got < 0 && errno == EINTR) {
+               continue;
+            }
+            if (got <= 0) {
+               return fail(got < 0 ? std::string("pread failed: ") + std::strerror(errno) : "unexpected end of file");
+            }
+            dst += got;
+            n -= size_t(got);
+            offset += uint64_t(got);
+         }
+         return true;
+#else
+         stream_.seekg(std::streamoff(offset));
+         if (!stream_.read(dst, std::streamsize(n))) {
+            stream_.clear();
+            return fail("read failed");
+         }
+         return true;
+#endif
+      }
+
+      bool fail(std::string message)
+      {
+         error_ = std::move(message);
+         return false;
+      }
+
+      file_index index_;
+#if BEVE_HAS_MMAP
+      int fd_ = -1;
+#else
+      std::ifstream stream_;
+#endif
+      std::string error_;
+   };
+}
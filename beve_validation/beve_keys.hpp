@@ -0,0 +1,266 @@
+#pragma once
+
+// Dictionary-encoded object keys: an opt-in BEVE extension for payloads that repeat the same
+// keys, such as arrays of records. The distinct keys are written once, in a key table, and every
+// string-keyed object after it refers to its keys by index:
+//
+//    KEY_TABLE    (0x2e) | count | count x (size | bytes) | value
+//    KEYED_OBJECT (0x36) | count | count x (key index | value)
+//
+// Key indices are compressed sizes, so the first 64 keys cost one byte each. A table covers the
+// value that follows it (one message). On a stream of messages, `encode_keys` with one
+// `key_table` per stream emits the table with the first message and again only when new keys
+// appear, each time in full; `expand_keys` with one `key_table` per stream keeps the last table
+// it read for the messages that carry none.
+//
+// glz::read_beve only reads plain BEVE, so the C++ reader is `expand_keys`, one pass that
+// rewrites keyed objects as string-keyed objects; `encode_keys` is the inverse for bytes written
+// by glz::write_beve. BEVE.jl writes the extension directly with `to_beve(data; dict_keys = true)`
+// and reads it in `from_beve` and `deser_beve`.
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <expected>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "beve_core.hpp"
+
+namespace beve
+{
+   class key_table
+   {
+     public:
+      size_t size() const noexcept { return keys_.size(); }
+      std::string_view operator[](size_t i) const noexcept { return keys_[i]; }
+
+      // Index of `key`, appending it when it is new
+      uint64_t intern(std::string_view key)
+      {
+         if (auto it = index_.find(key); it != index_.end()) {
+            return it->second;
+         }
+         return append(key);
+      }
+
+      // Appends `key` at the next index, even when it is already present (tables are read as is)
+      uint64_t append(std::string_view key)
+      {
+         const uint64_t i = keys_.size();
+         const std::string& stored = keys_.emplace_back(key); // deque: references stay valid
+         index_.emplace(stored, i);
+         return i;
+      }
+
+      void clear() noexcept
+      {
+         keys_.clear();
+         index_.clear();
+         emitted_ = 0;
+      }
+
+      // Number of keys the last emitted table held (encode_keys re-emits once the table grows)
+      size_t emitted() const noexcept { return emitted_; }
+      void set_emitted() noexcept { emitted_ = keys_.size(); }
+
+     private:
+      std::deque<std::string> keys_;
+      std::unordered_map<std::string_view, uint64_t> index_;
+      size_t emitted_ = 0;
+   };
+
+   namespace detail
+   {
+      enum class key_direction : uint8_t { encode, expand };
+
+      // Copies the value at `pos` to `out`, rewriting string-keyed objects as keyed objects
+      // (encode) or keyed objects as string-keyed objects (expand); advances `pos` past it
+      inline std::expected<void, view_error> transcode_keys(std::string_view b, size_t& pos, std::string& out,
+                                                            key_table& table, key_direction direction,
+                                                            size_t depth)
+      {
+         if (depth > max_depth) {
+            return std::unexpected(view_error::depth_exceeded);
+         }
+         if (pos >= b.size()) {
+            return std::unexpected(view_error::unexpected_end);
+         }
+         const uint8_t h = uint8_t(b[pos]);
+         const size_t start = pos;
+         auto copy_rest = [&]() -> std::expected<void, view_error> {
+            auto end = skip_value(b, start, depth);
+            if (!end) {
+               return std::unexpected(end.error());
+            }
+            out.append(b.substr(start, *end - start));
+            pos = *end;
+            return {};
+         };
+
+         const auto kind = header_table[h].kind;
+         const bool rewrite_string_object = direction == key_direction::encode && h == headers::string_object;
+         const bool rewrite_keyed_object = direction == key_direction::expand && h == headers::keyed_object;
+         if (kind == header_kind::key_table || (direction == key_direction::encode && h == headers::keyed_object)) {
+            return std::unexpected(view_error::invalid_header); // tables only at the top of a message
+         }
+         if (kind != header_kind::object && kind != header_kind::generic_array && kind != header_kind::tag &&
+             !rewrite_keyed_object) {
+            return copy_rest();
+         }
+
+         ++pos;
+         if (kind == header_kind::tag) {
+            auto index = read_compressed_size(b, pos);
+            if (!index) {
+               return std::unexpected(index.error());
+            }
+            out.append(b.substr(start, pos - start));
+            return transcode_keys(b, pos, out, table, direction, depth + 1);
+         }
+         auto count = read_compressed_size(b, pos);
+         if (!count) {
+            return std::unexpected(count.error());
+         }
+         out.push_back(char(rewrite_string_object ? headers::keyed_object
+                            : rewrite_keyed_object ? headers::string_object
+                                                   : h));
+         write_compressed_size(out, *count);
+         const size_t key_width = kind == header_kind::object ? header_table[h].width : 0;
+         for (uint64_t i = 0; i < *count; ++i) {
+            if (rewrite_string_object) {
+               auto n = read_compressed_size(b, pos);
+               if (!n) {
+                  return std::unexpected(n.error());
+               }
+               if (*n > b.size() - pos) {
+                  return std::unexpected(view_error::size_overflow);
+               }
+               write_compressed_size(out, table.intern(b.substr(pos, size_t(*n))));
+               pos += size_t(*n);
+            }
+            else if (rewrite_keyed_object) {
+               auto index = read_compressed_size(b, pos);
+               if (!index) {
+                  return std::unexpected(index.error());
+               }
+               if (*index >= table.size()) {
+                  return std::unexpected(view_error::index_out_of_range);
+               }
+               const std::string_view key = table[size_t(*index)];
+               write_compressed_size(out, key.size());
+               out.append(key);
+            }
+            else if (kind == header_kind::object) {
+               // String keys (expanding) and integer keys are copied as they are
+               const size_t key_start = pos;
+               if (key_width == 0) {
+                  if (auto r = skip_string_body(b, pos); !r) {
+                     return std::unexpected(r.error());
+                  }
+               }
+               else if (auto r = advance(b, pos, key_width); !r) {
+                  return std::unexpected(r.error());
+               }
+               out.append(b.substr(key_start, pos - key_start));
+            }
+            if (auto r = transcode_keys(b, pos, out, table, direction, depth + 1); !r) {
+               return r;
+            }
+         }
+         return {};
+      }
+
+      inline void write_key_table(std::string& out, const key_table& table)
+      {
+         out.push_back(char(headers::key_table));
+         write_compressed_size(out, table.size());
+         for (size_t i = 0; i < table.size(); ++i) {
+            write_compressed_size(out, table[i].size());
+            out.append(table[i]);
+         }
+      }
+   }
+
+   // Reads the key table whose header is at `pos` into `table` (replacing its keys) and moves
+   // `pos` to the value the table covers
+   inline std::expected<void, view_error> read_key_table(std::string_view b, size_t& pos, key_table& table)
+   {
+      ++pos;
+      auto count = read_compressed_size(b, pos);
+      if (!count) {
+         return std::unexpected(count.error());
+      }
+      if (*count > b.size() - pos) { // every key takes at least its size byte
+         return std::unexpected(view_error::size_overflow);
+      }
+      table.clear();
+      for (uint64_t i = 0; i < *count; ++i) {
+         auto n = read_compressed_size(b, pos);
+         if (!n) {
+            return std::unexpected(n.error());
+         }
+         if (*n > b.size() - pos) {
+            return std::unexpected(view_error::size_overflow);
+         }
+         table.append(b.substr(pos, size_t(*n)));
+         pos += size_t(*n);
+      }
+      return {};
+   }
+
+   // Appends `plain` (one BEVE value, e.g. from glz::write_beve) to `out` with its string-keyed
+   // objects dictionary encoded. New keys are added to `table`; the table is written ahead of the
+   // value unless every key was already in the last table written from `table`.
+   inline std::expected<void, view_error> encode_keys(std::string_view plain, std::string& out, key_table& table)
+   {
+      std::string body;
+      body.reserve(plain.size());
+      size_t pos = 0;
+      if (auto r = detail::transcode_keys(plain, pos, body, table, detail::key_direction::encode, 0); !r) {
+         return r;
+      }
+      if (table.emitted() != table.size() || table.size() == 0) {
+         detail::write_key_table(out, table);
+         table.set_emitted();
+      }
+      out.append(body);
+      return {};
+   }
+
+   inline std::expected<std::string, view_error> encode_keys(std::string_view plain)
+   {
+      key_table table;
+      std::string out;
+      if (auto r = encode_keys(plain, out, table); !r) {
+         return std::unexpected(r.error());
+      }
+      return out;
+   }
+
+   // Appends `keyed` (a message from encode_keys or BEVE.jl's `dict_keys = true`) to `out` as plain
+   // BEVE for glz::read_beve. A leading key table replaces `table`; without one the message uses
+   // the table read last. Values without keyed objects are copied through unchanged.
+   inline std::expected<void, view_error> expand_keys(std::string_view keyed, std::string& out, key_table& table)
+   {
+      size_t pos = 0;
+      if (!keyed.empty() && uint8_t(keyed[0]) == headers::key_table) {
+         if (auto r = read_key_table(keyed, pos, table); !r) {
+            return r;
+         }
+      }
+      out.reserve(out.size() + keyed.size());
+      return detail::transcode_keys(keyed, pos, out, table, detail::key_direction::expand, 0);
+   }
+
+   inline std::expected<std::string, view_error> expand_keys(std::string_view keyed)
+   {
+      key_table table;
+      std::string out;
+      if (auto r = expand_keys(keyed, out, table); !r) {
+         return std::unexpected(r.error());
+      }
+      return out;
+   }
+}
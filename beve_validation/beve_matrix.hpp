@@ -0,0 +1,187 @@
+#pragma once
+
+// Eigen matrices from BEVE matrix extensions in a single pass.
+//
+// `inspect_matrix` reads the MATRIX header, layout byte, extents and element header once and
+// checks that the extents account for every element. `visit_matrix` then dispatches on the
+// element header to a callback templated on the scalar type, so a file of unknown element type
+// costs one decode rather than one attempted decode per candidate type. The payload is either
+// copied into an owned Eigen::Matrix (`decode_matrix`) or, when its address happens to be
+// aligned for the scalar, viewed in place through an Eigen::Map (`map_matrix`). BEVE does not pad
+// payloads, so whether a map is possible depends on where the writer placed the data; callers
+// fall back to `decode_matrix` on view_error::misaligned. Planar complex data (beve_planar.hpp)
+// has no interleaved elements to view, so it is only decoded, and mapping it fails with
+// view_error::planar_layout.
+
+#include <Eigen/Core>
+
+#include <complex>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "beve_core.hpp"
+#include "beve_planar.hpp"
+#include "beve_view.hpp"
+
+namespace beve
+{
+   template <class Scalar, int Layout = Eigen::RowMajor>
+   using dense_matrix = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic, Layout>;
+
+   template <class Scalar, int Layout = Eigen::RowMajor>
+   using matrix_map = Eigen::Map<const dense_matrix<Scalar, Layout>>;
+
+   // A two dimensional BEVE matrix, located but not decoded
+   struct matrix_info
+   {
+      bool column_major{};
+      Eigen::Index rows{};
+      Eigen::Index cols{};
+      typed_array_view data;
+   };
+
+   // Whether the matrix payload holds exactly `Scalar` elements; complex payloads may be
+   // interleaved or planar
+   template <class Scalar>
+   inline bool holds(const matrix_info& m) noexcept
+   {
+      return element_matches<Scalar>(m.data.header, m.data.complex_header) ||
+             planar_matches<Scalar>(m.data.header, m.data.complex_header);
+   }
+
+   inline std::expected<matrix_info, view_error> inspect_matrix(std::string_view bytes)
+   {
+      auto m = beve_view{bytes}.as_matrix();
+      if (!m) {
+         return std::unexpected(m.error());
+      }
+      if (m->extents.size() != 2) {
+         return std::unexpected(view_error::type_mismatch);
+      }
+      const uint64_t rows = m->extents[0];
+      const uint64_t cols = m->extents[1];
+      // The element count is bounded by the buffer, so a matching product cannot have overflowed
+      if ((rows != 0 && cols > m->data.count / rows) || rows * cols != m->data.count) {
+         return std::unexpected(view_error::extent_mismatch);
+      }
+      matrix_info out;
+      out.column_major = m->column_major;
+      out.rows = Eigen::Index(rows);
+      out.cols = Eigen::Index(cols);
+      out.data = m->data;
+      return out;
+   }
+
+   // Calls `f(std::type_identity<Scalar>{})` for the element type of `m`. Returns false (without
+   // calling `f`) for element types with no C++ scalar here: bool, f16, bf16 and integer complex.
+   // Planar complex data is visited as std::complex like interleaved data; `decode_matrix`
+   // interleaves it, and `map_matrix` refuses it.
+   template <class F>
+   bool visit_matrix(const matrix_info& m, F&& f)
+   {
+      switch (m.data.header) {
+      case headers::f32_array: f(std::type_identity<float>{}); return true;
+      case headers::f64_array: f(std::type_identity<double>{}); return true;
+      case headers::i8_array: f(std::type_identity<int8_t>{}); return true;
+      case headers::i16_array: f(std::type_identity<int16_t>{}); return true;
+      case headers::i32_array: f(std::type_identity<int32_t>{}); return true;
+      case headers::i64_array: f(std::type_identity<int64_t>{}); return true;
+      case headers::u8_array: f(std::type_identity<uint8_t>{}); return true;
+      case headers::u16_array: f(std::type_identity<uint16_t>{}); return true;
+      case headers::u32_array: f(std::type_identity<uint32_t>{}); return true;
+      case headers::u64_array: f(std::type_identity<uint64_t>{}); return true;
+      case headers::complex:
+         if (holds<std::complex<float>>(m)) {
+            f(std::type_identity<std::complex<float>>{});
+            return true;
+         }
+         if (holds<std::complex<double>>(m)) {
+            f(std::type_identity<std::complex<double>>{});
+            return true;
+         }
+         return false;
+      default:
+         return false;
+      }
+   }
+
+   namespace detail
+   {
+      // Copies the payload in storage order, interleaving planar complex data
+      template <class Scalar>
+      void copy_matrix_payload(const matrix_info& m, Scalar* dst) noexcept
+      {
+         if constexpr (detail::planar_complex<Scalar>) {
+            if (m.data.planar()) {
+               const size_t half = m.data.size_bytes() / 2;
+               interleave<typename Scalar::value_type>(m.data.data, m.data.data + half, m.data.count,
+                                                       reinterpret_cast<char*>(dst));
+               return;
+            }
+         }
+         std::memcpy(dst, m.data.data, m.data.size_bytes());
+      }
+   }
+
+   // Copies the payload into `out`, transposing the storage order if the layouts differ
+   template <class Scalar, int Layout>
+   std::expected<void, view_error> decode_matrix(const matrix_info& m, dense_matrix<Scalar, Layout>& out)
+   {
+      if (!holds<Scalar>(m)) {
+         return std::unexpected(view_error::type_mismatch);
+      }
+      constexpr bool out_column_major = (Layout & Eigen::RowMajorBit) == 0;
+      if (out_column_major == m.column_major) {
+         out.resize(m.rows, m.cols);
+         detail::copy_matrix_payload(m, out.data());
+      }
+      else {
+         constexpr int source_layout = out_column_major ? Eigen::RowMajor : Eigen::ColMajor;
+         dense_matrix<Scalar, source_layout> staged(m.rows, m.cols);
+         detail::copy_matrix_payload(m, staged.data());
+         out = staged;
+      }
+      return {};
+   }
+
+   // Views the payload in place. The returned map aliases the buffer that was inspected.
+   template <class Scalar, int Layout = Eigen::RowMajor>
+   std::expected<matrix_map<Scalar, Layout>, view_error> map_matrix(const matrix_info& m) noexcept
+   {
+      if (!holds<Scalar>(m) || ((Layout & Eigen::RowMajorBit) == 0) != m.column_major) {
+         return std::unexpected(view_error::type_mismatch);
+      }
+      if (m.data.planar()) {
+         return std::unexpected(view_error::planar_layout);
+      }
+      if (reinterpret_cast<uintptr_t>(m.data.data) % alignof(Scalar) != 0) {
+         return std::unexpected(view_error::misaligned);
+      }
+      return matrix_map<Scalar, Layout>(reinterpret_cast<const Scalar*>(m.data.data), m.rows, m.cols);
+   }
+
+   // Appends `m` as a BEVE matrix. Extents are written as an i64 typed array, as Glaze and BEVE.jl do.
+   template <class Scalar, int Layout>
+   void write_matrix(const dense_matrix<Scalar, Layout>& m, std::string& out)
+   {
+      out.push_back(char(headers::matrix));
+      out.push_back(char((Layout & Eigen::RowMajorBit) ? 0 : 1));
+      out.push_back(char(headers::i64_array));
+      write_compressed_size(out, 2);
+      const int64_t extents[2] = {int64_t(m.rows()), int64_t(m.cols())};
+      out.append(reinterpret_cast<const char*>(extents), sizeof(extents));
+      if constexpr (is_complex<Scalar>::value) {
+         out.push_back(char(headers::complex));
+         out.push_back(char(complex_array_header<typename Scalar::value_type>()));
+      }
+      else {
+         out.push_back(char(typed_array_header<Scalar>()));
+      }
+      write_compressed_size(out, uint64_t(m.size()));
+      out.append(reinterpret_cast<const char*>(m.data()), size_t(m.size()) * sizeof(Scalar));
+   }
+}
@@ -0,0 +1,330 @@
+#pragma once
+
+// Zero-copy file access for BEVE payloads.
+//
+// `mapped_file` maps a file read-only so that `glz::read_beve` can decode straight
+// from the page cache instead of first copying every byte into a std::string.
+// On platforms without mmap it falls back to a single bulk read into an owned buffer.
+// `mapped_output` is the write-side counterpart for output whose size is known up front.
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define BEVE_HAS_MMAP 1
+#else
+#define BEVE_HAS_MMAP 0
+#endif
+
+namespace beve
+{
+   struct map_options
+   {
+      bool sequential = true; // MADV_SEQUENTIAL: aggressive read-ahead, early page reclaim
+      bool huge_pages = true; // MADV_HUGEPAGE: honored where the kernel supports file THP
+      bool populate = false; // MAP_POPULATE: pre-fault the whole file up front (Linux only)
+   };
+
+   class mapped_file
+   {
+     public:
+      mapped_file() = default;
+      explicit mapped_file(const std::string& path, map_options options = {}) { open(path, options); }
+      ~mapped_file() { close(); }
+
+      mapped_file(const mapped_file&) = delete;
+      mapped_file& operator=(const mapped_file&) = delete;
+
+      mapped_file(mapped_file&& other) noexcept { swap(other); }
+      mapped_file& operator=(mapped_file&& other) noexcept
+      {
+         if (this != &other) {
+            close();
+            swap(other);
+         }
+         return *this;
+      }
+
+      bool open(const std::string& path, map_options options = {})
+      {
+         close();
+#if BEVE_HAS_MMAP
+         const int fd = ::open(path.c_str(), O_RDONLY);
+         if (fd < 0) {
+            error_ = std::strerror(errno);
+            return false;
+         }
+
+         struct stat st{};
+         if (::fstat(fd, &st) != 0) {
+            error_ = std::strerror(errno);
+            ::close(fd);
+            return false;
+         }
+
+         size_ = static_cast<size_t>(st.st_size);
+         if (size_ == 0) {
+            // mmap rejects zero-length mappings; an empty file is still a valid (empty) view
+            ::close(fd);
+            open_ = true;
+            return true;
+         }
+
+         int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+         if (options.populate) {
+            flags |= MAP_POPULATE;
+         }
+#endif
+         void* addr = ::mmap(nullptr, size_, PROT_READ, flags, fd, 0);
+         ::close(fd); // the mapping keeps its own reference to the file
+         if (addr == MAP_FAILED) {
+            error_ = std::strerror(errno);
+            size_ = 0;
+            return false;
+         }
+
+         // Advice is best effort; failures only cost performance
+         if (options.sequential) {
+            ::madvise(addr, size_, MADV_SEQUENTIAL);
+         }
+#ifdef MADV_HUGEPAGE
+         if (options.huge_pages) {
+            ::madvise(addr, size_, MADV_HUGEPAGE);
+         }
+#endif
+         data_ = static_cast<const char*>(addr);
+         open_ = true;
+         return true;
+#else
+         (void)options;
+         std::ifstream file(path, std::ios::binary | std::ios::ate);
+         if (!file) {
+            error_ = "failed to open file";
+            return false;
+         }
+         owned_.resize(static_cast<size_t>(file.tellg()));
+         file.seekg(0);
+         file.read(owned_.data(), static_cast<std::streamsize>(owned_.size()));
+         if (!file) {
+            error_ = "failed to read file";
+            owned_.clear();
+            return false;
+         }
+         data_ = owned_.data();
+         size_ = owned_.size();
+         open_ = true;
+         return true;
+#endif
+      }
+
+      void close() noexcept
+      {
+#if BEVE_HAS_MMAP
+         if (data_ && size_ > 0) {
+            ::munmap(const_cast<char*>(data_), size_);
+         }
+#else
+         owned_.clear();
+         owned_.shrink_to_fit();
+#endif
+         data_ = nullptr;
+         size_ = 0;
+         open_ = false;
+      }
+
+      bool is_open() const noexcept { return open_; }
+      const char* data() const noexcept { return data_; }
+      size_t size() const noexcept { return size_; }
+      std::string_view view() const noexcept { return {data_, size_}; }
+      std::span<const std::byte> bytes() const noexcept
+      {
+         return {reinterpret_cast<const std::byte*>(data_), size_};
+      }
+      const std::string& error() const noexcept { return error_; }
+
+      void swap(mapped_file& other) noexcept
+      {
+         std::swap(data_, other.data_);
+         std::swap(size_, other.size_);
+         std::swap(open_, other.open_);
+         std::swap(error_, other.error_);
+#if !BEVE_HAS_MMAP
+         std::swap(owned_, other.owned_);
+#endif
+      }
+
+     private:
+      const char* data_ = nullptr;
+      size_t size_ = 0;
+      bool open_ = false;
+      std::string error_;
+#if !BEVE_HAS_MMAP
+      std::string owned_;
+#endif
+   };
+
+   // A file created at its final size and mapped writable, so that a writer which knows the
+   // encoded size up front (see beve_size.hpp) can encode straight into the page cache. Space is
+   // reserved before mapping where the filesystem supports it, so running out of disk fails in
+   // create() rather than as a fault while writing. Without mmap the region is an owned buffer
+   // that close() writes out.
+   class mapped_output
+   {
+     public:
+      mapped_output() = default;
+      ~mapped_output() { close(); }
+
+      mapped_output(const mapped_output&) = delete;
+      mapped_output& operator=(const mapped_output&) = delete;
+
+      bool create(const std::string& path, size_t size)
+      {
+         close();
+#if BEVE_HAS_MMAP
+         fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+         if (fd_ < 0) {
+            error_ = std::strerror(errno);
+            return false;
+         }
+         if (::ftruncate(fd_, static_cast<off_t>(size)) != 0) {
+            return fail();
+         }
+#ifdef __linux__
+         if (size > 0) {
+            // Returns the error instead of setting errno; filesystems without it are fine
+            const int r = ::posix_fallocate(fd_, 0, static_cast<off_t>(size));
+            if (r != 0 && r != EINVAL && r != EOPNOTSUPP) {
+               errno = r;
+               return fail();
+            }
+         }
+#endif
+         size_ = size;
+         if (size_ > 0) {
+            void* addr = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+            if (addr == MAP_FAILED) {
+               size_ = 0;
+               return fail();
+            }
+            ::madvise(addr, size_, MADV_SEQUENTIAL);
+            data_ = static_cast<char*>(addr);
+         }
+         return true;
+#else
+         path_ = path;
+         owned_.resize(size);
+         data_ = owned_.data();
+         size_ = size;
+         return true;
+#endif
+      }
+
+      char* data() noexcept { return data_; }
+      size_t size() const noexcept { return size_; }
+      const std::string& error() const noexcept { return error_; }
+
+      // Unmaps and closes the file (the kernel writes the dirty pages back); false on failure
+      bool close() noexcept
+      {
+         bool ok = true;
+#if BEVE_HAS_MMAP
+         if (data_ && ::munmap(data_, size_) != 0) {
+            error_ = std::strerror(errno);
+            ok = false;
+         }
+         if (fd_ >= 0 && ::close(fd_) != 0) {
+            error_ = std::strerror(errno);
+            ok = false;
+         }
+         fd_ = -1;
+#else
+         if (!path_.empty()) {
+            std::ofstream file(path_, std::ios::binary | std::ios::trunc);
+            file.write(owned_.data(), static_cast<std::streamsize>(owned_.size()));
+            if (!file) {
+               error_ = "failed to write file";
+               ok = false;
+            }
+         }
+         path_.clear();
+         owned_.clear();
+         owned_.shrink_to_fit();
+#endif
+         data_ = nullptr;
+         size_ = 0;
+         return ok;
+      }
+
+     private:
+#if BEVE_HAS_MMAP
+      bool fail() noexcept
+      {
+         error_ = std::strerror(errno);
+         ::close(fd_);
+         fd_ = -1;
+         return false;
+      }
+
+      int fd_ = -1;
+#else
+      std::string path_;
+      std::string owned_;
+#endif
+      char* data_ = nullptr;
+      size_t size_ = 0;
+      std::string error_;
+   };
+
+   // Reads the whole file into `out` with one sized allocation and bulk read() calls.
+   // This is the copy-based alternative to `mapped_file` when the bytes must outlive the file.
+   inline bool read_file(const std::string& path, std::string& out)
+   {
+#if BEVE_HAS_MMAP
+      const int fd = ::open(path.c_str(), O_RDONLY);
+      if (fd < 0) {
+         return false;
+      }
+      struct stat st{};
+      if (::fstat(fd, &st) != 0) {
+         ::close(fd);
+         return false;
+      }
+      out.resize(static_cast<size_t>(st.st_size));
+      size_t offset = 0;
+      while (offset < out.size()) {
+         const auto n = ::read(fd, out.data() + offset, out.size() - offset);
+         if (n < 0 && errno == EINTR) {
+            continue;
+         }
+         if (n <= 0) {
+            ::close(fd);
+            out.resize(offset);
+            return false;
+         }
+         offset += static_cast<size_t>(n);
+      }
+      ::close(fd);
+      return true;
+#else
+      std::ifstream file(path, std::ios::binary | std::ios::ate);
+      if (!file) {
+         return false;
+      }
+      out.resize(static_cast<size_t>(file.tellg()));
+      file.seekg(0);
+      file.read(out.data(), static_cast<std::streamsize>(out.size()));
+      return static_cast<bool>(file);
+#endif
+   }
+}
@@ -0,0 +1,306 @@
+#pragma once
+
+// Packed numeric arrays: a lossless, block-compressed alternative to a typed array for time
+// series, carried as a BEVE extension (header 0x26, the next free extension subtype after
+// complex numbers). BEVE.jl reads them transparently and writes them with
+// `to_beve(data; pack_arrays = true)`.
+//
+//    PACKED_ARRAY | codec | element header | count | payload bytes | payload
+//
+// `element header` is the typed array header the values would otherwise be written with
+// (f32_array, i64_array, ...), `count` the number of values and `payload bytes` the payload
+// length, both compressed sizes, so walkers skip a packed array in O(1). The payload is a
+// sequence of blocks of `pack_block` values (the last one may be shorter):
+//
+//    width (1 byte) | first value (raw, little endian) | (n - 1) residuals of `width` bits
+//
+// Residuals are packed LSB first and the block is padded to a whole byte. Each value's bit
+// pattern is compared with the previous one's: `xor_previous` stores their XOR (Gorilla-style,
+// for floats), `delta` the zigzagged wrapping difference (for integers, or for monotonic float
+// series, whose bit patterns increase by small steps). Every block restarts from its own first
+// value and uses one width, so blocks decode independently and the unpacking loop has no
+// data-dependent branches.
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "beve_core.hpp"
+
+namespace beve
+{
+   enum class pack_codec : uint8_t { xor_previous = 0, delta = 1 };
+
+   inline constexpr size_t pack_block = 128;
+
+   template <class T>
+   inline constexpr pack_codec default_pack_codec = std::is_floating_point_v<T> ? pack_codec::xor_previous
+                                                                                : pack_codec::delta;
+
+   struct packed_array_view
+   {
+      pack_codec codec{};
+      uint8_t element_header{};
+      size_t count{};
+      std::string_view payload;
+   };
+
+   namespace detail
+   {
+      template <class T>
+      using pack_bits_t = std::conditional_t<
+         sizeof(T) == 1, uint8_t,
+         std::conditional_t<sizeof(T) == 2, uint16_t, std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>>;
+
+      template <class U>
+      inline U pack_residual(U value, U previous, pack_codec codec) noexcept
+      {
+         if (codec == pack_codec::xor_previous) {
+            return U(value ^ previous);
+         }
+         using S = std::make_signed_t<U>;
+         const U d = U(value - previous);
+         return U(U(d << 1) ^ U(S(d) >> (8 * sizeof(U) - 1)));
+      }
+
+      // Bytes used by `n` values of `width` bits after the first value of a block
+      inline constexpr size_t packed_block_bits_bytes(size_t n, unsigned width) noexcept
+      {
+         return (n > 1 ? (n - 1) * width + 7 : 0) / 8;
+      }
+
+      // Residuals of one block; bits of the OR of all residuals give the block width
+      template <class U>
+      inline unsigned block_residuals(const U* bits, size_t n, pack_codec codec, uint64_t* residuals) noexcept
+      {
+         uint64_t any = 0;
+         for (size_t i = 1; i < n; ++i) {
+            residuals[i] = pack_residual<U>(bits[i], bits[i - 1], codec);
+            any |= residuals[i];
+         }
+         return unsigned(std::bit_width(any));
+      }
+
+      inline uint64_t load_le64(const unsigned char* p) noexcept
+      {
+         uint64_t word;
+         std::memcpy(&word, p, 8);
+         if constexpr (std::endian::native == std::endian::big) {
+            word = std::byteswap(word);
+         }
+         return word;
+      }
+
+      inline void store_le64(unsigned char* p, uint64_t word) noexcept
+      {
+         if constexpr (std::endian::native == std::endian::big) {
+            word = std::byteswap(word);
+         }
+         std::memcpy(p, &word, 8);
+      }
+
+      // Room for a full block of 64-bit residuals plus the 8 bytes a word load or store may
+      // reach past the last one
+      inline constexpr size_t pack_scratch_bytes = (pack_block - 1) * 8 + 16;
+
+      inline void pack_bits(const uint64_t* residuals, size_t n, unsigned width, unsigned char* out) noexcept
+      {
+         std::memset(out, 0, packed_block_bits_bytes(n, width) + 16);
+         for (size_t i = 1; i < n; ++i) {
+            const size_t bit = (i - 1) * width;
+            unsigned char* p = out + bit / 8;
+            const unsigned shift = unsigned(bit % 8);
+            store_le64(p, load_le64(p) | (residuals[i] << shift));
+            if (shift + width > 64) {
+               store_le64(p + 8, load_le64(p + 8) | (residuals[i] >> (64 - shift)));
+            }
+         }
+      }
+
+      // The inverse of pack_bits. Widths up to 57 bits always sit inside one unaligned word,
+      // so the common case is a load, a shift and a mask per value.
+      inline void unpack_bits(const unsigned char* in, size_t n, unsigned width, uint64_t* residuals) noexcept
+      {
+         const uint64_t mask = width == 64 ? ~uint64_t(0) : (uint64_t(1) << width) - 1;
+         if (width <= 57) {
+            for (size_t i = 1; i < n; ++i) {
+               const size_t bit = (i - 1) * width;
+               residuals[i] = (load_le64(in + bit / 8) >> (bit % 8)) & mask;
+            }
+            return;
+         }
+         for (size_t i = 1; i < n; ++i) {
+            const size_t bit = (i - 1) * width;
+            const unsigned shift = unsigned(bit % 8);
+            uint64_t v = load_le64(in + bit / 8) >> shift;
+            if (shift + width > 64) {
+               v |= load_le64(in + bit / 8 + 8) << (64 - shift);
+            }
+            residuals[i] = v & mask;
+         }
+      }
+
+      template <class U>
+      inline void unpack_residuals(const uint64_t* residuals, size_t n, pack_codec codec, U* bits) noexcept
+      {
+         if (codec == pack_codec::xor_previous) {
+            for (size_t i = 1; i < n; ++i) {
+               bits[i] = U(bits[i - 1] ^ U(residuals[i]));
+            }
+         }
+         else {
+            for (size_t i = 1; i < n; ++i) {
+               const U z = U(residuals[i]);
+               bits[i] = U(bits[i - 1] + U(U(z >> 1) ^ U(U(0) - U(z & 1))));
+            }
+         }
+      }
+   }
+
+   // Appends `values` to `out` as a packed array
+   template <class T>
+   void write_packed_array(std::string& out, std::span<const T> values, pack_codec codec = default_pack_codec<T>)
+   {
+      static_assert(std::endian::native == std::endian::little, "packed arrays assume a little-endian host");
+      using U = detail::pack_bits_t<T>;
+      const size_t blocks = (values.size() + pack_block - 1) / pack_block;
+      U block[pack_block];
+      uint64_t residuals[pack_block];
+
+      // Widths first, so the payload length can precede the payload
+      std::vector<uint8_t> widths(blocks);
+      size_t payload = 0;
+      for (size_t b = 0; b < blocks; ++b) {
+         const size_t n = std::min(pack_block, values.size() - b * pack_block);
+         std::memcpy(block, values.data() + b * pack_block, n * sizeof(T));
+         widths[b] = uint8_t(detail::block_residuals(block, n, codec, residuals));
+         payload += 1 + sizeof(T) + detail::packed_block_bits_bytes(n, widths[b]);
+      }
+
+      out.push_back(char(headers::packed_array));
+      out.push_back(char(codec));
+      out.push_back(char(typed_array_header<T>()));
+      write_compressed_size(out, values.size());
+      write_compressed_size(out, payload);
+
+      size_t at = out.size();
+      out.resize(at + payload);
+      unsigned char scratch[detail::pack_scratch_bytes];
+      for (size_t b = 0; b < blocks; ++b) {
+         const size_t n = std::min(pack_block, values.size() - b * pack_block);
+         std::memcpy(block, values.data() + b * pack_block, n * sizeof(T));
+         detail::block_residuals(block, n, codec, residuals);
+         out[at++] = char(widths[b]);
+         std::memcpy(out.data() + at, block, sizeof(T));
+         at += sizeof(T);
+         detail::pack_bits(residuals, n, widths[b], scratch);
+         const size_t used = detail::packed_block_bits_bytes(n, widths[b]);
+         std::memcpy(out.data() + at, scratch, used);
+         at += used;
+      }
+   }
+
+   // Reads the header of the packed array at the start of `bytes`
+   inline std::expected<packed_array_view, view_error> as_packed_array(std::string_view bytes) noexcept
+   {
+      if (bytes.size() < 3 || uint8_t(bytes[0]) != headers::packed_array) {
+         return std::unexpected(bytes.empty() ? view_error::unexpected_end : view_error::type_mismatch);
+      }
+      packed_array_view out;
+      const uint8_t codec = uint8_t(bytes[1]);
+      out.element_header = uint8_t(bytes[2]);
+      if (codec > uint8_t(pack_codec::delta) || type_of(out.element_header) != value_type::typed_array ||
+          ((out.element_header >> 3) & 0b11) == 3 || byte_count(out.element_header) > 8) {
+         return std::unexpected(view_error::invalid_header);
+      }
+      out.codec = pack_codec(codec);
+      size_t pos = 3;
+      auto count = read_compressed_size(bytes, pos);
+      if (!count) {
+         return std::unexpected(count.error());
+      }
+      auto length = read_compressed_size(bytes, pos);
+      if (!length) {
+         return std::unexpected(length.error());
+      }
+      if (*length > bytes.size() - pos) {
+         return std::unexpected(view_error::size_overflow);
+      }
+      out.count = size_t(*count);
+      out.payload = bytes.substr(pos, size_t(*length));
+      return out;
+   }
+
+   // Decodes a packed array of T into `out` (resized to match). Blocks are checked against the
+   // payload before they are read, so a truncated or corrupt payload is an error, not an overrun.
+   template <class T>
+   std::expected<void, view_error> read_packed_array(const packed_array_view& array, std::vector<T>& out)
+   {
+      static_assert(std::endian::native == std::endian::little, "packed arrays assume a little-endian host");
+      using U = detail::pack_bits_t<T>;
+      if (array.element_header != typed_array_header<T>()) {
+         return std::unexpected(view_error::type_mismatch);
+      }
+      // Every block takes at least 1 + sizeof(T) bytes, which bounds `count` before allocating
+      const size_t blocks = (array.count + pack_block - 1) / pack_block;
+      if (blocks > array.payload.size() / (1 + sizeof(T))) {
+         return std::unexpected(view_error::size_overflow);
+      }
+      out.resize(array.count);
+      const auto* in = reinterpret_cast<const unsigned char*>(array.payload.data());
+      const size_t size = array.payload.size();
+      U block[pack_block];
+      uint64_t residuals[pack_block];
+      unsigned char scratch[detail::pack_scratch_bytes];
+      size_t pos = 0;
+      for (size_t b = 0; b < blocks; ++b) {
+         const size_t n = std::min(pack_block, array.count - b * pack_block);
+         if (size - pos < 1 + sizeof(T)) {
+            return std::unexpected(view_error::unexpected_end);
+         }
+         const unsigned width = in[pos++];
+         if (width > 8 * sizeof(T)) {
+            return std::unexpected(view_error::invalid_header);
+         }
+         std::memcpy(block, in + pos, sizeof(T));
+         pos += sizeof(T);
+         const size_t used = detail::packed_block_bits_bytes(n, width);
+         if (size - pos < used) {
+            return std::unexpected(view_error::unexpected_end);
+         }
+         // Unpack from a padded copy near the end of the payload, so word loads stay in bounds
+         const unsigned char* packed = in + pos;
+         if (size - pos < used + 16) {
+            std::memcpy(scratch, packed, used);
+            std::memset(scratch + used, 0, 16);
+            packed = scratch;
+         }
+         detail::unpack_bits(packed, n, width, residuals);
+         detail::unpack_residuals<U>(residuals, n, array.codec, block);
+         std::memcpy(out.data() + b * pack_block, block, n * sizeof(T));
+         pos += used;
+      }
+      if (pos != size) {
+         return std::unexpected(view_error::size_overflow);
+      }
+      return {};
+   }
+
+   template <class T>
+   std::expected<void, view_error> read_packed_array(std::string_view bytes, std::vector<T>& out)
+   {
+      auto array = as_packed_array(bytes);
+      if (!array) {
+         return std::unexpected(array.error());
+      }
+      return read_packed_array(*array, out);
+   }
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+// Two-stage parallel decoding of large arrays of objects.
+//
+// The extent of a BEVE value is only known once it has been walked, so a generic array of
+// objects decodes strictly in order. Walking is far cheaper than decoding, though: it touches
+// headers and sizes only and skips strings and typed array payloads in O(1). Stage 1
+// (`scan_array`) walks the array once and records where every element starts, in the spirit of
+// simdjson's structural index. Stage 2 (`read_array_parallel`) cuts that tape into ranges of
+// roughly equal byte size and decodes them concurrently on a thread pool, each element straight
+// from its own slice of the input into its slot of the output vector. Nothing is copied or
+// re-encoded between the stages.
+//
+//    beve::thread_pool pool;
+//    std::vector<Record> records;
+//    std::string error;
+//    if (!beve::read_array_parallel(records, bytes, pool, error)) { ... }
+
+#include <glaze/glaze.hpp>
+#include <glaze/beve.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <expected>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "beve_core.hpp"
+#include "beve_thread_pool.hpp"
+
+namespace beve
+{
+   // Element boundaries of one generic array: element i spans [bounds[i], bounds[i + 1])
+   struct array_tape
+   {
+      std::string_view bytes;
+      std::vector<size_t> bounds;
+
+      size_t size() const noexcept { return bounds.empty() ? 0 : bounds.size() - 1; }
+
+      std::string_view element(size_t i) const noexcept
+      {
+         return bytes.substr(bounds[i], bounds[i + 1] - bounds[i]);
+      }
+   };
+
+   // Stage 1: records the element boundaries of the generic array at the start of `bytes`
+   inline std::expected<array_tape, view_error> scan_array(std::string_view bytes)
+   {
+      if (bytes.empty()) {
+         return std::unexpected(view_error::unexpected_end);
+      }
+      if (type_of(uint8_t(bytes[0])) != value_type::generic_array) {
+         return std::unexpected(view_error::type_mismatch);
+      }
+      size_t pos = 1;
+      auto count = read_compressed_size(bytes, pos);
+      if (!count) {
+         return std::unexpected(count.error());
+      }
+      // Every element is at least one byte, which bounds the reservation by the input size
+      if (*count > bytes.size() - pos) {
+         return std::unexpected(view_error::size_overflow);
+      }
+      array_tape tape;
+      tape.bytes = bytes;
+      tape.bounds.resize(size_t(*count) + 1);
+      for (size_t i = 0; i < *count; ++i) {
+         tape.bounds[i] = pos;
+         auto end = skip_value(bytes, pos, 1);
+         if (!end) {
+            return std::unexpected(end.error());
+         }
+         pos = *end;
+      }
+      tape.bounds.back() = pos;
+      return tape;
+   }
+
+   struct parallel_read_options
+   {
+      size_t chunks_per_thread = 4; // more, smaller ranges let fast threads absorb uneven elements
+      size_t min_chunk_bytes = size_t(64) << 10; // below this a range is not worth a task
+   };
+
+   // Stage 2: decodes the elements of `tape` into `out` (resized to match) on `pool`
+   template <class T>
+   bool read_array_parallel(std::vector<T>& out, const array_tape& tape, thread_pool& pool, std::string& error,
+                            const parallel_read_options& options = {})
+   {
+      const size_t n = tape.size();
+      out.resize(n);
+      if (n == 0) {
+         return true;
+      }
+
+      // Cut at element boundaries so that each range holds about the same number of bytes
+      const size_t total = tape.bounds[n] - tape.bounds[0];
+      const size_t chunks = std::max<size_t>(1, pool.size() * options.chunks_per_thread);
+      const size_t target = std::max(options.min_chunk_bytes, (total + chunks - 1) / chunks);
+
+      std::atomic<size_t> failed_at{n};
+      auto decode_range = [&](size_t first, size_t last) {
+         for (size_t i = first; i < last; ++i) {
+            if (auto ec = glz::read_beve(out[i], tape.element(i))) {
+               size_t expected = n;
+               while (i < expected && !failed_at.compare_exchange_weak(expected, i)) {
+               }
+               return;
+            }
+         }
+      };
+
+      size_t first = 0;
+      while (first < n) {
+         const size_t* limit = std::upper_bound(tape.bounds.data() + first + 1, tape.bounds.data() + n,
+                                                tape.bounds[first] + target - 1);
+         const size_t last = size_t(limit - tape.bounds.data());
+         pool.submit([&decode_range, first, last] { decode_range(first, last); });
+         first = last;
+      }
+      pool.wait();
+
+      if (const size_t i = failed_at.load(); i < n) {
+         T probe{};
+         auto ec = glz::read_beve(probe, tape.element(i));
+         error = "element " + std::to_string(i) + ": " + glz::format_error(ec, tape.element(i));
+         return false;
+      }
+      return true;
+   }
+
+   // Both stages: the array at the start of `bytes` into `out`
+   template <class T>
+   bool read_array_parallel(std::vector<T>& out, std::string_view bytes, thread_pool& pool, std::string& error,
+                            const parallel_read_options& options = {})
+   {
+      auto tape = scan_array(bytes);
+      if (!tape) {
+         error = std::string("scan failed: ") + std::string(to_string(tape.error()));
+         return false;
+      }
+      return read_array_parallel(out, *tape, pool, error, options);
+   }
+}
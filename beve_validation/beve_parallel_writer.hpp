@@ -0,0 +1,254 @@
+#pragma once
+
+// Field-parallel serialization of large objects.
+//
+// A BEVE object is its header and count followed by key/value pairs, and a value's encoding does
+// not depend on where it ends up, so every member can be serialized on its own. `object_writer`
+// records the members of one object, serializes each into its own segment on a thread pool, and
+// only then lays out the result: the offsets follow from the segment sizes, and the segments are
+// spliced into the output with one (parallel) memcpy each, or handed to the kernel with writev
+// when the destination is a file and no contiguous copy is needed at all.
+//
+// Adding the members in the order their glz::meta declares them produces exactly the bytes
+// glz::write_beve would. Members must stay alive and unmodified until write() returns. A writer
+// keeps its segment buffers between calls, so reusing one for repeated snapshots of the same
+// struct does not reallocate them; it is not thread safe itself.
+//
+//    beve::object_writer w;
+//    w.field("large_float_vec", s.large_float_vec);
+//    w.field("large_double_vec", s.large_double_vec);
+//    w.field("samples", s.samples, beve::half_format::bf16);  // stored as BF16_ARRAY
+//    w.field("timestamps", s.timestamps, beve::pack_codec::delta);  // stored as a packed array
+//    w.write(out, pool);                                      // or w.write_file("snapshot.beve", pool)
+
+#include <glaze/glaze.hpp>
+#include <glaze/beve.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if __has_include(<sys/uio.h>)
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <climits>
+#define BEVE_HAS_WRITEV 1
+#else
+#define BEVE_HAS_WRITEV 0
+#endif
+
+#include "beve_core.hpp"
+#include "beve_half.hpp"
+#include "beve_packed.hpp"
+#include "beve_thread_pool.hpp"
+
+namespace beve
+{
+   class object_writer
+   {
+     public:
+      // Registers a member; `value` is referenced, not copied
+      template <class T>
+      void field(std::string_view key, const T& value)
+      {
+         field_with(key, [&value](std::string& out) -> std::string {
+            if (auto ec = glz::write_beve(value, out)) {
+               return glz::format_error(ec);
+            }
+            return {};
+         });
+      }
+
+      // Registers a float member stored as BF16_ARRAY or F16_ARRAY instead of F32_ARRAY, at half the size
+      void field(std::string_view key, const std::vector<float>& value, half_format format)
+      {
+         field_with(key, [&value, format](std::string& out) -> std::string {
+            out.clear();
+            write_half_array(out, value, format);
+            return {};
+         });
+      }
+
+      // Registers a numeric member stored as a delta/XOR packed array instead of a typed array
+      template <class T>
+      void field(std::string_view key, const std::vector<T>& value, pack_codec codec)
+      {
+         field_with(key, [&value, codec](std::string& out) -> std::string {
+            out.clear();
+            write_packed_array(out, std::span<const T>(value), codec);
+            return {};
+         });
+      }
+
+      // Forgets the registered members but keeps their buffers for the next object
+      void clear() noexcept { size_ = 0; }
+
+      size_t size() const noexcept { return size_; }
+
+      // Serializes the object into `out`, replacing its contents
+      bool write(std::string& out, thread_pool& pool)
+      {
+         if (!serialize(pool)) {
+            return false;
+         }
+         out.resize(total_bytes());
+         std::memcpy(out.data(), head_.data(), head_.size());
+         size_t offset = head_.size();
+         for (size_t i = 0; i < size_; ++i) {
+            member& m = members_[i];
+            std::memcpy(out.data() + offset, m.key.data(), m.key.size());
+            offset += m.key.size();
+            char* dst = out.data() + offset;
+            pool.submit([dst, &m] { std::memcpy(dst, m.value.data(), m.value.size()); });
+            offset += m.value.size();
+         }
+         pool.wait();
+         return true;
+      }
+
+      // Serializes the object straight to `path`, gathering the segments with writev
+      bool write_file(const std::string& path, thread_pool& pool)
+      {
+         if (!serialize(pool)) {
+            return false;
+         }
+#if BEVE_HAS_WRITEV
+         const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+         if (fd < 0) {
+            return fail("failed to open " + path + ": " + std::strerror(errno));
+         }
+         std::vector<iovec> iov;
+         iov.reserve(1 + 2 * size_);
+         iov.push_back({head_.data(), head_.size()});
+         for (size_t i = 0; i < size_; ++i) {
+            iov.push_back({members_[i].key.data(), members_[i].key.size()});
+            iov.push_back({members_[i].value.data(), members_[i].value.size()});
+         }
+         const bool ok = write_all(fd, iov);
+         const int saved = errno;
+         ::close(fd);
+         if (!ok) {
+            return fail("failed to write " + path + ": " + std::strerror(saved));
+         }
+         return true;
+#else
+         std::ofstream file(path, std::ios::binary);
+         file.write(head_.data(), std::streamsize(head_.size()));
+         for (size_t i = 0; i < size_; ++i) {
+            file.write(members_[i].key.data(), std::streamsize(members_[i].key.size()));
+            file.write(members_[i].value.data(), std::streamsize(members_[i].value.size()));
+         }
+         if (!file) {
+            return fail("failed to write " + path);
+         }
+         return true;
+#endif
+      }
+
+      // Size in bytes of the object produced by the last successful write()
+      size_t total_bytes() const noexcept
+      {
+         size_t n = head_.size();
+         for (size_t i = 0; i < size_; ++i) {
+            n += members_[i].key.size() + members_[i].value.size();
+         }
+         return n;
+      }
+
+      const std::string& error() const noexcept { return error_; }
+
+     private:
+      struct member
+      {
+         std::string name;
+         std::string key; // compressed length followed by the key bytes
+         std::function<std::string(std::string&)> serialize; // returns an error message, empty on success
+         std::string value;
+         std::string error;
+      };
+
+      template <class Serialize>
+      void field_with(std::string_view key, Serialize&& serialize)
+      {
+         member& m = next_member();
+         m.name = key;
+         m.key.clear();
+         write_compressed_size(m.key, key.size());
+         m.key.append(key);
+         m.serialize = std::forward<Serialize>(serialize);
+      }
+
+      member& next_member()
+      {
+         if (size_ == members_.size()) {
+            members_.emplace_back();
+         }
+         return members_[size_++];
+      }
+
+      bool serialize(thread_pool& pool)
+      {
+         head_.clear();
+         head_.push_back(char(headers::string_object));
+         write_compressed_size(head_, size_);
+         for (size_t i = 0; i < size_; ++i) {
+            member& m = members_[i];
+            pool.submit([&m] { m.error = m.serialize(m.value); });
+         }
+         pool.wait();
+         for (size_t i = 0; i < size_; ++i) {
+            if (!members_[i].error.empty()) {
+               return fail("failed to serialize " + members_[i].name + ": " + members_[i].error);
+            }
+         }
+         error_.clear();
+         return true;
+      }
+
+#if BEVE_HAS_WRITEV
+      // writev takes at most IOV_MAX segments and may stop early; resume until everything is out
+      static bool write_all(int fd, std::vector<iovec>& iov)
+      {
+         size_t first = 0;
+         while (first < iov.size()) {
+            const int n = int(std::min<size_t>(iov.size() - first, IOV_MAX));
+            const ssize_t written = ::writev(fd, iov.data() + first, n);
+            if (written < 0) {
+               if (errno == EINTR) {
+                  continue;
+               }
+               return false;
+            }
+            size_t left = size_t(written);
+            while (first < iov.size() && left >= iov[first].iov_len) {
+               left -= iov[first].iov_len;
+               ++first;
+            }
+            if (left > 0) {
+               iov[first].iov_base = static_cast<char*>(iov[first].iov_base) + left;
+               iov[first].iov_len -= left;
+            }
+         }
+         return true;
+      }
+#endif
+
+      bool fail(std::string message)
+      {
+         error_ = std::move(message);
+         return false;
+      }
+
+      std::vector<member> members_;
+      size_t size_ = 0;
+      std::string head_;
+      std::string error_;
+   };
+}
@@ -0,0 +1,267 @@
+#pragma once
+
+// In-place updates of encoded BEVE buffers. `patch_value` replaces the value a JSON pointer
+// selects (see beve_pointer.hpp) with another encoded value without decoding or re-serializing
+// anything else:
+//
+//    same encoded size (numbers, booleans, equal-length strings)   overwritten in place
+//    different size                                                one splice of the tail
+//    a missing last key, or "-" on a generic array                 inserted at the end of the
+//                                                                  parent, whose count is rewritten
+//
+// BEVE containers carry element counts, not byte lengths, so a splice never has to fix up
+// enclosing sizes; only an insertion changes a count, and only the parent's (its compressed size
+// may grow a byte width, which is a second, small splice).
+//
+// A counter in a large state blob is a same-size update. Resolve it once and keep the target:
+//
+//    auto target = beve::resolve_pointer(state, "/stats/requests");
+//    for (...) beve::overwrite_value(state, *target, encoded_count);
+//
+// Targets stay valid across in-place updates; any splice or insertion before a target moves it.
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <limits>
+#include <string>
+#include <string_view>
+
+#include "beve_core.hpp"
+#include "beve_pointer.hpp"
+
+namespace beve
+{
+   enum class patch_kind : uint8_t { in_place, spliced, inserted };
+
+   struct patch_result
+   {
+      patch_kind kind = patch_kind::in_place;
+      pointer_target target{}; // where the new value now lives in the buffer
+   };
+
+   namespace detail
+   {
+      // Decimal token to the little-endian key bytes of an integer-keyed object
+      inline bool encode_integer_key(uint8_t header, std::string_view token, char* out) noexcept
+      {
+         const size_t width = byte_count(header);
+         uint64_t raw = 0;
+         if (((header >> 3) & 0b11) == 1) {
+            int64_t v = 0;
+            auto [p, ec] = std::from_chars(token.data(), token.data() + token.size(), v);
+            const int64_t lo = width == 8 ? std::numeric_limits<int64_t>::min() : -(int64_t(1) << (8 * width - 1));
+            const int64_t hi = width == 8 ? std::numeric_limits<int64_t>::max() : (int64_t(1) << (8 * width - 1)) - 1;
+            if (token.empty() || ec != std::errc{} || p != token.data() + token.size() || v < lo || v > hi) {
+               return false;
+            }
+            raw = uint64_t(v);
+         }
+         else {
+            auto v = parse_index(token);
+            if (!v || (width < 8 && *v >> (8 * width))) {
+               return false;
+            }
+            raw = *v;
+         }
+         std::memcpy(out, &raw, width); // little endian, like every BEVE scalar
+         return true;
+      }
+
+      // Sets the compressed size at `pos` to `count`; returns the change in buffer length
+      inline ptrdiff_t rewrite_count(std::string& b, size_t pos, uint64_t count)
+      {
+         const size_t old_width = size_t(1) << (uint8_t(b[pos]) & 0b11);
+         char bytes[8];
+         const size_t width = encode_compressed_size(bytes, count);
+         if (width == old_width) {
+            std::memcpy(b.data() + pos, bytes, width);
+         }
+         else {
+            b.replace(pos, old_width, bytes, width);
+         }
+         return ptrdiff_t(width) - ptrdiff_t(old_width);
+      }
+
+      // Appends `entry` (a key and value, or an array element) to the container whose header is
+      // at `header_pos` and whose bytes end at `end`
+      inline pointer_target append_entry(std::string& b, size_t header_pos, size_t end, std::string_view key,
+                                         std::string_view value)
+      {
+         size_t count_pos = header_pos + 1;
+         const uint64_t count = *read_compressed_size(b, count_pos); // already validated by the resolver
+         if (key.empty()) {
+            b.insert(end, value);
+         }
+         else {
+            std::string entry;
+            entry.reserve(key.size() + value.size());
+            entry.append(key).append(value);
+            b.insert(end, entry);
+         }
+         const ptrdiff_t shift = rewrite_count(b, header_pos + 1, count + 1);
+         const size_t begin = size_t(ptrdiff_t(end) + shift) + key.size();
+         return pointer_target{begin, begin + value.size(), 0};
+      }
+   }
+
+   // Replaces the value at `target` (from resolve_pointer on this buffer) with `value`, one encoded
+   // value. Typed array elements only take a value of their own element type.
+   inline std::expected<patch_result, view_error> overwrite_value(std::string& buffer, const pointer_target& target,
+                                                                  std::string_view value)
+   {
+      if (value.empty()) {
+         return std::unexpected(view_error::unexpected_end);
+      }
+      if (target.element_header) {
+         if (uint8_t(value[0]) != target.element_header) {
+            // Booleans are stored as bits, so either boolean fits a boolean element
+            const bool boolean = (target.element_header == headers::boolean_true ||
+                                  target.element_header == headers::boolean_false) &&
+                                 value.size() == 1 &&
+                                 (uint8_t(value[0]) == headers::boolean_true || uint8_t(value[0]) == headers::boolean_false);
+            if (!boolean) {
+               return std::unexpected(view_error::type_mismatch);
+            }
+         }
+         if (target.begin == target.end) {
+            if (value.size() != 1) {
+               return std::unexpected(view_error::type_mismatch);
+            }
+            const uint8_t mask = uint8_t(1u << target.bit);
+            uint8_t& byte = reinterpret_cast<uint8_t&>(buffer[target.begin]);
+            byte = uint8_t(value[0]) == headers::boolean_true ? uint8_t(byte | mask) : uint8_t(byte & ~mask);
+            return patch_result{patch_kind::in_place, pointer_target{target.begin, target.end, uint8_t(value[0]), target.bit}};
+         }
+         value.remove_prefix(1);
+         if (target.element_header != headers::string && value.size() != target.end - target.begin) {
+            return std::unexpected(view_error::type_mismatch);
+         }
+      }
+      const size_t old_size = target.end - target.begin;
+      const pointer_target updated{target.begin, target.begin + value.size(), target.element_header};
+      if (value.size() == old_size) {
+         std::memcpy(buffer.data() + target.begin, value.data(), value.size());
+         return patch_result{patch_kind::in_place, updated};
+      }
+      buffer.replace(target.begin, old_size, value);
+      return patch_result{patch_kind::spliced, updated};
+   }
+
+   // Replaces (or inserts) the value `pointer` selects in the encoded value at the start of
+   // `buffer` with `value`, which must be exactly one encoded value. A pointer whose last token
+   // names a missing key of an object inserts it; "-" appends to a generic array.
+   inline std::expected<patch_result, view_error> patch_value(std::string& buffer, std::string_view pointer,
+                                                              std::string_view value)
+   {
+      auto value_end = skip_value(value, 0);
+      if (!value_end) {
+         return std::unexpected(value_end.error());
+      }
+      if (*value_end != value.size()) {
+         return std::unexpected(view_error::invalid_header); // trailing bytes after the value
+      }
+      if (pointer.empty() || pointer == "/") {
+         auto whole = resolve_pointer(buffer, {});
+         if (!whole) {
+            return std::unexpected(whole.error());
+         }
+         return overwrite_value(buffer, *whole, value);
+      }
+      if (pointer.front() != '/') {
+         return std::unexpected(view_error::key_not_found);
+      }
+
+      // Resolve the parent, then find (or make room for) the last token ourselves
+      const size_t slash = pointer.rfind('/');
+      const std::string_view token = pointer.substr(slash + 1);
+      auto parent = resolve_pointer(buffer, pointer.substr(0, slash));
+      if (!parent) {
+         return std::unexpected(parent.error());
+      }
+      if (parent->element_header) {
+         return std::unexpected(view_error::type_mismatch); // below a typed array element
+      }
+      size_t pos = parent->begin;
+      while (uint8_t(buffer[pos]) == headers::tag) {
+         ++pos;
+         (void)read_compressed_size(buffer, pos);
+      }
+      const size_t container = pos;
+      const uint8_t header = uint8_t(buffer[container]);
+      const auto type = type_of(header);
+
+      if (type == value_type::typed_array) {
+         auto i = detail::parse_index(token);
+         if (!i) {
+            return std::unexpected(view_error::index_out_of_range);
+         }
+         auto element = detail::typed_array_element(buffer, container, *i);
+         if (!element) {
+            return std::unexpected(element.error());
+         }
+         return overwrite_value(buffer, *element, value);
+      }
+      if (type == value_type::generic_array) {
+         if (token == "-") {
+            return patch_result{patch_kind::inserted, detail::append_entry(buffer, container, parent->end, {}, value)};
+         }
+         auto i = detail::parse_index(token);
+         if (!i) {
+            return std::unexpected(view_error::index_out_of_range);
+         }
+         if (auto r = detail::find_element(buffer, pos, *i); !r) {
+            return std::unexpected(r.error());
+         }
+      }
+      else if (type == value_type::object) {
+         auto found = detail::find_member(buffer, pos, token);
+         if (!found && found.error() != view_error::key_not_found) {
+            return std::unexpected(found.error());
+         }
+         if (!found) {
+            // find_member stopped at the end of the object, which is where the new member goes
+            std::string key;
+            if (header == headers::string_object) {
+               std::string unescaped;
+               for (size_t t = 0; t < token.size(); ++t) {
+                  char c = token[t];
+                  if (c == '~' && t + 1 < token.size() && (token[t + 1] == '0' || token[t + 1] == '1')) {
+                     c = token[++t] == '1' ? '/' : '~';
+                  }
+                  unescaped.push_back(c);
+               }
+               write_compressed_size(key, unescaped.size());
+               key += unescaped;
+            }
+            else {
+               key.resize(byte_count(header));
+               if (!detail::encode_integer_key(header, token, key.data())) {
+                  return std::unexpected(view_error::key_not_found);
+               }
+            }
+            return patch_result{patch_kind::inserted, detail::append_entry(buffer, container, pos, key, value)};
+         }
+      }
+      else {
+         return std::unexpected(view_error::type_mismatch);
+      }
+      auto end = skip_value(buffer, pos);
+      if (!end) {
+         return std::unexpected(end.error());
+      }
+      return overwrite_value(buffer, pointer_target{pos, *end, 0}, value);
+   }
+
+   // patch_value for an arithmetic scalar, encoded with its own header
+   template <class T>
+   inline std::expected<patch_result, view_error> patch_number(std::string& buffer, std::string_view pointer, T v)
+   {
+      char bytes[1 + sizeof(T)];
+      bytes[0] = char(number_header<T>());
+      std::memcpy(bytes + 1, &v, sizeof(T));
+      return patch_value(buffer, pointer, std::string_view(bytes, sizeof(bytes)));
+   }
+}
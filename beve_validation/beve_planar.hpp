@@ -0,0 +1,306 @@
+#pragma once
+
+// Planar (split real/imaginary) complex arrays and matrices.
+//
+// BEVE stores a complex array interleaved (re, im, re, im, ...), the layout of std::complex and of
+// Julia's ComplexF32/ComplexF64. FFT and DSP kernels usually want split buffers instead, one of
+// real parts and one of imaginary parts, and pay for a deinterleave pass after every decode. A
+// planar complex array keeps the COMPLEX header and sets bit 1 of the component header that
+// follows it (`planar_complex_array_header<T>()`: 0x43 for float, 0x63 for double). The payload is
+// the same size as the interleaved one: every real part, then every imaginary part.
+//
+//    beve::write_planar_complex_array(out, re, im);              // split buffers: two copies
+//    beve::write_planar_complex_array(out, samples);             // std::complex: deinterleaved
+//    beve::read_split_complex(bytes, re, im);                    // either layout into split buffers
+//    beve::read_complex_array(bytes, samples);                   // either layout into std::complex
+//
+// BEVE.jl reads planar arrays back as Vector{ComplexF32/ComplexF64} and writes them with
+// `to_beve(data; planar_complex = true)`. Glaze and other BEVE readers do not understand the flag.
+// The conversions between the layouts pick an AVX2 path at run time and otherwise fall back to
+// scalar loops.
+
+#include <bit>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define BEVE_PLANAR_X86 1
+#else
+#define BEVE_PLANAR_X86 0
+#endif
+
+#include "beve_core.hpp"
+#include "beve_view.hpp"
+
+namespace beve
+{
+   namespace detail
+   {
+      // Portable loops over little-endian payload bytes; `in`/`out` hold n interleaved pairs and
+      // `re`/`im` n components each. None of the pointers need to be aligned.
+      template <class T>
+      inline void deinterleave_loop(const char* in, size_t n, char* re, char* im) noexcept
+      {
+         for (size_t i = 0; i < n; ++i) {
+            std::memcpy(re + i * sizeof(T), in + 2 * i * sizeof(T), sizeof(T));
+            std::memcpy(im + i * sizeof(T), in + (2 * i + 1) * sizeof(T), sizeof(T));
+         }
+      }
+
+      template <class T>
+      inline void interleave_loop(const char* re, const char* im, size_t n, char* out) noexcept
+      {
+         for (size_t i = 0; i < n; ++i) {
+            std::memcpy(out + 2 * i * sizeof(T), re + i * sizeof(T), sizeof(T));
+            std::memcpy(out + (2 * i + 1) * sizeof(T), im + i * sizeof(T), sizeof(T));
+         }
+      }
+
+#if BEVE_PLANAR_X86
+      inline bool planar_avx2() noexcept
+      {
+         static const bool supported = [] {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") != 0;
+         }();
+         return supported;
+      }
+
+      // Shuffles work within 128-bit lanes; the final 64-bit permute (0, 2, 1, 3) puts the lanes'
+      // halves back in order
+      __attribute__((target("avx2"))) inline void deinterleave_f32_avx2(const char* in, size_t n, char* re,
+                                                                       char* im) noexcept
+      {
+         size_t i = 0;
+         for (; i + 8 <= n; i += 8) {
+            const __m256 a = _mm256_loadu_ps(reinterpret_cast<const float*>(in + 8 * i));
+            const __m256 b = _mm256_loadu_ps(reinterpret_cast<const float*>(in + 8 * i + 32));
+            const __m256d r = _mm256_castps_pd(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+            const __m256d m = _mm256_castps_pd(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+            _mm256_storeu_pd(reinterpret_cast<double*>(re + 4 * i), _mm256_permute4x64_pd(r, _MM_SHUFFLE(3, 1, 2, 0)));
+            _mm256_storeu_pd(reinterpret_cast<double*>(im + 4 * i), _mm256_permute4x64_pd(m, _MM_SHUFFLE(3, 1, 2, 0)));
+         }
+         deinterleave_loop<float>(in + 8 * i, n - i, re + 4 * i, im + 4 * i);
+      }
+
+      __attribute__((target("avx2"))) inline void interleave_f32_avx2(const char* re, const char* im, size_t n,
+                                                                     char* out) noexcept
+      {
+         size_t i = 0;
+         for (; i + 8 <= n; i += 8) {
+            const __m256d r = _mm256_loadu_pd(reinterpret_cast<const double*>(re + 4 * i));
+            const __m256d m = _mm256_loadu_pd(reinterpret_cast<const double*>(im + 4 * i));
+            const __m256 rp = _mm256_castpd_ps(_mm256_permute4x64_pd(r, _MM_SHUFFLE(3, 1, 2, 0)));
+            const __m256 mp = _mm256_castpd_ps(_mm256_permute4x64_pd(m, _MM_SHUFFLE(3, 1, 2, 0)));
+            _mm256_storeu_ps(reinterpret_cast<float*>(out + 8 * i), _mm256_unpacklo_ps(rp, mp));
+            _mm256_storeu_ps(reinterpret_cast<float*>(out + 8 * i + 32), _mm256_unpackhi_ps(rp, mp));
+         }
+         interleave_loop<float>(re + 4 * i, im + 4 * i, n - i, out + 8 * i);
+      }
+
+      __attribute__((target("avx2"))) inline void deinterleave_f64_avx2(const char* in, size_t n, char* re,
+                                                                       char* im) noexcept
+      {
+         size_t i = 0;
+         for (; i + 4 <= n; i += 4) {
+            const __m256d a = _mm256_loadu_pd(reinterpret_cast<const double*>(in + 16 * i));
+            const __m256d b = _mm256_loadu_pd(reinterpret_cast<const double*>(in + 16 * i + 32));
+            const __m256d r = _mm256_unpacklo_pd(a, b);
+            const __m256d m = _mm256_unpackhi_pd(a, b);
+            _mm256_storeu_pd(reinterpret_cast<double*>(re + 8 * i), _mm256_permute4x64_pd(r, _MM_SHUFFLE(3, 1, 2, 0)));
+            _mm256_storeu_pd(reinterpret_cast<double*>(im + 8 * i), _mm256_permute4x64_pd(m, _MM_SHUFFLE(3, 1, 2, 0)));
+         }
+         deinterleave_loop<double>(in + 16 * i, n - i, re + 8 * i, im + 8 * i);
+      }
+
+      __attribute__((target("avx2"))) inline void interleave_f64_avx2(const char* re, const char* im, size_t n,
+                                                                     char* out) noexcept
+      {
+         size_t i = 0;
+         for (; i + 4 <= n; i += 4) {
+            const __m256d r = _mm256_permute4x64_pd(_mm256_loadu_pd(reinterpret_cast<const double*>(re + 8 * i)),
+                                                    _MM_SHUFFLE(3, 1, 2, 0));
+            const __m256d m = _mm256_permute4x64_pd(_mm256_loadu_pd(reinterpret_cast<const double*>(im + 8 * i)),
+                                                    _MM_SHUFFLE(3, 1, 2, 0));
+            _mm256_storeu_pd(reinterpret_cast<double*>(out + 16 * i), _mm256_unpacklo_pd(r, m));
+            _mm256_storeu_pd(reinterpret_cast<double*>(out + 16 * i + 32), _mm256_unpackhi_pd(r, m));
+         }
+         interleave_loop<double>(re + 8 * i, im + 8 * i, n - i, out + 16 * i);
+      }
+#endif
+
+      template <class T>
+      concept planar_component = std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+      template <class T>
+      concept planar_complex = is_complex<T>::value && planar_component<typename T::value_type>;
+   }
+
+   // Whether `header` and `complex_header` describe a planar array of T, the planar counterpart of
+   // element_matches
+   template <class T>
+   inline constexpr bool planar_matches(uint8_t header, uint8_t complex_header) noexcept
+   {
+      if constexpr (detail::planar_complex<T>) {
+         return header == headers::complex && complex_header == planar_complex_array_header<typename T::value_type>();
+      }
+      else {
+         return false;
+      }
+   }
+
+   // Splits n interleaved pairs at `in` into n real parts at `re` and n imaginary parts at `im`
+   template <detail::planar_component T>
+   inline void deinterleave(const char* in, size_t n, char* re, char* im) noexcept
+   {
+      static_assert(std::endian::native == std::endian::little, "planar conversions assume a little-endian host");
+#if BEVE_PLANAR_X86
+      if (detail::planar_avx2()) {
+         if constexpr (std::is_same_v<T, float>) {
+            return detail::deinterleave_f32_avx2(in, n, re, im);
+         }
+         else {
+            return detail::deinterleave_f64_avx2(in, n, re, im);
+         }
+      }
+#endif
+      detail::deinterleave_loop<T>(in, n, re, im);
+   }
+
+   // Merges n real parts at `re` and n imaginary parts at `im` into n interleaved pairs at `out`
+   template <detail::planar_component T>
+   inline void interleave(const char* re, const char* im, size_t n, char* out) noexcept
+   {
+      static_assert(std::endian::native == std::endian::little, "planar conversions assume a little-endian host");
+#if BEVE_PLANAR_X86
+      if (detail::planar_avx2()) {
+         if constexpr (std::is_same_v<T, float>) {
+            return detail::interleave_f32_avx2(re, im, n, out);
+         }
+         else {
+            return detail::interleave_f64_avx2(re, im, n, out);
+         }
+      }
+#endif
+      detail::interleave_loop<T>(re, im, n, out);
+   }
+
+   // Appends split real and imaginary parts as a planar complex array; `re` and `im` must be the
+   // same length
+   template <detail::planar_component T>
+   inline void write_planar_complex_array(std::string& out, std::span<const T> re, std::span<const T> im)
+   {
+      out.push_back(char(headers::complex));
+      out.push_back(char(planar_complex_array_header<T>()));
+      write_compressed_size(out, re.size());
+      out.append(reinterpret_cast<const char*>(re.data()), re.size_bytes());
+      out.append(reinterpret_cast<const char*>(im.data()), im.size_bytes());
+   }
+
+   // Appends `values` as a planar complex array, deinterleaving straight into the buffer
+   template <detail::planar_component T>
+   inline void write_planar_complex_array(std::string& out, std::span<const std::complex<T>> values)
+   {
+      out.push_back(char(headers::complex));
+      out.push_back(char(planar_complex_array_header<T>()));
+      write_compressed_size(out, values.size());
+      const size_t at = out.size();
+      const size_t half = values.size() * sizeof(T);
+      // resize_and_overwrite skips zero-filling bytes that are about to be written
+      out.resize_and_overwrite(at + 2 * half, [&](char* p, size_t n) {
+         deinterleave<T>(reinterpret_cast<const char*>(values.data()), values.size(), p + at, p + at + half);
+         return n;
+      });
+   }
+
+   // Appends a rows x cols matrix with planar complex data, as glaze writes Eigen matrices (I64
+   // extents) but with the data split. `values` is in storage order.
+   template <detail::planar_component T>
+   inline void write_planar_complex_matrix(std::string& out, size_t rows, size_t cols, bool column_major,
+                                           std::span<const std::complex<T>> values)
+   {
+      out.push_back(char(headers::matrix));
+      out.push_back(char(column_major ? 1 : 0));
+      out.push_back(char(headers::i64_array));
+      write_compressed_size(out, 2);
+      const int64_t extents[2] = {int64_t(rows), int64_t(cols)};
+      out.append(reinterpret_cast<const char*>(extents), sizeof(extents));
+      write_planar_complex_array(out, values);
+   }
+
+   // Reads a complex array of either layout into split buffers (resized to match): two copies
+   // for a planar array, a deinterleave pass for an interleaved one
+   template <detail::planar_component T>
+   inline std::expected<void, view_error> read_split_complex(const typed_array_view& array, std::vector<T>& re,
+                                                            std::vector<T>& im)
+   {
+      if (array.header != headers::complex ||
+          (array.complex_header & ~uint8_t(0b010)) != complex_array_header<T>()) {
+         return std::unexpected(view_error::type_mismatch);
+      }
+      re.resize(array.count);
+      im.resize(array.count);
+      const size_t half = array.count * sizeof(T);
+      if (array.planar() && array.count > 0) {
+         std::memcpy(re.data(), array.data, half);
+         std::memcpy(im.data(), array.data + half, half);
+      }
+      else if (!array.planar()) {
+         deinterleave<T>(array.data, array.count, reinterpret_cast<char*>(re.data()),
+                         reinterpret_cast<char*>(im.data()));
+      }
+      return {};
+   }
+
+   // Reads a complex array of either layout into `out` (resized to match): one copy for an
+   // interleaved array, an interleave pass for a planar one
+   template <detail::planar_component T>
+   inline std::expected<void, view_error> read_complex_array(const typed_array_view& array,
+                                                            std::vector<std::complex<T>>& out)
+   {
+      if (array.header != headers::complex ||
+          (array.complex_header & ~uint8_t(0b010)) != complex_array_header<T>()) {
+         return std::unexpected(view_error::type_mismatch);
+      }
+      out.resize(array.count);
+      const size_t half = array.count * sizeof(T);
+      if (array.planar()) {
+         interleave<T>(array.data, array.data + half, array.count, reinterpret_cast<char*>(out.data()));
+      }
+      else if (array.count > 0) {
+         std::memcpy(out.data(), array.data, 2 * half);
+      }
+      return {};
+   }
+
+   template <detail::planar_component T>
+   inline std::expected<void, view_error> read_split_complex(std::string_view bytes, std::vector<T>& re,
+                                                            std::vector<T>& im)
+   {
+      auto array = beve_view{bytes}.as_typed_array();
+      if (!array) {
+         return std::unexpected(array.error());
+      }
+      return read_split_complex(*array, re, im);
+   }
+
+   template <detail::planar_component T>
+   inline std::expected<void, view_error> read_complex_array(std::string_view bytes,
+                                                            std::vector<std::complex<T>>& out)
+   {
+      auto array = beve_view{bytes}.as_typed_array();
+      if (!array) {
+         return std::unexpected(array.error());
+      }
+      return read_complex_array(*array, out);
+   }
+}
@@ -0,0 +1,284 @@
+#pragma once
+
+// RFC 6901 JSON pointers resolved directly on encoded BEVE bytes. The resolver walks the
+// value once, front to back: at each level it reads object keys (or counts array elements)
+// until it reaches the next reference token, stepping over every value it passes with
+// `skip_value`, which follows length prefixes and never looks inside strings or typed array
+// payloads. Nothing is decoded and nothing is allocated, so finding `/employees/3/salary` in
+// a 200 MB object costs a walk over the keys that precede it rather than a full decode.
+//
+// The result is the byte span of the target. Pass it to glz::read_beve (or BEVE.jl's
+// `from_beve_at`) to decode only that value:
+//
+//    auto target = beve::resolve_pointer(bytes, "/employees/3/salary");
+//    double salary{};
+//    if (target) glz::read_beve(salary, target->encoded(bytes));
+//
+// Reference tokens select keys of string-keyed objects, keys of integer-keyed objects (the
+// token is parsed as an integer), and 0-based indices of generic and typed arrays. Type tags
+// (variants) are transparent.
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "beve_core.hpp"
+
+namespace beve
+{
+   // Where a JSON pointer lands inside an encoded value: the bytes [begin, end). Elements of
+   // typed arrays are not standalone values; for them `element_header` is the header their
+   // bytes lack (the scalar, string or boolean header), otherwise it is 0.
+   struct pointer_target
+   {
+      size_t begin = 0;
+      size_t end = 0;
+      uint8_t element_header = 0;
+      uint8_t bit = 0; // boolean array elements: the bit within the byte at `begin`
+
+      // The target as a standalone encoded value, copied only when a header must be prepended
+      std::string encoded(std::string_view buffer) const
+      {
+         std::string out;
+         out.reserve(end - begin + 1);
+         if (element_header) {
+            out.push_back(char(element_header));
+         }
+         out.append(buffer.substr(begin, end - begin));
+         return out;
+      }
+
+      // The target's bytes in place; only a complete value when element_header is 0
+      std::string_view span(std::string_view buffer) const noexcept { return buffer.substr(begin, end - begin); }
+   };
+
+   namespace detail
+   {
+      // Compares a key with a reference token, unescaping ~1 and ~0 on the fly
+      inline bool token_equals(std::string_view key, std::string_view token) noexcept
+      {
+         size_t k = 0;
+         for (size_t t = 0; t < token.size(); ++t, ++k) {
+            char c = token[t];
+            if (c == '~' && t + 1 < token.size() && (token[t + 1] == '0' || token[t + 1] == '1')) {
+               c = token[++t] == '1' ? '/' : '~';
+            }
+            if (k == key.size() || key[k] != c) {
+               return false;
+            }
+         }
+         return k == key.size();
+      }
+
+      inline std::optional<uint64_t> parse_index(std::string_view token) noexcept
+      {
+         uint64_t i = 0;
+         auto [p, ec] = std::from_chars(token.data(), token.data() + token.size(), i);
+         if (token.empty() || ec != std::errc{} || p != token.data() + token.size()) {
+            return std::nullopt;
+         }
+         return i;
+      }
+
+      // Whether the integer key at `pos` (width and signedness from the object header) equals
+      // the token read as a decimal integer
+      inline bool integer_key_equals(std::string_view b, size_t pos, uint8_t header, std::string_view token) noexcept
+      {
+         const size_t width = byte_count(header);
+         uint64_t raw = 0;
+         std::memcpy(&raw, b.data() + pos, width);
+         if (((header >> 3) & 0b11) == 1) {
+            if (width < 8 && (raw >> (8 * width - 1)) & 1) {
+               raw |= ~uint64_t(0) << (8 * width);
+            }
+            int64_t wanted = 0;
+            auto [p, ec] = std::from_chars(token.data(), token.data() + token.size(), wanted);
+            return !token.empty() && ec == std::errc{} && p == token.data() + token.size() && int64_t(raw) == wanted;
+         }
+         auto wanted = parse_index(token);
+         return wanted && raw == *wanted;
+      }
+
+      // Element `i` of the typed array whose header is at `pos`
+      inline std::expected<pointer_target, view_error> typed_array_element(std::string_view b, size_t pos,
+                                                                          uint64_t i) noexcept
+      {
+         const uint8_t header = uint8_t(b[pos++]);
+         auto count = read_compressed_size(b, pos);
+         if (!count) {
+            return std::unexpected(count.error());
+         }
+         if (i >= *count) {
+            return std::unexpected(view_error::index_out_of_range);
+         }
+         if (header == headers::string_array) {
+            for (uint64_t k = 0; k < i; ++k) {
+               if (auto r = skip_string_body(b, pos); !r) {
+                  return std::unexpected(r.error());
+               }
+            }
+            const size_t begin = pos;
+            if (auto r = skip_string_body(b, pos); !r) {
+               return std::unexpected(r.error());
+            }
+            return pointer_target{begin, pos, headers::string};
+         }
+         if (header == headers::bool_array) {
+            // Bits have no bytes of their own; the element is the whole boolean header
+            if (i / 8 >= b.size() - pos) {
+               return std::unexpected(view_error::unexpected_end);
+            }
+            const size_t byte = pos + size_t(i / 8);
+            const bool bit = (uint8_t(b[byte]) >> (i % 8)) & 1;
+            return pointer_target{byte, byte, bit ? headers::boolean_true : headers::boolean_false, uint8_t(i % 8)};
+         }
+         const size_t width = byte_count(header);
+         if (*count > (b.size() - pos) / width) {
+            return std::unexpected(view_error::size_overflow);
+         }
+         // Numeric typed array headers are their scalar header plus 3
+         const size_t begin = pos + size_t(i) * width;
+         return pointer_target{begin, begin + width, uint8_t(header - 3)};
+      }
+
+      // Moves `pos` from an object header to the value of the key matching `token`
+      inline std::expected<void, view_error> find_member(std::string_view b, size_t& pos, std::string_view token) noexcept
+      {
+         const uint8_t header = uint8_t(b[pos++]);
+         auto count = read_compressed_size(b, pos);
+         if (!count) {
+            return std::unexpected(count.error());
+         }
+         const size_t key_width = header == headers::string_object ? 0 : byte_count(header);
+         if (key_width > sizeof(uint64_t)) {
+            return std::unexpected(view_error::type_mismatch); // 128-bit keys
+         }
+         for (uint64_t k = 0; k < *count; ++k) {
+            bool match;
+            if (key_width == 0) {
+               auto n = read_compressed_size(b, pos);
+               if (!n) {
+                  return std::unexpected(n.error());
+               }
+               if (*n > b.size() - pos) {
+                  return std::unexpected(view_error::size_overflow);
+               }
+               match = token_equals(b.substr(pos, size_t(*n)), token);
+               pos += size_t(*n);
+            }
+            else {
+               if (key_width > b.size() - pos) {
+                  return std::unexpected(view_error::unexpected_end);
+               }
+               match = integer_key_equals(b, pos, header, token);
+               pos += key_width;
+            }
+            if (match) {
+               return {};
+            }
+            auto next = skip_value(b, pos);
+            if (!next) {
+               return std::unexpected(next.error());
+            }
+            pos = *next;
+         }
+         return std::unexpected(view_error::key_not_found);
+      }
+
+      // Moves `pos` from a generic array header to element `i`
+      inline std::expected<void, view_error> find_element(std::string_view b, size_t& pos, uint64_t i) noexcept
+      {
+         ++pos;
+         auto count = read_compressed_size(b, pos);
+         if (!count) {
+            return std::unexpected(count.error());
+         }
+         if (i >= *count) {
+            return std::unexpected(view_error::index_out_of_range);
+         }
+         for (uint64_t k = 0; k < i; ++k) {
+            auto next = skip_value(b, pos);
+            if (!next) {
+               return std::unexpected(next.error());
+            }
+            pos = *next;
+         }
+         return {};
+      }
+   }
+
+   // Resolves `pointer` ("" or "/" for the whole value) against the encoded value at the start
+   // of `buffer`
+   inline std::expected<pointer_target, view_error> resolve_pointer(std::string_view buffer,
+                                                                   std::string_view pointer) noexcept
+   {
+      if (pointer == "/") {
+         pointer = {};
+      }
+      else if (!pointer.empty()) {
+         if (pointer.front() != '/') {
+            return std::unexpected(view_error::key_not_found);
+         }
+         pointer.remove_prefix(1);
+      }
+      bool done = pointer.empty();
+      size_t pos = 0;
+      while (!done) {
+         if (pos >= buffer.size()) {
+            return std::unexpected(view_error::unexpected_end);
+         }
+         const uint8_t header = uint8_t(buffer[pos]);
+         if (header == headers::tag) {
+            // Descend into the tagged value; a pointer that ends here keeps the tag
+            ++pos;
+            if (auto index = read_compressed_size(buffer, pos); !index) {
+               return std::unexpected(index.error());
+            }
+            continue;
+         }
+         const size_t slash = pointer.find('/');
+         const std::string_view token = pointer.substr(0, slash);
+         const auto type = type_of(header);
+         if (type == value_type::object) {
+            if (auto r = detail::find_member(buffer, pos, token); !r) {
+               return std::unexpected(r.error());
+            }
+         }
+         else if (type == value_type::generic_array || type == value_type::typed_array) {
+            auto i = detail::parse_index(token);
+            if (!i) {
+               return std::unexpected(view_error::index_out_of_range);
+            }
+            if (type == value_type::typed_array) {
+               // Typed array elements are leaves
+               if (slash != std::string_view::npos) {
+                  return std::unexpected(view_error::type_mismatch);
+               }
+               return detail::typed_array_element(buffer, pos, *i);
+            }
+            if (auto r = detail::find_element(buffer, pos, *i); !r) {
+               return std::unexpected(r.error());
+            }
+         }
+         else {
+            return std::unexpected(view_error::type_mismatch);
+         }
+         if (slash == std::string_view::npos) {
+            done = true;
+         }
+         else {
+            pointer.remove_prefix(slash + 1);
+         }
+      }
+      auto end = skip_value(buffer, pos);
+      if (!end) {
+         return std::unexpected(end.error());
+      }
+      return pointer_target{pos, *end, 0};
+   }
+}
@@ -0,0 +1,360 @@
+#pragma once
+
+// Single-producer/single-consumer ring buffer of BEVE frames in POSIX shared memory, for
+// handing messages between processes on one machine without touching the file system.
+// BEVE.jl maps the same segment (`open_beve_ring` / `create_beve_ring`), so a C++ producer
+// can feed a Julia consumer and the other way around.
+//
+// Segment layout (all fields little endian):
+//
+//    0    magic "BEVERNG1"
+//    8    capacity of the data region in bytes (a power of two)
+//    64   head: total bytes ever published by the producer
+//    128  tail: total bytes ever released by the consumer
+//    192  closed flag, set by the producer when it will write no more frames
+//    256  data region
+//
+// head, tail and the closed flag each sit on their own cache line and are only written by one
+// side. Frames are an 8-byte length followed by the BEVE bytes, padded to 8 bytes. A frame is
+// never split across the end of the region: when it does not fit before the end the producer
+// writes `ring_wrap` in place of a length and starts the frame at offset 0, so the consumer
+// always sees one contiguous span it can decode in place.
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define BEVE_HAS_SHM 1
+#else
+#define BEVE_HAS_SHM 0
+#endif
+
+namespace beve
+{
+   inline constexpr uint64_t ring_magic = 0x31474e5245564542ull; // "BEVERNG1" read little endian
+   inline constexpr size_t ring_header_bytes = 256;
+   inline constexpr size_t ring_head_offset = 64;
+   inline constexpr size_t ring_tail_offset = 128;
+   inline constexpr size_t ring_closed_offset = 192;
+   inline constexpr uint64_t ring_wrap = ~uint64_t(0);
+
+   class shm_ring
+   {
+     public:
+      shm_ring() = default;
+      ~shm_ring() { close(); }
+
+      shm_ring(const shm_ring&) = delete;
+      shm_ring& operator=(const shm_ring&) = delete;
+
+      shm_ring(shm_ring&& other) noexcept { swap(other); }
+      shm_ring& operator=(shm_ring&& other) noexcept
+      {
+         if (this != &other) {
+            close();
+            swap(other);
+         }
+         return *this;
+      }
+
+      // Creates (or truncates) the segment `name` with `capacity` bytes of frame storage,
+      // rounded up to a power of two. Frames may be up to half the capacity, less 8 bytes.
+      bool create(std::string_view name, size_t capacity = size_t(1) << 24)
+      {
+         close();
+#if BEVE_HAS_SHM
+         size_t rounded = 64;
+         while (rounded < capacity) {
+            rounded <<= 1;
+         }
+         const std::string path = segment_name(name);
+         const int fd = ::shm_open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+         if (fd < 0) {
+            error_ = std::strerror(errno);
+            return false;
+         }
+         const bool sized = ::ftruncate(fd, off_t(ring_header_bytes + rounded)) == 0;
+         if (!sized || !map(fd, ring_header_bytes + rounded)) {
+            if (!sized) {
+               error_ = std::strerror(errno);
+            }
+            ::close(fd);
+            return false;
+         }
+         ::close(fd);
+         std::memcpy(base_ + 8, &rounded, sizeof(uint64_t));
+         // Publishing the magic last tells a reader racing with create() that the header is whole
+         std::atomic_ref<uint64_t>(word(0)).store(ring_magic, std::memory_order_release);
+         attach(rounded);
+         return true;
+#else
+         (void)name;
+         (void)capacity;
+         error_ = "POSIX shared memory is not available on this platform";
+         return false;
+#endif
+      }
+
+      // Maps an existing segment created by either language
+      bool open(std::string_view name)
+      {
+         close();
+#if BEVE_HAS_SHM
+         const int fd = ::shm_open(segment_name(name).c_str(), O_RDWR, 0);
+         if (fd < 0) {
+            error_ = std::strerror(errno);
+            return false;
+         }
+         struct stat st{};
+         if (::fstat(fd, &st) != 0 || size_t(st.st_size) < ring_header_bytes) {
+            error_ = "segment is too small to hold a ring header";
+            ::close(fd);
+            return false;
+         }
+         if (!map(fd, size_t(st.st_size))) {
+            ::close(fd);
+            return false;
+         }
+         ::close(fd);
+         uint64_t capacity = 0;
+         std::memcpy(&capacity, base_ + 8, sizeof(uint64_t));
+         if (std::atomic_ref<uint64_t>(word(0)).load(std::memory_order_acquire) != ring_magic ||
+             capacity < 64 || (capacity & (capacity - 1)) != 0 || ring_header_bytes + capacity > size_) {
+            error_ = "segment is not a BEVE ring";
+            close();
+            return false;
+         }
+         attach(capacity);
+         return true;
+#else
+         (void)name;
+         error_ = "POSIX shared memory is not available on this platform";
+         return false;
+#endif
+      }
+
+      // Removes the segment name; existing mappings stay valid until they are closed
+      static bool unlink(std::string_view name) noexcept
+      {
+#if BEVE_HAS_SHM
+         return ::shm_unlink(segment_name(name).c_str()) == 0;
+#else
+         (void)name;
+         return false;
+#endif
+      }
+
+      void close() noexcept
+      {
+#if BEVE_HAS_SHM
+         if (base_) {
+            ::munmap(base_, size_);
+         }
+#endif
+         base_ = nullptr;
+         data_ = nullptr;
+         size_ = 0;
+         mask_ = 0;
+      }
+
+      bool is_open() const noexcept { return base_ != nullptr; }
+      size_t capacity() const noexcept { return mask_ + 1; }
+      // A frame padded out by a wrap marker then never needs more than the whole region, so
+      // any frame up to this size is eventually accepted by an empty ring
+      size_t max_frame_size() const noexcept { return capacity() / 2 - 8; }
+      const std::string& error() const noexcept { return error_; }
+
+      // Producer: copies `frame` into the ring. Returns false when the ring is too full; the
+      // frame is then not written.
+      bool try_push(std::string_view frame) noexcept
+      {
+         if (frame.size() > max_frame_size()) {
+            return false;
+         }
+         const uint64_t need = frame_bytes(frame.size());
+         const uint64_t at = head_ & mask_;
+         const uint64_t skip = capacity() - at < need ? capacity() - at : 0;
+         if (head_ + skip + need - cached_tail_ > capacity()) {
+            cached_tail_ = tail().load(std::memory_order_acquire);
+            if (head_ + skip + need - cached_tail_ > capacity()) {
+               return false;
+            }
+         }
+         if (skip) {
+            store_length(at, ring_wrap);
+            head_ += skip;
+         }
+         const uint64_t start = head_ & mask_;
+         store_length(start, frame.size());
+         if (!frame.empty()) {
+            std::memcpy(data_ + start + 8, frame.data(), frame.size());
+         }
+         head_ += need;
+         head().store(head_, std::memory_order_release);
+         return true;
+      }
+
+      // Producer: waits for room, then pushes. Returns false (without waiting) only when the
+      // frame can never fit.
+      bool push(std::string_view frame)
+      {
+         if (frame.size() > max_frame_size()) {
+            error_ = "frame of " + std::to_string(frame.size()) + " bytes exceeds the ring's maximum of " +
+                     std::to_string(max_frame_size());
+            return false;
+         }
+         for (unsigned spins = 0; !try_push(frame); ++spins) {
+            backoff(spins);
+         }
+         return true;
+      }
+
+      // Producer: tells the consumer no more frames will follow
+      void close_writer() noexcept { closed().store(1, std::memory_order_release); }
+
+      // Consumer: the oldest unreleased frame, or nullopt when none is ready. The view points
+      // into shared memory and stays valid until pop().
+      std::optional<std::string_view> front() noexcept
+      {
+         if (tail_ == cached_head_) {
+            cached_head_ = head().load(std::memory_order_acquire);
+            if (tail_ == cached_head_) {
+               return std::nullopt;
+            }
+         }
+         skip_wrap();
+         const uint64_t at = tail_ & mask_;
+         return std::string_view(data_ + at + 8, size_t(load_length(at)));
+      }
+
+      // Consumer: waits for the next frame. Returns nullopt once the producer has closed the
+      // ring and every frame has been consumed.
+      std::optional<std::string_view> wait_front() noexcept
+      {
+         for (unsigned spins = 0;; ++spins) {
+            if (auto frame = front()) {
+               return frame;
+            }
+            if (closed().load(std::memory_order_acquire)) {
+               // A frame published just before the flag is still delivered
+               return front();
+            }
+            backoff(spins);
+         }
+      }
+
+      // Consumer: releases the oldest frame to the producer; does nothing when none is ready
+      void pop() noexcept
+      {
+         if (!front()) {
+            return;
+         }
+         tail_ += frame_bytes(load_length(tail_ & mask_));
+         tail().store(tail_, std::memory_order_release);
+      }
+
+      bool closed_by_writer() const noexcept { return closed().load(std::memory_order_acquire) != 0; }
+
+      void swap(shm_ring& other) noexcept
+      {
+         std::swap(base_, other.base_);
+         std::swap(data_, other.data_);
+         std::swap(size_, other.size_);
+         std::swap(mask_, other.mask_);
+         std::swap(head_, other.head_);
+         std::swap(tail_, other.tail_);
+         std::swap(cached_head_, other.cached_head_);
+         std::swap(cached_tail_, other.cached_tail_);
+         std::swap(error_, other.error_);
+      }
+
+     private:
+      static constexpr uint64_t frame_bytes(uint64_t length) noexcept { return 8 + ((length + 7) & ~uint64_t(7)); }
+
+      static std::string segment_name(std::string_view name)
+      {
+         return name.starts_with('/') ? std::string(name) : "/" + std::string(name);
+      }
+
+      // Steps over a wrap marker at the read position. The marker and the frame after it are
+      // published together, so the frame is there to read.
+      void skip_wrap() noexcept
+      {
+         const uint64_t at = tail_ & mask_;
+         if (load_length(at) == ring_wrap) {
+            tail_ += capacity() - at;
+         }
+      }
+
+      // Spin briefly (a handoff is usually a few hundred nanoseconds away), then yield the core
+      static void backoff(unsigned spins) noexcept
+      {
+         if (spins >= 64) {
+            std::this_thread::yield();
+         }
+      }
+
+#if BEVE_HAS_SHM
+      bool map(int fd, size_t size)
+      {
+         void* addr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+         if (addr == MAP_FAILED) {
+            error_ = std::strerror(errno);
+            return false;
+         }
+         base_ = static_cast<char*>(addr);
+         size_ = size;
+         return true;
+      }
+#endif
+
+      // Either side resumes from the positions in the header, so a restarted consumer picks
+      // up where the previous one stopped
+      void attach(uint64_t capacity) noexcept
+      {
+         data_ = base_ + ring_header_bytes;
+         mask_ = capacity - 1;
+         head_ = cached_head_ = head().load(std::memory_order_acquire);
+         tail_ = cached_tail_ = tail().load(std::memory_order_acquire);
+      }
+
+      // The header words live in the shared mapping, not in this object
+      uint64_t& word(size_t offset) const noexcept { return *reinterpret_cast<uint64_t*>(base_ + offset); }
+      std::atomic_ref<uint64_t> head() const noexcept { return std::atomic_ref<uint64_t>(word(ring_head_offset)); }
+      std::atomic_ref<uint64_t> tail() const noexcept { return std::atomic_ref<uint64_t>(word(ring_tail_offset)); }
+      std::atomic_ref<uint64_t> closed() const noexcept
+      {
+         return std::atomic_ref<uint64_t>(word(ring_closed_offset));
+      }
+
+      void store_length(uint64_t at, uint64_t length) noexcept { std::memcpy(data_ + at, &length, 8); }
+      uint64_t load_length(uint64_t at) const noexcept
+      {
+         uint64_t length;
+         std::memcpy(&length, data_ + at, 8);
+         return length;
+      }
+
+      char* base_ = nullptr;
+      char* data_ = nullptr;
+      size_t size_ = 0;
+      uint64_t mask_ = 0;
+      uint64_t head_ = 0; // producer's next write position
+      uint64_t tail_ = 0; // consumer's next read position
+      uint64_t cached_head_ = 0;
+      uint64_t cached_tail_ = 0;
+      std::string error_;
+   };
+}
@@ -0,0 +1,425 @@
+#pragma once
+
+// Exact encoded sizes, computed before writing.
+//
+// glz::write_beve grows its output buffer as it writes, so a multi-GB value costs repeated
+// realloc + copy and up to twice its size in transient memory. `size_of` returns the exact number
+// of bytes a value encodes to by adding up headers, compressed sizes and payload sizes without
+// writing anything; typed arrays cost O(1) each, so only the structure is visited, never the
+// payload. `write_to` then encodes into memory that already has that size, and the payload is
+// copied once, straight to its destination:
+//
+//    std::string out;
+//    beve::write_exact(value, out);                    // one allocation of exactly size_of(value)
+//    beve::write_file_exact(value, "snapshot.beve");   // into a file mapped at its final size
+//
+// The bytes are the ones glz::write_beve produces. Structs are described once, members in their
+// glz::meta order (std::optional members that are empty are skipped, as glaze skips null members):
+//
+//    template <>
+//    struct beve::layout<LargeArrayTypes> {
+//       using T = LargeArrayTypes;
+//       static constexpr auto value = beve::object_layout{
+//          beve::member{"large_float_vec", &T::large_float_vec}, beve::member{"large_double_vec", &T::large_double_vec}};
+//    };
+//
+// Supported values: bool, arithmetic types, std::string, std::complex, std::optional,
+// std::variant, ranges (typed arrays of arithmetic, complex, bool and std::string elements,
+// generic arrays otherwise), maps with string or integer keys and structs with a layout.
+
+#include <complex>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <variant>
+
+#include "beve_core.hpp"
+#include "beve_mmap.hpp"
+
+namespace beve
+{
+   template <class Record, class Member>
+   struct member
+   {
+      std::string_view key;
+      Member Record::*ptr;
+   };
+
+   template <class Record, class... Members>
+   struct object_layout
+   {
+      std::tuple<member<Record, Members>...> members;
+
+      constexpr object_layout(member<Record, Members>... m) : members(m...) {}
+   };
+
+   // Specialize with `static constexpr auto value = beve::object_layout{...}`
+   template <class T>
+   struct layout;
+
+   template <class T>
+   concept has_layout = requires { layout<T>::value; };
+
+   namespace detail
+   {
+      template <class T>
+      struct is_optional : std::false_type
+      {};
+      template <class T>
+      struct is_optional<std::optional<T>> : std::true_type
+      {};
+
+      template <class T>
+      struct is_variant : std::false_type
+      {};
+      template <class... Ts>
+      struct is_variant<std::variant<Ts...>> : std::true_type
+      {};
+
+      template <class T>
+      concept string_like = std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>;
+
+      template <class T>
+      concept map_like = std::ranges::range<T> && requires {
+         typename T::key_type;
+         typename T::mapped_type;
+      };
+
+      template <class T>
+      concept array_like = std::ranges::sized_range<T> && !string_like<T> && !map_like<T>;
+
+      template <class T>
+      inline constexpr bool is_number = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+
+      // Header of an object keyed by K
+      template <class K>
+      inline constexpr uint8_t object_header() noexcept
+      {
+         if constexpr (string_like<K>) {
+            return headers::string_object;
+         }
+         else {
+            static_assert(std::is_integral_v<K> && !std::is_same_v<K, bool>, "object keys must be strings or integers");
+            return uint8_t((typed_array_header<K>() & ~uint8_t(0b111)) | 0b011);
+         }
+      }
+
+      inline size_t string_body_size(std::string_view s) noexcept { return compressed_size_width(s.size()) + s.size(); }
+
+      inline char* put_byte(char* p, uint8_t b) noexcept
+      {
+         *p = char(b);
+         return p + 1;
+      }
+
+      inline char* put_size(char* p, uint64_t n) noexcept { return p + encode_compressed_size(p, n); }
+
+      inline char* put_bytes(char* p, const void* src, size_t n) noexcept
+      {
+         if (n) {
+            std::memcpy(p, src, n);
+         }
+         return p + n;
+      }
+
+      inline char* put_string_body(char* p, std::string_view s) noexcept
+      {
+         return put_bytes(put_size(p, s.size()), s.data(), s.size());
+      }
+
+      template <class T>
+      size_t value_size(const T& v) noexcept;
+
+      template <class T>
+      char* encode_value(const T& v, char* p) noexcept;
+
+      template <class R>
+      size_t array_size(const R& r) noexcept
+      {
+         using E = std::ranges::range_value_t<R>;
+         const size_t n = size_t(std::ranges::size(r));
+         const size_t head = 1 + compressed_size_width(n);
+         if constexpr (std::is_same_v<E, bool>) {
+            return head + (n + 7) / 8;
+         }
+         else if constexpr (is_number<E>) {
+            return head + n * sizeof(E);
+         }
+         else if constexpr (is_complex<E>::value) {
+            return head + 1 + n * sizeof(E);
+         }
+         else if constexpr (string_like<E>) {
+            size_t bytes = head;
+            for (const auto& s : r) {
+               bytes += string_body_size(s);
+            }
+            return bytes;
+         }
+         else {
+            size_t bytes = head;
+            for (const auto& e : r) {
+               bytes += value_size(e);
+            }
+            return bytes;
+         }
+      }
+
+      template <class R>
+      char* encode_array(const R& r, char* p) noexcept
+      {
+         using E = std::ranges::range_value_t<R>;
+         const size_t n = size_t(std::ranges::size(r));
+         if constexpr (std::is_same_v<E, bool>) {
+            p = put_size(put_byte(p, headers::bool_array), n);
+            std::memset(p, 0, (n + 7) / 8);
+            size_t i = 0;
+            for (const bool b : r) {
+               if (b) {
+                  p[i / 8] = char(uint8_t(p[i / 8]) | uint8_t(1u << (i % 8)));
+               }
+               ++i;
+            }
+            return p + (n + 7) / 8;
+         }
+         else if constexpr (is_number<E> || is_complex<E>::value) {
+            if constexpr (is_complex<E>::value) {
+               p = put_byte(put_byte(p, headers::complex), complex_array_header<typename E::value_type>());
+            }
+            else {
+               p = put_byte(p, typed_array_header<E>());
+            }
+            p = put_size(p, n);
+            if constexpr (std::ranges::contiguous_range<R>) {
+               return put_bytes(p, std::ranges::data(r), n * sizeof(E));
+            }
+            else {
+               for (const auto& e : r) {
+                  p = put_bytes(p, &e, sizeof(E));
+               }
+               return p;
+            }
+         }
+         else if constexpr (string_like<E>) {
+            p = put_size(put_byte(p, headers::string_array), n);
+            for (const auto& s : r) {
+               p = put_string_body(p, s);
+            }
+            return p;
+         }
+         else {
+            p = put_size(put_byte(p, headers::generic_array), n);
+            for (const auto& e : r) {
+               p = encode_value(e, p);
+            }
+            return p;
+         }
+      }
+
+      template <class M>
+      size_t map_size(const M& m) noexcept
+      {
+         using K = typename M::key_type;
+         size_t bytes = 1 + compressed_size_width(size_t(std::ranges::size(m)));
+         for (const auto& [k, v] : m) {
+            if constexpr (string_like<K>) {
+               bytes += string_body_size(k);
+            }
+            else {
+               bytes += sizeof(K);
+            }
+            bytes += value_size(v);
+         }
+         return bytes;
+      }
+
+      template <class M>
+      char* encode_map(const M& m, char* p) noexcept
+      {
+         using K = typename M::key_type;
+         p = put_size(put_byte(p, object_header<K>()), size_t(std::ranges::size(m)));
+         for (const auto& [k, v] : m) {
+            if constexpr (string_like<K>) {
+               p = put_string_body(p, k);
+            }
+            else {
+               p = put_bytes(p, &k, sizeof(K));
+            }
+            p = encode_value(v, p);
+         }
+         return p;
+      }
+
+      template <class M>
+      bool member_written(const M& v) noexcept
+      {
+         if constexpr (is_optional<M>::value) {
+            return v.has_value();
+         }
+         else {
+            return true;
+         }
+      }
+
+      template <class T>
+      size_t struct_size(const T& v) noexcept
+      {
+         size_t count = 0;
+         size_t bytes = 0;
+         std::apply(
+            [&](const auto&... m) {
+               ((member_written(v.*m.ptr) ? (++count, bytes += string_body_size(m.key) + value_size(v.*m.ptr)) : 0),
+                ...);
+            },
+            layout<T>::value.members);
+         return 1 + compressed_size_width(count) + bytes;
+      }
+
+      template <class T>
+      char* encode_struct(const T& v, char* p) noexcept
+      {
+         size_t count = 0;
+         std::apply([&](const auto&... m) { ((count += member_written(v.*m.ptr)), ...); }, layout<T>::value.members);
+         p = put_size(put_byte(p, headers::string_object), count);
+         std::apply(
+            [&](const auto&... m) {
+               ((member_written(v.*m.ptr) ? (p = encode_value(v.*m.ptr, put_string_body(p, m.key))) : p), ...);
+            },
+            layout<T>::value.members);
+         return p;
+      }
+
+      template <class T>
+      size_t value_size(const T& v) noexcept
+      {
+         if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, std::nullopt_t> ||
+                       std::is_same_v<T, std::monostate>) {
+            return 1;
+         }
+         else if constexpr (is_number<T>) {
+            return 1 + sizeof(T);
+         }
+         else if constexpr (is_complex<T>::value) {
+            return 2 + sizeof(T);
+         }
+         else if constexpr (string_like<T>) {
+            return 1 + string_body_size(v);
+         }
+         else if constexpr (is_optional<T>::value) {
+            return v ? value_size(*v) : 1;
+         }
+         else if constexpr (is_variant<T>::value) {
+            return 1 + compressed_size_width(v.index()) + std::visit([](const auto& x) { return value_size(x); }, v);
+         }
+         else if constexpr (has_layout<T>) {
+            return struct_size(v);
+         }
+         else if constexpr (map_like<T>) {
+            return map_size(v);
+         }
+         else if constexpr (array_like<T>) {
+            return array_size(v);
+         }
+         else {
+            static_assert(sizeof(T) == 0, "size_of: unsupported type (does it need a beve::layout?)");
+         }
+      }
+
+      template <class T>
+      char* encode_value(const T& v, char* p) noexcept
+      {
+         if constexpr (std::is_same_v<T, bool>) {
+            return put_byte(p, v ? headers::boolean_true : headers::boolean_false);
+         }
+         else if constexpr (std::is_same_v<T, std::nullopt_t> || std::is_same_v<T, std::monostate>) {
+            return put_byte(p, headers::null);
+         }
+         else if constexpr (is_number<T>) {
+            return put_bytes(put_byte(p, number_header<T>()), &v, sizeof(T));
+         }
+         else if constexpr (is_complex<T>::value) {
+            // A single complex number: the array component header without its array bit
+            const uint8_t component = uint8_t(complex_array_header<typename T::value_type>() & ~uint8_t(1));
+            return put_bytes(put_byte(put_byte(p, headers::complex), component), &v, sizeof(T));
+         }
+         else if constexpr (string_like<T>) {
+            return put_string_body(put_byte(p, headers::string), v);
+         }
+         else if constexpr (is_optional<T>::value) {
+            return v ? encode_value(*v, p) : put_byte(p, headers::null);
+         }
+         else if constexpr (is_variant<T>::value) {
+            p = put_size(put_byte(p, headers::tag), v.index());
+            return std::visit([p](const auto& x) { return encode_value(x, p); }, v);
+         }
+         else if constexpr (has_layout<T>) {
+            return encode_struct(v, p);
+         }
+         else if constexpr (map_like<T>) {
+            return encode_map(v, p);
+         }
+         else {
+            return encode_array(v, p);
+         }
+      }
+   }
+
+   // Exact number of bytes `value` encodes to
+   template <class T>
+   inline size_t size_of(const T& value) noexcept
+   {
+      return detail::value_size(value);
+   }
+
+   // Encodes `value` into `out`, which must have room for size_of(value) bytes; returns the end
+   template <class T>
+   inline char* write_to(const T& value, char* out) noexcept
+   {
+      return detail::encode_value(value, out);
+   }
+
+   // Encodes `value` into `out` (for example a caller's mapped region); returns the bytes written,
+   // or size_overflow when `out` is too small, in which case nothing is written
+   template <class T>
+   inline std::expected<size_t, view_error> write_into(const T& value, std::span<char> out) noexcept
+   {
+      const size_t n = size_of(value);
+      if (n > out.size()) {
+         return std::unexpected(view_error::size_overflow);
+      }
+      write_to(value, out.data());
+      return n;
+   }
+
+   // Replaces `out` with the encoded `value`, allocating once (or not at all when `out` already
+   // has the capacity) and without zero-filling the bytes first
+   template <class T>
+   inline void write_exact(const T& value, std::string& out)
+   {
+      const size_t n = size_of(value);
+      out.clear();
+      out.resize_and_overwrite(n, [&](char* p, size_t) { return size_t(write_to(value, p) - p); });
+   }
+
+   // Writes the encoded `value` to `path` through a mapping of the file at its final size, so the
+   // bytes go straight to the page cache with no intermediate buffer
+   template <class T>
+   inline bool write_file_exact(const T& value, const std::string& path)
+   {
+      mapped_output file;
+      if (!file.create(path, size_of(value))) {
+         return false;
+      }
+      write_to(value, file.data());
+      return file.close();
+   }
+}
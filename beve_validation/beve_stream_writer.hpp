@@ -0,0 +1,407 @@
+#pragma once
+
+// Bounded-memory BEVE writer.
+//
+// `stream_writer` emits BEVE directly to a file descriptor through a fixed-size buffer, so
+// values far larger than RAM can be written as long as their element counts are known up
+// front (BEVE prefixes every container with its count, never its byte length). Typed arrays
+// are declared with their final length and then filled chunk by chunk; chunks larger than the
+// buffer bypass it entirely. Peak memory is the buffer plus whatever chunk the caller holds.
+//
+//    beve::stream_writer out;
+//    out.open("capture.beve");
+//    out.begin_object(2);
+//    out.key("rate");
+//    out.value(48000.0);
+//    out.key("samples");
+//    out.begin_typed_array<float>(n);
+//    while (...) out.push(std::span<const float>(chunk));
+//    out.close();
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "beve_core.hpp"
+
+namespace beve
+{
+   class stream_writer
+   {
+     public:
+      static constexpr size_t default_buffer_size = size_t(1) << 20;
+
+      stream_writer() = default;
+
+      // Writes to an already open descriptor, which the caller keeps ownership of
+      explicit stream_writer(int fd, size_t buffer_size = default_buffer_size) : fd_(fd)
+      {
+         buffer_.resize(std::max<size_t>(buffer_size, 64));
+      }
+
+      ~stream_writer() { close(); }
+
+      stream_writer(const stream_writer&) = delete;
+      stream_writer& operator=(const stream_writer&) = delete;
+
+      bool open(const std::string& path, size_t buffer_size = default_buffer_size)
+      {
+         close();
+         fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+         if (fd_ < 0) {
+            return fail(std::string("open failed: ") + std::strerror(errno));
+         }
+         owns_fd_ = true;
+         root_written_ = false;
+         error_.clear();
+         bytes_written_ = 0;
+         buffer_.resize(std::max<size_t>(buffer_size, 64));
+         return true;
+      }
+
+      // Flushes, checks that every declared container was filled, and releases an owned descriptor
+      bool close()
+      {
+         if (fd_ < 0) {
+            return ok();
+         }
+         flush();
+         if (ok() && !open_.empty()) {
+            fail("stream closed with " + std::to_string(open_.back().remaining) + " values still owed");
+         }
+         if (owns_fd_) {
+            ::close(fd_);
+            owns_fd_ = false;
+         }
+         fd_ = -1;
+         open_.clear();
+         return ok();
+      }
+
+      bool ok() const noexcept { return error_.empty(); }
+      const std::string& error() const noexcept { return error_; }
+      uint64_t bytes_written() const noexcept { return bytes_written_ + used_; }
+      size_t buffer_size() const noexcept { return buffer_.size(); }
+
+      void begin_object(uint64_t count)
+      {
+         begin_value();
+         put_byte(headers::string_object);
+         put_size(count);
+         push_container(container::object, count);
+      }
+
+      void key(std::string_view k)
+      {
+         if (open_.empty() || open_.back().kind != container::object || open_.back().expecting_value) {
+            fail("key written outside of an object");
+            return;
+         }
+         put_size(k.size());
+         put_bytes(k.data(), k.size());
+         open_.back().expecting_value = true;
+      }
+
+      void begin_array(uint64_t count)
+      {
+         begin_value();
+         put_byte(headers::generic_array);
+         put_size(count);
+         push_container(container::generic_array, count);
+      }
+
+      // Declares a typed array of exactly `count` elements, to be supplied through push()
+      template <class T>
+      void begin_typed_array(uint64_t count)
+      {
+         begin_value();
+         put_byte(typed_array_header<T>());
+         put_size(count);
+         push_container(container::typed_array, count, typed_array_header<T>());
+      }
+
+      // Declares an array of exactly `count` std::complex<T>, to be supplied through push()
+      template <class T>
+      void begin_complex_array(uint64_t count)
+      {
+         begin_value();
+         put_byte(headers::complex);
+         put_byte(complex_array_header<T>());
+         put_size(count);
+         push_container(container::typed_array, count, headers::complex, complex_array_header<T>());
+      }
+
+      template <class T>
+      void push(std::span<const T> elements)
+      {
+         static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>);
+         if (open_.empty() || open_.back().kind != container::typed_array ||
+             !element_matches<T>(open_.back().header, open_.back().complex_header)) {
+            fail("push without a matching begin_typed_array");
+            return;
+         }
+         auto& top = open_.back();
+         if (elements.size() > top.remaining) {
+            fail("push exceeds the declared typed array length");
+            return;
+         }
+         if constexpr (std::endian::native == std::endian::little || sizeof(T) == 1) {
+            put_bytes(reinterpret_cast<const char*>(elements.data()), elements.size_bytes());
+         }
+         else {
+            for (T v : elements) {
+               put_scalar(v);
+            }
+         }
+         top.remaining -= elements.size();
+         if (top.remaining == 0) {
+            pop_container();
+         }
+      }
+
+      template <class T>
+      void push(std::span<const std::complex<T>> elements)
+      {
+         if (open_.empty() || open_.back().kind != container::typed_array ||
+             !element_matches<std::complex<T>>(open_.back().header, open_.back().complex_header)) {
+            fail("push without a matching begin_complex_array");
+            return;
+         }
+         auto& top = open_.back();
+         if (elements.size() > top.remaining) {
+            fail("push exceeds the declared complex array length");
+            return;
+         }
+         if constexpr (std::endian::native == std::endian::little) {
+            put_bytes(reinterpret_cast<const char*>(elements.data()), elements.size_bytes());
+         }
+         else {
+            for (const auto& v : elements) {
+               put_scalar(v.real());
+               put_scalar(v.imag());
+            }
+         }
+         top.remaining -= elements.size();
+         if (top.remaining == 0) {
+            pop_container();
+         }
+      }
+
+      template <class T>
+      void push(const std::vector<T>& elements)
+      {
+         push(std::span<const T>(elements));
+      }
+
+      void value(std::nullptr_t)
+      {
+         begin_value();
+         put_byte(headers::null);
+         end_value();
+      }
+
+      void value(bool b)
+      {
+         begin_value();
+         put_byte(b ? headers::boolean_true : headers::boolean_false);
+         end_value();
+      }
+
+      template <class T>
+         requires(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>)
+      void value(T v)
+      {
+         begin_value();
+         put_byte(number_header<T>());
+         put_scalar(v);
+         end_value();
+      }
+
+      void value(std::string_view s)
+      {
+         begin_value();
+         put_byte(headers::string);
+         put_size(s.size());
+         put_bytes(s.data(), s.size());
+         end_value();
+      }
+
+      void value(const char* s) { value(std::string_view(s)); }
+
+      // Splices in a value that is already BEVE encoded (e.g. the output of glz::write_beve)
+      void raw(std::string_view encoded)
+      {
+         begin_value();
+         put_bytes(encoded.data(), encoded.size());
+         end_value();
+      }
+
+      bool flush()
+      {
+         if (used_ > 0 && ok()) {
+            write_all(buffer_.data(), used_);
+            bytes_written_ += used_;
+         }
+         used_ = 0;
+         return ok();
+      }
+
+     private:
+      enum class container : uint8_t { object, generic_array, typed_array };
+
+      struct frame
+      {
+         container kind;
+         uint64_t remaining;
+         uint8_t header = 0; // typed arrays: the declared element header, or headers::complex
+         uint8_t complex_header = 0; // and the component header for complex arrays
+         bool expecting_value = false;
+      };
+
+      bool fail(std::string message)
+      {
+         if (error_.empty()) {
+            error_ = std::move(message);
+         }
+         return false;
+      }
+
+      void push_container(container kind, uint64_t count, uint8_t header = 0, uint8_t complex_header = 0)
+      {
+         if (count == 0) {
+            end_value();
+            return;
+         }
+         open_.push_back({kind, count, header, complex_header, false});
+      }
+
+      void pop_container()
+      {
+         open_.pop_back();
+         end_value();
+      }
+
+      // Validates that a value may start here (inside an object it must follow a key)
+      void begin_value()
+      {
+         if (open_.empty()) {
+            if (root_written_) {
+               fail("more than one root value");
+            }
+            return;
+         }
+         const auto& top = open_.back();
+         if (top.kind == container::typed_array) {
+            fail("typed array elements must be supplied with push()");
+         }
+         else if (top.kind == container::object && !top.expecting_value) {
+            fail("object value written without a key");
+         }
+      }
+
+      // Accounts for a completed value in the enclosing container, closing containers as they fill
+      void end_value()
+      {
+         if (open_.empty()) {
+            root_written_ = true;
+            return;
+         }
+         auto& top = open_.back();
+         top.expecting_value = false;
+         if (--top.remaining == 0) {
+            pop_container();
+         }
+      }
+
+      void put_byte(uint8_t b)
+      {
+         if (used_ == buffer_.size()) {
+            flush();
+         }
+         buffer_[used_++] = char(b);
+      }
+
+      void put_size(uint64_t n)
+      {
+         if (n > max_compressed_size) {
+            fail("size too large");
+            return;
+         }
+         if (buffer_.size() - used_ < 8) {
+            flush();
+         }
+         used_ += encode_compressed_size(buffer_.data() + used_, n);
+      }
+
+      // BEVE is little endian on the wire
+      template <class T>
+      void put_scalar(T v)
+      {
+         char bytes[sizeof(T)];
+         std::memcpy(bytes, &v, sizeof(T));
+         if constexpr (std::endian::native == std::endian::big) {
+            std::reverse(bytes, bytes + sizeof(T));
+         }
+         put_bytes(bytes, sizeof(T));
+      }
+
+      void put_bytes(const char* data, size_t n)
+      {
+         if (n >= buffer_.size()) {
+            // Large payloads go straight to the descriptor without touching the buffer
+            flush();
+            if (ok()) {
+               write_all(data, n);
+               bytes_written_ += n;
+            }
+            return;
+         }
+         if (buffer_.size() - used_ < n) {
+            flush();
+         }
+         std::memcpy(buffer_.data() + used_, data, n);
+         used_ += n;
+      }
+
+      void write_all(const char* data, size_t n)
+      {
+         if (fd_ < 0) {
+            fail("stream is not open");
+            return;
+         }
+         while (n > 0) {
+            const auto w = ::write(fd_, data, n);
+            if (w < 0) {
+               if (errno == EINTR) {
+                  continue;
+               }
+               fail(std::string("write failed: ") + std::strerror(errno));
+               return;
+            }
+            data += w;
+            n -= size_t(w);
+         }
+      }
+
+      int fd_ = -1;
+      bool owns_fd_ = false;
+      bool root_written_ = false;
+      std::vector<char> buffer_ = std::vector<char>(default_buffer_size);
+      size_t used_ = 0;
+      uint64_t bytes_written_ = 0;
+      std::vector<frame> open_;
+      std::string error_;
+   };
+}
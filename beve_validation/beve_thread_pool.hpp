@@ -0,0 +1,156 @@
+#pragma once
+
+// Work-stealing thread pool for embarrassingly parallel batch jobs (validating, converting or
+// benchmarking many independent files).
+//
+// Every worker owns a deque. Submitted tasks are dealt round-robin across the deques; a worker
+// pops from the back of its own deque and, once that is empty, steals from the front of the
+// others. Tasks of very uneven cost (a few large files among many small ones) therefore keep
+// every core busy until the whole batch drains. Tasks must not throw.
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace beve
+{
+   class thread_pool
+   {
+     public:
+      using task = std::function<void()>;
+
+      explicit thread_pool(size_t threads = default_threads())
+      {
+         threads = std::max<size_t>(threads, 1);
+         queues_.reserve(threads);
+         for (size_t i = 0; i < threads; ++i) {
+            queues_.push_back(std::make_unique<queue>());
+         }
+         workers_.reserve(threads);
+         for (size_t i = 0; i < threads; ++i) {
+            workers_.emplace_back([this, i] { run(i); });
+         }
+      }
+
+      ~thread_pool()
+      {
+         wait();
+         {
+            std::lock_guard lock(wake_mutex_);
+            stopping_ = true;
+         }
+         wake_.notify_all();
+         for (auto& w : workers_) {
+            w.join();
+         }
+      }
+
+      thread_pool(const thread_pool&) = delete;
+      thread_pool& operator=(const thread_pool&) = delete;
+
+      static size_t default_threads() noexcept { return std::max(1u, std::thread::hardware_concurrency()); }
+
+      size_t size() const noexcept { return workers_.size(); }
+
+      void submit(task t)
+      {
+         auto& q = *queues_[next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size()];
+         {
+            std::lock_guard lock(q.mutex);
+            q.tasks.push_back(std::move(t));
+         }
+         {
+            std::lock_guard lock(wake_mutex_);
+            ++queued_;
+            ++unfinished_;
+         }
+         wake_.notify_one();
+      }
+
+      // Blocks until every task submitted so far has finished
+      void wait()
+      {
+         std::unique_lock lock(wake_mutex_);
+         idle_.wait(lock, [this] { return unfinished_ == 0; });
+      }
+
+     private:
+      struct queue
+      {
+         std::mutex mutex;
+         std::deque<task> tasks;
+      };
+
+      std::optional<task> take(size_t self)
+      {
+         {
+            auto& own = *queues_[self];
+            std::lock_guard lock(own.mutex);
+            if (!own.tasks.empty()) {
+               task t = std::move(own.tasks.back());
+               own.tasks.pop_back();
+               return t;
+            }
+         }
+         for (size_t k = 1; k < queues_.size(); ++k) {
+            auto& victim = *queues_[(self + k) % queues_.size()];
+            std::lock_guard lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+               task t = std::move(victim.tasks.front());
+               victim.tasks.pop_front();
+               return t;
+            }
+         }
+         return std::nullopt;
+      }
+
+      void run(size_t self)
+      {
+         while (true) {
+            {
+               std::unique_lock lock(wake_mutex_);
+               wake_.wait(lock, [this] { return stopping_ || queued_ > 0; });
+               if (queued_ == 0) {
+                  return; // stopping and drained
+               }
+               --queued_; // claims one task
+            }
+            // submit() pushes before it counts, so a claimed task is always in some deque, but a
+            // concurrent thief can take the one we would have found from a deque we already
+            // scanned while leaving another behind us; rescan until we get one
+            std::optional<task> t;
+            while (!(t = take(self))) {
+               std::this_thread::yield();
+            }
+            (*t)();
+            bool drained = false;
+            {
+               std::lock_guard lock(wake_mutex_);
+               drained = --unfinished_ == 0;
+            }
+            if (drained) {
+               idle_.notify_all();
+            }
+         }
+      }
+
+      std::vector<std::unique_ptr<queue>> queues_;
+      std::vector<std::thread> workers_;
+      std::atomic<size_t> next_queue_{0};
+
+      std::mutex wake_mutex_;
+      std::condition_variable wake_;
+      std::condition_variable idle_;
+      size_t queued_ = 0; // submitted but not yet claimed by a worker
+      size_t unfinished_ = 0; // submitted but not yet completed
+      bool stopping_ = false;
+   };
+}
@@ -0,0 +1,381 @@
+#pragma once
+
+// Lazy, read-only random access over encoded BEVE bytes.
+//
+// A `beve_view` refers to one encoded value inside a caller-owned buffer (a std::string, a
+// `beve::mapped_file`, ...). Nothing is decoded up front: objects and generic arrays build an
+// offset table of their children the first time they are indexed, typed arrays and matrices
+// expose their payload in place, and `raw()` yields the exact encoded bytes of a value so that
+// `glz::read_beve` can decode just that value. The buffer must outlive every view into it.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "beve_core.hpp"
+
+namespace beve
+{
+   // A typed array (or complex array) payload addressed in place
+   struct typed_array_view
+   {
+      uint8_t header{}; // element header: the typed array header, or headers::complex
+      uint8_t complex_header{}; // complex arrays only: the component header that follows headers::complex
+      const char* data{};
+      size_t count{};
+      size_t element_size{}; // bytes per element; 2 * component width for complex arrays
+
+      size_t size_bytes() const noexcept { return count * element_size; }
+
+      // A planar complex array stores every real part and then every imaginary part, so its
+      // elements are not contiguous; read it with beve_planar.hpp
+      bool planar() const noexcept { return header == headers::complex && (complex_header & 0b010) != 0; }
+
+      // Reinterprets the payload as T. BEVE does not align payloads, so this only succeeds when
+      // the element width matches and the bytes happen to be suitably aligned for T; use
+      // `copy_to` or `get` otherwise.
+      template <class T>
+      std::optional<std::span<const T>> as_span() const noexcept
+      {
+         if (sizeof(T) != element_size || planar() || reinterpret_cast<uintptr_t>(data) % alignof(T) != 0) {
+            return std::nullopt;
+         }
+         return std::span<const T>(reinterpret_cast<const T*>(data), count);
+      }
+
+      template <class T>
+      T get(size_t i) const noexcept
+      {
+         T value;
+         if (planar()) {
+            const size_t half = element_size / 2;
+            std::memcpy(reinterpret_cast<char*>(&value), data + i * half, half);
+            std::memcpy(reinterpret_cast<char*>(&value) + half, data + (count + i) * half, half);
+            return value;
+         }
+         std::memcpy(&value, data + i * element_size, sizeof(T));
+         return value;
+      }
+
+      template <class T>
+      bool copy_to(std::span<T> out) const noexcept
+      {
+         if (sizeof(T) != element_size || planar() || out.size() < count) {
+            return false;
+         }
+         std::memcpy(out.data(), data, size_bytes());
+         return true;
+      }
+   };
+
+   class beve_view;
+
+   struct matrix_view
+   {
+      bool column_major{};
+      std::vector<uint64_t> extents;
+      typed_array_view data;
+   };
+
+   class beve_view
+   {
+     public:
+      beve_view() = default;
+
+      // Views the value that starts at the beginning of `bytes`
+      explicit beve_view(std::string_view bytes) noexcept : buffer_(bytes) {}
+
+      uint8_t header() const noexcept { return buffer_.empty() ? headers::null : uint8_t(buffer_[0]); }
+      value_type type() const noexcept { return type_of(header()); }
+      bool empty() const noexcept { return buffer_.empty(); }
+
+      bool is_object() const noexcept { return type() == value_type::object; }
+      bool is_string_object() const noexcept { return header() == headers::string_object; }
+      bool is_generic_array() const noexcept { return type() == value_type::generic_array; }
+      bool is_typed_array() const noexcept { return type() == value_type::typed_array; }
+      bool is_matrix() const noexcept { return header() == headers::matrix; }
+
+      // The exact encoded bytes of this value, suitable for glz::read_beve
+      std::expected<std::string_view, view_error> raw() const noexcept
+      {
+         if (extent_ == npos) {
+            auto end = skip_value(buffer_, 0);
+            if (!end) {
+               return std::unexpected(end.error());
+            }
+            extent_ = *end;
+         }
+         return buffer_.substr(0, extent_);
+      }
+
+      // Number of keys (objects) or elements (arrays); read from the header without walking
+      std::expected<size_t, view_error> size() const noexcept
+      {
+         const auto t = type();
+         if (t != value_type::object && t != value_type::typed_array && t != value_type::generic_array) {
+            return std::unexpected(view_error::type_mismatch);
+         }
+         size_t pos = 1;
+         auto n = read_compressed_size(buffer_, pos);
+         if (!n) {
+            return std::unexpected(n.error());
+         }
+         return size_t(*n);
+      }
+
+      // Looks up a key of a string-keyed object. The first lookup walks the object once to record
+      // every key and value offset; subsequent lookups only consult that table.
+      std::expected<beve_view, view_error> find(std::string_view key) const
+      {
+         if (!is_string_object()) {
+            return std::unexpected(view_error::type_mismatch);
+         }
+         if (auto r = build_table(); !r) {
+            return std::unexpected(r.error());
+         }
+         const auto& t = *table_;
+         if (!t.by_key.empty()) {
+            if (auto it = t.by_key.find(key); it != t.by_key.end()) {
+               return child(t.entries[it->second]);
+            }
+            return std::unexpected(view_error::key_not_found);
+         }
+         for (const auto& e : t.entries) {
+            if (e.key == key) {
+               return child(e);
+            }
+         }
+         return std::unexpected(view_error::key_not_found);
+      }
+
+      // Element `i` of a generic array, or value `i` of an object (in encoded order)
+      std::expected<beve_view, view_error> at(size_t i) const
+      {
+         if (!is_generic_array() && !is_object()) {
+            return std::unexpected(view_error::type_mismatch);
+         }
+         if (auto r = build_table(); !r) {
+            return std::unexpected(r.error());
+         }
+         if (i >= table_->entries.size()) {
+            return std::unexpected(view_error::index_out_of_range);
+         }
+         return child(table_->entries[i]);
+      }
+
+      // Keys of a string-keyed object in encoded order
+      std::expected<std::vector<std::string_view>, view_error> keys() const
+      {
+         if (!is_string_object()) {
+            return std::unexpected(view_error::type_mismatch);
+         }
+         if (auto r = build_table(); !r) {
+            return std::unexpected(r.error());
+         }
+         std::vector<std::string_view> out;
+         out.reserve(table_->entries.size());
+         for (const auto& e : table_->entries) {
+            out.push_back(e.key);
+         }
+         return out;
+      }
+
+      std::expected<std::string_view, view_error> as_string() const noexcept
+      {
+         if (header() != headers::string) {
+            return std::unexpected(view_error::type_mismatch);
+         }
+         size_t pos = 1;
+         auto n = read_compressed_size(buffer_, pos);
+         if (!n) {
+            return std::unexpected(n.error());
+         }
+         if (*n > buffer_.size() - pos) {
+            return std::unexpected(view_error::size_overflow);
+         }
+         return buffer_.substr(pos, size_t(*n));
+      }
+
+      // Reads a scalar number whose encoded width matches sizeof(T)
+      template <class T>
+      std::expected<T, view_error> as_number() const noexcept
+      {
+         if (type() != value_type::number || byte_count(header()) != sizeof(T)) {
+            return std::unexpected(view_error::type_mismatch);
+         }
+         if (buffer_.size() < 1 + sizeof(T)) {
+            return std::unexpected(view_error::unexpected_end);
+         }
+         T value;
+         std::memcpy(&value, buffer_.data() + 1, sizeof(T));
+         return value;
+      }
+
+      std::expected<bool, view_error> as_bool() const noexcept
+      {
+         if (header() == headers::boolean_true) return true;
+         if (header() == headers::boolean_false) return false;
+         return std::unexpected(view_error::type_mismatch);
+      }
+
+      // Numeric typed arrays and complex arrays
+      std::expected<typed_array_view, view_error> as_typed_array() const noexcept
+      {
+         const uint8_t h = header();
+         size_t pos = 1;
+         typed_array_view out;
+         if (h == headers::complex) {
+            if (buffer_.size() < 2 || (uint8_t(buffer_[1]) & 0b101) != 1) { // arrays, interleaved or planar
+               return std::unexpected(view_error::type_mismatch);
+            }
+            out.complex_header = uint8_t(buffer_[1]);
+            out.element_size = 2 * byte_count(out.complex_header);
+            pos = 2;
+         }
+         else if (type() == value_type::typed_array && ((h >> 3) & 0b11) < 3) {
+            out.element_size = byte_count(h);
+         }
+         else {
+            return std::unexpected(view_error::type_mismatch);
+         }
+         auto n = read_compressed_size(buffer_, pos);
+         if (!n) {
+            return std::unexpected(n.error());
+         }
+         if (*n > (buffer_.size() - pos) / out.element_size) {
+            return std::unexpected(view_error::size_overflow);
+         }
+         out.header = h;
+         out.data = buffer_.data() + pos;
+         out.count = size_t(*n);
+         return out;
+      }
+
+      std::expected<matrix_view, view_error> as_matrix() const
+      {
+         if (!is_matrix()) {
+            return std::unexpected(view_error::type_mismatch);
+         }
+         if (buffer_.size() < 3) {
+            return std::unexpected(view_error::unexpected_end);
+         }
+         matrix_view out;
+         out.column_major = (uint8_t(buffer_[1]) & 1) != 0;
+
+         beve_view extents_view{buffer_.substr(2)};
+         auto extents = extents_view.as_typed_array();
+         if (!extents || ((extents->header >> 3) & 0b11) == 0) {
+            return std::unexpected(view_error::type_mismatch);
+         }
+         out.extents.reserve(extents->count);
+         const bool is_signed = ((extents->header >> 3) & 0b11) == 1;
+         for (size_t i = 0; i < extents->count; ++i) {
+            uint64_t e = 0;
+            std::memcpy(&e, extents->data + i * extents->element_size, extents->element_size);
+            if (is_signed && extents->element_size < 8 && (e >> (8 * extents->element_size - 1))) {
+               return std::unexpected(view_error::invalid_header); // negative extent
+            }
+            out.extents.push_back(e);
+         }
+         const size_t data_pos = size_t(extents->data - buffer_.data()) + extents->size_bytes();
+         auto data = beve_view{buffer_.substr(data_pos)}.as_typed_array();
+         if (!data) {
+            return std::unexpected(data.error());
+         }
+         out.data = *data;
+         return out;
+      }
+
+     private:
+      static constexpr size_t npos = size_t(-1);
+
+      struct entry
+      {
+         std::string_view key; // empty for generic array elements and integer keys
+         size_t begin;
+         size_t end;
+      };
+
+      struct offset_table
+      {
+         std::vector<entry> entries;
+         std::unordered_map<std::string_view, size_t> by_key; // only populated for larger objects
+      };
+
+      // Objects with more keys than this get a hash index in addition to the ordered table
+      static constexpr size_t hash_threshold = 16;
+
+      beve_view child(const entry& e) const noexcept
+      {
+         beve_view v{buffer_.substr(e.begin, e.end - e.begin)};
+         v.extent_ = e.end - e.begin;
+         return v;
+      }
+
+      std::expected<void, view_error> build_table() const
+      {
+         if (table_) {
+            return {};
+         }
+         auto table = std::make_shared<offset_table>();
+         size_t pos = 1;
+         auto count = read_compressed_size(buffer_, pos);
+         if (!count) {
+            return std::unexpected(count.error());
+         }
+         // Every element occupies at least one byte, which bounds a hostile count
+         if (*count > buffer_.size() - pos) {
+            return std::unexpected(view_error::size_overflow);
+         }
+         table->entries.reserve(size_t(*count));
+         const bool object = is_object();
+         const bool string_keys = is_string_object();
+         for (uint64_t i = 0; i < *count; ++i) {
+            entry e{};
+            if (string_keys) {
+               auto n = read_compressed_size(buffer_, pos);
+               if (!n) {
+                  return std::unexpected(n.error());
+               }
+               if (*n > buffer_.size() - pos) {
+                  return std::unexpected(view_error::size_overflow);
+               }
+               e.key = buffer_.substr(pos, size_t(*n));
+               pos += size_t(*n);
+            }
+            else if (object) {
+               if (auto r = detail::advance(buffer_, pos, byte_count(header())); !r) {
+                  return std::unexpected(r.error());
+               }
+            }
+            e.begin = pos;
+            auto end = skip_value(buffer_, pos);
+            if (!end) {
+               return std::unexpected(end.error());
+            }
+            e.end = pos = *end;
+            table->entries.push_back(e);
+         }
+         if (string_keys && table->entries.size() > hash_threshold) {
+            table->by_key.reserve(table->entries.size());
+            for (size_t i = 0; i < table->entries.size(); ++i) {
+               table->by_key.emplace(table->entries[i].key, i);
+            }
+         }
+         extent_ = pos;
+         table_ = std::move(table);
+         return {};
+      }
+
+      std::string_view buffer_{};
+      mutable size_t extent_ = npos;
+      mutable std::shared_ptr<const offset_table> table_{};
+   };
+}
@@ -0,0 +1,208 @@
+#pragma once
+
+// zstd-compressed BEVE, the C++ side of BEVE.jl's CodecZstd extension (`to_beve_zstd`,
+// `read_beve_zstd_file`, ...).
+//
+// A compressed BEVE payload is nothing more than the plain BEVE bytes wrapped in standard zstd
+// frames, so files written here can be read with `read_beve_zstd_file` in Julia and vice versa.
+// Frames written by zstd_codec always record their content size, which lets decompression size
+// its output exactly; frames from streaming writers (TranscodingStreams in Julia, `zstd` on the
+// command line when reading a pipe) may not, and are decompressed incrementally instead.
+//
+// A zstd_codec owns its compression and decompression contexts and scratch buffers, so reusing
+// one codec across calls avoids re-allocating zstd's window tables and the intermediate BEVE
+// buffer on every message. A codec is not thread safe; use one per thread.
+
+#include <glaze/glaze.hpp>
+#include <glaze/beve.hpp>
+
+#include <zstd.h>
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#include "beve_mmap.hpp"
+
+namespace beve
+{
+   class zstd_codec
+   {
+     public:
+      static constexpr int default_level = 3; // matches DEFAULT_ZSTD_LEVEL in ext/CodecZstdExt.jl
+
+      static int min_level() noexcept { return ZSTD_minCLevel(); }
+      static int max_level() noexcept { return ZSTD_maxCLevel(); }
+
+      zstd_codec() = default;
+      ~zstd_codec()
+      {
+         ZSTD_freeCCtx(cctx_);
+         ZSTD_freeDCtx(dctx_);
+      }
+
+      zstd_codec(const zstd_codec&) = delete;
+      zstd_codec& operator=(const zstd_codec&) = delete;
+
+      // Compresses `raw` into a single frame, replacing the contents of `out`
+      bool compress(std::string_view raw, std::string& out, int level = default_level)
+      {
+         if (!cctx_ && !(cctx_ = ZSTD_createCCtx())) {
+            return fail("ZSTD_createCCtx failed");
+         }
+         ZSTD_CCtx_reset(cctx_, ZSTD_reset_session_and_parameters);
+         if (const size_t rc = ZSTD_CCtx_setParameter(cctx_, ZSTD_c_compressionLevel, level); ZSTD_isError(rc)) {
+            return fail(rc);
+         }
+         out.resize(ZSTD_compressBound(raw.size()));
+         const size_t n = ZSTD_compress2(cctx_, out.data(), out.size(), raw.data(), raw.size());
+         if (ZSTD_isError(n)) {
+            return fail(n);
+         }
+         out.resize(n);
+         return true;
+      }
+
+      // Decompresses one or more concatenated frames, replacing the contents of `out`
+      bool decompress(std::string_view compressed, std::string& out)
+      {
+         if (!dctx_ && !(dctx_ = ZSTD_createDCtx())) {
+            return fail("ZSTD_createDCtx failed");
+         }
+         ZSTD_DCtx_reset(dctx_, ZSTD_reset_session_only);
+         if (compressed.empty()) {
+            return fail("empty input");
+         }
+
+         const unsigned long long known = content_size(compressed);
+         if (known == ZSTD_CONTENTSIZE_ERROR) {
+            return fail("not a complete zstd frame");
+         }
+         if (known != ZSTD_CONTENTSIZE_UNKNOWN) {
+            out.resize(size_t(known));
+            const size_t n = ZSTD_decompressDCtx(dctx_, out.data(), out.size(), compressed.data(), compressed.size());
+            if (ZSTD_isError(n)) {
+               return fail(n);
+            }
+            if (n != out.size()) {
+               return fail("frame content size does not match the decompressed data");
+            }
+            return true;
+         }
+
+         // No content size in some frame: grow the output as the stream decodes
+         out.resize(std::max(compressed.size() * 4, ZSTD_DStreamOutSize()));
+         ZSTD_inBuffer in{compressed.data(), compressed.size(), 0};
+         ZSTD_outBuffer dst{out.data(), out.size(), 0};
+         size_t remaining = 1;
+         while (in.pos < in.size || remaining != 0) {
+            if (dst.pos == dst.size) {
+               out.resize(out.size() * 2);
+               dst.dst = out.data();
+               dst.size = out.size();
+            }
+            const size_t out_before = dst.pos;
+            remaining = ZSTD_decompressStream(dctx_, &dst, &in);
+            if (ZSTD_isError(remaining)) {
+               return fail(remaining);
+            }
+            if (in.pos == in.size && remaining != 0 && dst.pos == out_before && dst.pos < dst.size) {
+               return fail("truncated zstd frame");
+            }
+         }
+         out.resize(dst.pos);
+         return true;
+      }
+
+      // Serializes `value` to BEVE and compresses it into `out`
+      template <class T>
+      bool write(const T& value, std::string& out, int level = default_level)
+      {
+         if (auto ec = glz::write_beve(value, raw_)) {
+            return fail("BEVE write failed: " + glz::format_error(ec));
+         }
+         return compress(raw_, out, level);
+      }
+
+      // Decompresses `compressed` and decodes the BEVE payload into `value`
+      template <class T>
+      bool read(T& value, std::string_view compressed)
+      {
+         if (!decompress(compressed, raw_)) {
+            return false;
+         }
+         if (auto ec = glz::read_beve(value, raw_)) {
+            return fail("BEVE read failed: " + glz::format_error(ec, raw_));
+         }
+         return true;
+      }
+
+      template <class T>
+      bool write_file(const T& value, const std::string& path, int level = default_level)
+      {
+         if (!write(value, compressed_, level)) {
+            return false;
+         }
+         std::ofstream file(path, std::ios::binary);
+         if (!file.write(compressed_.data(), std::streamsize(compressed_.size()))) {
+            return fail("failed to write " + path);
+         }
+         return true;
+      }
+
+      template <class T>
+      bool read_file(T& value, const std::string& path)
+      {
+         mapped_file file;
+         if (!file.open(path)) {
+            return fail("failed to open " + path + ": " + file.error());
+         }
+         return read(value, file.view());
+      }
+
+      // The uncompressed BEVE bytes of the last successful write() or read()
+      std::string_view last_beve() const noexcept { return raw_; }
+
+      const std::string& error() const noexcept { return error_; }
+
+     private:
+      // Total decompressed size of all frames, ZSTD_CONTENTSIZE_UNKNOWN if any frame does not
+      // record it, ZSTD_CONTENTSIZE_ERROR if the input is not a sequence of zstd frames
+      static unsigned long long content_size(std::string_view compressed) noexcept
+      {
+         unsigned long long total = 0;
+         while (!compressed.empty()) {
+            const unsigned long long frame = ZSTD_getFrameContentSize(compressed.data(), compressed.size());
+            if (frame == ZSTD_CONTENTSIZE_ERROR || frame == ZSTD_CONTENTSIZE_UNKNOWN) {
+               return frame;
+            }
+            const size_t frame_bytes = ZSTD_findFrameCompressedSize(compressed.data(), compressed.size());
+            if (ZSTD_isError(frame_bytes)) {
+               return ZSTD_CONTENTSIZE_ERROR;
+            }
+            total += frame;
+            compressed.remove_prefix(frame_bytes);
+         }
+         return total;
+      }
+
+      bool fail(size_t zstd_code)
+      {
+         error_ = ZSTD_getErrorName(zstd_code);
+         return false;
+      }
+
+      bool fail(std::string message)
+      {
+         error_ = std::move(message);
+         return false;
+      }
+
+      ZSTD_CCtx* cctx_ = nullptr;
+      ZSTD_DCtx* dctx_ = nullptr;
+      std::string raw_;
+      std::string compressed_;
+      std::string error_;
+   };
+}
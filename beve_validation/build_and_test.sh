@@ -25,6 +25,56 @@ if [ $? -eq 0 ]; then
     # Run C++ tests to read Julia files
     echo -e "\n=== C++ reading Julia files ==="
     ./build/beve_validator --read-julia
+    
+    # bf16/f16 conversions and the Julia reduced-precision files
+    echo -e "\n=== C++ bf16/f16 tests ==="
+    ./build/test_half
+    
+    # Delta/XOR packed arrays and the Julia packed file
+    echo -e "\n=== C++ packed array tests ==="
+    ./build/test_packed
+    
+    # Shared-memory ring handoff, and the ring test_validation.jl left behind
+    echo -e "\n=== C++ shared-memory ring tests ==="
+    ./build/test_ring
+    
+    # JSON pointers over encoded bytes, and over the Julia all_types file
+    echo -e "\n=== C++ JSON pointer tests ==="
+    ./build/test_pointer
+    
+    # In-place patches, splices and inserted members of encoded buffers
+    echo -e "\n=== C++ patch tests ==="
+    ./build/test_patch
+
+    # Dictionary-encoded keys: round trips, stream tables and malformed input
+    echo -e "\n=== C++ key dictionary tests ==="
+    ./build/test_keys
+
+    # Exact sizes: size_of against the written bytes, caller regions and mapped files
+    echo -e "\n=== C++ exact size tests ==="
+    ./build/test_size
+
+    # Flat maps: sorted and hash-ordered integer-keyed objects, value types and bounds
+    echo -e "\n=== C++ flat map tests ==="
+    ./build/test_flat_map
+
+    # Planar complex arrays: SIMD interleave/deinterleave, both layouts, matrices and bounds
+    echo -e "\n=== C++ planar complex tests ==="
+    ./build/test_planar
+
+    # Async batch writes: io_uring and thread-pool backends, O_DIRECT and registered buffers
+    echo -e "\n=== C++ async writer tests ==="
+    ./build/test_async_writer
+    
+    # C++ HTTP server: JSON pointers, keep-alive and pipelining over loopback
+    echo -e "\n=== C++ HTTP server tests ==="
+    ./build/test_http
+    
+    # zstd round trips and Julia zstd files (only built when zstd is found)
+    if [ -x ./build/test_zstd ]; then
+        echo -e "\n=== C++ zstd tests ==="
+        ./build/test_zstd
+    fi
 else
     echo "Build failed!"
     exit 1
@@ -11,202 +11,24 @@
 #include <array>
 #include <chrono>
 #include <algorithm>
+#include <iomanip>
+#include <numeric>
 
-namespace fs = std::filesystem;
-
-struct BasicTypes {
-   bool b = true;
-   int8_t i8 = -42;
-   uint8_t u8 = 200;
-   int16_t i16 = -1234;
-   uint16_t u16 = 45678;
-   int32_t i32 = -2147483647;
-   uint32_t u32 = 3000000000;
-   int64_t i64 = -9223372036854775807LL;
-   uint64_t u64 = 18446744073709551615ULL;
-   float f32 = 3.14159f;
-   double f64 = 2.718281828459045;
-   std::string str = "Hello, BEVE!";
-};
-
-template <>
-struct glz::meta<BasicTypes> {
-   using T = BasicTypes;
-   static constexpr auto value = object(
-      "b", &T::b,
-      "i8", &T::i8,
-      "u8", &T::u8,
-      "i16", &T::i16,
-      "u16", &T::u16,
-      "i32", &T::i32,
-      "u32", &T::u32,
-      "i64", &T::i64,
-      "u64", &T::u64,
-      "f32", &T::f32,
-      "f64", &T::f64,
-      "str", &T::str
-   );
-};
-
-struct ArrayTypes {
-   std::vector<int32_t> int_vec = {1, 2, 3, 4, 5};
-   std::vector<double> double_vec = {1.1, 2.2, 3.3};
-   std::vector<std::string> string_vec = {"alpha", "beta", "gamma"};
-   std::vector<bool> bool_vec = {true, false, true, true, false};
-   std::array<int32_t, 5> int_array = {10, 20, 30, 40, 50};
-};
-
-template <>
-struct glz::meta<ArrayTypes> {
-   using T = ArrayTypes;
-   static constexpr auto value = object(
-      "int_vec", &T::int_vec,
-      "double_vec", &T::double_vec,
-      "string_vec", &T::string_vec,
-      "bool_vec", &T::bool_vec,
-      "int_array", &T::int_array
-   );
-};
-
-struct ComplexTypes {
-   std::complex<float> cf = {1.5f, 2.5f};
-   std::complex<double> cd = {3.7, 4.8};
-   std::vector<std::complex<float>> complex_vec = {{1.0f, 2.0f}, {3.0f, 4.0f}, {5.0f, 6.0f}};
-};
-
-template <>
-struct glz::meta<ComplexTypes> {
-   using T = ComplexTypes;
-   static constexpr auto value = object(
-      "cf", &T::cf,
-      "cd", &T::cd,
-      "complex_vec", &T::complex_vec
-   );
-};
-
-struct MapTypes {
-   std::map<std::string, int32_t> string_int_map = {{"one", 1}, {"two", 2}, {"three", 3}};
-   std::map<int32_t, std::string> int_string_map = {{1, "first"}, {2, "second"}, {3, "third"}};
-   std::unordered_map<std::string, double> unordered_map = {{"pi", 3.14159}, {"e", 2.71828}};
-};
-
-template <>
-struct glz::meta<MapTypes> {
-   using T = MapTypes;
-   static constexpr auto value = object(
-      "string_int_map", &T::string_int_map,
-      "int_string_map", &T::int_string_map,
-      "unordered_map", &T::unordered_map
-   );
-};
-
-struct OptionalTypes {
-   std::optional<int32_t> opt_int = 42;
-   std::optional<std::string> opt_string = "optional value";
-   std::optional<double> opt_empty = std::nullopt;
-};
-
-template <>
-struct glz::meta<OptionalTypes> {
-   using T = OptionalTypes;
-   static constexpr auto value = object(
-      "opt_int", &T::opt_int,
-      "opt_string", &T::opt_string,
-      "opt_empty", &T::opt_empty
-   );
-};
-
-struct VariantTypes {
-   using var_t = std::variant<int32_t, double, std::string>;
-   var_t var_int = 42;
-   var_t var_double = 3.14;
-   var_t var_string = std::string("variant string");
-};
-
-template <>
-struct glz::meta<VariantTypes> {
-   using T = VariantTypes;
-   static constexpr auto value = object(
-      "var_int", &T::var_int,
-      "var_double", &T::var_double,
-      "var_string", &T::var_string
-   );
-};
-
-struct NestedStruct {
-   BasicTypes basic;
-   ArrayTypes arrays;
-   int32_t extra = 999;
-};
-
-template <>
-struct glz::meta<NestedStruct> {
-   using T = NestedStruct;
-   static constexpr auto value = object(
-      "basic", &T::basic,
-      "arrays", &T::arrays,
-      "extra", &T::extra
-   );
-};
-
-struct AllTypes {
-   BasicTypes basic;
-   ArrayTypes arrays;
-   ComplexTypes complex;
-   MapTypes maps;
-   OptionalTypes optionals;
-   VariantTypes variants;
-   NestedStruct nested;
-};
+#include "beve_async_writer.hpp"
+#include "beve_batch.hpp"
+#include "beve_keys.hpp"
+#include "beve_mmap.hpp"
+#include "beve_parallel_writer.hpp"
+#include "beve_shm_ring.hpp"
+#include "validation_types.hpp"
+#if BEVE_HAS_ZSTD
+#include "beve_zstd.hpp"
+#endif
 
-struct LargeArrayTypes {
-   std::vector<float> large_float_vec;
-   std::vector<double> large_double_vec;
-   std::vector<std::complex<float>> large_complex_float_vec;
-   std::vector<std::complex<double>> large_complex_double_vec;
-   
-   LargeArrayTypes() {
-      // Initialize with 10,000 elements each
-      const size_t size = 10000;
-      
-      large_float_vec.reserve(size);
-      large_double_vec.reserve(size);
-      large_complex_float_vec.reserve(size);
-      large_complex_double_vec.reserve(size);
-      
-      for (size_t i = 0; i < size; ++i) {
-         large_float_vec.push_back(static_cast<float>(i) * 0.1f);
-         large_double_vec.push_back(static_cast<double>(i) * 0.01);
-         large_complex_float_vec.push_back({static_cast<float>(i), static_cast<float>(i) * 0.5f});
-         large_complex_double_vec.push_back({static_cast<double>(i) * 0.1, static_cast<double>(i) * 0.2});
-      }
-   }
-};
-
-template <>
-struct glz::meta<LargeArrayTypes> {
-   using T = LargeArrayTypes;
-   static constexpr auto value = object(
-      "large_float_vec", &T::large_float_vec,
-      "large_double_vec", &T::large_double_vec,
-      "large_complex_float_vec", &T::large_complex_float_vec,
-      "large_complex_double_vec", &T::large_complex_double_vec
-   );
-};
+namespace fs = std::filesystem;
 
-template <>
-struct glz::meta<AllTypes> {
-   using T = AllTypes;
-   static constexpr auto value = object(
-      "basic", &T::basic,
-      "arrays", &T::arrays,
-      "complex", &T::complex,
-      "maps", &T::maps,
-      "optionals", &T::optionals,
-      "variants", &T::variants,
-      "nested", &T::nested
-   );
-};
+// Byte-for-byte checks that fail here make the validator exit non-zero
+static int failed_checks = 0;
 
 template <typename T>
 bool write_beve_file(const T& obj, const std::string& filename) {
@@ -230,24 +52,36 @@ bool write_beve_file(const T& obj, const std::string& filename) {
    return true;
 }
 
+// Queues the file on `writer` and returns once it is encoded; the write completes in the
+// background and failures surface from writer.finish()
+template <typename T>
+bool write_beve_file(const T& obj, const std::string& filename, beve::async_file_writer& writer) {
+   std::string buffer;
+   auto ec = glz::write_beve(obj, buffer);
+   if (ec) {
+      std::cerr << "Failed to serialize to BEVE: " << glz::format_error(ec) << std::endl;
+      return false;
+   }
+   std::cout << "Queued " << buffer.size() << " bytes for " << filename << std::endl;
+   return writer.write(filename, std::move(buffer));
+}
+
 template <typename T>
 bool read_beve_file(T& obj, const std::string& filename) {
-   std::ifstream file(filename, std::ios::binary);
-   if (!file) {
-      std::cerr << "Failed to open file for reading: " << filename << std::endl;
+   // Decode straight out of the page cache rather than copying the file into a string
+   beve::mapped_file file;
+   if (!file.open(filename)) {
+      std::cerr << "Failed to open file for reading: " << filename << " (" << file.error() << ")" << std::endl;
       return false;
    }
    
-   std::string buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-   file.close();
-   
-   auto ec = glz::read_beve(obj, buffer);
+   auto ec = glz::read_beve(obj, file.view());
    if (ec) {
       std::cerr << "Failed to deserialize from BEVE: " << glz::format_error(ec) << std::endl;
       return false;
    }
    
-   std::cout << "Read " << buffer.size() << " bytes from " << filename << std::endl;
+   std::cout << "Read " << file.size() << " bytes from " << filename << std::endl;
    return true;
 }
 
@@ -388,6 +222,39 @@ void test_large_arrays() {
                    << std::endl;
       }
    }
+   
+   // The field-parallel writer must reproduce glz::write_beve byte for byte
+   std::string sequential, parallel;
+   beve::object_writer writer;
+   writer.field("large_float_vec", original.large_float_vec);
+   writer.field("large_double_vec", original.large_double_vec);
+   writer.field("large_complex_float_vec", original.large_complex_float_vec);
+   writer.field("large_complex_double_vec", original.large_complex_double_vec);
+   beve::thread_pool pool;
+   if (auto ec = glz::write_beve(original, sequential)) {
+      std::cout << "Parallel write: ✗ glz::write_beve failed: " << glz::format_error(ec) << std::endl;
+      ++failed_checks;
+   }
+   else if (!writer.write(parallel, pool)) {
+      std::cout << "Parallel write: ✗ " << writer.error() << std::endl;
+      ++failed_checks;
+   }
+   else {
+      std::cout << "Parallel write (" << pool.size() << " threads): "
+                << (parallel == sequential ? "✓ identical to glz::write_beve" : "✗ differs from glz::write_beve")
+                << std::endl;
+      failed_checks += parallel != sequential;
+   }
+   
+   // So must the exact-size encoder, which has its own copy of the schema in beve::layout
+   if (!sequential.empty()) {
+      std::string exact;
+      beve::write_exact(original, exact);
+      std::cout << "Exact-size write (" << beve::size_of(original) << " bytes): "
+                << (exact == sequential ? "✓ identical to glz::write_beve" : "✗ differs from glz::write_beve")
+                << std::endl;
+      failed_checks += exact != sequential;
+   }
 }
 
 void generate_test_files() {
@@ -395,32 +262,122 @@ void generate_test_files() {
    
    fs::create_directory("cpp_generated");
    
+   // Each file is written in the background while the next one is encoded
+   beve::async_file_writer writer;
+   
    BasicTypes basic;
-   write_beve_file(basic, "cpp_generated/basic_types.beve");
+   write_beve_file(basic, "cpp_generated/basic_types.beve", writer);
    
    ArrayTypes arrays;
-   write_beve_file(arrays, "cpp_generated/array_types.beve");
+   write_beve_file(arrays, "cpp_generated/array_types.beve", writer);
    
    ComplexTypes complex;
-   write_beve_file(complex, "cpp_generated/complex_types.beve");
+   write_beve_file(complex, "cpp_generated/complex_types.beve", writer);
    
    MapTypes maps;
-   write_beve_file(maps, "cpp_generated/map_types.beve");
+   write_beve_file(maps, "cpp_generated/map_types.beve", writer);
    
    OptionalTypes optionals;
-   write_beve_file(optionals, "cpp_generated/optional_types.beve");
+   write_beve_file(optionals, "cpp_generated/optional_types.beve", writer);
    
    VariantTypes variants;
-   write_beve_file(variants, "cpp_generated/variant_types.beve");
+   write_beve_file(variants, "cpp_generated/variant_types.beve", writer);
    
    NestedStruct nested;
-   write_beve_file(nested, "cpp_generated/nested_struct.beve");
+   write_beve_file(nested, "cpp_generated/nested_struct.beve", writer);
    
    AllTypes all;
-   write_beve_file(all, "cpp_generated/all_types.beve");
+   write_beve_file(all, "cpp_generated/all_types.beve", writer);
    
    LargeArrayTypes large;
-   write_beve_file(large, "cpp_generated/large_arrays.beve");
+   write_beve_file(large, "cpp_generated/large_arrays.beve", writer);
+   
+   if (!writer.finish()) {
+      std::cerr << "Failed to write test files: " << writer.error() << std::endl;
+   }
+   
+   // A record batch as one object of typed arrays, for deser_beve(Vector{ColumnarRecord}, ...)
+   std::string columnar;
+   beve::write_columnar(std::span<const ColumnarRecord>(make_columnar_records(1000)), columnar_record_columns,
+                        columnar);
+   std::ofstream("cpp_generated/columnar_records.beve", std::ios::binary)
+      .write(columnar.data(), std::streamsize(columnar.size()));
+   
+   // The same records row by row with dictionary-encoded keys, for BEVE.jl's KEY_TABLE reader
+   std::string rows;
+   if (!glz::write_beve(make_columnar_records(1000), rows)) {
+      if (auto keyed = beve::encode_keys(rows)) {
+         std::ofstream("cpp_generated/keyed_records.beve", std::ios::binary)
+            .write(keyed->data(), std::streamsize(keyed->size()));
+         std::cout << "Wrote " << keyed->size() << " bytes to cpp_generated/keyed_records.beve (" << rows.size()
+                   << " with string keys)" << std::endl;
+      }
+   }
+   
+   // The same floats as bf16, f16 and f32 arrays; i * 0.25 for i < 256 is exact in all three
+   std::vector<float> quarters(256);
+   for (size_t i = 0; i < quarters.size(); ++i) {
+      quarters[i] = float(i) * 0.25f;
+   }
+   beve::object_writer half_writer;
+   half_writer.field("bf16", quarters, beve::half_format::bf16);
+   half_writer.field("f16", quarters, beve::half_format::f16);
+   half_writer.field("f32", quarters);
+   beve::thread_pool half_pool(1);
+   if (!half_writer.write_file("cpp_generated/half_arrays.beve", half_pool)) {
+      std::cerr << "Failed to write half_arrays.beve: " << half_writer.error() << std::endl;
+   }
+   
+   // Packed arrays for BEVE.jl's PACKED_ARRAY decoder, one per codec
+   std::vector<float> series(10000);
+   std::vector<int64_t> timestamps(10000);
+   for (size_t i = 0; i < series.size(); ++i) {
+      series[i] = float(i) * 0.1f;
+      timestamps[i] = 1'700'000'000'000 + int64_t(i) * 1000;
+   }
+   beve::object_writer packed_writer;
+   packed_writer.field("floats", series, beve::pack_codec::xor_previous);
+   packed_writer.field("floats_delta", series, beve::pack_codec::delta);
+   packed_writer.field("ints", timestamps, beve::pack_codec::delta);
+   if (!packed_writer.write_file("cpp_generated/packed_arrays.beve", half_pool)) {
+      std::cerr << "Failed to write packed_arrays.beve: " << packed_writer.error() << std::endl;
+   }
+   
+   // A shared-memory ring for open_beve_ring on the Julia side. The segment outlives this
+   // process; test_validation.jl drains and unlinks it.
+   beve::shm_ring ring;
+   if (ring.create("/beve_cpp_ring", size_t(1) << 20)) {
+      std::string frame;
+      (void)glz::write_beve(basic, frame);
+      ring.push(frame);
+      std::vector<float> floats(1000);
+      std::iota(floats.begin(), floats.end(), 1.0f);
+      (void)glz::write_beve(floats, frame);
+      ring.push(frame);
+      ring.close_writer();
+      std::cout << "Wrote 2 frames to the /beve_cpp_ring shared-memory ring" << std::endl;
+   }
+   else {
+      std::cerr << "Failed to create /beve_cpp_ring: " << ring.error() << std::endl;
+   }
+   
+#if BEVE_HAS_ZSTD
+   // Compressed copies for read_beve_zstd_file on the Julia side
+   beve::zstd_codec codec;
+   auto write_zstd = [&](const auto& obj, const std::string& filename) {
+      if (codec.write_file(obj, filename)) {
+         std::cout << "Wrote " << fs::file_size(filename) << " bytes to " << filename << " ("
+                   << codec.last_beve().size() << " uncompressed)" << std::endl;
+      }
+      else {
+         std::cerr << "Failed to write " << filename << ": " << codec.error() << std::endl;
+      }
+   };
+   write_zstd(basic, "cpp_generated/basic_types.beve.zst");
+   write_zstd(complex, "cpp_generated/complex_types.beve.zst");
+   write_zstd(all, "cpp_generated/all_types.beve.zst");
+   write_zstd(large, "cpp_generated/large_arrays.beve.zst");
+#endif
 }
 
 void test_julia_generated_files() {
@@ -435,11 +392,7 @@ void test_julia_generated_files() {
       if (entry.path().extension() == ".beve") {
          std::cout << "\nReading: " << entry.path().filename() << std::endl;
          
-         std::ifstream file(entry.path(), std::ios::binary);
-         std::string buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-         file.close();
-         
-         std::cout << "File size: " << buffer.size() << " bytes" << std::endl;
+         std::cout << "File size: " << fs::file_size(entry.path()) << " bytes" << std::endl;
          
          if (entry.path().filename() == "basic_types.beve") {
             BasicTypes obj;
@@ -447,14 +400,117 @@ void test_julia_generated_files() {
                print_json(obj, "Parsed");
             }
          }
+         else if (entry.path().filename() == "keyed_records.beve") {
+            // Written with dict_keys = true; expanded to plain BEVE for glaze
+            beve::mapped_file file;
+            std::vector<ColumnarRecord> records;
+            if (!file.open(entry.path().string())) {
+               std::cerr << "Failed to open " << entry.path() << ": " << file.error() << std::endl;
+            }
+            else if (auto plain = beve::expand_keys(file.view()); !plain) {
+               std::cerr << "Failed to expand keys: " << beve::to_string(plain.error()) << std::endl;
+            }
+            else if (auto ec = glz::read_beve(records, *plain)) {
+               std::cerr << "Failed to deserialize from BEVE: " << glz::format_error(ec) << std::endl;
+            }
+            else {
+               const auto expected = make_columnar_records(records.size());
+               const bool match = std::equal(records.begin(), records.end(), expected.begin(), [](auto& a, auto& b) {
+                  return a.id == b.id && a.value == b.value && a.name == b.name;
+               });
+               std::cout << records.size() << " records from " << file.size() << " bytes (" << plain->size()
+                         << " expanded), match expected: " << (match ? "✓" : "✗") << std::endl;
+            }
+         }
+      }
+#if BEVE_HAS_ZSTD
+      else if (entry.path().filename() == "basic_types.beve.zst") {
+         std::cout << "\nReading: " << entry.path().filename() << std::endl;
+         beve::zstd_codec codec;
+         BasicTypes obj;
+         if (codec.read_file(obj, entry.path().string())) {
+            std::cout << "Decompressed " << fs::file_size(entry.path()) << " -> " << codec.last_beve().size()
+                      << " bytes" << std::endl;
+            print_json(obj, "Parsed");
+         }
+         else {
+            std::cerr << "Failed to read " << entry.path() << ": " << codec.error() << std::endl;
+         }
+      }
+#endif
+   }
+}
+
+// Validates every .beve file under `dir` in parallel
+int run_batch_validation(const std::string& dir, const beve::batch_options& options, bool quiet) {
+   const auto paths = beve::collect_beve_files(dir);
+   if (paths.empty()) {
+      std::cerr << "No .beve files found under " << dir << std::endl;
+      return 1;
+   }
+   std::cout << "\nValidating " << paths.size() << " files under " << dir << " with " << options.threads
+             << " threads" << (options.decode ? "" : " (structure only)") << "..." << std::endl;
+   
+   const auto report = beve::validate_batch(paths, options);
+   
+   for (const auto& f : report.files) {
+      if (!f.ok) {
+         std::cout << "FAIL " << f.path << ": " << f.error << "\n";
+      }
+      else if (!quiet) {
+         std::cout << "ok   " << f.path << " (" << f.bytes << " bytes)\n";
       }
    }
+   
+   std::cout << "\nHeader histogram:\n";
+   std::vector<std::pair<uint64_t, uint8_t>> histogram;
+   for (size_t h = 0; h < report.header_counts.size(); ++h) {
+      if (report.header_counts[h]) {
+         histogram.emplace_back(report.header_counts[h], uint8_t(h));
+      }
+   }
+   std::sort(histogram.rbegin(), histogram.rend());
+   for (const auto& [n, h] : histogram) {
+      std::cout << "  0x" << std::hex << std::setw(2) << std::setfill('0') << int(h) << std::dec << std::setfill(' ')
+                << " " << std::left << std::setw(16) << beve::header_name(h) << std::right << std::setw(14) << n
+                << "\n";
+   }
+   
+   std::cout << "\nFiles:      " << report.files.size() << " (" << report.failures << " failed)\n";
+   std::cout << "Bytes:      " << report.total_bytes << "\n";
+   std::cout << "Time:       " << std::fixed << std::setprecision(3) << report.seconds << " s\n";
+   std::cout << "Throughput: " << std::setprecision(1) << report.bytes_per_second() / (1024.0 * 1024.0)
+             << " MB/s, " << report.files.size() / std::max(report.seconds, 1e-9) << " files/s\n";
+   return report.failures == 0 ? 0 : 1;
 }
 
 int main(int argc, char* argv[]) {
    std::cout << "BEVE Validation Tool" << std::endl;
    std::cout << "===================" << std::endl;
    
+   if (argc > 2 && std::string(argv[1]) == "--batch") {
+      beve::batch_options options;
+      bool quiet = false;
+      for (int i = 3; i < argc; ++i) {
+         const std::string arg = argv[i];
+         if (arg == "-j" && i + 1 < argc) {
+            options.threads = std::max<size_t>(1, std::stoul(argv[++i]));
+         }
+         else if (arg == "--no-decode") {
+            options.decode = false;
+         }
+         else if (arg == "--quiet" || arg == "-q") {
+            quiet = true;
+         }
+         else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            std::cerr << "Usage: beve_validator --batch <dir> [-j N] [--no-decode] [--quiet]" << std::endl;
+            return 2;
+         }
+      }
+      return run_batch_validation(argv[2], options, quiet);
+   }
+   
    if (argc > 1 && std::string(argv[1]) == "--read-julia") {
       test_julia_generated_files();
       return 0;
@@ -470,6 +526,7 @@ int main(int argc, char* argv[]) {
    
    std::cout << "\nTest files generated in cpp_generated/" << std::endl;
    std::cout << "Run with --read-julia to read Julia generated files" << std::endl;
+   std::cout << "Run with --batch <dir> [-j N] to validate a directory of files in parallel" << std::endl;
    
-   return 0;
+   return failed_checks == 0 ? 0 : 1;
 }
\ No newline at end of file
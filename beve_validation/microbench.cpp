@@ -0,0 +1,451 @@
+// Microbenchmarks for the two operations every BEVE value pays for: header dispatch and
+// compressed-size decoding.
+//
+// Each case is run against a baseline and against the table-driven / branchless code in
+// beve_core.hpp, on inputs with realistic size distributions, and the results are checked to
+// agree before the speedup is reported. The baselines mirror what the decoders did before:
+// a byte-at-a-time size assembly (as in BEVE.jl's read_size), a width-sized memcpy, and a
+// walker that re-derives each header's meaning with nested switches.
+
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "benchmark_harness.hpp"
+#include "beve_core.hpp"
+
+namespace baseline
+{
+   using beve::view_error;
+
+   // Assembles the size one byte at a time behind a branch on the width
+   inline std::expected<uint64_t, view_error> read_size_bytewise(std::string_view b, size_t& pos) noexcept
+   {
+      if (pos >= b.size()) {
+         return std::unexpected(view_error::unexpected_end);
+      }
+      const uint8_t first = uint8_t(b[pos]);
+      const size_t n = size_t(1) << (first & 0b11);
+      if (b.size() - pos < n) {
+         return std::unexpected(view_error::unexpected_end);
+      }
+      if (n == 1) {
+         ++pos;
+         return first >> 2;
+      }
+      uint64_t value = 0;
+      for (size_t i = 0; i < n; ++i) {
+         value |= uint64_t(uint8_t(b[pos + i])) << (8 * i);
+      }
+      pos += n;
+      return value >> 2;
+   }
+
+   // Copies exactly the encoded width
+   inline std::expected<uint64_t, view_error> read_size_memcpy(std::string_view b, size_t& pos) noexcept
+   {
+      if (pos >= b.size()) {
+         return std::unexpected(view_error::unexpected_end);
+      }
+      const size_t n = size_t(1) << (uint8_t(b[pos]) & 0b11);
+      if (b.size() - pos < n) {
+         return std::unexpected(view_error::unexpected_end);
+      }
+      uint64_t word = 0;
+      std::memcpy(&word, b.data() + pos, n);
+      if constexpr (std::endian::native == std::endian::big) {
+         word = std::byteswap(word) >> (64 - 8 * n);
+      }
+      pos += n;
+      return word >> 2;
+   }
+
+   // Payload bytes that follow a header, derived from its bits (0 for containers and invalid headers)
+   inline size_t fixed_width(uint8_t h) noexcept
+   {
+      switch (beve::type_of(h)) {
+      case beve::value_type::null_or_bool:
+         return 0;
+      case beve::value_type::number:
+         return beve::byte_count(h);
+      case beve::value_type::typed_array:
+         return ((h >> 3) & 0b11) < 3 ? beve::byte_count(h) : 0;
+      case beve::value_type::object:
+         return ((h >> 3) & 0b11) == 0 ? 0 : beve::byte_count(h);
+      default:
+         return 0;
+      }
+   }
+
+   inline std::expected<void, view_error> skip_string_body(std::string_view b, size_t& pos) noexcept
+   {
+      auto n = read_size_memcpy(b, pos);
+      if (!n) {
+         return std::unexpected(n.error());
+      }
+      return beve::detail::advance(b, pos, *n);
+   }
+
+   // The switch-based walker, with a per-width memcpy size decode
+   inline std::expected<size_t, view_error> skip_value(std::string_view b, size_t pos, size_t depth = 0) noexcept
+   {
+      using namespace beve;
+      using beve::detail::advance;
+      using beve::detail::advance_elements;
+      if (depth > max_depth) {
+         return std::unexpected(view_error::depth_exceeded);
+      }
+      if (pos >= b.size()) {
+         return std::unexpected(view_error::unexpected_end);
+      }
+      const uint8_t h = uint8_t(b[pos++]);
+
+      auto ok = [&](std::expected<void, view_error> r) -> std::expected<size_t, view_error> {
+         if (!r) {
+            return std::unexpected(r.error());
+         }
+         return pos;
+      };
+
+      switch (type_of(h)) {
+      case value_type::null_or_bool:
+         if (h != headers::null && h != headers::boolean_false && h != headers::boolean_true) {
+            return std::unexpected(view_error::invalid_header);
+         }
+         return pos;
+      case value_type::number:
+         return ok(advance(b, pos, byte_count(h)));
+      case value_type::string:
+         return ok(skip_string_body(b, pos));
+      case value_type::object: {
+         auto count = read_size_memcpy(b, pos);
+         if (!count) {
+            return std::unexpected(count.error());
+         }
+         const uint8_t key_type = (h >> 3) & 0b11;
+         for (uint64_t i = 0; i < *count; ++i) {
+            if (key_type == 0) {
+               if (auto r = skip_string_body(b, pos); !r) {
+                  return std::unexpected(r.error());
+               }
+            }
+            else if (auto r = advance(b, pos, byte_count(h)); !r) {
+               return std::unexpected(r.error());
+            }
+            auto next = skip_value(b, pos, depth + 1);
+            if (!next) {
+               return next;
+            }
+            pos = *next;
+         }
+         return pos;
+      }
+      case value_type::typed_array: {
+         auto count = read_size_memcpy(b, pos);
+         if (!count) {
+            return std::unexpected(count.error());
+         }
+         const uint8_t element_type = (h >> 3) & 0b11;
+         if (element_type < 3) {
+            return ok(advance_elements(b, pos, *count, byte_count(h)));
+         }
+         if (h == headers::bool_array) {
+            return ok(advance(b, pos, (*count + 7) / 8));
+         }
+         if (h == headers::string_array) {
+            for (uint64_t i = 0; i < *count; ++i) {
+               if (auto r = skip_string_body(b, pos); !r) {
+                  return std::unexpected(r.error());
+               }
+            }
+            return pos;
+         }
+         return std::unexpected(view_error::invalid_header);
+      }
+      case value_type::generic_array: {
+         auto count = read_size_memcpy(b, pos);
+         if (!count) {
+            return std::unexpected(count.error());
+         }
+         for (uint64_t i = 0; i < *count; ++i) {
+            auto next = skip_value(b, pos, depth + 1);
+            if (!next) {
+               return next;
+            }
+            pos = *next;
+         }
+         return pos;
+      }
+      default:
+         return std::unexpected(view_error::invalid_header); // extensions do not occur in these payloads
+      }
+   }
+}
+
+namespace
+{
+   // Minimal encoder for building payloads without glaze
+   struct encoder
+   {
+      std::string out;
+
+      void header(uint8_t h) { out.push_back(char(h)); }
+      void size(uint64_t n) { beve::write_compressed_size(out, n); }
+      void key(std::string_view k)
+      {
+         size(k.size());
+         out.append(k);
+      }
+      void string(std::string_view s)
+      {
+         header(beve::headers::string);
+         key(s);
+      }
+      template <class T>
+      void number(T v)
+      {
+         header(beve::number_header<T>());
+         out.append(reinterpret_cast<const char*>(&v), sizeof(T));
+      }
+   };
+
+   // Encoded sizes drawn from `weights` over the 1/2/4/8-byte classes
+   std::string size_stream(size_t count, std::array<double, 4> weights, uint32_t seed)
+   {
+      std::mt19937_64 rng(seed);
+      std::discrete_distribution<int> width(weights.begin(), weights.end());
+      constexpr uint64_t lo[4] = {0, 64, 16384, uint64_t(1) << 30};
+      constexpr uint64_t hi[4] = {63, 16383, (uint64_t(1) << 30) - 1, (uint64_t(1) << 40)};
+      encoder e;
+      for (size_t i = 0; i < count; ++i) {
+         const int w = width(rng);
+         e.size(std::uniform_int_distribution<uint64_t>(lo[w], hi[w])(rng));
+      }
+      return e.out;
+   }
+
+   // An array of records shaped like benchmark.cpp's SmallData: {id: i32, value: f64, name: string}
+   std::string small_records(size_t count)
+   {
+      encoder e;
+      e.header(beve::headers::generic_array);
+      e.size(count);
+      for (size_t i = 0; i < count; ++i) {
+         e.header(beve::headers::string_object);
+         e.size(3);
+         e.key("id");
+         e.number(int32_t(i));
+         e.key("value");
+         e.number(3.14159 * double(i));
+         e.key("name");
+         e.string("benchmark");
+      }
+      return e.out;
+   }
+
+   // `count` chains of objects and arrays nested `depth` levels deep, each ending in a number
+   std::string nested_chains(size_t count, size_t depth)
+   {
+      encoder e;
+      e.header(beve::headers::generic_array);
+      e.size(count);
+      for (size_t i = 0; i < count; ++i) {
+         for (size_t d = 0; d < depth; ++d) {
+            if (d % 2 == 0) {
+               e.header(beve::headers::string_object);
+               e.size(1);
+               e.key("child");
+            }
+            else {
+               e.header(beve::headers::generic_array);
+               e.size(1);
+            }
+         }
+         e.number(uint16_t(i));
+      }
+      return e.out;
+   }
+
+   // Messages whose strings and arrays straddle the 1/2/4-byte size boundaries
+   std::string mixed_messages(size_t count)
+   {
+      std::mt19937 rng(7);
+      std::uniform_int_distribution<size_t> text_length(0, 300);
+      std::uniform_int_distribution<size_t> array_length(0, 3000);
+      encoder e;
+      e.header(beve::headers::generic_array);
+      e.size(count);
+      for (size_t i = 0; i < count; ++i) {
+         e.header(beve::headers::string_object);
+         e.size(2);
+         e.key("text");
+         e.string(std::string(text_length(rng), 'x'));
+         e.key("samples");
+         const size_t n = array_length(rng);
+         e.header(beve::typed_array_header<float>());
+         e.size(n);
+         e.out.append(n * sizeof(float), '\0');
+      }
+      return e.out;
+   }
+
+   struct row
+   {
+      std::string name;
+      double baseline_ns;
+      double optimized_ns;
+      bool agree;
+   };
+
+   void print_rows(const std::string& title, const std::string& baseline_name, const std::vector<row>& rows)
+   {
+      std::cout << "\n" << title << "\n";
+      std::cout << std::left << std::setw(34) << "Case"
+                << std::right << std::setw(16) << baseline_name
+                << std::setw(16) << "optimized"
+                << std::setw(10) << "speedup"
+                << std::setw(8) << "agree\n";
+      std::cout << std::string(84, '-') << "\n";
+      for (const auto& r : rows) {
+         std::cout << std::left << std::setw(34) << r.name
+                   << std::right << std::fixed << std::setprecision(1)
+                   << std::setw(13) << r.baseline_ns << " ns"
+                   << std::setw(13) << r.optimized_ns << " ns"
+                   << std::setprecision(2) << std::setw(9) << r.baseline_ns / r.optimized_ns << "x"
+                   << std::setw(8) << (r.agree ? "✓" : "✗") << "\n";
+      }
+   }
+
+   // Decodes every size in `stream` and returns their sum
+   template <class Decode>
+   uint64_t sum_sizes(std::string_view stream, Decode&& decode)
+   {
+      uint64_t sum = 0;
+      size_t pos = 0;
+      while (pos < stream.size()) {
+         sum += *decode(stream, pos);
+      }
+      return sum;
+   }
+}
+
+int main()
+{
+   std::cout << "BEVE Header and Size Decoding Microbenchmarks\n";
+   std::cout << "=============================================\n";
+
+   bool all_agree = true;
+   beve::bench::options opts;
+   opts.samples = 300;
+
+   // Compressed sizes on their own
+   {
+      struct distribution
+      {
+         std::string name;
+         std::array<double, 4> weights;
+      };
+      const std::vector<distribution> distributions{
+         {"1-byte only", {1.0, 0.0, 0.0, 0.0}},
+         {"realistic (85/12/2.9/0.1 %)", {85.0, 12.0, 2.9, 0.1}},
+         {"uniform widths", {1.0, 1.0, 1.0, 1.0}},
+      };
+      std::vector<row> bytewise_rows, memcpy_rows;
+      for (const auto& d : distributions) {
+         const std::string stream = size_stream(100'000, d.weights, 42);
+         const uint64_t expected = sum_sizes(stream, baseline::read_size_bytewise);
+         const uint64_t via_memcpy = sum_sizes(stream, baseline::read_size_memcpy);
+         const uint64_t optimized = sum_sizes(stream, beve::read_compressed_size);
+         const bool agree = expected == via_memcpy && expected == optimized;
+         all_agree &= agree;
+
+         auto time = [&](auto decode) {
+            return beve::bench::measure([&] {
+               beve::bench::do_not_optimize(sum_sizes(stream, decode));
+            }, stream.size(), opts).p50_ns;
+         };
+         const double t_bytewise = time(baseline::read_size_bytewise);
+         const double t_memcpy = time(baseline::read_size_memcpy);
+         const double t_optimized = time(beve::read_compressed_size);
+         bytewise_rows.push_back({d.name, t_bytewise / 100'000.0, t_optimized / 100'000.0, agree});
+         memcpy_rows.push_back({d.name, t_memcpy / 100'000.0, t_optimized / 100'000.0, agree});
+      }
+      print_rows("Compressed size decode (per size)", "bytewise", bytewise_rows);
+      print_rows("Compressed size decode (per size)", "memcpy", memcpy_rows);
+   }
+
+   // Header dispatch on its own: classify every header byte of a realistic stream
+   {
+      std::mt19937 rng(3);
+      const std::array<uint8_t, 10> common{beve::headers::string_object, beve::headers::string,
+                                           beve::headers::i32, beve::headers::f64,
+                                           beve::headers::generic_array, beve::headers::f32_array,
+                                           beve::headers::u8, beve::headers::boolean_true,
+                                           beve::headers::i64_object, beve::headers::null};
+      std::discrete_distribution<int> pick{20, 25, 15, 15, 8, 5, 5, 4, 2, 1};
+      std::vector<uint8_t> stream(1 << 16);
+      for (auto& h : stream) {
+         h = common[pick(rng)];
+      }
+      auto via_switch = [&] {
+         size_t sum = 0;
+         for (uint8_t h : stream) {
+            sum += baseline::fixed_width(h);
+         }
+         return sum;
+      };
+      auto via_table = [&] {
+         size_t sum = 0;
+         for (uint8_t h : stream) {
+            sum += beve::header_table[h].width;
+         }
+         return sum;
+      };
+      const bool agree = via_switch() == via_table();
+      all_agree &= agree;
+      const double n = double(stream.size());
+      const double t_switch = beve::bench::measure([&] { beve::bench::do_not_optimize(via_switch()); }, stream.size(), opts).p50_ns;
+      const double t_table = beve::bench::measure([&] { beve::bench::do_not_optimize(via_table()); }, stream.size(), opts).p50_ns;
+      print_rows("Header dispatch (per header)", "switch", {{"mixed headers", t_switch / n, t_table / n, agree}});
+   }
+
+   // Whole payloads: structural walk with the baseline walker vs. beve::skip_value
+   {
+      struct payload
+      {
+         std::string name;
+         std::string bytes;
+      };
+      const std::vector<payload> payloads{
+         {"SmallData records (10K)", small_records(10'000)},
+         {"nested chains (1K x depth 256)", nested_chains(1'000, 256)},
+         {"mixed-size messages (2K)", mixed_messages(2'000)},
+      };
+      std::vector<row> rows;
+      for (const auto& p : payloads) {
+         const auto expected = baseline::skip_value(p.bytes, 0);
+         const auto optimized = beve::skip_value(p.bytes, 0);
+         const bool agree = expected && optimized && *expected == *optimized && *optimized == p.bytes.size();
+         all_agree &= agree;
+         const double t_baseline = beve::bench::measure([&] {
+            beve::bench::do_not_optimize(baseline::skip_value(p.bytes, 0));
+         }, p.bytes.size(), opts).p50_ns;
+         const double t_optimized = beve::bench::measure([&] {
+            beve::bench::do_not_optimize(beve::skip_value(p.bytes, 0));
+         }, p.bytes.size(), opts).p50_ns;
+         rows.push_back({p.name, t_baseline, t_optimized, agree});
+      }
+      print_rows("Structural walk (per payload)", "switch", rows);
+   }
+
+   if (!all_agree) {
+      std::cerr << "\nDecoders disagree" << std::endl;
+      return 1;
+   }
+   return 0;
+}
@@ -0,0 +1,130 @@
+using Pkg
+Pkg.activate("..")
+using BEVE
+using Printf
+using Random
+using Statistics
+
+# Julia counterpart of microbench.cpp: compressed-size decoding and header dispatch in
+# isolation, each against the implementation BEVE.jl used before, plus whole-payload decode
+# times for SmallData-like and deeply nested messages.
+
+# The previous read_size: every byte goes through read_byte! and is assembled with shifts
+function read_size_reference(deser::BEVE.BeveDeserializer)::Int
+    first = BEVE.read_byte!(deser)
+    n_bytes = 1 << (first & 0b11)
+    if n_bytes == 1
+        return Int(first >> 2)
+    end
+    val = UInt64(first)
+    for i in 1:(n_bytes - 1)
+        val |= UInt64(BEVE.read_byte!(deser)) << (8 * i)
+    end
+    return Int(val >> 2)
+end
+
+function encode_sizes(count::Int, weights::Vector{Float64}; seed = 42)
+    rng = MersenneTwister(seed)
+    ranges = (0:63, 64:16383, 16384:(2^30 - 1), 2^30:2^40)
+    cumulative = cumsum(weights ./ sum(weights))
+    io = IOBuffer()
+    for _ in 1:count
+        class = findfirst(>=(rand(rng)), cumulative)
+        BEVE.write_size(io, rand(rng, ranges[class]))
+    end
+    return take!(io)
+end
+
+function sum_sizes(read_fn, bytes::Vector{UInt8}, count::Int)
+    deser = BEVE.BeveDeserializer(IOBuffer(bytes))
+    total = 0
+    for _ in 1:count
+        total += read_fn(deser)
+    end
+    return total
+end
+
+# Median nanoseconds per call of `f` over `samples` runs (after one warm-up call)
+function median_ns(f; samples = 50)
+    f()
+    times = Vector{Float64}(undef, samples)
+    for i in 1:samples
+        t0 = time_ns()
+        f()
+        times[i] = time_ns() - t0
+    end
+    return median(times)
+end
+
+function print_row(name, baseline_ns, optimized_ns, agree)
+    @printf("%-34s %12.1f ns %12.1f ns %8.2fx %6s\n",
+            name, baseline_ns, optimized_ns, baseline_ns / optimized_ns, agree ? "✓" : "✗")
+end
+
+function print_header(title, baseline_name)
+    println("\n", title)
+    @printf("%-34s %15s %15s %9s %6s\n", "Case", baseline_name, "optimized", "speedup", "agree")
+    println("-" ^ 84)
+end
+
+function small_records(count::Int)
+    return [Dict("id" => Int32(i), "value" => 3.14159 * i, "name" => "benchmark") for i in 0:count-1]
+end
+
+function nested_chain(depth::Int, leaf)
+    value = leaf
+    for d in 1:depth
+        value = isodd(d) ? Any[value] : Dict("child" => value)
+    end
+    return value
+end
+
+function main()
+    println("BEVE.jl Header and Size Decoding Microbenchmarks")
+    println("================================================")
+    all_agree = true
+
+    print_header("Compressed size decode (per size)", "reference")
+    count = 100_000
+    for (name, weights) in (("1-byte only", [1.0, 0.0, 0.0, 0.0]),
+                            ("realistic (85/12/2.9/0.1 %)", [85.0, 12.0, 2.9, 0.1]),
+                            ("uniform widths", [1.0, 1.0, 1.0, 1.0]))
+        bytes = encode_sizes(count, weights)
+        agree = sum_sizes(read_size_reference, bytes, count) == sum_sizes(BEVE.read_size, bytes, count)
+        all_agree &= agree
+        t_reference = median_ns(() -> sum_sizes(read_size_reference, bytes, count))
+        t_optimized = median_ns(() -> sum_sizes(BEVE.read_size, bytes, count))
+        print_row(name, t_reference / count, t_optimized / count, agree)
+    end
+
+    print_header("Header dispatch (per header)", "Dict")
+    rng = MersenneTwister(3)
+    common = UInt8[BEVE.STRING_OBJECT, BEVE.STRING, BEVE.I32, BEVE.F64, BEVE.GENERIC_ARRAY,
+                   BEVE.F32_ARRAY, BEVE.U8, BEVE.TRUE, BEVE.I64_OBJECT, BEVE.NULL]
+    headers = rand(rng, common, 1 << 16)
+    via_dict() = count_found(h -> get(BEVE.HEADER_PARSERS, h, nothing), headers)
+    via_table() = count_found(h -> @inbounds(BEVE.HEADER_TABLE[Int(h) + 1]), headers)
+    agree = via_dict() == via_table()
+    all_agree &= agree
+    n = length(headers)
+    print_row("mixed headers", median_ns(via_dict) / n, median_ns(via_table) / n, agree)
+
+    println("\nWhole-payload decode (from_beve, per payload)")
+    @printf("%-34s %15s %12s\n", "Case", "median", "size")
+    println("-" ^ 63)
+    for (name, value) in (("SmallData records (10K)", small_records(10_000)),
+                          ("nested chains (1K x depth 256)", [nested_chain(256, UInt16(i)) for i in 1:1_000]))
+        bytes = to_beve(value)
+        t = median_ns(() -> from_beve(bytes); samples = 10)
+        @printf("%-34s %12.3f ms %9d B\n", name, t / 1e6, length(bytes))
+    end
+
+    if !all_agree
+        println("\nDecoders disagree")
+        exit(1)
+    end
+end
+
+count_found(lookup, headers) = count(h -> lookup(h) !== nothing, headers)
+
+main()
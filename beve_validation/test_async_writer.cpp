@@ -0,0 +1,181 @@
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "beve_async_writer.hpp"
+#include "beve_mmap.hpp"
+#include "test_check.hpp"
+
+using beve::test::check;
+
+struct snapshot
+{
+   uint64_t step{};
+   std::vector<double> state;
+};
+
+template <>
+struct beve::layout<snapshot>
+{
+   using T = snapshot;
+   static constexpr auto value = beve::object_layout{beve::member{"step", &T::step}, beve::member{"state", &T::state}};
+};
+
+static snapshot make_snapshot(uint64_t step, size_t n) {
+   snapshot s{step, std::vector<double>(n)};
+   for (size_t i = 0; i < n; ++i) {
+      s.state[i] = double(step) + double(i) * 0.5;
+   }
+   return s;
+}
+
+static std::string payload(size_t n, char seed) {
+   std::string s(n, '\0');
+   for (size_t i = 0; i < n; ++i) {
+      s[i] = char(seed + char(i % 251));
+   }
+   return s;
+}
+
+static bool file_is(const std::string& path, const std::string& expected) {
+   std::string file;
+   return beve::read_file(path, file) && file == expected;
+}
+
+static std::string name(const char* backend, size_t i) {
+   return std::string("test_async_") + backend + "_" + std::to_string(i) + ".beve";
+}
+
+// Sizes that cover empty files, partial blocks and several chunks
+static const std::vector<size_t> sizes = {0, 1, 4095, 4096, 4097, 100000, (size_t(3) << 20) + 17};
+
+static void run_batch(const char* backend, beve::async_write_options options) {
+   beve::async_file_writer writer(options);
+   std::vector<std::string> expected;
+   bool queued = true;
+   for (size_t i = 0; i < sizes.size(); ++i) {
+      expected.push_back(payload(sizes[i], char('a' + i)));
+      queued = writer.write(name(backend, i), expected.back()) && queued;
+   }
+   const snapshot snap = make_snapshot(42, 70000);
+   queued = writer.write_value(name(backend, sizes.size()), snap) && queued;
+   std::string encoded;
+   beve::write_exact(snap, encoded);
+   expected.push_back(encoded);
+
+   const bool finished = writer.finish();
+   bool match = true;
+   for (size_t i = 0; i < expected.size(); ++i) {
+      match = file_is(name(backend, i), expected[i]) && match;
+      std::remove(name(backend, i).c_str());
+   }
+   check(queued && finished && match && writer.files_written() == expected.size(),
+         std::string(backend) + ": every file holds exactly its bytes" + (finished ? "" : " (" + writer.error() + ")"));
+}
+
+static void test_backends() {
+   std::cout << "\nBackends:\n";
+   beve::async_write_options options;
+   options.chunk_size = 64 * 1024;
+   options.queue_depth = 8; // fewer entries than chunks, so ops wait for room in the ring
+   options.max_in_flight = 2;
+   {
+      beve::async_file_writer probe(options);
+      std::cout << "  (io_uring " << (probe.using_io_uring() ? "available" : "unavailable") << ")\n";
+   }
+   run_batch("uring", options);
+
+   auto pool = options;
+   pool.use_io_uring = false;
+   {
+      beve::async_file_writer writer(pool);
+      check(!writer.using_io_uring(), "use_io_uring = false selects the thread pool");
+   }
+   run_batch("pool", pool);
+
+   auto synced = options;
+   synced.fsync = true;
+   run_batch("fsync", synced);
+}
+
+static void test_staging_modes() {
+   std::cout << "\nStaging buffers:\n";
+   beve::async_write_options options;
+   options.chunk_size = 64 * 1024;
+   options.register_buffers = true;
+   {
+      beve::async_file_writer writer(options);
+      std::cout << "  (buffers " << (writer.registered() ? "registered" : "not registered") << ")\n";
+   }
+   run_batch("registered", options);
+
+#if defined(O_DIRECT)
+   // tmpfs and some overlay file systems reject O_DIRECT; only run where it opens
+   const int fd = ::open("test_async_probe.beve", O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, 0644);
+   const bool direct_supported = fd >= 0;
+   if (fd >= 0) {
+      ::close(fd);
+   }
+   std::remove("test_async_probe.beve");
+   if (direct_supported) {
+      auto direct = options;
+      direct.direct = true;
+      run_batch("direct", direct);
+      direct.use_io_uring = false;
+      run_batch("direct_pool", direct);
+   }
+   else {
+      std::cout << "  (O_DIRECT unsupported here, skipped)\n";
+   }
+#endif
+}
+
+static void test_errors() {
+   std::cout << "\nErrors:\n";
+   for (bool uring : {true, false}) {
+      beve::async_write_options options;
+      options.use_io_uring = uring;
+      beve::async_file_writer writer(options);
+      const bool queued = writer.write("no_such_directory/file.beve", "abc");
+      const bool good = writer.write("test_async_good.beve", "abc");
+      const bool finished = writer.finish();
+      check(!queued && good && !finished && writer.error().find("no_such_directory") != std::string::npos &&
+               file_is("test_async_good.beve", "abc"),
+            std::string(uring ? "io_uring" : "thread pool") + ": a bad path fails without stopping the batch");
+      check(writer.write("test_async_good.beve", "xy") && writer.finish() && file_is("test_async_good.beve", "xy"),
+            "finish() resets the failure for the next batch");
+      std::remove("test_async_good.beve");
+   }
+}
+
+static void test_many_files() {
+   std::cout << "\nMany files:\n";
+   beve::async_file_writer writer;
+   const size_t count = 200;
+   for (size_t i = 0; i < count; ++i) {
+      writer.write_value(name("many", i), make_snapshot(i, 100 + i));
+   }
+   bool ok = writer.finish();
+   for (size_t i = 0; i < count; ++i) {
+      std::string expected;
+      beve::write_exact(make_snapshot(i, 100 + i), expected);
+      ok = file_is(name("many", i), expected) && ok;
+      std::remove(name("many", i).c_str());
+   }
+   check(ok && writer.files_written() == count, "200 files through four staging buffers");
+}
+
+int main() {
+   std::cout << "Testing asynchronous file writes\n";
+   std::cout << "================================\n";
+
+   test_backends();
+   test_staging_modes();
+   test_errors();
+   test_many_files();
+
+   return beve::test::report("async writer");
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+// Pass/fail reporting shared by the test executables. Each check prints one line;
+// `report` prints the summary and returns the exit code for main.
+//
+//    using beve::test::check;
+//    check(r && *r == bytes.size(), "decodes and reports its length");
+//    return beve::test::report("flat map");
+//
+// The write_ and encode_ helpers build expected BEVE bytes by hand, straight from the spec, so
+// a test never checks an encoder against itself.
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "beve_core.hpp"
+
+namespace beve::test
+{
+   inline int failures = 0;
+
+   inline void check(bool ok, const std::string& what)
+   {
+      std::cout << (ok ? "  ✓ " : "  ✗ ") << what << "\n";
+      if (!ok) {
+         ++failures;
+      }
+   }
+
+   // Prints "All <name> tests passed" or the failure count
+   inline int report(std::string_view name)
+   {
+      std::cout << "\n"
+                << (failures == 0 ? "All " + std::string(name) + " tests passed"
+                                  : std::to_string(failures) + " " + std::string(name) + " tests failed")
+                << "\n";
+      return failures == 0 ? 0 : 1;
+   }
+
+   template <class T>
+   inline void append_raw(std::string& out, const T& v)
+   {
+      out.append(reinterpret_cast<const char*>(&v), sizeof(v));
+   }
+
+   // A string object key: its compressed size, then its bytes
+   inline void write_key(std::string& out, std::string_view key)
+   {
+      write_compressed_size(out, key.size());
+      out.append(key);
+   }
+
+   inline void write_string(std::string& out, std::string_view s)
+   {
+      out.push_back(char(headers::string));
+      write_key(out, s);
+   }
+
+   template <class T>
+   inline void write_number(std::string& out, uint8_t header, T v)
+   {
+      out.push_back(char(header));
+      append_raw(out, v);
+   }
+
+   inline std::string encode_string(std::string_view s)
+   {
+      std::string out;
+      write_string(out, s);
+      return out;
+   }
+
+   template <class T>
+   inline std::string encode_number(uint8_t header, T v)
+   {
+      std::string out;
+      write_number(out, header, v);
+      return out;
+   }
+
+   inline std::string encode_i32(int32_t v) { return encode_number(headers::i32, v); }
+}
@@ -8,20 +8,20 @@
 #include <complex>
 #include <iomanip>
 
+#include "beve_mmap.hpp"
+
 template<typename T>
 bool test_matrix_file(const std::string& filename, const std::string& description) {
     std::cout << "\nTesting " << description << "...\n";
     std::cout << "  File: " << filename << "\n";
     
-    // Read the file
-    std::ifstream file(filename, std::ios::binary);
-    if (!file) {
-        std::cerr << "  ✗ Failed to open file\n";
+    // Map the file instead of copying it through an istreambuf_iterator
+    beve::mapped_file file;
+    if (!file.open(filename)) {
+        std::cerr << "  ✗ Failed to open file: " << file.error() << "\n";
         return false;
     }
-    
-    std::string buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-    file.close();
+    const std::string_view buffer = file.view();
     
     std::cout << "  Read " << buffer.size() << " bytes\n";
     
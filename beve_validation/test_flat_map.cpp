@@ -0,0 +1,145 @@
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "beve_flat_map.hpp"
+#include "beve_size.hpp"
+#include "test_check.hpp"
+
+using namespace beve::test;
+
+template <class K, class V>
+static bool same_entries(const beve::flat_map<K, V>& flat, const std::map<K, V>& tree) {
+   if (flat.size() != tree.size()) {
+      return false;
+   }
+   auto it = tree.begin();
+   for (const auto& [k, v] : flat) {
+      if (k != it->first || v != it->second) {
+         return false;
+      }
+      ++it;
+   }
+   return true;
+}
+
+static void test_sorted_input() {
+   std::cout << "\nSorted input:\n";
+   std::map<uint32_t, double> tree;
+   for (uint32_t i = 0; i < 1000; ++i) {
+      tree[i * 7 + 3] = double(i) * 0.25;
+   }
+   std::string bytes;
+   beve::write_exact(tree, bytes);
+
+   beve::flat_map<uint32_t, double> flat;
+   auto r = beve::read_flat_map(bytes, flat);
+   check(r && *r == bytes.size(), "u32 => f64 object decodes and reports its length");
+   check(same_entries(flat, tree), "entries match std::map in key order");
+   check(flat.contains(10) && !flat.contains(11) && flat.at(703) == 100 * 0.25, "binary-search lookups");
+   check(flat.find(4) == flat.end() && (*flat.find(7 * 999 + 3)).second == 999 * 0.25, "find hits and misses");
+
+   std::string again;
+   beve::write_exact(flat, again);
+   check(again == bytes, "write_exact(flat_map) reproduces the bytes");
+
+   beve::flat_map<uint32_t, double> empty;
+   std::string none;
+   beve::write_exact(std::map<uint32_t, double>{}, none);
+   check(beve::read_flat_map(none, empty) && empty.empty(), "empty object");
+}
+
+static void test_value_types() {
+   std::cout << "\nValue types:\n";
+   std::map<int16_t, std::string> names{{-300, "minus"}, {0, "zero"}, {7, "seven"}, {12000, ""}};
+   std::string bytes;
+   beve::write_exact(names, bytes);
+
+   beve::flat_map<int16_t, std::string_view> views;
+   check(beve::read_flat_map(bytes, views) && views.size() == 4 && views.at(-300) == "minus" && views.at(12000).empty(),
+         "i16 => string_view");
+   const auto* first = views.at(7).data();
+   check(first >= bytes.data() && first < bytes.data() + bytes.size(), "string_view values point into the buffer");
+
+   beve::flat_map<int16_t, std::string> owned;
+   check(beve::read_flat_map(bytes, owned) && same_entries(owned, names), "i16 => std::string");
+
+   std::map<uint64_t, std::vector<float>> arrays{{1, {1.5f, 2.5f}}, {1ull << 40, {}}, {5, {-1.0f}}};
+   bytes.clear();
+   beve::write_exact(arrays, bytes);
+   beve::flat_map<uint64_t, std::vector<float>> vectors;
+   check(beve::read_flat_map(bytes, vectors) && same_entries(vectors, arrays), "u64 => vector<float>");
+
+   std::map<int8_t, bool> flags{{-1, true}, {0, false}, {1, true}};
+   bytes.clear();
+   beve::write_exact(flags, bytes);
+   beve::flat_map<int8_t, bool> bools;
+   check(beve::read_flat_map(bytes, bools) && same_entries(bools, flags), "i8 => bool");
+}
+
+static void test_unsorted_input() {
+   std::cout << "\nUnsorted input:\n";
+   // Hash-ordered, as BEVE.jl writes a Dict, with key 5 repeated
+   const std::vector<std::pair<int32_t, int64_t>> entries{{9, 90}, {5, 50}, {-2, -20}, {5, 51}, {100, 1000}, {0, 0}};
+   std::string bytes(1, char(beve::detail::integer_object_header<int32_t>()));
+   beve::write_compressed_size(bytes, entries.size());
+   for (const auto& [k, v] : entries) {
+      append_raw(bytes, k);
+      bytes.push_back(char(beve::number_header<int64_t>()));
+      append_raw(bytes, v);
+   }
+
+   beve::flat_map<int32_t, int64_t> flat;
+   auto r = beve::read_flat_map(bytes, flat);
+   const std::vector<int32_t> keys{-2, 0, 5, 9, 100};
+   const std::vector<int64_t> values{-20, 0, 51, 90, 1000};
+   check(r && *r == bytes.size(), "hash-ordered object decodes");
+   check(std::vector<int32_t>(flat.keys().begin(), flat.keys().end()) == keys &&
+            std::vector<int64_t>(flat.values().begin(), flat.values().end()) == values,
+         "keys sorted, the last of a repeated key wins");
+}
+
+static void test_errors() {
+   std::cout << "\nErrors:\n";
+   std::map<uint16_t, double> tree{{1, 1.0}, {2, 2.0}};
+   std::string bytes;
+   beve::write_exact(tree, bytes);
+
+   beve::flat_map<int16_t, double> wrong_sign;
+   check(beve::read_flat_map(bytes, wrong_sign).error() == beve::view_error::type_mismatch, "key signedness must match");
+   beve::flat_map<uint32_t, double> wrong_width;
+   check(beve::read_flat_map(bytes, wrong_width).error() == beve::view_error::type_mismatch, "key width must match");
+   beve::flat_map<uint16_t, float> wrong_value;
+   check(beve::read_flat_map(bytes, wrong_value).error() == beve::view_error::type_mismatch, "value type must match");
+
+   std::string strings;
+   beve::write_exact(std::map<std::string, double>{{"a", 1.0}}, strings);
+   beve::flat_map<uint16_t, double> flat;
+   check(beve::read_flat_map(strings, flat).error() == beve::view_error::type_mismatch, "string-keyed object rejected");
+
+   bool truncated = true;
+   for (size_t n = 0; n < bytes.size(); ++n) {
+      truncated = !beve::read_flat_map(std::string_view(bytes).substr(0, n), flat) && truncated;
+   }
+   check(truncated, "every truncation fails");
+
+   std::string hostile(1, char(beve::detail::integer_object_header<uint16_t>()));
+   beve::write_compressed_size(hostile, uint64_t(1) << 40);
+   check(beve::read_flat_map(hostile, flat).error() == beve::view_error::size_overflow,
+         "a count larger than the buffer is rejected before allocating");
+}
+
+int main() {
+   std::cout << "Testing flat integer-keyed maps\n";
+   std::cout << "===============================\n";
+
+   test_sorted_input();
+   test_value_types();
+   test_unsorted_input();
+   test_errors();
+
+   return beve::test::report("flat map");
+}
@@ -0,0 +1,146 @@
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "beve_half.hpp"
+#include "beve_mmap.hpp"
+#include "beve_view.hpp"
+#include "test_check.hpp"
+
+namespace fs = std::filesystem;
+
+using beve::test::check;
+
+void test_scalar_conversions() {
+   std::cout << "\nScalar conversions...\n";
+   check(beve::float_to_bf16(1.0f) == 0x3f80 && beve::float_to_bf16(-2.0f) == 0xc000, "bf16 exact values");
+   // 1 + 2^-8 is halfway between two bf16 values and rounds to the even one; a hair above rounds up
+   check(beve::float_to_bf16(1.00390625f) == 0x3f80, "bf16 ties round to even");
+   check(beve::float_to_bf16(std::nextafter(1.00390625f, 2.0f)) == 0x3f81, "bf16 rounds to nearest");
+   check(beve::float_to_bf16(std::numeric_limits<float>::max()) == 0x7f80, "bf16 overflow becomes infinity");
+   check(std::isnan(beve::bf16_to_float(beve::float_to_bf16(std::numeric_limits<float>::quiet_NaN()))),
+         "bf16 keeps NaN");
+
+   check(beve::float_to_f16(1.0f) == 0x3c00 && beve::float_to_f16(-2.0f) == 0xc000, "f16 exact values");
+   check(beve::float_to_f16(65504.0f) == 0x7bff && beve::float_to_f16(65520.0f) == 0x7c00,
+         "f16 max and overflow to infinity");
+   check(beve::float_to_f16(std::ldexp(1.0f, -24)) == 0x0001 && beve::float_to_f16(std::ldexp(1.0f, -26)) == 0,
+         "f16 subnormals round to nearest");
+   check((beve::float_to_f16(std::numeric_limits<float>::quiet_NaN()) & 0x7fff) > 0x7c00, "f16 keeps NaN");
+
+   bool round_trips = true;
+   for (uint32_t h = 0; h < 0x10000; ++h) {
+      const float f = beve::f16_to_float(uint16_t(h));
+      round_trips &= std::isnan(f) ? (h & 0x7fff) > 0x7c00 : beve::float_to_f16(f) == h;
+   }
+   check(round_trips, "every f16 value widens and narrows back to itself");
+}
+
+void test_array_round_trip() {
+   std::cout << "\nTyped array round trips...\n";
+   // Sizes around the 8 and 16 lane vector widths exercise both the vector bodies and the tails
+   for (size_t n : {size_t(0), size_t(7), size_t(8), size_t(17), size_t(1000)}) {
+      std::vector<float> values(n);
+      for (size_t i = 0; i < n; ++i) {
+         values[i] = float(int(i % 256) - 128) * 0.25f;
+      }
+      for (auto format : {beve::half_format::bf16, beve::half_format::f16}) {
+         const std::string label = format == beve::half_format::bf16 ? "bf16" : "f16";
+         std::string bytes;
+         beve::write_half_array(bytes, values, format);
+         std::vector<float> restored;
+         auto read = beve::read_half_array(std::string_view(bytes), restored);
+         check(read && restored == values && bytes.size() == 1 + beve::compressed_size_width(n) + 2 * n,
+               label + " array of " + std::to_string(n));
+      }
+   }
+
+   // Bulk conversion must agree with the scalar one whichever vector path was picked
+   std::vector<float> values(4099);
+   for (size_t i = 0; i < values.size(); ++i) {
+      values[i] = std::ldexp(float(i) * 1.3f - 2000.0f, int(i % 60) - 30);
+   }
+   for (auto format : {beve::half_format::bf16, beve::half_format::f16}) {
+      std::vector<char> bulk(2 * values.size());
+      beve::narrow_to_half(values, bulk.data(), format);
+      std::vector<float> widened(values.size());
+      beve::widen_from_half(bulk.data(), widened, format);
+      bool same = true;
+      for (size_t i = 0; i < values.size(); ++i) {
+         uint16_t h;
+         std::memcpy(&h, bulk.data() + 2 * i, 2);
+         const bool bf16 = format == beve::half_format::bf16;
+         // AVX-512 BF16 flushes subnormal inputs to zero, which the scalar path does not
+         const bool subnormal = bf16 && std::fpclassify(values[i]) == FP_SUBNORMAL;
+         same &= subnormal || h == (bf16 ? beve::float_to_bf16(values[i]) : beve::float_to_f16(values[i]));
+         same &= std::bit_cast<uint32_t>(widened[i]) ==
+                 std::bit_cast<uint32_t>(bf16 ? beve::bf16_to_float(h) : beve::f16_to_float(h));
+      }
+      check(same, std::string(format == beve::half_format::bf16 ? "bf16" : "f16") +
+                     " bulk conversion matches the scalar one");
+   }
+
+   // bf16 sits in the one-byte float slot of the header, but a view must still step over 2 bytes per value
+   std::string object;
+   object.push_back(char(beve::headers::string_object));
+   beve::write_compressed_size(object, 2);
+   for (auto format : {beve::half_format::bf16, beve::half_format::f16}) {
+      const std::string_view key = format == beve::half_format::bf16 ? "bf16" : "f16";
+      beve::write_compressed_size(object, key.size());
+      object.append(key);
+      beve::write_half_array(object, values, format);
+   }
+   auto field = beve::beve_view{object}.find("f16");
+   auto array = field ? field->as_typed_array() : std::unexpected(field.error());
+   std::vector<float> after_bf16;
+   check(array && beve::read_half_array(*array, after_bf16) && after_bf16.size() == values.size(),
+         "finds a field that follows a bf16 array");
+
+   std::string f32;
+   f32.push_back(char(beve::headers::f32_array));
+   beve::write_compressed_size(f32, 0);
+   std::vector<float> ignored;
+   auto read = beve::read_half_array(std::string_view(f32), ignored);
+   check(!read && read.error() == beve::view_error::type_mismatch, "rejects an f32 array");
+}
+
+// julia_generated/{bf16,f16}_array.beve hold {"values": i * 0.25 for i in 0:255}
+void test_julia_files() {
+   std::cout << "\nReading Julia bf16/f16 files...\n";
+   if (!fs::exists("julia_generated")) {
+      std::cout << "  julia_generated directory not found. Run test_validation.jl first.\n";
+      return;
+   }
+   std::vector<float> expected(256);
+   for (size_t i = 0; i < expected.size(); ++i) {
+      expected[i] = float(i) * 0.25f;
+   }
+   for (const std::string name : {"bf16_array.beve", "f16_array.beve"}) {
+      std::string bytes;
+      if (!beve::read_file("julia_generated/" + name, bytes)) {
+         check(false, name + " exists");
+         continue;
+      }
+      auto field = beve::beve_view{bytes}.find("values");
+      auto array = field ? field->as_typed_array() : std::unexpected(field.error());
+      std::vector<float> values;
+      check(array && beve::read_half_array(*array, values) && values == expected, name + " matches");
+   }
+}
+
+int main() {
+   std::cout << "Testing bf16/f16 typed arrays\n";
+   std::cout << "=============================\n";
+
+   test_scalar_conversions();
+   test_array_round_trip();
+   test_julia_files();
+
+   return beve::test::report("half");
+}
@@ -0,0 +1,215 @@
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "beve_http.hpp"
+#include "test_check.hpp"
+
+using namespace beve::test;
+
+// {"name": "sensor", "values": [1.5, 2.5, 3.5] (f64 array), "tags": ["a", "bc"] (string array),
+//  "nested": {"list": [7, "x"] (generic array), "a/b": 1, "t~": 2}}
+static std::string make_object() {
+   std::string out(1, char(beve::headers::string_object));
+   beve::write_compressed_size(out, 4);
+   write_key(out, "name");
+   write_string(out, "sensor");
+
+   write_key(out, "values");
+   out.push_back(char(beve::headers::f64_array));
+   beve::write_compressed_size(out, 3);
+   for (double v : {1.5, 2.5, 3.5}) {
+      out.append(reinterpret_cast<const char*>(&v), sizeof(v));
+   }
+
+   write_key(out, "tags");
+   out.push_back(char(beve::headers::string_array));
+   beve::write_compressed_size(out, 2);
+   for (std::string_view s : {"a", "bc"}) {
+      beve::write_compressed_size(out, s.size());
+      out.append(s);
+   }
+
+   write_key(out, "nested");
+   out.push_back(char(beve::headers::string_object));
+   beve::write_compressed_size(out, 3);
+   write_key(out, "list");
+   out.push_back(char(beve::headers::generic_array));
+   beve::write_compressed_size(out, 2);
+   out += encode_i32(7);
+   write_string(out, "x");
+   write_key(out, "a/b");
+   out += encode_i32(1);
+   write_key(out, "t~");
+   out += encode_i32(2);
+   return out;
+}
+
+static beve::http_request get(std::string path, std::string pointer = {}) {
+   return {"GET", std::move(path), std::move(pointer), {}, true};
+}
+
+static beve::http_request post(std::string path, std::string body, std::string pointer = {}) {
+   return {"POST", std::move(path), std::move(pointer), std::move(body), true};
+}
+
+void test_handler() {
+   std::cout << "\nRequests handled directly...\n";
+   beve::http_server server;
+   server.register_object("sensor", make_object());
+
+   auto listing = server.handle(get("/"));
+   check(listing.status == 200 && listing.body.find("- /sensor") != std::string::npos, "GET / lists the paths");
+
+   auto whole = server.handle(get("/sensor"));
+   check(whole.status == 200 && whole.content_type == "application/x-beve" && whole.payload() == make_object(),
+         "GET of a whole value shares the stored bytes");
+   auto by_query = server.handle(get("/sensor", "/nested/list/1"));
+   auto by_path = server.handle(get("/sensor/nested/list/1"));
+   check(by_query.status == 200 && by_query.body == encode_string("x") && by_path.body == by_query.body,
+         "the pointer can come from the query or the path");
+
+   auto missing = server.handle(get("/other"));
+   check(missing.status == 404 && missing.body.find("Available paths: /sensor") != std::string::npos,
+         "404 lists the available paths");
+   check(server.handle(get("/sensor", "/nope")).status == 400, "400 for an unresolvable pointer");
+   check(server.handle(get("/sensorx")).status == 404, "prefixes only match at a '/' boundary");
+
+   check(server.handle(post("/sensor", encode_string("hello"), "/name")).status == 200, "POST with a pointer");
+   check(server.handle(get("/sensor", "/name")).body == encode_string("hello") &&
+            server.handle(get("/sensor", "/nested/t~0")).body == encode_i32(2),
+         "the new value is spliced in and the rest of the object is intact");
+
+   std::string f64(1, char(beve::headers::f64));
+   const double nine = 9.0;
+   f64.append(reinterpret_cast<const char*>(&nine), sizeof(nine));
+   check(server.handle(post("/sensor", f64, "/values/0")).status == 200 &&
+            server.handle(get("/sensor", "/values/0")).body == f64,
+         "POST replaces a typed array element");
+   check(server.handle(post("/sensor", encode_i32(1), "/values/0")).status == 400,
+         "a typed array element only takes its own type");
+   check(server.handle(post("/sensor", encode_string("abcdef"), "/tags/0")).status == 200 &&
+            server.handle(get("/sensor", "/tags/0")).body == encode_string("abcdef") &&
+            server.handle(get("/sensor", "/tags/1")).body == encode_string("bc"),
+         "POST resizes a string array element");
+
+   // Nothing else holds the stored bytes here, so same-size updates patch them in place
+   const auto before = server.object("/sensor");
+   const char* bytes = before->data();
+   const auto shared = server.handle(get("/sensor"));
+   check(server.handle(post("/sensor", encode_string("HELLO"), "/name")).status == 200 &&
+            shared.payload() == *before && server.object("/sensor")->data() != bytes,
+         "a POST copies bytes that a response still shares");
+   const auto current = server.object("/sensor")->data();
+   check(server.handle(post("/sensor", encode_string("hallo"), "/name")).status == 200 &&
+            server.object("/sensor")->data() == current,
+         "and patches unshared bytes in place");
+   check(server.handle(post("/sensor", encode_i32(3), "/count")).status == 200 &&
+            server.handle(get("/sensor", "/count")).body == encode_i32(3) &&
+            server.handle(post("/sensor", encode_i32(8), "/nested/list/-")).status == 200 &&
+            server.handle(get("/sensor", "/nested/list/2")).body == encode_i32(8),
+         "POST adds a missing key and appends with /-");
+
+   check(server.handle(post("/fresh", encode_i32(5))).status == 201 && server.object("/fresh") &&
+            *server.object("/fresh") == encode_i32(5),
+         "POST without a pointer creates a value");
+   check(server.handle(post("/missing", encode_i32(5), "/a")).status == 404, "POST with a pointer needs the path");
+   check(server.handle(post("/sensor", "\x02\x10" "ab")).status == 400, "POST rejects a malformed body");
+
+   beve::http_request options{"OPTIONS", "/sensor", {}, {}, true};
+   check(server.handle(options).extra_headers.find("Access-Control-Allow-Origin") != std::string::npos,
+         "OPTIONS answers with CORS headers");
+   beve::http_request del{"DELETE", "/sensor", {}, {}, true};
+   check(server.handle(del).status == 405, "other methods are not allowed");
+   check(server.unregister_object("/sensor") && !server.object("/sensor"), "unregisters a path");
+}
+
+void test_sockets() {
+   std::cout << "\nServing over sockets...\n";
+   beve::http_server_options options;
+   options.threads = 4;
+   beve::http_server server(options);
+   server.register_object("/sensor", make_object());
+   if (!server.start("127.0.0.1", 0)) {
+      check(false, "starts: " + server.error());
+      return;
+   }
+   check(server.port() != 0, "listens on an ephemeral port");
+
+   beve::http_client client;
+   if (!client.connect("127.0.0.1", server.port())) {
+      check(false, "connects: " + client.error());
+      return;
+   }
+   auto first = client.request("GET", "/sensor", {}, "/nested/a~1b");
+   auto second = client.request("GET", "/sensor/tags/1");
+   check(first && first->status == 200 && first->body == encode_i32(1) && second && second->body == encode_string("bc"),
+         "answers successive requests on one keep-alive connection");
+
+   bool ok = true;
+   for (int i = 0; i < 50; ++i) {
+      ok &= client.send("GET", i % 2 ? "/sensor/name" : "/sensor/nested/list/0");
+   }
+   for (int i = 0; i < 50 && ok; ++i) {
+      auto r = client.receive();
+      ok = r && r->status == 200 && r->body == (i % 2 ? encode_string("sensor") : encode_i32(7));
+   }
+   check(ok, "answers 50 pipelined requests in order");
+
+   std::string big(1, char(beve::headers::u8_array));
+   beve::write_compressed_size(big, 1 << 20);
+   for (size_t i = 0; i < (1 << 20); ++i) {
+      big.push_back(char(i * 31));
+   }
+   auto created = client.request("POST", "/big", big);
+   auto fetched = client.request("GET", "/big");
+   check(created && created->status == 201 && fetched && fetched->body == big, "round trips a 1 MB body");
+
+   beve::http_client other;
+   bool concurrent = other.connect("127.0.0.1", server.port());
+   auto a = other.request("GET", "/sensor", {}, "/values/2");
+   auto b = client.request("GET", "/", {});
+   concurrent &= a && a->status == 200 && b && b->body.find("- /big") != std::string::npos;
+   check(concurrent, "serves two connections at once");
+
+   // HTTP/1.0 without keep-alive: the server answers, then closes
+   bool closed = true;
+   {
+      std::string raw = "GET /sensor/name HTTP/1.0\r\n\r\n";
+      std::string error;
+      const int fd = beve::detail::connect_tcp("127.0.0.1", server.port(), error);
+      closed &= fd >= 0 && ::send(fd, raw.data(), raw.size(), MSG_NOSIGNAL) == ssize_t(raw.size());
+      std::string response;
+      char buffer[4096];
+      ssize_t n;
+      while (fd >= 0 && (n = ::recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+         response.append(buffer, size_t(n));
+      }
+      closed &= response.starts_with("HTTP/1.1 200") && response.ends_with(encode_string("sensor")) &&
+                response.find("Connection: close") != std::string::npos;
+      if (fd >= 0) {
+         ::close(fd);
+      }
+   }
+   check(closed, "closes the connection after an HTTP/1.0 request");
+
+   const auto start = std::chrono::steady_clock::now();
+   server.stop();
+   const auto elapsed = std::chrono::steady_clock::now() - start;
+   check(elapsed < std::chrono::seconds(2), "stop() closes idle keep-alive connections promptly");
+   check(!client.request("GET", "/sensor"), "connections are closed after stop()");
+}
+
+int main() {
+   std::cout << "Testing BEVE over HTTP\n";
+   std::cout << "======================\n";
+
+   test_handler();
+   test_sockets();
+
+   return beve::test::report("HTTP");
+}
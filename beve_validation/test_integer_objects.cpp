@@ -1,5 +1,6 @@
 #include <glaze/glaze.hpp>
 #include <glaze/beve.hpp>
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <map>
@@ -7,6 +8,8 @@
 #include <cstdint>
 #include <iomanip>
 
+#include "beve_flat_map.hpp"
+
 template<typename K, typename V>
 void test_integer_dict(const std::string& filename, const std::string& description) {
     std::cout << "\nTesting " << description << "...\n";
@@ -64,6 +67,20 @@ void test_integer_dict(const std::string& filename, const std::string& descripti
             std::cout << "  ✗ Round-trip mismatch: " << buffer.size() << " vs " << output.size() << " bytes\n";
         }
     }
+    
+    // Decode into a flat sorted-vector map; Julia writes Dict entries in hash order
+    beve::flat_map<K, V> flat;
+    auto flat_result = beve::read_flat_map(buffer, flat);
+    if (!flat_result) {
+        std::cerr << "  ✗ Failed to read flat_map: " << beve::to_string(flat_result.error()) << "\n";
+    } else if (flat.size() == result.size() &&
+               std::all_of(result.begin(), result.end(), [&](const auto& entry) {
+                   return flat.contains(entry.first) && flat.at(entry.first) == entry.second;
+               })) {
+        std::cout << "  ✓ flat_map matches std::map\n";
+    } else {
+        std::cout << "  ✗ flat_map mismatch\n";
+    }
 }
 
 int main() {
@@ -0,0 +1,226 @@
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include "beve_keys.hpp"
+#include "test_check.hpp"
+
+using namespace beve::test;
+
+// One SmallData-like record: {"id": i (i32), "name": "item<i>", "value": i / 2 (f64), "active": i even}
+static void write_record(std::string& out, int32_t i) {
+   out.push_back(char(beve::headers::string_object));
+   beve::write_compressed_size(out, 4);
+   write_key(out, "id");
+   write_number(out, beve::headers::i32, i);
+   write_key(out, "name");
+   write_string(out, "item" + std::to_string(i));
+   write_key(out, "value");
+   write_number(out, beve::headers::f64, i / 2.0);
+   write_key(out, "active");
+   out.push_back(char(i % 2 == 0 ? beve::headers::boolean_true : beve::headers::boolean_false));
+}
+
+static std::string make_records(int32_t n) {
+   std::string out(1, char(beve::headers::generic_array));
+   beve::write_compressed_size(out, uint64_t(n));
+   for (int32_t i = 0; i < n; ++i) {
+      write_record(out, i);
+   }
+   return out;
+}
+
+// {"lookup": {"a": 1, "b": 2}, "ids": {7: {"a": 3}} (u32 keys), "variant": tag 2 {"b": [1.5, 2.5] (f64 array)},
+//  "names": ["a", "b"] (string array), "list": [{"a": null}, "a"]}
+static std::string make_nested() {
+   std::string out(1, char(beve::headers::string_object));
+   beve::write_compressed_size(out, 5);
+
+   write_key(out, "lookup");
+   out.push_back(char(beve::headers::string_object));
+   beve::write_compressed_size(out, 2);
+   write_key(out, "a");
+   write_number(out, beve::headers::i32, int32_t(1));
+   write_key(out, "b");
+   write_number(out, beve::headers::i32, int32_t(2));
+
+   write_key(out, "ids");
+   out.push_back(char(beve::headers::u32_object));
+   beve::write_compressed_size(out, 1);
+   const uint32_t id = 7;
+   out.append(reinterpret_cast<const char*>(&id), sizeof(id));
+   out.push_back(char(beve::headers::string_object));
+   beve::write_compressed_size(out, 1);
+   write_key(out, "a");
+   write_number(out, beve::headers::i32, int32_t(3));
+
+   write_key(out, "variant");
+   out.push_back(char(beve::headers::tag));
+   beve::write_compressed_size(out, 2);
+   out.push_back(char(beve::headers::string_object));
+   beve::write_compressed_size(out, 1);
+   write_key(out, "b");
+   out.push_back(char(beve::headers::f64_array));
+   beve::write_compressed_size(out, 2);
+   for (double v : {1.5, 2.5}) {
+      out.append(reinterpret_cast<const char*>(&v), sizeof(v));
+   }
+
+   write_key(out, "names");
+   out.push_back(char(beve::headers::string_array));
+   beve::write_compressed_size(out, 2);
+   write_key(out, "a");
+   write_key(out, "b");
+
+   write_key(out, "list");
+   out.push_back(char(beve::headers::generic_array));
+   beve::write_compressed_size(out, 2);
+   out.push_back(char(beve::headers::string_object));
+   beve::write_compressed_size(out, 1);
+   write_key(out, "a");
+   out.push_back(char(beve::headers::null));
+   write_string(out, "a");
+   return out;
+}
+
+static bool round_trips(const std::string& plain) {
+   auto keyed = beve::encode_keys(plain);
+   if (!keyed) {
+      return false;
+   }
+   auto expanded = beve::expand_keys(*keyed);
+   return expanded && *expanded == plain && beve::skip_value(*keyed, 0) == keyed->size();
+}
+
+static void test_round_trip() {
+   std::cout << "\nRound trips:\n";
+   const std::string records = make_records(1000);
+   check(round_trips(records), "1000 records");
+   check(round_trips(make_nested()), "nested objects, integer keys, tags, string arrays");
+
+   std::string number;
+   write_number(number, beve::headers::f64, 2.5);
+   auto keyed = beve::encode_keys(number);
+   check(keyed && *keyed == std::string{char(beve::headers::key_table), 0} + number,
+         "a value without objects gets an empty table");
+   check(round_trips(number), "a value without objects");
+
+   std::string empty(1, char(beve::headers::string_object));
+   beve::write_compressed_size(empty, 0);
+   check(round_trips(empty), "an empty object");
+}
+
+static void test_layout() {
+   std::cout << "\nLayout:\n";
+   const std::string records = make_records(1000);
+   auto keyed = beve::encode_keys(records);
+   check(keyed.has_value(), "encodes");
+   if (!keyed) {
+      return;
+   }
+   // Table: header, count, then the four keys in first-use order
+   std::string table{char(beve::headers::key_table)};
+   beve::write_compressed_size(table, 4);
+   for (std::string_view k : {"id", "name", "value", "active"}) {
+      write_key(table, k);
+   }
+   check(keyed->starts_with(table), "the table lists keys once, in first-use order");
+   const size_t saved = records.size() - keyed->size();
+   check(saved == 1000 * (3 + 5 + 6 + 7 - 4) - table.size(), "each key costs one index byte");
+
+   // The first record after the table and the array header
+   size_t pos = table.size() + 1;
+   check(*beve::read_compressed_size(*keyed, pos) == 1000, "the array count is kept");
+   check(uint8_t((*keyed)[pos]) == beve::headers::keyed_object && uint8_t((*keyed)[pos + 2]) == 0,
+         "records are keyed objects starting at key index 0");
+
+   check(beve::type_of(beve::headers::key_table) == beve::value_type::extension &&
+            beve::type_of(beve::headers::keyed_object) == beve::value_type::extension,
+         "both headers are extensions");
+}
+
+static void test_stream() {
+   std::cout << "\nStream tables:\n";
+   beve::key_table writer;
+   std::string first, second, third;
+   std::string a, b;
+   write_record(a, 1);
+   write_record(b, 2);
+   std::string other(1, char(beve::headers::string_object));
+   beve::write_compressed_size(other, 1);
+   write_key(other, "extra");
+   write_number(other, beve::headers::i32, int32_t(9));
+
+   const bool encoded = beve::encode_keys(a, first, writer) && beve::encode_keys(b, second, writer) &&
+                        beve::encode_keys(other, third, writer);
+   check(encoded, "encodes three messages with one table");
+   check(uint8_t(first[0]) == beve::headers::key_table, "the first message carries the table");
+   check(uint8_t(second[0]) == beve::headers::keyed_object, "a message with known keys carries none");
+   check(uint8_t(third[0]) == beve::headers::key_table && writer.size() == 5,
+         "a new key re-emits the grown table");
+
+   beve::key_table reader;
+   std::string ea, eb, ec;
+   const bool expanded = beve::expand_keys(first, ea, reader) && beve::expand_keys(second, eb, reader) &&
+                         beve::expand_keys(third, ec, reader);
+   check(expanded && ea == a && eb == b && ec == other, "a reader with one table expands all three");
+
+   check(!beve::expand_keys(second).has_value() &&
+            beve::expand_keys(second).error() == beve::view_error::index_out_of_range,
+         "a message without a table needs the stream's table");
+}
+
+static void test_errors() {
+   std::cout << "\nErrors:\n";
+   const std::string records = make_records(3);
+   auto keyed = beve::encode_keys(records);
+   check(keyed.has_value(), "encodes");
+   if (!keyed) {
+      return;
+   }
+
+   bool all_fail = true;
+   for (size_t n = 0; n < keyed->size(); ++n) {
+      all_fail = all_fail && !beve::expand_keys(std::string_view(*keyed).substr(0, n));
+   }
+   check(all_fail, "every truncation fails");
+   all_fail = true;
+   for (size_t n = 0; n < records.size(); ++n) {
+      all_fail = all_fail && !beve::encode_keys(std::string_view(records).substr(0, n));
+   }
+   check(all_fail, "every truncated input to encode fails");
+
+   std::string wrapped(1, char(beve::headers::generic_array));
+   beve::write_compressed_size(wrapped, 1);
+   wrapped += *keyed;
+   auto r = beve::expand_keys(wrapped);
+   check(!r && r.error() == beve::view_error::invalid_header, "a table below the top level is rejected");
+   auto e = beve::encode_keys(*keyed);
+   check(!e && e.error() == beve::view_error::invalid_header, "encoding an already keyed value is rejected");
+
+   std::string oversized{char(beve::headers::key_table)};
+   beve::write_compressed_size(oversized, 1000);
+   auto o = beve::expand_keys(oversized);
+   check(!o && o.error() == beve::view_error::size_overflow, "a table count beyond the buffer is rejected");
+
+   std::string deep;
+   for (int i = 0; i < 2000; ++i) {
+      deep.push_back(char(beve::headers::generic_array));
+      beve::write_compressed_size(deep, 1);
+   }
+   deep.push_back(char(beve::headers::null));
+   auto d = beve::encode_keys(deep);
+   check(!d && d.error() == beve::view_error::depth_exceeded, "nesting beyond max_depth is rejected");
+}
+
+int main() {
+   std::cout << "Testing dictionary-encoded object keys\n";
+   std::cout << "======================================\n";
+
+   test_round_trip();
+   test_layout();
+   test_stream();
+   test_errors();
+
+   return beve::test::report("key dictionary");
+}
@@ -5,59 +5,65 @@
 #include <vector>
 #include <complex>
 
+#include "beve_mmap.hpp"
+#include "beve_view.hpp"
+
 // Test reading Julia-generated matrix samples
 int main() {
     std::cout << "Testing Julia-generated BEVE matrices\n";
     std::cout << "=====================================\n\n";
     
-    // Read the file
-    std::ifstream file("julia_generated/matrices.beve", std::ios::binary);
-    if (!file) {
+    // Map the file
+    beve::mapped_file file;
+    if (!file.open("julia_generated/matrices.beve")) {
         std::cerr << "Failed to open julia_generated/matrices.beve\n";
         return 1;
     }
     
-    std::string buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-    file.close();
-    
-    // Parse as a generic glz::json_t to inspect the structure
-    glz::json_t data;
-    auto ec = glz::read_beve(data, buffer);
-    
-    if (ec) {
-        std::cerr << "Failed to parse BEVE data: " << glz::format_error(ec) << "\n";
+    // Inspect the structure in place; nothing is decoded until a key is touched
+    beve::beve_view data{file.view()};
+    if (auto raw = data.raw(); !raw) {
+        std::cerr << "Failed to parse BEVE data: " << beve::to_string(raw.error()) << "\n";
         return 1;
     }
     
-    // Print what we got
-    std::string json_output;
-    auto json_ec = glz::write_json(data, json_output);
-    if (!json_ec) {
-        std::cout << "Parsed data as JSON:\n" << json_output << "\n\n";
-    }
-    
-    // Check if it's an object by attempting to access it as such
-    if (data.is_object()) {
-        auto& obj = data.get_object();
-        std::cout << "Successfully parsed as object with " << obj.size() << " entries\n";
+    if (data.is_string_object()) {
+        auto keys = data.keys();
+        if (!keys) {
+            std::cerr << "Failed to index object: " << beve::to_string(keys.error()) << "\n";
+            return 1;
+        }
+        std::cout << "Successfully parsed as object with " << keys->size() << " entries\n";
         
         // List all keys
-        for (const auto& [key, value] : obj) {
+        for (const auto key : *keys) {
             std::cout << "  Key: " << key << "\n";
             
-            // Try to identify matrix structure
-            if (value.is_object()) {
-                const auto& matrix_obj = value.get_object();
-                if (matrix_obj.contains("layout") && matrix_obj.contains("extents") && matrix_obj.contains("value")) {
-                    std::cout << "    -> Appears to be a matrix\n";
-                    auto layout_it = matrix_obj.find("layout");
-                    auto extents_it = matrix_obj.find("extents");
-                    if (layout_it != matrix_obj.end() && layout_it->second.is_string()) {
-                        std::cout << "       Layout: " << layout_it->second.get_string() << "\n";
-                    }
-                    if (extents_it != matrix_obj.end() && extents_it->second.is_array()) {
-                        std::cout << "       Dimensions: " << extents_it->second.get_array().size() << "\n";
-                    }
+            auto value = data.find(key);
+            if (!value || !value->is_matrix()) {
+                continue;
+            }
+            
+            auto matrix = value->as_matrix();
+            if (!matrix) {
+                std::cout << "    -> Malformed matrix: " << beve::to_string(matrix.error()) << "\n";
+                continue;
+            }
+            std::cout << "    -> Appears to be a matrix\n";
+            std::cout << "       Layout: " << (matrix->column_major ? "layout_left" : "layout_right") << "\n";
+            std::cout << "       Dimensions: " << matrix->extents.size() << " (";
+            for (size_t i = 0; i < matrix->extents.size(); ++i) {
+                std::cout << (i ? "x" : "") << matrix->extents[i];
+            }
+            std::cout << ")\n";
+            std::cout << "       Elements: " << matrix->data.count << " x " << matrix->data.element_size << " bytes\n";
+            
+            // Decode just this entry to JSON for display
+            glz::json_t decoded;
+            if (auto raw = value->raw(); raw && !glz::read_beve(decoded, *raw)) {
+                std::string json_output;
+                if (!glz::write_json(decoded, json_output)) {
+                    std::cout << "       JSON: " << json_output << "\n";
                 }
             }
         }
@@ -68,4 +74,4 @@ int main() {
     std::cout << "\n✅ Matrix reading test completed\n";
     
     return 0;
-}
\ No newline at end of file
+}
@@ -8,6 +8,9 @@
 #include <complex>
 #include <map>
 
+#include "beve_mmap.hpp"
+#include "beve_view.hpp"
+
 // Test structures to hold our matrices
 struct MatrixSamples {
     Eigen::Matrix<float, 3, 3, Eigen::RowMajor> row_major_2d;
@@ -31,86 +34,57 @@ int main() {
     std::cout << "Testing Julia-generated BEVE matrices with Eigen\n";
     std::cout << "==============================================\n\n";
     
-    // Read the file
-    std::ifstream file("julia_generated/matrices.beve", std::ios::binary);
-    if (!file) {
+    // Map the file
+    beve::mapped_file file;
+    if (!file.open("julia_generated/matrices.beve")) {
         std::cerr << "Failed to open julia_generated/matrices.beve\n";
         return 1;
     }
     
-    std::string buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-    file.close();
-    
-    // First, let's parse as generic json_t to see all matrices
-    glz::json_t all_data;
-    auto ec = glz::read_beve(all_data, buffer);
-    
-    if (ec) {
-        std::cerr << "Failed to parse BEVE data: " << glz::format_error(ec) << "\n";
+    // Index the top-level keys in place instead of materializing every matrix as json_t
+    beve::beve_view all_data{file.view()};
+    auto keys = all_data.keys();
+    if (!keys) {
+        std::cerr << "Failed to parse BEVE data: " << beve::to_string(keys.error()) << "\n";
         return 1;
     }
     
-    // Print what we got
-    if (all_data.is_object()) {
-        auto& obj = all_data.get_object();
-        std::cout << "Found " << obj.size() << " matrix samples:\n";
-        for (const auto& [key, value] : obj) {
-            std::cout << "  - " << key << "\n";
-        }
-        std::cout << "\n";
+    std::cout << "Found " << keys->size() << " matrix samples:\n";
+    for (const auto key : *keys) {
+        std::cout << "  - " << key << "\n";
     }
+    std::cout << "\n";
     
     // Now try to parse specific matrices with Eigen types
-    // We'll need to manually extract the ones we can handle with fixed-size Eigen matrices
     
     // Test 1: Read a simple 3x3 row-major matrix
     std::cout << "Test 1: Reading 3x3 row-major matrix\n";
-    if (all_data.is_object()) {
-        auto& obj = all_data.get_object();
-        auto it = obj.find("row_major_2d");
-        if (it != obj.end()) {
-            // For now, let's just verify the structure
-            std::string json_str;
-            auto json_ec = glz::write_json(it->second, json_str);
-            if (!json_ec) {
-                std::cout << "  JSON representation: " << json_str << "\n";
+    if (auto entry = all_data.find("row_major_2d")) {
+        auto matrix = entry->as_matrix();
+        if (matrix) {
+            std::cout << "  ✓ Found matrix structure with layout, extents, and value\n";
+            
+            std::cout << "  Dimensions: ";
+            for (const auto dim : matrix->extents) {
+                std::cout << dim << " ";
             }
+            std::cout << "\n";
+            std::cout << "  Number of elements: " << matrix->data.count << "\n";
             
-            // Check if it looks like matrix data
-            if (it->second.is_object()) {
-                auto& matrix_obj = it->second.get_object();
-                auto layout_it = matrix_obj.find("layout");
-                auto extents_it = matrix_obj.find("extents");
-                auto value_it = matrix_obj.find("value");
-                
-                if (layout_it != matrix_obj.end() && extents_it != matrix_obj.end() && value_it != matrix_obj.end()) {
-                    std::cout << "  ✓ Found matrix structure with layout, extents, and value\n";
-                    
-                    if (extents_it->second.is_array()) {
-                        auto& extents = extents_it->second.get_array();
-                        std::cout << "  Dimensions: ";
-                        for (const auto& dim : extents) {
-                            if (dim.is_number()) {
-                                std::cout << dim.get_number() << " ";
-                            }
-                        }
-                        std::cout << "\n";
-                    }
-                    
-                    if (value_it->second.is_array()) {
-                        auto& values = value_it->second.get_array();
-                        std::cout << "  Number of elements: " << values.size() << "\n";
-                        std::cout << "  First few elements: ";
-                        for (size_t i = 0; i < std::min(size_t(5), values.size()); ++i) {
-                            if (values[i].is_number()) {
-                                std::cout << values[i].get_number() << " ";
-                            }
-                        }
-                        std::cout << "...\n";
-                    }
-                }
+            // Decode only this entry, straight from the mapped bytes
+            Eigen::Matrix<float, 3, 3, Eigen::RowMajor> row_major;
+            auto raw = entry->raw();
+            if (raw && !glz::read_beve(row_major, *raw)) {
+                std::cout << "  ✓ Decoded into Eigen::Matrix<float, 3, 3, RowMajor>\n";
+                std::cout << "  Values:\n" << row_major << "\n";
+            } else {
+                std::cout << "  ✗ Failed to decode into a 3x3 float matrix\n";
             }
+        } else {
+            std::cout << "  ✗ row_major_2d is not a matrix: " << beve::to_string(matrix.error()) << "\n";
         }
+    } else {
+        std::cout << "  ✗ row_major_2d not found\n";
     }
     
     std::cout << "\n";
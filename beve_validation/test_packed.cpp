@@ -0,0 +1,199 @@
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "beve_mmap.hpp"
+#include "beve_packed.hpp"
+#include "beve_view.hpp"
+#include "test_check.hpp"
+
+namespace fs = std::filesystem;
+
+using beve::test::check;
+
+// Compares bit patterns, so NaNs and signed zeros must come back exactly
+template <class T>
+bool same_bits(const std::vector<T>& a, const std::vector<T>& b) {
+   return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0);
+}
+
+template <class T>
+bool round_trips(const std::vector<T>& values, beve::pack_codec codec) {
+   std::string bytes;
+   beve::write_packed_array(bytes, std::span<const T>(values), codec);
+   std::vector<T> restored;
+   return beve::read_packed_array(std::string_view(bytes), restored) && same_bits(values, restored);
+}
+
+template <class T>
+void test_type(const std::string& label, T (*make)(size_t)) {
+   bool ok = true;
+   // Sizes around the block length exercise empty, single-value and partial last blocks
+   for (size_t n : {size_t(0), size_t(1), size_t(127), size_t(128), size_t(129), size_t(1000)}) {
+      std::vector<T> values(n);
+      for (size_t i = 0; i < n; ++i) {
+         values[i] = make(i);
+      }
+      ok &= round_trips(values, beve::pack_codec::xor_previous);
+      ok &= round_trips(values, beve::pack_codec::delta);
+   }
+   check(ok, label + " round trips with both codecs");
+}
+
+void test_round_trips() {
+   std::cout << "\nRound trips...\n";
+   test_type<float>("float", [](size_t i) { return float(i) * 0.1f; });
+   test_type<double>("double", [](size_t i) { return std::sin(double(i) / 10.0) * 1e6; });
+   test_type<int8_t>("int8", [](size_t i) { return int8_t(i * 37); });
+   test_type<int16_t>("int16", [](size_t i) { return int16_t(1000 - int(i) * 3); });
+   test_type<int32_t>("int32", [](size_t i) { return int32_t(i * i) - 5000; });
+   test_type<int64_t>("int64", [](size_t i) { return int64_t(1'700'000'000'000) + int64_t(i) * 1000; });
+   test_type<uint8_t>("uint8", [](size_t i) { return uint8_t(255 - i); });
+   test_type<uint32_t>("uint32", [](size_t i) { return uint32_t(i % 7 == 0 ? 0xffffffffu : i); });
+   test_type<uint64_t>("uint64", [](size_t i) { return uint64_t(i) << 40; });
+
+   // Full-width residuals take the two-word unpacking path
+   std::mt19937_64 rng(42);
+   std::vector<uint64_t> noise(1000);
+   for (auto& v : noise) {
+      v = rng();
+   }
+   check(round_trips(noise, beve::pack_codec::xor_previous) && round_trips(noise, beve::pack_codec::delta),
+         "random 64-bit values");
+
+   std::vector<int64_t> extremes{0, std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::min(), -1, 1};
+   check(round_trips(extremes, beve::pack_codec::delta), "wrapping deltas between int64 extremes");
+
+   std::vector<double> specials{0.0, -0.0, std::numeric_limits<double>::quiet_NaN(),
+                                std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(),
+                                std::numeric_limits<double>::denorm_min(), 1.0};
+   check(round_trips(specials, beve::pack_codec::xor_previous), "NaN, infinities, signed zero and subnormals");
+}
+
+void test_compression() {
+   std::cout << "\nCompression...\n";
+   std::vector<float> series(100'000);
+   for (size_t i = 0; i < series.size(); ++i) {
+      series[i] = float(i) * 0.1f;
+   }
+   const size_t raw = series.size() * sizeof(float);
+   std::string xored, delta;
+   beve::write_packed_array(xored, std::span<const float>(series), beve::pack_codec::xor_previous);
+   beve::write_packed_array(delta, std::span<const float>(series), beve::pack_codec::delta);
+   std::cout << "    i * 0.1f, 100K floats: " << raw << " raw, " << xored.size() << " xor, " << delta.size()
+             << " delta\n";
+   check(xored.size() < raw && delta.size() < raw / 2, "monotonic floats pack below the raw size");
+
+   std::vector<int64_t> timestamps(100'000);
+   for (size_t i = 0; i < timestamps.size(); ++i) {
+      timestamps[i] = 1'700'000'000'000 + int64_t(i) * 1000 + int64_t(i % 3);
+   }
+   std::string packed;
+   beve::write_packed_array(packed, std::span<const int64_t>(timestamps));
+   check(packed.size() * 4 < timestamps.size() * sizeof(int64_t), "regular int64 timestamps pack 4x or better");
+
+   std::vector<int32_t> constant(1000, 7);
+   std::string flat;
+   beve::write_packed_array(flat, std::span<const int32_t>(constant));
+   // 8 blocks of a width byte and the first value, no residual bits
+   auto view = beve::as_packed_array(flat);
+   check(view && view->payload.size() == 8 * (1 + sizeof(int32_t)), "constant blocks store no residual bits");
+}
+
+void test_views_and_errors() {
+   std::cout << "\nViews and malformed input...\n";
+   std::vector<double> values(300);
+   for (size_t i = 0; i < values.size(); ++i) {
+      values[i] = double(i) * 0.5;
+   }
+
+   // {"packed": <packed array>, "after": "x"}: walkers must step over the payload
+   std::string object;
+   object.push_back(char(beve::headers::string_object));
+   beve::write_compressed_size(object, 2);
+   beve::write_compressed_size(object, 6);
+   object.append("packed");
+   beve::write_packed_array(object, std::span<const double>(values));
+   beve::write_compressed_size(object, 5);
+   object.append("after");
+   object.push_back(char(beve::headers::string));
+   beve::write_compressed_size(object, 1);
+   object.append("x");
+
+   beve::beve_view root{object};
+   auto after = root.find("after");
+   check(after && after->as_string() && *after->as_string() == "x", "finds a field that follows a packed array");
+   auto packed = root.find("packed");
+   std::vector<double> restored;
+   check(packed && packed->raw() && beve::read_packed_array(*packed->raw(), restored) && restored == values,
+         "decodes a packed array found through a view");
+   check(beve::skip_value(object, 0).value_or(0) == object.size(), "skip_value spans the whole object");
+
+   std::string bytes;
+   beve::write_packed_array(bytes, std::span<const double>(values));
+   std::vector<float> wrong_type;
+   auto mismatch = beve::read_packed_array(std::string_view(bytes), wrong_type);
+   check(!mismatch && mismatch.error() == beve::view_error::type_mismatch, "rejects the wrong element type");
+
+   auto truncated = beve::read_packed_array(std::string_view(bytes).substr(0, bytes.size() - 10), restored);
+   check(!truncated, "rejects a truncated payload");
+
+   // A count far beyond what the payload could hold must not allocate
+   std::string lying;
+   lying.push_back(char(beve::headers::packed_array));
+   lying.push_back(char(beve::pack_codec::delta));
+   lying.push_back(char(beve::typed_array_header<int64_t>()));
+   beve::write_compressed_size(lying, uint64_t(1) << 40);
+   beve::write_compressed_size(lying, 9);
+   lying.append(9, '\0');
+   std::vector<int64_t> ignored;
+   auto overflow = beve::read_packed_array(std::string_view(lying), ignored);
+   check(!overflow && overflow.error() == beve::view_error::size_overflow && ignored.empty(),
+         "rejects a count the payload cannot hold");
+}
+
+// julia_generated/packed_arrays.beve holds {"floats": Float32[i * 0.1 for i in 0:9999],
+// "ints": Int64[1_700_000_000_000 + 1000i for i in 0:9999]} written with pack_arrays = true
+void test_julia_files() {
+   std::cout << "\nReading Julia packed arrays...\n";
+   if (!fs::exists("julia_generated")) {
+      std::cout << "  julia_generated directory not found. Run test_validation.jl first.\n";
+      return;
+   }
+   std::string bytes;
+   if (!beve::read_file("julia_generated/packed_arrays.beve", bytes)) {
+      check(false, "packed_arrays.beve exists");
+      return;
+   }
+   std::vector<float> floats, expected_floats(10000);
+   std::vector<int64_t> ints, expected_ints(10000);
+   for (size_t i = 0; i < 10000; ++i) {
+      expected_floats[i] = float(i) * 0.1f;
+      expected_ints[i] = 1'700'000'000'000 + int64_t(i) * 1000;
+   }
+   beve::beve_view root{bytes};
+   auto f = root.find("floats");
+   auto n = root.find("ints");
+   check(f && f->raw() && beve::read_packed_array(*f->raw(), floats) && floats == expected_floats, "floats match");
+   check(n && n->raw() && beve::read_packed_array(*n->raw(), ints) && ints == expected_ints, "ints match");
+}
+
+int main() {
+   std::cout << "Testing packed numeric arrays\n";
+   std::cout << "=============================\n";
+
+   test_round_trips();
+   test_compression();
+   test_views_and_errors();
+   test_julia_files();
+
+   return beve::test::report("packed");
+}
@@ -0,0 +1,251 @@
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "beve_patch.hpp"
+#include "test_check.hpp"
+
+using namespace beve::test;
+
+// {"name": "sensor", "count": 0 (i64), "values": [1.5, 2.5, 3.5] (f64 array),
+//  "tags": ["a", "bc"] (string array), "flags": [true, false, ... x10] (bool array),
+//  "nested": {"list": [7, "x"] (generic array), "a/b": 1},
+//  "by_id": {-5: "minus five"} (i16 keys), "variant": tag 1 {"inner": 4}, "last": "end"}
+static std::string make_object() {
+   std::string out(1, char(beve::headers::string_object));
+   beve::write_compressed_size(out, 9);
+   write_key(out, "name");
+   write_string(out, "sensor");
+   write_key(out, "count");
+   out += encode_number(beve::headers::i64, int64_t(0));
+
+   write_key(out, "values");
+   out.push_back(char(beve::headers::f64_array));
+   beve::write_compressed_size(out, 3);
+   for (double v : {1.5, 2.5, 3.5}) {
+      out.append(reinterpret_cast<const char*>(&v), sizeof(v));
+   }
+
+   write_key(out, "tags");
+   out.push_back(char(beve::headers::string_array));
+   beve::write_compressed_size(out, 2);
+   for (std::string_view s : {"a", "bc"}) {
+      beve::write_compressed_size(out, s.size());
+      out.append(s);
+   }
+
+   write_key(out, "flags");
+   out.push_back(char(beve::headers::bool_array));
+   beve::write_compressed_size(out, 10);
+   out.push_back(char(0b0000'0101)); // elements 0 and 2
+   out.push_back(char(0b0000'0010)); // element 9
+
+   write_key(out, "nested");
+   out.push_back(char(beve::headers::string_object));
+   beve::write_compressed_size(out, 2);
+   write_key(out, "list");
+   out.push_back(char(beve::headers::generic_array));
+   beve::write_compressed_size(out, 2);
+   out += encode_i32(7);
+   write_string(out, "x");
+   write_key(out, "a/b");
+   out += encode_i32(1);
+
+   write_key(out, "by_id");
+   out.push_back(char(beve::headers::i16_object));
+   beve::write_compressed_size(out, 1);
+   const int16_t key = -5;
+   out.append(reinterpret_cast<const char*>(&key), sizeof(key));
+   write_string(out, "minus five");
+
+   write_key(out, "variant");
+   out.push_back(char(beve::headers::tag));
+   beve::write_compressed_size(out, 1);
+   out.push_back(char(beve::headers::string_object));
+   beve::write_compressed_size(out, 1);
+   write_key(out, "inner");
+   out += encode_i32(4);
+
+   write_key(out, "last");
+   write_string(out, "end");
+   return out;
+}
+
+static std::string at(const std::string& buffer, std::string_view pointer) {
+   auto target = beve::resolve_pointer(buffer, pointer);
+   return target ? target->encoded(buffer) : "<" + std::string(beve::to_string(target.error())) + ">";
+}
+
+static std::optional<beve::patch_kind> patch(std::string& buffer, std::string_view pointer, std::string_view value) {
+   auto r = beve::patch_value(buffer, pointer, value);
+   return r ? std::optional{r->kind} : std::nullopt;
+}
+
+static bool is_single_value(const std::string& buffer) {
+   auto end = beve::skip_value(buffer, 0);
+   return end && *end == buffer.size();
+}
+
+void test_in_place() {
+   std::cout << "\nSame-size updates...\n";
+   std::string object = make_object();
+   const size_t size = object.size();
+   const char* data = object.data();
+
+   check(beve::patch_number(object, "/count", int64_t(41)).has_value() &&
+            at(object, "/count") == encode_number(beve::headers::i64, int64_t(41)),
+         "patch_number overwrites an i64");
+   check(patch(object, "/name", encode_string("SENSOR")) == beve::patch_kind::in_place &&
+            at(object, "/name") == encode_string("SENSOR"),
+         "an equal-length string is overwritten in place");
+   check(patch(object, "/values/1", encode_number(beve::headers::f64, 9.0)) == beve::patch_kind::in_place &&
+            at(object, "/values/1") == encode_number(beve::headers::f64, 9.0) &&
+            at(object, "/values/2") == encode_number(beve::headers::f64, 3.5),
+         "a typed array element is overwritten without its header");
+   check(patch(object, "/flags/1", std::string(1, char(beve::headers::boolean_true))) == beve::patch_kind::in_place &&
+            patch(object, "/flags/9", std::string(1, char(beve::headers::boolean_false))) == beve::patch_kind::in_place &&
+            at(object, "/flags/1") == std::string(1, char(beve::headers::boolean_true)) &&
+            at(object, "/flags/9") == std::string(1, char(beve::headers::boolean_false)) &&
+            at(object, "/flags/0") == std::string(1, char(beve::headers::boolean_true)),
+         "boolean array bits are set and cleared");
+   check(patch(object, "/variant/inner", encode_i32(5)) == beve::patch_kind::in_place &&
+            at(object, "/variant/inner") == encode_i32(5),
+         "through a type tag");
+   check(object.size() == size && object.data() == data && is_single_value(object),
+         "nothing moved or reallocated");
+
+   // The counter pattern: resolve once, overwrite many times
+   auto target = beve::resolve_pointer(object, "/count");
+   bool ok = bool(target);
+   for (int64_t i = 0; i < 1000 && ok; ++i) {
+      auto r = beve::overwrite_value(object, *target, encode_number(beve::headers::i64, i));
+      ok = r && r->kind == beve::patch_kind::in_place && r->target.begin == target->begin;
+   }
+   check(ok && at(object, "/count") == encode_number(beve::headers::i64, int64_t(999)),
+         "a resolved target stays valid across in-place updates");
+}
+
+void test_splice() {
+   std::cout << "\nResized values...\n";
+   std::string object = make_object();
+   check(patch(object, "/name", encode_string("a much longer sensor name")) == beve::patch_kind::spliced &&
+            at(object, "/name") == encode_string("a much longer sensor name") && at(object, "/last") == encode_string("end") &&
+            is_single_value(object),
+         "a longer string is spliced in and later values are intact");
+   check(patch(object, "/tags/0", encode_string("abcdef")) == beve::patch_kind::spliced &&
+            at(object, "/tags/0") == encode_string("abcdef") && at(object, "/tags/1") == encode_string("bc"),
+         "a string array element is resized");
+   check(patch(object, "/count", encode_string("many")) == beve::patch_kind::spliced &&
+            at(object, "/count") == encode_string("many"),
+         "a value can change type");
+   std::string long_string(100, 'z'); // needs a two-byte length
+   check(patch(object, "/nested/list/1", encode_string(long_string)) == beve::patch_kind::spliced &&
+            at(object, "/nested/list/1") == encode_string(long_string) && at(object, "/nested/a~1b") == encode_i32(1),
+         "a generic array element grows past a size-width boundary");
+   check(patch(object, "", encode_i32(3)) == beve::patch_kind::spliced && object == encode_i32(3),
+         "\"\" replaces the whole value");
+}
+
+void test_insert() {
+   std::cout << "\nInserted members and elements...\n";
+   std::string object = make_object();
+   auto r = beve::patch_value(object, "/unit", encode_string("kelvin"));
+   check(r && r->kind == beve::patch_kind::inserted && at(object, "/unit") == encode_string("kelvin") &&
+            r->target.encoded(object) == encode_string("kelvin") && at(object, "/last") == encode_string("end") &&
+            is_single_value(object),
+         "a missing key is appended to the object");
+   check(patch(object, "/nested/list/-", encode_i32(8)) == beve::patch_kind::inserted &&
+            at(object, "/nested/list/2") == encode_i32(8) && at(object, "/nested/a~1b") == encode_i32(1),
+         "\"-\" appends to a generic array");
+   check(patch(object, "/by_id/300", encode_string("three hundred")) == beve::patch_kind::inserted &&
+            at(object, "/by_id/300") == encode_string("three hundred") && at(object, "/by_id/-5") == encode_string("minus five"),
+         "an integer key is inserted with the object's key width");
+   check(patch(object, "/nested/t~0", encode_i32(2)) == beve::patch_kind::inserted &&
+            at(object, "/nested/t~0") == encode_i32(2),
+         "inserted keys are unescaped");
+   check(patch(object, "/variant/extra", encode_i32(6)) == beve::patch_kind::inserted &&
+            at(object, "/variant/extra") == encode_i32(6) && at(object, "/variant/inner") == encode_i32(4),
+         "inserts into a tagged object");
+
+   // A 64th member needs a two-byte count: the count grows and the new member is still found
+   std::string wide(1, char(beve::headers::string_object));
+   beve::write_compressed_size(wide, 63);
+   for (int i = 0; i < 63; ++i) {
+      write_key(wide, "k" + std::to_string(i));
+      wide += encode_i32(i);
+   }
+   auto grown = beve::patch_value(wide, "/k63", encode_i32(63));
+   check(grown && grown->target.encoded(wide) == encode_i32(63) && at(wide, "/k63") == encode_i32(63) &&
+            at(wide, "/k0") == encode_i32(0) && is_single_value(wide) && beve::compressed_size_width(64) == 2,
+         "the parent's count is rewritten when it needs a wider encoding");
+}
+
+void test_errors() {
+   std::cout << "\nRejected patches...\n";
+   const std::string original = make_object();
+   std::string object = original;
+   auto error_of = [&](std::string_view pointer, std::string_view value) {
+      auto r = beve::patch_value(object, pointer, value);
+      return r ? std::optional<beve::view_error>{} : r.error();
+   };
+   check(error_of("/values/0", encode_i32(1)) == beve::view_error::type_mismatch,
+         "a typed array element only takes its own type");
+   check(error_of("/flags/0", encode_i32(1)) == beve::view_error::type_mismatch, "a boolean element only takes booleans");
+   check(error_of("/values/3", encode_number(beve::headers::f64, 1.0)) == beve::view_error::index_out_of_range &&
+            error_of("/values/-", encode_number(beve::headers::f64, 1.0)) == beve::view_error::index_out_of_range,
+         "typed arrays are not extended");
+   check(error_of("/nested/list/5", encode_i32(1)) == beve::view_error::index_out_of_range,
+         "an index past the end of a generic array");
+   check(error_of("/missing/child", encode_i32(1)) == beve::view_error::key_not_found, "only the last key is inserted");
+   check(error_of("/by_id/70000", encode_i32(1)) == beve::view_error::key_not_found &&
+            error_of("/by_id/x", encode_i32(1)) == beve::view_error::key_not_found,
+         "an integer key must fit the object's key type");
+   check(error_of("/name/0", encode_i32(1)) == beve::view_error::type_mismatch, "indexing into a string");
+   check(error_of("/name", "\x02\x10" "ab") == beve::view_error::size_overflow &&
+            error_of("/name", encode_i32(1) + "x") == beve::view_error::invalid_header,
+         "the value must be exactly one encoded value");
+   check(object == original, "failed patches leave the buffer untouched");
+}
+
+void test_large_buffer() {
+   std::cout << "\nPatching after large values...\n";
+   // {"blob": <32 MB u8 array>, "stats": {"requests": 0 (u64)}}
+   std::string state(1, char(beve::headers::string_object));
+   beve::write_compressed_size(state, 2);
+   write_key(state, "blob");
+   state.push_back(char(beve::headers::u8_array));
+   beve::write_compressed_size(state, 32 << 20);
+   state.append(32 << 20, '\x11');
+   write_key(state, "stats");
+   state.push_back(char(beve::headers::string_object));
+   beve::write_compressed_size(state, 1);
+   write_key(state, "requests");
+   state += encode_number(beve::headers::u64, uint64_t(0));
+
+   bool ok = true;
+   for (uint64_t i = 1; i <= 10000 && ok; ++i) {
+      auto r = beve::patch_number(state, "/stats/requests", i);
+      ok = r && r->kind == beve::patch_kind::in_place;
+   }
+   check(ok && at(state, "/stats/requests") == encode_number(beve::headers::u64, uint64_t(10000)),
+         "10000 counter updates behind a 32 MB array");
+   check(patch(state, "/stats/errors", encode_number(beve::headers::u64, uint64_t(1))) == beve::patch_kind::inserted &&
+            at(state, "/stats/errors") == encode_number(beve::headers::u64, uint64_t(1)) && is_single_value(state),
+         "inserts a member after the large array");
+}
+
+int main() {
+   std::cout << "Testing in-place patching of encoded BEVE\n";
+   std::cout << "=========================================\n";
+
+   test_in_place();
+   test_splice();
+   test_insert();
+   test_errors();
+   test_large_buffer();
+
+   return beve::test::report("patch");
+}
@@ -0,0 +1,192 @@
+#include <complex>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "beve_planar.hpp"
+#include "beve_size.hpp"
+#include "test_check.hpp"
+
+#if __has_include(<Eigen/Core>)
+#include "beve_matrix.hpp"
+#endif
+
+using beve::test::check;
+
+template <class T>
+static std::vector<std::complex<T>> make_signal(size_t n) {
+   std::vector<std::complex<T>> v(n);
+   for (size_t i = 0; i < n; ++i) {
+      v[i] = {T(i) * T(0.5), -T(i) - T(0.25)};
+   }
+   return v;
+}
+
+template <class T>
+static void test_kernels(const char* type) {
+   std::cout << "\nKernels (" << type << "):\n";
+   // Every tail length around the vector widths, at odd byte offsets
+   bool split_ok = true, merge_ok = true, fallback_ok = true;
+   for (size_t n = 0; n <= 37; ++n) {
+      const auto signal = make_signal<T>(n);
+      std::string in(1 + n * sizeof(std::complex<T>), '\0');
+      if (n > 0) {
+         std::memcpy(in.data() + 1, signal.data(), n * sizeof(std::complex<T>));
+      }
+      std::string re(3 + n * sizeof(T), '\0'), im(5 + n * sizeof(T), '\0');
+      beve::deinterleave<T>(in.data() + 1, n, re.data() + 3, im.data() + 5);
+      for (size_t i = 0; i < n; ++i) {
+         T r, m;
+         std::memcpy(&r, re.data() + 3 + i * sizeof(T), sizeof(T));
+         std::memcpy(&m, im.data() + 5 + i * sizeof(T), sizeof(T));
+         split_ok = split_ok && r == signal[i].real() && m == signal[i].imag();
+      }
+      std::string out(7 + n * sizeof(std::complex<T>), '\0');
+      beve::interleave<T>(re.data() + 3, im.data() + 5, n, out.data() + 7);
+      merge_ok = merge_ok && std::memcmp(out.data() + 7, in.data() + 1, n * sizeof(std::complex<T>)) == 0;
+
+      // The scalar fallback must agree with whichever path ran above
+      std::string loop_re(re.size(), '\0'), loop_im(im.size(), '\0'), loop_out(out.size(), '\0');
+      beve::detail::deinterleave_loop<T>(in.data() + 1, n, loop_re.data() + 3, loop_im.data() + 5);
+      beve::detail::interleave_loop<T>(loop_re.data() + 3, loop_im.data() + 5, n, loop_out.data() + 7);
+      fallback_ok = fallback_ok && loop_re == re && loop_im == im && loop_out == out;
+   }
+   check(split_ok, "deinterleave, 0 to 37 elements, unaligned");
+   check(merge_ok, "interleave restores the pairs");
+   check(fallback_ok, "scalar loops match");
+}
+
+template <class T>
+static void test_arrays(const char* type) {
+   std::cout << "\nArrays (" << type << "):\n";
+   const auto signal = make_signal<T>(1001);
+   std::vector<T> re(signal.size()), im(signal.size());
+   for (size_t i = 0; i < signal.size(); ++i) {
+      re[i] = signal[i].real();
+      im[i] = signal[i].imag();
+   }
+
+   std::string from_complex, from_split, interleaved;
+   beve::write_planar_complex_array<T>(from_complex, signal);
+   beve::write_planar_complex_array<T>(from_split, re, im);
+   beve::write_exact(signal, interleaved);
+   check(from_complex == from_split, "std::complex and split writers agree");
+   check(from_complex.size() == interleaved.size() &&
+            uint8_t(from_complex[1]) == beve::planar_complex_array_header<T>() &&
+            uint8_t(interleaved[1]) == beve::complex_array_header<T>(),
+         "same size as interleaved, component header bit 1 set");
+   check(std::memcmp(from_complex.data() + 4, re.data(), re.size() * sizeof(T)) == 0, "real parts come first");
+
+   std::vector<T> out_re, out_im;
+   std::vector<std::complex<T>> out;
+   check(beve::read_split_complex<T>(from_complex, out_re, out_im) && out_re == re && out_im == im,
+         "planar into split buffers");
+   check(beve::read_split_complex<T>(interleaved, out_re, out_im) && out_re == re && out_im == im,
+         "interleaved into split buffers");
+   check(beve::read_complex_array<T>(from_complex, out) && out == signal, "planar into std::complex");
+   check(beve::read_complex_array<T>(interleaved, out) && out == signal, "interleaved into std::complex");
+
+   auto view = beve::beve_view{from_complex}.as_typed_array();
+   check(view && view->planar() && view->count == signal.size() && view->get<std::complex<T>>(17) == signal[17],
+         "typed_array_view::get assembles planar elements");
+   check(view && !view->template as_span<std::complex<T>>() &&
+            !view->copy_to(std::span<std::complex<T>>(out.data(), out.size())),
+         "as_span and copy_to refuse planar payloads");
+
+   std::string empty;
+   beve::write_planar_complex_array<T>(empty, std::span<const std::complex<T>>{});
+   check(beve::read_split_complex<T>(empty, out_re, out_im) && out_re.empty() && out_im.empty(), "empty array");
+}
+
+static void test_matrix() {
+   std::cout << "\nMatrices:\n";
+   const auto values = make_signal<double>(12);
+   std::string bytes;
+   beve::write_planar_complex_matrix<double>(bytes, 3, 4, true, values);
+   auto matrix = beve::beve_view{bytes}.as_matrix();
+   check(matrix && matrix->column_major && matrix->extents == std::vector<uint64_t>{3, 4} && matrix->data.planar(),
+         "3x4 column-major planar matrix");
+   std::vector<std::complex<double>> out;
+   check(matrix && beve::read_complex_array<double>(matrix->data, out) && out == values, "matrix data round trips");
+
+#if __has_include(<Eigen/Core>)
+   auto info = beve::inspect_matrix(bytes);
+   bool visited = false;
+   check(info && beve::visit_matrix(*info, [&]<class S>(std::type_identity<S>) {
+            visited = std::is_same_v<S, std::complex<double>>;
+         }) && visited,
+         "visit_matrix reports std::complex<double>");
+   beve::dense_matrix<std::complex<double>, Eigen::ColMajor> col;
+   beve::dense_matrix<std::complex<double>> row;
+   check(info && beve::decode_matrix(*info, col) && col.rows() == 3 && col.cols() == 4 && col(1, 2) == values[7],
+         "decode_matrix interleaves planar data");
+   check(info && beve::decode_matrix(*info, row) && row == col, "decode_matrix transposes planar data");
+   check(info && beve::map_matrix<std::complex<double>, Eigen::ColMajor>(*info).error() ==
+                    beve::view_error::planar_layout,
+         "map_matrix refuses planar data");
+   beve::dense_matrix<std::complex<float>> narrow;
+   check(info && beve::decode_matrix(*info, narrow).error() == beve::view_error::type_mismatch,
+         "component width must match");
+#endif
+}
+
+static void test_embedded() {
+   std::cout << "\nInside other values:\n";
+   // An object holding a planar array followed by another member: skipping must cover it
+   const auto signal = make_signal<float>(100);
+   std::string bytes(1, char(beve::headers::string_object));
+   beve::write_compressed_size(bytes, 2);
+   beve::write_compressed_size(bytes, 6);
+   bytes += "signal";
+   beve::write_planar_complex_array<float>(bytes, signal);
+   beve::write_compressed_size(bytes, 4);
+   bytes += "rate";
+   bytes.push_back(char(beve::number_header<double>()));
+   const double rate = 48000.0;
+   bytes.append(reinterpret_cast<const char*>(&rate), sizeof(rate));
+
+   beve::beve_view root{bytes};
+   auto field = root.find("rate");
+   check(field && field->as_number<double>() == 48000.0, "members after a planar array are found");
+   auto array = root.find("signal");
+   auto typed = array ? array->as_typed_array() : std::unexpected(array.error());
+   std::vector<std::complex<float>> out;
+   check(typed && beve::read_complex_array<float>(*typed, out) && out == signal, "planar member decodes");
+   check(typed && !beve::element_matches<std::complex<float>>(typed->header, typed->complex_header),
+         "not mistaken for an interleaved array by typed readers");
+}
+
+static void test_errors() {
+   std::cout << "\nErrors:\n";
+   std::string bytes;
+   beve::write_planar_complex_array<float>(bytes, make_signal<float>(10));
+   std::vector<double> re, im;
+   check(beve::read_split_complex<double>(bytes, re, im).error() == beve::view_error::type_mismatch,
+         "component width must match");
+   std::string floats;
+   beve::write_exact(std::vector<float>{1, 2, 3}, floats);
+   std::vector<float> fre, fim;
+   check(beve::read_split_complex<float>(floats, fre, fim).error() == beve::view_error::type_mismatch,
+         "real arrays are not complex");
+   bool truncated = true;
+   for (size_t n = 0; n < bytes.size(); ++n) {
+      truncated = !beve::read_split_complex<float>(std::string_view(bytes).substr(0, n), fre, fim) && truncated;
+   }
+   check(truncated, "every truncation fails");
+}
+
+int main() {
+   std::cout << "Testing planar complex arrays\n";
+   std::cout << "=============================\n";
+
+   test_kernels<float>("float");
+   test_kernels<double>("double");
+   test_arrays<float>("float");
+   test_arrays<double>("double");
+   test_matrix();
+   test_embedded();
+   test_errors();
+
+   return beve::test::report("planar complex");
+}
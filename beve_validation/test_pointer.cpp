@@ -0,0 +1,206 @@
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "beve_mmap.hpp"
+#include "beve_pointer.hpp"
+#include "beve_view.hpp"
+#include "test_check.hpp"
+
+namespace fs = std::filesystem;
+
+using namespace beve::test;
+
+// {"name": "sensor", "values": [1.5, 2.5, 3.5] (f64 array), "tags": ["a", "bc"] (string array),
+//  "flags": [true, false, ... x10] (bool array),
+//  "nested": {"list": [7, "x"] (generic array), "a/b": 1, "t~": 2},
+//  "by_id": {-5: "minus five", 300: "three hundred"} (i16 keys),
+//  "variant": tag 1 {"inner": 4}}
+static std::string make_object() {
+   std::string out(1, char(beve::headers::string_object));
+   beve::write_compressed_size(out, 7);
+   write_key(out, "name");
+   write_string(out, "sensor");
+
+   write_key(out, "values");
+   out.push_back(char(beve::headers::f64_array));
+   beve::write_compressed_size(out, 3);
+   for (double v : {1.5, 2.5, 3.5}) {
+      out.append(reinterpret_cast<const char*>(&v), sizeof(v));
+   }
+
+   write_key(out, "tags");
+   out.push_back(char(beve::headers::string_array));
+   beve::write_compressed_size(out, 2);
+   for (std::string_view s : {"a", "bc"}) {
+      beve::write_compressed_size(out, s.size());
+      out.append(s);
+   }
+
+   write_key(out, "flags");
+   out.push_back(char(beve::headers::bool_array));
+   beve::write_compressed_size(out, 10);
+   out.push_back(char(0b0000'0101)); // elements 0 and 2
+   out.push_back(char(0b0000'0010)); // element 9
+
+   write_key(out, "nested");
+   out.push_back(char(beve::headers::string_object));
+   beve::write_compressed_size(out, 3);
+   write_key(out, "list");
+   out.push_back(char(beve::headers::generic_array));
+   beve::write_compressed_size(out, 2);
+   out += encode_i32(7);
+   write_string(out, "x");
+   write_key(out, "a/b");
+   out += encode_i32(1);
+   write_key(out, "t~");
+   out += encode_i32(2);
+
+   write_key(out, "by_id");
+   out.push_back(char(beve::headers::i16_object));
+   beve::write_compressed_size(out, 2);
+   for (auto [key, value] : {std::pair<int16_t, std::string_view>{-5, "minus five"}, {300, "three hundred"}}) {
+      out.append(reinterpret_cast<const char*>(&key), sizeof(key));
+      write_string(out, value);
+   }
+
+   write_key(out, "variant");
+   out.push_back(char(beve::headers::tag));
+   beve::write_compressed_size(out, 1);
+   out.push_back(char(beve::headers::string_object));
+   beve::write_compressed_size(out, 1);
+   write_key(out, "inner");
+   out += encode_i32(4);
+   return out;
+}
+
+static std::string at(const std::string& buffer, std::string_view pointer) {
+   auto target = beve::resolve_pointer(buffer, pointer);
+   return target ? target->encoded(buffer) : "<" + std::string(beve::to_string(target.error())) + ">";
+}
+
+void test_resolution() {
+   std::cout << "\nResolving pointers...\n";
+   const std::string object = make_object();
+   auto whole = beve::resolve_pointer(object, "");
+   auto slash = beve::resolve_pointer(object, "/");
+   check(whole && whole->begin == 0 && whole->end == object.size() && slash && slash->end == object.size(),
+         "\"\" and \"/\" select the whole value");
+
+   check(at(object, "/name") == encode_string("sensor"), "/name");
+   check(at(object, "/values/1") == encode_number(beve::headers::f64, 2.5), "/values/1 is an f64 scalar");
+   check(at(object, "/tags/1") == encode_string("bc"), "/tags/1 is a string");
+   check(at(object, "/flags/0") == std::string(1, char(beve::headers::boolean_true)) &&
+            at(object, "/flags/1") == std::string(1, char(beve::headers::boolean_false)) &&
+            at(object, "/flags/9") == std::string(1, char(beve::headers::boolean_true)),
+         "boolean array elements become boolean values");
+   check(at(object, "/nested/list/0") == encode_i32(7) && at(object, "/nested/list/1") == encode_string("x"),
+         "generic array elements");
+   check(at(object, "/nested/a~1b") == encode_i32(1) && at(object, "/nested/t~0") == encode_i32(2),
+         "~1 and ~0 escapes");
+   check(at(object, "/by_id/-5") == encode_string("minus five") && at(object, "/by_id/300") == encode_string("three hundred"),
+         "integer-keyed objects, including negative keys");
+   check(at(object, "/variant/inner") == encode_i32(4), "type tags are transparent");
+   auto tagged = beve::resolve_pointer(object, "/variant");
+   check(tagged && uint8_t(object[tagged->begin]) == beve::headers::tag, "a pointer ending at a tag keeps it");
+
+   auto nested = beve::resolve_pointer(object, "/nested");
+   check(nested && nested->element_header == 0 &&
+            beve::beve_view{nested->span(object)}.find("list").has_value(),
+         "span() is the value in place");
+}
+
+void test_errors() {
+   std::cout << "\nPointers that do not resolve...\n";
+   const std::string object = make_object();
+   auto error_of = [&](std::string_view pointer) {
+      auto target = beve::resolve_pointer(object, pointer);
+      return target ? std::optional<beve::view_error>{} : target.error();
+   };
+   check(error_of("/nope") == beve::view_error::key_not_found, "a missing key");
+   check(error_of("/nam") == beve::view_error::key_not_found, "a key prefix is not a key");
+   check(error_of("/values/3") == beve::view_error::index_out_of_range, "an index past the end");
+   check(error_of("/values/x") == beve::view_error::index_out_of_range, "a non-numeric index");
+   check(error_of("/by_id/7") == beve::view_error::key_not_found && error_of("/by_id/x") == beve::view_error::key_not_found,
+         "a missing integer key");
+   check(error_of("/name/0") == beve::view_error::type_mismatch, "indexing into a string");
+   check(error_of("/values/0/x") == beve::view_error::type_mismatch, "descending below a typed array element");
+   check(error_of("name") == beve::view_error::key_not_found, "a pointer without a leading '/'");
+
+   // Every truncation must fail cleanly rather than read past the end
+   bool ok = true;
+   for (size_t n = 0; n < object.size(); ++n) {
+      const std::string_view cut = std::string_view(object).substr(0, n);
+      for (const char* pointer : {"/variant/inner", "/by_id/300", "/nested/t~0", "/flags/9", "/tags/1", ""}) {
+         auto target = beve::resolve_pointer(cut, pointer);
+         ok &= !target || target->end <= n;
+      }
+   }
+   check(ok, "truncated buffers never resolve past their end");
+}
+
+void test_large_object() {
+   std::cout << "\nSkipping over large values...\n";
+   // {"blob": <8 MB u8 array>, "employees": [{"name", "salary"} x 10000], "last": "end"}
+   std::string object(1, char(beve::headers::string_object));
+   beve::write_compressed_size(object, 3);
+   write_key(object, "blob");
+   object.push_back(char(beve::headers::u8_array));
+   beve::write_compressed_size(object, 8 << 20);
+   object.append(8 << 20, '\x7f');
+   write_key(object, "employees");
+   object.push_back(char(beve::headers::generic_array));
+   beve::write_compressed_size(object, 10000);
+   for (int i = 0; i < 10000; ++i) {
+      object.push_back(char(beve::headers::string_object));
+      beve::write_compressed_size(object, 2);
+      write_key(object, "name");
+      write_string(object, "employee " + std::to_string(i));
+      write_key(object, "salary");
+      object += encode_number(beve::headers::f64, 1000.0 + i);
+   }
+   write_key(object, "last");
+   write_string(object, "end");
+
+   check(at(object, "/employees/9999/salary") == encode_number(beve::headers::f64, 10999.0),
+         "/employees/9999/salary after an 8 MB array");
+   check(at(object, "/employees/3/name") == encode_string("employee 3"), "/employees/3/name");
+   check(at(object, "/last") == encode_string("end"), "/last");
+}
+
+// julia_generated/all_types.beve is to_beve of AllTypes from test_validation.jl
+void test_julia_files() {
+   std::cout << "\nResolving pointers in Julia files...\n";
+   if (!fs::exists("julia_generated")) {
+      std::cout << "  julia_generated directory not found. Run test_validation.jl first.\n";
+      return;
+   }
+   std::string bytes;
+   if (!beve::read_file("julia_generated/all_types.beve", bytes)) {
+      check(false, "all_types.beve exists");
+      return;
+   }
+   check(at(bytes, "/nested/basic/str") == encode_string("Hello, BEVE!"), "/nested/basic/str");
+   check(at(bytes, "/nested/extra") == encode_i32(999), "/nested/extra");
+   check(at(bytes, "/arrays/string_vec/2") == encode_string("gamma"), "/arrays/string_vec/2");
+   check(at(bytes, "/arrays/bool_vec/3") == std::string(1, char(beve::headers::boolean_true)), "/arrays/bool_vec/3");
+   check(at(bytes, "/maps/int_string_map/2") == encode_string("second"), "/maps/int_string_map/2");
+   check(at(bytes, "/basic/i64") == encode_number(beve::headers::i64, int64_t(-9223372036854775807)), "/basic/i64");
+}
+
+int main() {
+   std::cout << "Testing JSON pointers over encoded BEVE\n";
+   std::cout << "=======================================\n";
+
+   test_resolution();
+   test_errors();
+   test_large_object();
+   test_julia_files();
+
+   return beve::test::report("pointer");
+}
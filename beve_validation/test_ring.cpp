@@ -0,0 +1,150 @@
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "beve_shm_ring.hpp"
+#include "beve_view.hpp"
+#include "test_check.hpp"
+
+using beve::test::check;
+
+// A frame whose bytes are derived from its sequence number, so corruption and reordering show
+static std::string make_frame(uint64_t seq, size_t size) {
+   std::string frame(size, '\0');
+   for (size_t i = 0; i < size; ++i) {
+      frame[i] = char((seq * 131 + i * 7) & 0xff);
+   }
+   if (size >= sizeof(seq)) {
+      std::memcpy(frame.data(), &seq, sizeof(seq));
+   }
+   return frame;
+}
+
+void test_single_process() {
+   std::cout << "\nOne producer and one consumer mapping...\n";
+   const char* name = "/beve_test_ring";
+   beve::shm_ring producer, consumer;
+   check(producer.create(name, 1000), "creates a segment");
+   check(producer.capacity() == 1024, "rounds the capacity up to a power of two");
+   check(consumer.open(name), "opens the segment by name");
+   check(!consumer.front(), "an empty ring has no frame");
+
+   check(producer.try_push("") && producer.try_push("hello"), "pushes frames");
+   auto empty = consumer.front();
+   check(empty && empty->empty(), "delivers an empty frame");
+   consumer.pop();
+   auto hello = consumer.front();
+   check(hello && *hello == "hello", "delivers frames in order");
+   consumer.pop();
+
+   // Frames of every length up to the maximum, enough to go around the region many times
+   bool ok = true;
+   for (uint64_t seq = 0; seq < 5000; ++seq) {
+      const auto frame = make_frame(seq, size_t(seq * 37 % (producer.max_frame_size() + 1)));
+      ok &= producer.try_push(frame);
+      auto got = consumer.front();
+      ok &= got && *got == frame;
+      consumer.pop();
+   }
+   check(ok, "wraps around the region without splitting frames");
+
+   size_t pushed = 0;
+   while (producer.try_push(make_frame(pushed, 100))) {
+      ++pushed;
+   }
+   check(pushed > 0 && pushed <= 1024 / 112, "refuses frames once the ring is full");
+   consumer.pop();
+   check(producer.try_push(make_frame(pushed, 100)), "accepts a frame once the consumer releases one");
+
+   const std::string too_big(producer.max_frame_size() + 1, 'x');
+   check(!producer.push(too_big) && !producer.error().empty(), "rejects a frame larger than the maximum");
+
+   producer.close_writer();
+   size_t drained = 0;
+   while (auto frame = consumer.wait_front()) {
+      ++drained;
+      consumer.pop();
+   }
+   check(drained == pushed && consumer.closed_by_writer(), "drains the remaining frames after close_writer");
+
+   beve::shm_ring::unlink(name);
+   beve::shm_ring missing;
+   check(!missing.open(name) && !missing.error().empty(), "fails to open an unlinked segment");
+}
+
+void test_threads() {
+   std::cout << "\nProducer and consumer threads...\n";
+   const char* name = "/beve_test_ring_threads";
+   beve::shm_ring producer;
+   if (!producer.create(name, 1 << 16)) {
+      check(false, "creates a segment: " + producer.error());
+      return;
+   }
+   constexpr uint64_t frames = 200'000;
+   std::thread writer([&] {
+      for (uint64_t seq = 0; seq < frames; ++seq) {
+         producer.push(make_frame(seq, 8 + size_t(seq % 3000)));
+      }
+      producer.close_writer();
+   });
+
+   beve::shm_ring consumer;
+   bool ok = consumer.open(name);
+   uint64_t received = 0;
+   while (ok) {
+      auto frame = consumer.wait_front();
+      if (!frame) {
+         break;
+      }
+      ok = *frame == make_frame(received, 8 + size_t(received % 3000));
+      consumer.pop();
+      ++received;
+   }
+   writer.join();
+   check(ok && received == frames, std::to_string(received) + " frames arrive intact and in order");
+   beve::shm_ring::unlink(name);
+}
+
+// test_validation.jl leaves the segment /beve_julia_ring holding to_beve("hello from julia")
+// and to_beve(Float32.(1:1000)), then closes it
+void test_julia_ring() {
+   std::cout << "\nReading the Julia ring...\n";
+   beve::shm_ring ring;
+   if (!ring.open("/beve_julia_ring")) {
+      std::cout << "  /beve_julia_ring not found. Run test_validation.jl first.\n";
+      return;
+   }
+   auto first = ring.wait_front();
+   auto text = first ? beve::beve_view{*first}.as_string() : std::unexpected(beve::view_error::unexpected_end);
+   check(text && *text == "hello from julia", "string frame");
+   if (first) {
+      ring.pop();
+   }
+   auto second = ring.wait_front();
+   auto floats = second ? beve::beve_view{*second}.as_typed_array()
+                        : std::unexpected(beve::view_error::unexpected_end);
+   bool ok = floats && floats->count == 1000;
+   for (size_t i = 0; ok && i < 1000; ++i) {
+      ok = floats->get<float>(i) == float(i + 1);
+   }
+   check(ok, "float array frame decodes in place");
+   if (second) {
+      ring.pop();
+   }
+   check(!ring.wait_front(), "the ring is closed and drained");
+   beve::shm_ring::unlink("/beve_julia_ring");
+}
+
+int main() {
+   std::cout << "Testing the shared-memory frame ring\n";
+   std::cout << "====================================\n";
+
+   test_single_process();
+   test_threads();
+   test_julia_ring();
+
+   return beve::test::report("ring");
+}
@@ -0,0 +1,202 @@
+#include <complex>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "beve_size.hpp"
+#include "test_check.hpp"
+
+using namespace beve::test;
+
+struct sample
+{
+   int32_t id{};
+   std::string name;
+   std::vector<double> values;
+   std::optional<std::string> note;
+   std::vector<std::complex<float>> signal;
+   std::map<std::string, std::variant<int64_t, std::string>> attributes;
+};
+
+template <>
+struct beve::layout<sample>
+{
+   using T = sample;
+   static constexpr auto value =
+      beve::object_layout{beve::member{"id", &T::id},         beve::member{"name", &T::name},
+                          beve::member{"values", &T::values}, beve::member{"note", &T::note},
+                          beve::member{"signal", &T::signal}, beve::member{"attributes", &T::attributes}};
+};
+
+static sample make_sample(bool with_note) {
+   sample s;
+   s.id = 7;
+   s.name = "probe";
+   s.values = {1.5, 2.5};
+   if (with_note) {
+      s.note = "hi";
+   }
+   s.signal = {{1.0f, -1.0f}};
+   s.attributes = {{"count", int64_t(3)}, {"unit", std::string("mV")}};
+   return s;
+}
+
+// The bytes glz::write_beve produces for make_sample
+static std::string expected_sample(bool with_note) {
+   std::string out(1, char(beve::headers::string_object));
+   beve::write_compressed_size(out, with_note ? 6 : 5);
+   write_key(out, "id");
+   out.push_back(char(beve::headers::i32));
+   append_raw(out, int32_t(7));
+   write_key(out, "name");
+   out.push_back(char(beve::headers::string));
+   write_key(out, "probe");
+   write_key(out, "values");
+   out.push_back(char(beve::headers::f64_array));
+   beve::write_compressed_size(out, 2);
+   append_raw(out, 1.5);
+   append_raw(out, 2.5);
+   if (with_note) {
+      write_key(out, "note");
+      out.push_back(char(beve::headers::string));
+      write_key(out, "hi");
+   }
+   write_key(out, "signal");
+   out.push_back(char(beve::headers::complex));
+   out.push_back(char(beve::complex_array_header<float>()));
+   beve::write_compressed_size(out, 1);
+   append_raw(out, std::complex<float>{1.0f, -1.0f});
+   write_key(out, "attributes");
+   out.push_back(char(beve::headers::string_object));
+   beve::write_compressed_size(out, 2);
+   write_key(out, "count");
+   out.push_back(char(beve::headers::tag));
+   beve::write_compressed_size(out, 0);
+   out.push_back(char(beve::headers::i64));
+   append_raw(out, int64_t(3));
+   write_key(out, "unit");
+   out.push_back(char(beve::headers::tag));
+   beve::write_compressed_size(out, 1);
+   out.push_back(char(beve::headers::string));
+   write_key(out, "mV");
+   return out;
+}
+
+// size_of agrees with the bytes written and with skip_value over them
+template <class T>
+static bool consistent(const T& v) {
+   std::string out;
+   beve::write_exact(v, out);
+   auto end = beve::skip_value(out, 0);
+   return out.size() == beve::size_of(v) && end && *end == out.size();
+}
+
+static void test_scalars() {
+   std::cout << "\nScalars and strings:\n";
+   check(beve::size_of(true) == 1 && beve::size_of(int8_t(1)) == 2 && beve::size_of(3.0) == 9,
+         "bool, i8 and f64 sizes");
+   check(beve::size_of(std::complex<double>{}) == 18, "a complex<double> is header, component header, payload");
+   check(beve::size_of(std::optional<int32_t>{}) == 1 && beve::size_of(std::optional<int32_t>{5}) == 5,
+         "an empty optional is null");
+
+   std::string single;
+   beve::write_exact(std::complex<float>{1.0f, 2.0f}, single);
+   check(uint8_t(single[0]) == beve::headers::complex && uint8_t(single[1]) == 0x40,
+         "a single complex uses the non-array component header");
+
+   bool widths = true;
+   for (size_t n : {0, 63, 64, 16383, 16384}) {
+      const std::string s(n, 'x');
+      widths = widths && beve::size_of(s) == 1 + beve::compressed_size_width(n) + n && consistent(s);
+   }
+   check(widths, "string size prefixes widen at 64 and 16384 bytes");
+}
+
+static void test_containers() {
+   std::cout << "\nContainers:\n";
+   const std::vector<float> floats(1000, 1.0f);
+   check(beve::size_of(floats) == 1 + 2 + 4000 && consistent(floats), "a float array is header, size, payload");
+   const std::vector<bool> bits(13, true);
+   std::string encoded;
+   beve::write_exact(bits, encoded);
+   check(beve::size_of(bits) == 4 && encoded.size() == 4 && uint8_t(encoded[2]) == 0xff &&
+            uint8_t(encoded[3]) == 0x1f,
+         "bool arrays are bit packed");
+   const std::vector<std::string> names{"a", "bc", ""};
+   check(beve::size_of(names) == 2 + 2 + 3 + 1 && consistent(names), "string arrays store bodies only");
+   const std::vector<std::vector<int16_t>> nested{{1, 2}, {}, {3}};
+   check(consistent(nested), "arrays of arrays are generic arrays");
+   const std::map<uint32_t, std::string> by_id{{1, "a"}, {2, "b"}};
+   encoded.clear();
+   beve::write_exact(by_id, encoded);
+   check(uint8_t(encoded[0]) == beve::headers::u32_object && encoded.size() == 2 + 2 * (4 + 3) &&
+            consistent(by_id),
+         "integer keys are raw");
+   const std::vector<std::complex<double>> cplx(100);
+   check(beve::size_of(cplx) == 1 + 1 + 2 + 1600 && consistent(cplx), "complex arrays");
+}
+
+static void test_structs() {
+   std::cout << "\nStructs:\n";
+   for (bool with_note : {true, false}) {
+      const sample s = make_sample(with_note);
+      std::string out;
+      beve::write_exact(s, out);
+      check(out == expected_sample(with_note) && beve::size_of(s) == out.size(),
+            with_note ? "a struct matches glaze's bytes" : "an empty optional member is skipped");
+   }
+   std::vector<sample> many(100, make_sample(true));
+   check(consistent(many), "an array of structs");
+}
+
+static void test_destinations() {
+   std::cout << "\nDestinations:\n";
+   const sample s = make_sample(true);
+   const size_t n = beve::size_of(s);
+
+   std::vector<char> region(n + 8, '\x7f');
+   auto written = beve::write_into(s, region);
+   check(written && *written == n && std::string(region.data(), n) == expected_sample(true) && region[n] == '\x7f',
+         "write_into fills exactly its bytes of a caller region");
+   std::vector<char> small(n - 1, '\x7f');
+   auto r = beve::write_into(s, small);
+   check(!r && r.error() == beve::view_error::size_overflow && small[0] == '\x7f',
+         "a region that is too small is rejected before writing");
+
+   std::string reused;
+   reused.reserve(4 * n);
+   const char* before = reused.data();
+   beve::write_exact(s, reused);
+   check(reused.data() == before && reused.size() == n, "write_exact reuses capacity it already has");
+
+   const std::string path = "test_size_output.beve";
+   std::vector<double> big(1 << 16);
+   for (size_t i = 0; i < big.size(); ++i) {
+      big[i] = double(i);
+   }
+   std::string file, direct;
+   beve::write_exact(big, direct);
+   check(beve::write_file_exact(big, path) && beve::read_file(path, file) && file == direct,
+         "write_file_exact writes the encoded bytes through a mapping");
+   check(beve::write_file_exact(std::vector<double>{}, path) && beve::read_file(path, file) &&
+            file == std::string("\x64\x00", 2),
+         "an overwritten file is truncated to the new size");
+   std::remove(path.c_str());
+}
+
+int main() {
+   std::cout << "Testing exact encoded sizes\n";
+   std::cout << "===========================\n";
+
+   test_scalars();
+   test_containers();
+   test_structs();
+   test_destinations();
+
+   return beve::test::report("exact size");
+}
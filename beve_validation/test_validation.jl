@@ -3,6 +3,14 @@ Pkg.activate("..")
 using BEVE
 using Test
 
+# The zstd helpers live in a package extension; the compressed files are skipped without it
+const HAS_ZSTD = try
+    @eval using CodecZstd
+    true
+catch
+    false
+end
+
 # Define structures matching C++ types
 struct BasicTypes
     b::Bool
@@ -67,6 +75,12 @@ struct LargeArrayTypes
     large_complex_double_vec::Vector{ComplexF64}
 end
 
+struct ColumnarRecord
+    id::Int32
+    value::Float64
+    name::String
+end
+
 # Create test data
 function create_basic_types()
     BasicTypes(
@@ -214,6 +228,49 @@ function generate_julia_test_files()
     beve_data = write_beve_file(large, "julia_generated/large_arrays.beve")
     write_time = time() - t0
     println("  Write time: $(round(write_time * 1000, digits=1)) ms")
+
+    # Reduced-precision arrays for test_half; i * 0.25 for i < 256 is exact in bf16 and f16
+    quarters = Dict("values" => Float32[i * 0.25f0 for i in 0:255])
+    for format in (:bf16, :f16)
+        filename = "julia_generated/$(format)_array.beve"
+        println("Writing $filename")
+        bytes = to_beve(quarters; float32_as = format)
+        write(filename, bytes)
+        println("  Wrote $(length(bytes)) bytes")
+    end
+
+    # Packed arrays for test_packed
+    series = Dict("floats" => Float32[i * 0.1f0 for i in 0:9999],
+                  "ints" => Int64[1_700_000_000_000 + 1000i for i in 0:9999])
+    println("Writing julia_generated/packed_arrays.beve")
+    bytes = to_beve(series; pack_arrays = true)
+    write("julia_generated/packed_arrays.beve", bytes)
+    println("  Wrote $(length(bytes)) bytes")
+
+    # Row-wise records with dictionary-encoded keys for beve_validator (beve::expand_keys)
+    println("Writing julia_generated/keyed_records.beve")
+    bytes = to_beve([ColumnarRecord(Int32(i), i * 0.25, "record $i") for i in 0:999]; dict_keys = true)
+    write("julia_generated/keyed_records.beve", bytes)
+    println("  Wrote $(length(bytes)) bytes")
+
+    # A shared-memory ring for test_ring, left in place (and closed) for it to drain
+    if Sys.islinux()
+        println("Writing the /beve_julia_ring shared-memory ring")
+        ring = create_beve_ring("beve_julia_ring"; capacity = 1 << 16)
+        write_beve_frame(ring, "hello from julia")
+        write_beve_frame(ring, Float32.(1:1000))
+        finish_beve_ring(ring)
+        close(ring)
+    end
+
+    if HAS_ZSTD
+        # Compressed copies for beve_zstd.hpp; test_zstd checks they decompress to the files above
+        for (data, name) in ((basic, "basic_types"), (complex, "complex_types"),
+                             (all, "all_types"), (large, "large_arrays"))
+            compressed = write_beve_zstd_file("julia_generated/$name.beve.zst", data)
+            println("Wrote julia_generated/$name.beve.zst ($(length(compressed)) bytes)")
+        end
+    end
 end
 
 # Test reading C++ generated files
@@ -307,6 +364,137 @@ function test_cpp_generated_files()
             println("  Error: $e")
         end
     end
+
+    # Test bf16/f16 arrays from beve::write_half_array
+    if isfile("$cpp_dir/half_arrays.beve")
+        println("\nTesting half_arrays.beve")
+        beve_data = read_beve_file("$cpp_dir/half_arrays.beve")
+        try
+            parsed = from_beve(beve_data)
+            expected = Float32[i * 0.25f0 for i in 0:255]
+            println("  bf16 match expected: ", parsed["bf16"] isa Vector{Float32} && parsed["bf16"] == expected ? "✓" : "✗")
+            println("  f16 match expected: ", parsed["f16"] isa Vector{Float16} && parsed["f16"] == expected ? "✓" : "✗")
+            println("  f32 match expected: ", parsed["f32"] == expected ? "✓" : "✗")
+        catch e
+            println("  Error: $e")
+        end
+    end
+
+    # Test packed arrays from beve::write_packed_array
+    if isfile("$cpp_dir/packed_arrays.beve")
+        println("\nTesting packed_arrays.beve")
+        beve_data = read_beve_file("$cpp_dir/packed_arrays.beve")
+        try
+            parsed = from_beve(beve_data)
+            floats = Float32[i * 0.1f0 for i in 0:9999]
+            ints = Int64[1_700_000_000_000 + 1000i for i in 0:9999]
+            println("  xor floats match expected: ", parsed["floats"] == floats ? "✓" : "✗")
+            println("  delta floats match expected: ", parsed["floats_delta"] == floats ? "✓" : "✗")
+            println("  delta ints match expected: ", parsed["ints"] == ints ? "✓" : "✗")
+        catch e
+            println("  Error: $e")
+        end
+    end
+
+    # Test the shared-memory ring beve_validator leaves behind
+    if Sys.islinux() && isfile("/dev/shm/beve_cpp_ring")
+        println("\nTesting the /beve_cpp_ring shared-memory ring")
+        try
+            ring = open_beve_ring("beve_cpp_ring")
+            frame = read_beve_frame(copy, ring; timeout = 1)
+            println("  first frame matches basic_types.beve: ",
+                    frame == read("$cpp_dir/basic_types.beve") ? "✓" : "✗")
+            println("  float frame decodes in place: ",
+                    read_beve_frame(ring; timeout = 1) == Float32.(1:1000) ? "✓" : "✗")
+            println("  ring is closed and drained: ", read_beve_frame(ring; timeout = 1) === nothing ? "✓" : "✗")
+            close(ring)
+        catch e
+            println("  Error: $e")
+        end
+        unlink_beve_ring("beve_cpp_ring")
+    end
+
+    # Resolve JSON pointers on the encoded bytes of all_types.beve
+    if isfile("$cpp_dir/all_types.beve")
+        println("\nTesting JSON pointers over all_types.beve")
+        bytes = read("$cpp_dir/all_types.beve")
+        try
+            whole = from_beve(bytes)
+            for pointer in ("/nested/basic/str", "/nested/extra", "/arrays/string_vec/2", "/arrays/bool_vec/3",
+                            "/arrays/double_vec/1", "/maps/int_string_map/2", "/basic/u64")
+                parts = split(pointer[2:end], '/')
+                expected = foldl((v, p) -> v isa AbstractVector ? v[parse(Int, p) + 1] :
+                                           v isa Dict{String} ? v[p] : v[parse(keytype(v), p)], parts; init = whole)
+                println("  $pointer: ", isequal(from_beve_at(bytes, pointer), expected) ? "✓" : "✗")
+            end
+
+            # Patch the C++ bytes in place and by splice; everything else must decode unchanged
+            patched = copy(bytes)
+            patch_beve!(patched, "/arrays/double_vec/1", 42.0)
+            patch_beve!(patched, "/nested/basic/str", "patched from Julia")
+            patch_beve!(patched, "/maps/int_string_map/99", "inserted")
+            after = from_beve(patched)
+            whole["arrays"]["double_vec"][2] = 42.0
+            whole["nested"]["basic"]["str"] = "patched from Julia"
+            whole["maps"]["int_string_map"][99] = "inserted"
+            println("  patched in place, spliced and inserted: ", isequal(after, whole) ? "✓" : "✗")
+        catch e
+            println("  Error: $e")
+        end
+    end
+
+    # Test a columnar record batch from beve::write_columnar
+    if isfile("$cpp_dir/columnar_records.beve")
+        println("\nTesting columnar_records.beve")
+        beve_data = read_beve_file("$cpp_dir/columnar_records.beve")
+        try
+            records = deser_beve(Vector{ColumnarRecord}, beve_data)
+            expected = [ColumnarRecord(Int32(i), i * 0.25, "record $i") for i in 0:length(records) - 1]
+            println("  $(length(records)) records, match expected: ", records == expected ? "✓" : "✗")
+        catch e
+            println("  Error: $e")
+        end
+    end
+
+    # Test row-wise records whose keys beve::encode_keys dictionary encoded
+    if isfile("$cpp_dir/keyed_records.beve")
+        println("\nTesting keyed_records.beve")
+        beve_data = read_beve_file("$cpp_dir/keyed_records.beve")
+        try
+            records = deser_beve(Vector{ColumnarRecord}, beve_data)
+            expected = [ColumnarRecord(Int32(i), i * 0.25, "record $i") for i in 0:length(records) - 1]
+            println("  $(length(records)) records, match expected: ", records == expected ? "✓" : "✗")
+        catch e
+            println("  Error: $e")
+        end
+    end
+end
+
+# Test reading C++ generated zstd files against their uncompressed counterparts
+function test_cpp_zstd_files()
+    println("\n=== Testing C++ Generated zstd Files ===")
+
+    cpp_dir = "build/cpp_generated"
+    if !HAS_ZSTD
+        println("CodecZstd not available, skipping.")
+        return
+    end
+    if !isdir(cpp_dir)
+        println("$cpp_dir directory not found. Run C++ tests first.")
+        return
+    end
+
+    for file in filter(f -> endswith(f, ".beve.zst"), readdir(cpp_dir))
+        path = joinpath(cpp_dir, file)
+        plain = read(path[1:end-4])
+        println("\nTesting $file ($(filesize(path)) bytes, $(length(plain)) uncompressed)")
+        @test transcode(ZstdDecompressor, read(path)) == plain
+        @test read_beve_zstd_file(path) == from_beve(plain)
+        if file == "basic_types.beve.zst"
+            @test deser_beve_zstd_file(BasicTypes, path) == deser_beve(BasicTypes, plain)
+        end
+        println("  ✓ matches $(file[1:end-4])")
+    end
 end
 
 # Test round-trip serialization
@@ -371,6 +559,7 @@ function run_tests()
     
     # Test reading C++ generated files
     test_cpp_generated_files()
+    test_cpp_zstd_files()
     
     # Test round-trip serialization
     test_round_trip()
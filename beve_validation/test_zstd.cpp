@@ -0,0 +1,105 @@
+#include <glaze/glaze.hpp>
+#include <glaze/beve.hpp>
+#include <complex>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "beve_mmap.hpp"
+#include "beve_zstd.hpp"
+#include "test_check.hpp"
+
+namespace fs = std::filesystem;
+
+struct ZstdSample {
+   std::vector<float> floats;
+   std::vector<std::complex<double>> complex_values;
+   std::map<std::string, int32_t> lookup;
+   std::string name = "zstd sample";
+};
+
+template <>
+struct glz::meta<ZstdSample> {
+   using T = ZstdSample;
+   static constexpr auto value = object("floats", &T::floats, "complex_values", &T::complex_values,
+                                        "lookup", &T::lookup, "name", &T::name);
+};
+
+static void check(bool ok, const std::string& what, const beve::zstd_codec& codec) {
+   beve::test::check(ok, ok || codec.error().empty() ? what : what + " (" + codec.error() + ")");
+}
+
+void test_round_trip() {
+   std::cout << "\nRound trip through every level class...\n";
+   ZstdSample sample;
+   for (int i = 0; i < 10000; ++i) {
+      sample.floats.push_back(float(i) * 0.25f);
+      sample.complex_values.emplace_back(i * 0.5, -i * 0.5);
+   }
+   for (int i = 0; i < 100; ++i) {
+      sample.lookup["key" + std::to_string(i)] = i;
+   }
+
+   beve::zstd_codec codec;
+   std::string compressed;
+   for (int level : {beve::zstd_codec::min_level(), 1, beve::zstd_codec::default_level, 19}) {
+      ZstdSample restored;
+      restored.name.clear();
+      const bool ok = codec.write(sample, compressed, level) && codec.read(restored, compressed);
+      check(ok && restored.floats == sample.floats && restored.complex_values == sample.complex_values &&
+               restored.lookup == sample.lookup && restored.name == sample.name,
+            "level " + std::to_string(level) + " (" + std::to_string(compressed.size()) + " bytes)", codec);
+   }
+
+   std::string garbage = "definitely not zstd";
+   ZstdSample ignored;
+   check(!codec.read(ignored, garbage), "rejects data that is not zstd", codec);
+   if (codec.write(sample, compressed)) {
+      compressed.resize(compressed.size() / 2);
+      check(!codec.read(ignored, compressed), "rejects a truncated frame", codec);
+   }
+}
+
+// Every julia_generated/*.beve.zst must decompress to exactly the bytes of the matching
+// uncompressed file and decode as generic BEVE
+void test_julia_files() {
+   std::cout << "\nReading Julia zstd files...\n";
+   if (!fs::exists("julia_generated")) {
+      std::cout << "  julia_generated directory not found. Run test_validation.jl first.\n";
+      return;
+   }
+
+   beve::zstd_codec codec;
+   size_t found = 0;
+   for (const auto& entry : fs::directory_iterator("julia_generated")) {
+      const std::string path = entry.path().string();
+      if (!path.ends_with(".beve.zst")) {
+         continue;
+      }
+      ++found;
+      glz::json_t value{};
+      const bool decoded = codec.read_file(value, path);
+      check(decoded, entry.path().filename().string() + " decodes", codec);
+
+      std::string plain;
+      const std::string plain_path = path.substr(0, path.size() - 4);
+      if (decoded && beve::read_file(plain_path, plain)) {
+         check(codec.last_beve() == plain, "  matches " + fs::path(plain_path).filename().string(), codec);
+      }
+   }
+   if (found == 0) {
+      std::cout << "  No .beve.zst files in julia_generated (CodecZstd not installed for Julia?)\n";
+   }
+}
+
+int main() {
+   std::cout << "Testing zstd-compressed BEVE\n";
+   std::cout << "============================\n";
+
+   test_round_trip();
+   test_julia_files();
+
+   return beve::test::report("zstd");
+}
@@ -0,0 +1,253 @@
+#pragma once
+
+// The structs beve_validator round-trips with BEVE.jl, shared with beve_benchmark so both
+// measure the same shapes of data.
+
+#include <glaze/glaze.hpp>
+#include <glaze/beve.hpp>
+
+#include <array>
+#include <complex>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include "beve_columnar.hpp"
+#include "beve_size.hpp"
+
+struct BasicTypes {
+   bool b = true;
+   int8_t i8 = -42;
+   uint8_t u8 = 200;
+   int16_t i16 = -1234;
+   uint16_t u16 = 45678;
+   int32_t i32 = -2147483647;
+   uint32_t u32 = 3000000000;
+   int64_t i64 = -9223372036854775807LL;
+   uint64_t u64 = 18446744073709551615ULL;
+   float f32 = 3.14159f;
+   double f64 = 2.718281828459045;
+   std::string str = "Hello, BEVE!";
+};
+
+template <>
+struct glz::meta<BasicTypes> {
+   using T = BasicTypes;
+   static constexpr auto value = object(
+      "b", &T::b,
+      "i8", &T::i8,
+      "u8", &T::u8,
+      "i16", &T::i16,
+      "u16", &T::u16,
+      "i32", &T::i32,
+      "u32", &T::u32,
+      "i64", &T::i64,
+      "u64", &T::u64,
+      "f32", &T::f32,
+      "f64", &T::f64,
+      "str", &T::str
+   );
+};
+
+struct ArrayTypes {
+   std::vector<int32_t> int_vec = {1, 2, 3, 4, 5};
+   std::vector<double> double_vec = {1.1, 2.2, 3.3};
+   std::vector<std::string> string_vec = {"alpha", "beta", "gamma"};
+   std::vector<bool> bool_vec = {true, false, true, true, false};
+   std::array<int32_t, 5> int_array = {10, 20, 30, 40, 50};
+};
+
+template <>
+struct glz::meta<ArrayTypes> {
+   using T = ArrayTypes;
+   static constexpr auto value = object(
+      "int_vec", &T::int_vec,
+      "double_vec", &T::double_vec,
+      "string_vec", &T::string_vec,
+      "bool_vec", &T::bool_vec,
+      "int_array", &T::int_array
+   );
+};
+
+struct ComplexTypes {
+   std::complex<float> cf = {1.5f, 2.5f};
+   std::complex<double> cd = {3.7, 4.8};
+   std::vector<std::complex<float>> complex_vec = {{1.0f, 2.0f}, {3.0f, 4.0f}, {5.0f, 6.0f}};
+};
+
+template <>
+struct glz::meta<ComplexTypes> {
+   using T = ComplexTypes;
+   static constexpr auto value = object(
+      "cf", &T::cf,
+      "cd", &T::cd,
+      "complex_vec", &T::complex_vec
+   );
+};
+
+struct MapTypes {
+   std::map<std::string, int32_t> string_int_map = {{"one", 1}, {"two", 2}, {"three", 3}};
+   std::map<int32_t, std::string> int_string_map = {{1, "first"}, {2, "second"}, {3, "third"}};
+   std::unordered_map<std::string, double> unordered_map = {{"pi", 3.14159}, {"e", 2.71828}};
+};
+
+template <>
+struct glz::meta<MapTypes> {
+   using T = MapTypes;
+   static constexpr auto value = object(
+      "string_int_map", &T::string_int_map,
+      "int_string_map", &T::int_string_map,
+      "unordered_map", &T::unordered_map
+   );
+};
+
+struct OptionalTypes {
+   std::optional<int32_t> opt_int = 42;
+   std::optional<std::string> opt_string = "optional value";
+   std::optional<double> opt_empty = std::nullopt;
+};
+
+template <>
+struct glz::meta<OptionalTypes> {
+   using T = OptionalTypes;
+   static constexpr auto value = object(
+      "opt_int", &T::opt_int,
+      "opt_string", &T::opt_string,
+      "opt_empty", &T::opt_empty
+   );
+};
+
+struct VariantTypes {
+   using var_t = std::variant<int32_t, double, std::string>;
+   var_t var_int = 42;
+   var_t var_double = 3.14;
+   var_t var_string = std::string("variant string");
+};
+
+template <>
+struct glz::meta<VariantTypes> {
+   using T = VariantTypes;
+   static constexpr auto value = object(
+      "var_int", &T::var_int,
+      "var_double", &T::var_double,
+      "var_string", &T::var_string
+   );
+};
+
+struct NestedStruct {
+   BasicTypes basic;
+   ArrayTypes arrays;
+   int32_t extra = 999;
+};
+
+template <>
+struct glz::meta<NestedStruct> {
+   using T = NestedStruct;
+   static constexpr auto value = object(
+      "basic", &T::basic,
+      "arrays", &T::arrays,
+      "extra", &T::extra
+   );
+};
+
+struct AllTypes {
+   BasicTypes basic;
+   ArrayTypes arrays;
+   ComplexTypes complex;
+   MapTypes maps;
+   OptionalTypes optionals;
+   VariantTypes variants;
+   NestedStruct nested;
+};
+
+struct LargeArrayTypes {
+   std::vector<float> large_float_vec;
+   std::vector<double> large_double_vec;
+   std::vector<std::complex<float>> large_complex_float_vec;
+   std::vector<std::complex<double>> large_complex_double_vec;
+   
+   LargeArrayTypes() : LargeArrayTypes(10000) {}
+   
+   explicit LargeArrayTypes(size_t size) {
+      large_float_vec.reserve(size);
+      large_double_vec.reserve(size);
+      large_complex_float_vec.reserve(size);
+      large_complex_double_vec.reserve(size);
+      
+      for (size_t i = 0; i < size; ++i) {
+         large_float_vec.push_back(static_cast<float>(i) * 0.1f);
+         large_double_vec.push_back(static_cast<double>(i) * 0.01);
+         large_complex_float_vec.push_back({static_cast<float>(i), static_cast<float>(i) * 0.5f});
+         large_complex_double_vec.push_back({static_cast<double>(i) * 0.1, static_cast<double>(i) * 0.2});
+      }
+   }
+};
+
+template <>
+struct glz::meta<LargeArrayTypes> {
+   using T = LargeArrayTypes;
+   static constexpr auto value = object(
+      "large_float_vec", &T::large_float_vec,
+      "large_double_vec", &T::large_double_vec,
+      "large_complex_float_vec", &T::large_complex_float_vec,
+      "large_complex_double_vec", &T::large_complex_double_vec
+   );
+};
+
+// The same members, in the same order, for beve::size_of / beve::write_exact. test_large_arrays
+// in main.cpp checks write_exact against glz::write_beve byte for byte.
+template <>
+struct beve::layout<LargeArrayTypes> {
+   using T = LargeArrayTypes;
+   static constexpr auto value = beve::object_layout{
+      beve::member{"large_float_vec", &T::large_float_vec},
+      beve::member{"large_double_vec", &T::large_double_vec},
+      beve::member{"large_complex_float_vec", &T::large_complex_float_vec},
+      beve::member{"large_complex_double_vec", &T::large_complex_double_vec}
+   };
+};
+
+template <>
+struct glz::meta<AllTypes> {
+   using T = AllTypes;
+   static constexpr auto value = object(
+      "basic", &T::basic,
+      "arrays", &T::arrays,
+      "complex", &T::complex,
+      "maps", &T::maps,
+      "optionals", &T::optionals,
+      "variants", &T::variants,
+      "nested", &T::nested
+   );
+};
+
+// One row of a record batch, written column by column with beve::write_columnar
+struct ColumnarRecord {
+   int32_t id = 0;
+   double value = 0.0;
+   std::string name;
+};
+
+template <>
+struct glz::meta<ColumnarRecord> {
+   using T = ColumnarRecord;
+   static constexpr auto value = object("id", &T::id, "value", &T::value, "name", &T::name);
+};
+
+inline constexpr auto columnar_record_columns = beve::columnar_layout{
+   beve::column{"id", &ColumnarRecord::id}, beve::column{"value", &ColumnarRecord::value},
+   beve::column{"name", &ColumnarRecord::name}};
+
+inline std::vector<ColumnarRecord> make_columnar_records(size_t count) {
+   std::vector<ColumnarRecord> records(count);
+   for (size_t i = 0; i < count; ++i) {
+      records[i].id = int32_t(i);
+      records[i].value = double(i) * 0.25;
+      records[i].name = "record " + std::to_string(i);
+   }
+   return records;
+}
@@ -4,7 +4,7 @@ using BEVE
 using HTTP
 
 # Import the functions we need from BEVE
-using BEVE: to_beve, from_beve, deser_beve
+using BEVE: to_beve, from_beve, deser_beve, BeveBuffer, resolve_beve_pointer, patch_beve_encoded!
 
 # Import the stubs we'll extend
 import BEVE: register_object, unregister_object, start_server, BeveHttpClient
@@ -60,6 +60,9 @@ end
 
 company = Company("ACME Corp", employees)
 register_object("/api/company", company)
+
+# Keep the value encoded: GETs slice the bytes, POSTs with a pointer patch them in place
+register_object("/api/state", BeveBuffer(to_beve(state)))
 ```
 """
 function BEVE.register_object(path::String, obj::T) where T
@@ -279,6 +282,20 @@ function handle_get_request(path::String, json_pointer::String = "")::HTTP.Respo
                                "Object not found at path: $path\n\nAvailable paths: $available_paths_str")
         end
         
+        # Encoded buffers are sliced, never re-serialized
+        if obj isa BeveBuffer
+            target = try
+                resolve_beve_pointer(obj.data, json_pointer)
+            catch e
+                return HTTP.Response(400, "JSON pointer resolution error: $(e)")
+            end
+            beve_data = obj.data[target.range]
+            target.element_header == 0x00 || pushfirst!(beve_data, target.element_header)
+            return HTTP.Response(200,
+                               ["Content-Type" => "application/x-beve"],
+                               beve_data)
+        end
+
         # Resolve JSON pointer if provided
         if !isempty(json_pointer)
             pointer_segments = parse_json_pointer(json_pointer)
@@ -307,6 +324,17 @@ Handle POST request to create/update BEVE data.
 """
 function handle_post_request(path::String, body::Vector{UInt8}, json_pointer::String = "")::HTTP.Response
     try
+        # A pointer into an encoded buffer patches the body's bytes in without decoding them
+        current = get(GLOBAL_REGISTRY.registered_objects, path, nothing)
+        if current isa BeveBuffer && !isempty(json_pointer)
+            try
+                patch_beve_encoded!(current.data, json_pointer, body)
+                return HTTP.Response(200, "Object updated at path: $path$json_pointer")
+            catch e
+                return HTTP.Response(400, "JSON pointer update error: $(e)")
+            end
+        end
+
         # Deserialize the body
         new_data = from_beve(body)
         
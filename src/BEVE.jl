@@ -1,5 +1,7 @@
 module BEVE
 
+using Mmap
+
 function deser end
 function parse_value end
 
@@ -38,17 +40,105 @@ end
 # Convenience constructor
 BeveMatrix(layout::MatrixLayout, extents::Vector{Int}, data::Vector{T}) where T = BeveMatrix{T}(layout, extents, data)
 
+"""
+    BeveSortedDict{K, V}(keys::Vector{K}, vals::Vector{V})
+    BeveSortedDict(dict::AbstractDict)
+
+A read-only dictionary kept as two parallel vectors, keys sorted ascending: the layout of C++23
+`std::flat_map` (and of `beve::flat_map` in beve_validation/beve_flat_map.hpp). Lookups are
+binary searches. `from_beve(data; sorted_int_keys = true)` decodes integer-keyed objects into
+one, and writing one emits its entries in key order.
+
+The constructors sort their input; for a repeated key the last value wins.
+"""
+struct BeveSortedDict{K, V} <: AbstractDict{K, V}
+    keys::Vector{K}
+    vals::Vector{V}
+
+    # `keys` must already be sorted and unique
+    BeveSortedDict{K, V}(keys::Vector{K}, vals::Vector{V}, ::Val{:sorted}) where {K, V} = new{K, V}(keys, vals)
+end
+
+function BeveSortedDict{K, V}(keys::AbstractVector, vals::AbstractVector) where {K, V}
+    length(keys) == length(vals) ||
+        throw(ArgumentError("BeveSortedDict needs as many values ($(length(vals))) as keys ($(length(keys)))"))
+    sorted_keys, sorted_vals = sort_by_key(Vector{K}(keys), Vector{V}(vals))
+    return BeveSortedDict{K, V}(sorted_keys, sorted_vals, Val(:sorted))
+end
+
+BeveSortedDict(keys::AbstractVector{K}, vals::AbstractVector{V}) where {K, V} = BeveSortedDict{K, V}(keys, vals)
+BeveSortedDict{K, V}(dict::AbstractDict) where {K, V} = BeveSortedDict{K, V}(collect(keys(dict)), collect(values(dict)))
+BeveSortedDict(dict::AbstractDict{K, V}) where {K, V} = BeveSortedDict{K, V}(dict)
+BeveSortedDict{K, V}() where {K, V} = BeveSortedDict{K, V}(K[], V[], Val(:sorted))
+
+# Orders `keys` and `vals` by key, keeping the last value of each repeated key. Input that is
+# already strictly increasing is returned as is.
+function sort_by_key(keys::Vector{K}, vals::Vector{V}) where {K, V}
+    issorted(keys; lt = <=) && return keys, vals
+    order = sortperm(keys; alg = Base.Sort.DEFAULT_STABLE)
+    keep = [i == length(order) || !isequal(keys[order[i]], keys[order[i + 1]]) for i in eachindex(order)]
+    order = order[keep]
+    return keys[order], vals[order]
+end
+
+Base.length(d::BeveSortedDict) = length(d.keys)
+
+function Base.iterate(d::BeveSortedDict, i::Int = 1)
+    i > length(d.keys) && return nothing
+    return (d.keys[i] => d.vals[i]), i + 1
+end
+
+# Index of `key` in `d.keys`, or 0
+function sorted_index(d::BeveSortedDict, key)
+    i = searchsortedfirst(d.keys, key)
+    return i <= length(d.keys) && isequal(d.keys[i], key) ? i : 0
+end
+
+Base.haskey(d::BeveSortedDict, key) = sorted_index(d, key) != 0
+
+function Base.get(d::BeveSortedDict, key, default)
+    i = sorted_index(d, key)
+    return i == 0 ? default : d.vals[i]
+end
+
+function Base.getindex(d::BeveSortedDict, key)
+    i = sorted_index(d, key)
+    i == 0 && throw(KeyError(key))
+    return d.vals[i]
+end
+
+Base.keys(d::BeveSortedDict) = d.keys
+Base.values(d::BeveSortedDict) = d.vals
+
 # Exports for serialization
-export to_beve, to_beve!, write_beve_file, to_beve_zstd, write_beve_zstd_file,
+export to_beve, to_beve!, to_beve_columnar, write_beve_file, to_beve_zstd, write_beve_zstd_file, beve_size_of,
        BeveTypeTag, BeveMatrix, MatrixLayout, LayoutRight, LayoutLeft, @skip
 
 # Exports for deserialization  
 export from_beve, read_beve_file, from_beve_zstd, read_beve_zstd_file,
-       deser_beve, deser_beve_file, deser_beve_zstd, deser_beve_zstd_file
+       deser_beve, deser_beve_file, deser_beve_zstd, deser_beve_zstd_file, BeveSortedDict
+
+# Exports for sidecar indexes
+export BeveIndex, BeveIndexEntry, write_beve_index, read_beve_index, read_beve_slice
+
+# Exports for JSON pointers over encoded bytes
+export BevePointerTarget, resolve_beve_pointer, from_beve_at, deser_beve_at
+
+# Exports for in-place patching of encoded buffers
+export BeveBuffer, patch_beve!, patch_beve_encoded!
+
+# Exports for shared-memory frame rings
+export BeveRing, create_beve_ring, open_beve_ring, unlink_beve_ring, finish_beve_ring,
+       write_beve_frame, read_beve_frame, deser_beve_frame
 
 include("Headers.jl")
 include("Ser.jl")
+include("Size.jl")
 include("De.jl")
+include("Index.jl")
+include("Pointer.jl")
+include("Patch.jl")
+include("Ring.jl")
 
 # HTTP functionality stubs - these will be replaced by the extension when HTTP.jl is loaded
 function register_object end
@@ -8,9 +8,12 @@ mutable struct BeveDeserializer{IOType<:IO}
     pos::UInt64                 # Current byte position for error reporting
 
     preserve_matrices::Bool
+    sorted_int_keys::Bool       # Integer-keyed objects become BeveSortedDicts instead of Dicts
+    keys::Vector{String}        # Key table for KEYED_OBJECTs, from the last KEY_TABLE read
 
-    function BeveDeserializer(io::IO; preserve_matrices::Bool = false)
-        new{typeof(io)}(io, nothing, Vector{UInt8}(undef, 8192), Vector{UInt8}(undef, 64), UInt64(0), preserve_matrices)
+    function BeveDeserializer(io::IO; preserve_matrices::Bool = false, sorted_int_keys::Bool = false)
+        new{typeof(io)}(io, nothing, Vector{UInt8}(undef, 8192), Vector{UInt8}(undef, 64), UInt64(0), preserve_matrices,
+                        sorted_int_keys, String[])
     end
 end
 
@@ -36,6 +39,8 @@ const HEADER_PARSERS = Dict{UInt8, Function}(
     U32 => (deser) -> ltoh(read(deser.io, UInt32)),
     U64 => (deser) -> ltoh(read(deser.io, UInt64)),
     U128 => (deser) -> ltoh(read(deser.io, UInt128)),
+    BF16 => (deser) -> bf16_to_float32(ltoh(read(deser.io, UInt16))),
+    F16 => (deser) -> ltoh(read(deser.io, Float16)),
     F32 => (deser) -> ltoh(read(deser.io, Float32)),
     F64 => (deser) -> ltoh(read(deser.io, Float64)),
     STRING => (deser) -> read_string_data(deser),
@@ -52,6 +57,8 @@ const HEADER_PARSERS = Dict{UInt8, Function}(
     U128_OBJECT => (deser) -> parse_integer_object(deser, UInt128),
     BOOL_ARRAY => (deser) -> parse_bool_array(deser),
     STRING_ARRAY => (deser) -> parse_string_array(deser),
+    BF16_ARRAY => (deser) -> parse_bf16_array(deser),
+    F16_ARRAY => (deser) -> parse_f16_array(deser),
     F32_ARRAY => (deser) -> parse_f32_array(deser),
     F64_ARRAY => (deser) -> parse_f64_array(deser),
     I8_ARRAY => (deser) -> parse_i8_array(deser),
@@ -65,7 +72,10 @@ const HEADER_PARSERS = Dict{UInt8, Function}(
     GENERIC_ARRAY => (deser) -> parse_generic_array(deser),
     COMPLEX => (deser) -> parse_complex(deser),
     TAG => (deser) -> parse_type_tag(deser),
-    MATRIX => (deser) -> parse_matrix(deser)
+    MATRIX => (deser) -> parse_matrix(deser),
+    PACKED_ARRAY => (deser) -> parse_packed_array(deser),
+    KEY_TABLE => (deser) -> parse_key_table(deser),
+    KEYED_OBJECT => (deser) -> parse_keyed_object(deser)
 )
 
 struct BeveError <: Exception
@@ -101,34 +111,43 @@ function peek_byte!(deser::BeveDeserializer)::UInt8
     return deser.peek_byte
 end
 
-# Optimized size reading function
+# Sizes below 64 fit in the first byte and take the inlined early exit; wider sizes are
+# handled out of line by `read_wide_size`.
 @inline function read_size(deser::BeveDeserializer)::Int
     first = read_byte!(deser)
-    n_bytes = 1 << (first & 0b11)  # Faster than 2^(first & 0b11)
-    
-    if n_bytes == 1
+    width_code = first & 0b11
+    if width_code == 0x00
         return Int(first >> 2)
     end
-    
-    if n_bytes == 2
-        second = read_byte!(deser)
-        val = UInt16(first) | (UInt16(second) << 8)
-        return Int(ltoh(val) >> 2)
-    elseif n_bytes == 4
-        # Read 3 more bytes
-        val = UInt32(first)
-        val |= UInt32(read_byte!(deser)) << 8
-        val |= UInt32(read_byte!(deser)) << 16
-        val |= UInt32(read_byte!(deser)) << 24
-        return Int(ltoh(val) >> 2)
-    else  # n_bytes == 8
-        # Read 7 more bytes
-        val = UInt64(first)
-        for i in 1:7
-            val |= UInt64(read_byte!(deser)) << (8 * i)
+    return read_wide_size(deser, first, width_code)
+end
+
+# Whether `n` more bytes can be read without hitting the end. Only buffers know this up
+# front; other streams take the checked byte-at-a-time path.
+@inline has_bytes(io::IOBuffer, n::Int) = bytesavailable(io) >= n
+@inline has_bytes(::IO, ::Int) = false
+
+# Decodes a 2, 4 or 8 byte size whose first byte was already consumed. When the bytes are
+# known to be present they are read in one call and the little-endian word is masked to the
+# encoded width, instead of being assembled one byte (and one EOF check) at a time.
+function read_wide_size(deser::BeveDeserializer, first::UInt8, width_code::UInt8)::Int
+    n_bytes = 1 << width_code
+    if has_bytes(deser.io, n_bytes - 1)
+        buf = deser.temp_buffer
+        @inbounds buf[1] = first
+        GC.@preserve buf begin
+            unsafe_read(deser.io, pointer(buf, 2), n_bytes - 1)
+            word = ltoh(unsafe_load(Ptr{UInt64}(pointer(buf))))
         end
-        return Int(ltoh(val) >> 2)
+        deser.pos += n_bytes - 1
+        return Int((word & (typemax(UInt64) >> (64 - 8 * n_bytes))) >> 2)
+    end
+
+    val = UInt64(first)
+    for i in 1:(n_bytes - 1)
+        val |= UInt64(read_byte!(deser)) << (8 * i)
     end
+    return Int(val >> 2)
 end
 
 function read_string_data(deser::BeveDeserializer)::String
@@ -158,7 +177,7 @@ end
     end
 end
 
-@inline function read_array_data!(io::IO, result::Vector{T}) where T <: Union{Int16, Int32, Int64, UInt16, UInt32, UInt64, Float32, Float64}
+@inline function read_array_data!(io::IO, result::Vector{T}) where T <: Union{Int16, Int32, Int64, UInt16, UInt32, UInt64, Float16, Float32, Float64}
     if length(result) == 0
         return
     end
@@ -182,7 +201,7 @@ end
     end
 end
 
-@inline function read_array_data!(deser::BeveDeserializer, result::Vector{T}) where T <: Union{Int16, Int32, Int64, UInt16, UInt32, UInt64, Float32, Float64}
+@inline function read_array_data!(deser::BeveDeserializer, result::Vector{T}) where T <: Union{Int16, Int32, Int64, UInt16, UInt32, UInt64, Float16, Float32, Float64}
     if length(result) == 0
         return
     end
@@ -199,11 +218,20 @@ end
     end
 end
 
+# HEADER_PARSERS flattened into a 256-entry vector indexed by `header + 1`, so dispatch is an
+# array load rather than a hash lookup
+const HEADER_TABLE = let table = Vector{Union{Nothing, Function}}(nothing, 256)
+    for (header, parser) in HEADER_PARSERS
+        table[Int(header) + 1] = parser
+    end
+    table
+end
+
 # Optimized parse_value using lookup table
 function parse_value(deser::BeveDeserializer)
     header = read_byte!(deser)
     
-    parser = get(HEADER_PARSERS, header, nothing)
+    parser = @inbounds HEADER_TABLE[Int(header) + 1]
     if parser !== nothing
         return parser(deser)
     else
@@ -211,6 +239,25 @@ function parse_value(deser::BeveDeserializer)
     end
 end
 
+# Planar complex array data (see `to_beve(...; planar_complex = true)`): `size` real parts, then
+# `size` imaginary parts, read into the working buffer and interleaved into the result
+function read_planar_complex(deser::BeveDeserializer, ::Type{T}, size::Int) where T <: Union{Float32, Float64}
+    result = Vector{Complex{T}}(undef, size)
+    size == 0 && return result
+    buffer_size = 2 * size * sizeof(T)
+    if buffer_size > length(deser.read_buffer)
+        resize!(deser.read_buffer, buffer_size)
+    end
+    GC.@preserve deser begin
+        buffer_ptr = reinterpret(Ptr{T}, pointer(deser.read_buffer))
+        unsafe_read(deser.io, buffer_ptr, buffer_size)
+        @inbounds @simd for i in 1:size
+            result[i] = Complex{T}(ltoh(unsafe_load(buffer_ptr, i)), ltoh(unsafe_load(buffer_ptr, size + i)))
+        end
+    end
+    return result
+end
+
 function parse_complex(deser::BeveDeserializer)
     # Read the complex header byte
     complex_header = read_byte!(deser)
@@ -236,6 +283,13 @@ function parse_complex(deser::BeveDeserializer)
     if byte_count != 4 && byte_count != 8
         throw(BeveError("Unsupported complex float size: $byte_count bytes at byte $(deser.pos)"))
     end
+
+    # Bit 1 marks a planar array: every real part, then every imaginary part
+    if complex_header & COMPLEX_PLANAR != 0
+        is_array != 0 || throw(BeveError("Planar layout on a single complex number at byte $(deser.pos)"))
+        size = read_size(deser)
+        return byte_count == 4 ? read_planar_complex(deser, Float32, size) : read_planar_complex(deser, Float64, size)
+    end
     
     if is_array != 0
         # Handle complex arrays
@@ -327,7 +381,7 @@ function parse_type_tag(deser::BeveDeserializer)
 end
 
 const NUMERIC_MATRIX_HEADERS = UInt8[
-    F32_ARRAY, F64_ARRAY,
+    F16_ARRAY, F32_ARRAY, F64_ARRAY,
     I8_ARRAY, I16_ARRAY, I32_ARRAY, I64_ARRAY,
     U8_ARRAY, U16_ARRAY, U32_ARRAY, U64_ARRAY
 ]
@@ -421,7 +475,9 @@ function parse_numeric_matrix(deser::BeveDeserializer, layout::MatrixLayout, row
 end
 
 function matrix_element_type(header::UInt8)
-    if header == F32_ARRAY
+    if header == F16_ARRAY
+        return Float16
+    elseif header == F32_ARRAY
         return Float32
     elseif header == F64_ARRAY
         return Float64
@@ -468,6 +524,12 @@ function parse_matrix_value(deser::BeveDeserializer, header::UInt8)
     elseif header == BOOL_ARRAY
         read_byte!(deser)
         return parse_bool_array(deser)
+    elseif header == BF16_ARRAY
+        read_byte!(deser)
+        return parse_bf16_array(deser)
+    elseif header == F16_ARRAY
+        read_byte!(deser)
+        return parse_f16_array(deser)
     elseif header == F32_ARRAY
         read_byte!(deser)
         return parse_f32_array(deser)
@@ -549,8 +611,34 @@ function parse_string_object(deser::BeveDeserializer)::Dict{String, Any}
     return result
 end
 
+# KEY_TABLE: the keys, then the value whose keyed objects refer to them
+function parse_key_table(deser::BeveDeserializer)
+    count = read_size(deser)
+    keys = Vector{String}(undef, count)
+    for i in 1:count
+        keys[i] = read_string_data(deser)
+    end
+    deser.keys = keys
+    return parse_value(deser)
+end
+
+# KEYED_OBJECT: a string-keyed object whose keys are indices into `deser.keys`; the key strings
+# are shared with the table rather than copied per object
+function parse_keyed_object(deser::BeveDeserializer)::Dict{String, Any}
+    size = read_size(deser)
+    keys = deser.keys
+    result = Dict{String, Any}()
+    for _ in 1:size
+        i = read_size(deser)
+        i < length(keys) || throw(BeveError("Key index $i outside the key table of $(length(keys)) keys at byte $(deser.pos)"))
+        result[@inbounds keys[i + 1]] = parse_value(deser)
+    end
+    return result
+end
+
 function parse_integer_object(deser::BeveDeserializer, ::Type{T}) where T <: Integer
     size = read_size(deser)
+    deser.sorted_int_keys && return parse_sorted_integer_object(deser, T, size)
     result = Dict{T, Any}()
     
     for _ in 1:size
@@ -567,6 +655,59 @@ function parse_integer_object(deser::BeveDeserializer, ::Type{T}) where T <: Int
     return result
 end
 
+# Value types a sorted integer object stores unboxed, by header; anything else is boxed
+function unboxed_value_type(header::UInt8)
+    header == F64 && return Float64
+    header == F32 && return Float32
+    header == I64 && return Int64
+    header == I32 && return Int32
+    header == I16 && return Int16
+    header == I8 && return Int8
+    header == U64 && return UInt64
+    header == U32 && return UInt32
+    header == U16 && return UInt16
+    header == U8 && return UInt8
+    return Any
+end
+
+# Keys go into one vector and values into another, with no hash table. When every value has the
+# first value's numeric header the values are read straight into a typed vector, and keys that
+# arrive in order (as glaze writes a std::map) are not sorted again.
+function parse_sorted_integer_object(deser::BeveDeserializer, ::Type{T}, size::Int) where T <: Integer
+    # Every entry takes at least its key and a one-byte value, which bounds a hostile count
+    if deser.io isa IOBuffer && size > bytesavailable(deser.io) ÷ (sizeof(T) + 1)
+        throw(BeveError("Integer object of $size entries overruns the data at byte $(deser.pos)"))
+    end
+    keys = Vector{T}(undef, size)
+    size == 0 && return BeveSortedDict{T, Any}(keys, Any[], Val(:sorted))
+    keys[1] = ltoh(read(deser.io, T))
+    header = peek_byte!(deser)
+    vals = read_sorted_values!(deser, keys, Vector{unboxed_value_type(header)}(undef, size), header)
+    sorted_keys, sorted_vals = sort_by_key(keys, vals)
+    return BeveSortedDict{T, eltype(sorted_vals)}(sorted_keys, sorted_vals, Val(:sorted))
+end
+
+# Reads entries `first` onwards; the first key was read by the caller. A value whose header
+# differs from `header` moves the values read so far into a Vector{Any} and continues there.
+function read_sorted_values!(deser::BeveDeserializer, keys::Vector{T}, vals::Vector{V}, header::UInt8,
+                             first::Int = 1) where {T, V}
+    for i in first:length(keys)
+        i > 1 && (keys[i] = ltoh(read(deser.io, T)))
+        if V === Any
+            vals[i] = parse_value(deser)
+        elseif peek_byte!(deser) == header
+            read_byte!(deser)
+            vals[i] = ltoh(read(deser.io, V))
+        else
+            boxed = Vector{Any}(undef, length(vals))
+            copyto!(boxed, 1, vals, 1, i - 1)
+            boxed[i] = parse_value(deser)
+            return read_sorted_values!(deser, keys, boxed, header, i + 1)
+        end
+    end
+    return vals
+end
+
 function parse_bool_array(deser::BeveDeserializer)::Vector{Bool}
     size = read_size(deser)
     byte_count = (size + 7) ÷ 8
@@ -594,6 +735,99 @@ function parse_string_array(deser::BeveDeserializer)::Vector{String}
     return result
 end
 
+function parse_f16_array(deser::BeveDeserializer)::Vector{Float16}
+    size = read_size(deser)
+    result = Vector{Float16}(undef, size)
+    read_array_data!(deser, result)
+    return result
+end
+
+# bfloat16 has no Julia type, so BF16 arrays widen to Float32, block by block through the
+# read buffer
+function parse_bf16_array(deser::BeveDeserializer)::Vector{Float32}
+    size = read_size(deser)
+    result = Vector{Float32}(undef, size)
+    buffer = deser.read_buffer
+    block = length(buffer) ÷ 2
+    GC.@preserve buffer begin
+        raw = reinterpret(Ptr{UInt16}, pointer(buffer))
+        for start in 1:block:size
+            n = min(block, size - start + 1)
+            unsafe_read(deser.io, raw, 2 * n)
+            @inbounds @simd for i in 1:n
+                result[start + i - 1] = bf16_to_float32(ltoh(unsafe_load(raw, i)))
+            end
+        end
+    end
+    return result
+end
+
+# PACKED_ARRAY: codec, element header, count and payload length, then blocks that each start
+# from a raw value (see `write_packed_array` in Ser.jl). The payload is read whole and padded
+# so every residual can be taken from one or two unaligned 64-bit loads.
+function parse_packed_array(deser::BeveDeserializer)
+    codec = read_byte!(deser)
+    element_header = read_byte!(deser)
+    T = matrix_element_type(element_header)
+    if T === nothing || codec > PACK_DELTA
+        throw(BeveError("Unsupported packed array of $(header_name(element_header)) with codec $codec at byte $(deser.pos)"))
+    end
+    count = read_size(deser)
+    nbytes = read_size(deser)
+    # Every block takes at least 1 + sizeof(T) bytes, which bounds `count` before allocating
+    if cld(count, PACK_BLOCK) > nbytes ÷ (1 + sizeof(T))
+        throw(BeveError("Packed array of $count values cannot fit in $nbytes bytes at byte $(deser.pos)"))
+    end
+    if deser.io isa IOBuffer && !has_bytes(deser.io, nbytes)
+        throw(BeveError("Truncated packed array: $nbytes payload bytes declared at byte $(deser.pos)"))
+    end
+    payload = Vector{UInt8}(undef, nbytes + 16)
+    read!(deser.io, view(payload, 1:nbytes))
+    fill!(view(payload, (nbytes + 1):(nbytes + 16)), 0x00)
+    result = Vector{T}(undef, count)
+    unpack_array!(result, payload, nbytes, codec, deser.pos)
+    return result
+end
+
+@inline unzigzag(z::U) where U <: Unsigned = (z >> 1) ⊻ (zero(U) - (z & one(U)))
+
+function unpack_array!(result::Vector{T}, payload::Vector{UInt8}, nbytes::Int, codec::UInt8, at::UInt64) where T
+    U = packed_uint(T)
+    n = length(result)
+    pos = 0  # bytes of the payload consumed
+    GC.@preserve result payload begin
+        out = Ptr{U}(pointer(result))
+        p = pointer(payload)
+        for first in 1:PACK_BLOCK:n
+            last = min(first + PACK_BLOCK - 1, n)
+            pos + 1 + sizeof(T) <= nbytes || throw(BeveError("Truncated packed array at byte $at"))
+            width = Int(unsafe_load(p + pos))
+            width <= 8 * sizeof(T) || throw(BeveError("Invalid packed block width $width at byte $at"))
+            previous = ltoh(unsafe_load(Ptr{U}(p + pos + 1)))
+            pos += 1 + sizeof(T)
+            used = cld((last - first) * width, 8)
+            pos + used <= nbytes || throw(BeveError("Truncated packed array at byte $at"))
+            unsafe_store!(out, previous, first)
+            mask = (UInt64(1) << width) - UInt64(1)  # all ones for width 64
+            block = p + pos
+            @inbounds for i in 1:(last - first)
+                bit = (i - 1) * width
+                shift = bit & 7
+                residual = ltoh(unsafe_load(Ptr{UInt64}(block + (bit >> 3)))) >> shift
+                if shift + width > 64
+                    residual |= ltoh(unsafe_load(Ptr{UInt64}(block + (bit >> 3) + 8))) << (64 - shift)
+                end
+                r = (residual & mask) % U
+                previous = codec == PACK_XOR ? previous ⊻ r : previous + unzigzag(r)
+                unsafe_store!(out, previous, first + i)
+            end
+            pos += used
+        end
+    end
+    pos == nbytes || throw(BeveError("Packed array payload has $(nbytes - pos) unused bytes at byte $at"))
+    return result
+end
+
 function parse_f32_array(deser::BeveDeserializer)::Vector{Float32}
     size = read_size(deser)
     result = Vector{Float32}(undef, size)
@@ -676,10 +910,13 @@ function parse_generic_array(deser::BeveDeserializer)::Vector{Any}
 end
 
 """
-    from_beve(data::Vector{UInt8}; preserve_matrices::Bool = false) -> Any
+    from_beve(data::Vector{UInt8}; preserve_matrices::Bool = false, sorted_int_keys::Bool = false) -> Any
 
 Deserializes BEVE binary data back to Julia objects.
 
+With `sorted_int_keys = true`, integer-keyed objects decode into a [`BeveSortedDict`](@ref)
+(sorted key and value vectors, numeric values unboxed) instead of a `Dict{K, Any}`.
+
 ## Examples
 
 ```julia
@@ -688,23 +925,25 @@ julia> data = UInt8[0x03, 0x08, ...]  # Some BEVE binary data
 julia> result = from_beve(data)
 
 julia> raw = from_beve(data; preserve_matrices = true)
+
+julia> table = from_beve(data; sorted_int_keys = true)
 ```
 """
-function from_beve(data::Vector{UInt8}; preserve_matrices::Bool = false)
+function from_beve(data::Vector{UInt8}; preserve_matrices::Bool = false, sorted_int_keys::Bool = false)
     io = IOBuffer(data)
-    deser = BeveDeserializer(io; preserve_matrices = preserve_matrices)
+    deser = BeveDeserializer(io; preserve_matrices = preserve_matrices, sorted_int_keys = sorted_int_keys)
     return parse_value(deser)
 end
 
 """
-    read_beve_file(path::AbstractString; preserve_matrices::Bool = false) -> Any
+    read_beve_file(path::AbstractString; preserve_matrices::Bool = false, sorted_int_keys::Bool = false) -> Any
 
 Load a BEVE-encoded file from `path` by first reading it into a contiguous
 `Vector{UInt8}` buffer and then deserializing it with `from_beve`.
 """
-function read_beve_file(path::AbstractString; preserve_matrices::Bool = false)
+function read_beve_file(path::AbstractString; preserve_matrices::Bool = false, sorted_int_keys::Bool = false)
     data = read(path)
-    return from_beve(data; preserve_matrices = preserve_matrices)
+    return from_beve(data; preserve_matrices = preserve_matrices, sorted_int_keys = sorted_int_keys)
 end
 
 """
@@ -755,11 +994,17 @@ function deser_beve(::Type{T}, data::Vector{UInt8};
                     error_on_missing_fields::Bool = false,
                     preserve_matrices::Bool = false) where T
     parsed = from_beve(data; preserve_matrices = preserve_matrices)
-    ctx = ReconstructionContext(; error_on_missing = error_on_missing_fields)
+    return reconstruct_parsed(T, parsed, ReconstructionContext(; error_on_missing = error_on_missing_fields))
+end
 
+# Converts the generic result of `parse_value` into a `T`
+function reconstruct_parsed(::Type{T}, parsed, ctx::ReconstructionContext) where T
     # If T is a Dict type and parsed is also a Dict, just convert
     if T <: Dict && parsed isa Dict
         return convert(T, parsed)
+    elseif T <: AbstractVector && parsed isa Dict{String, Any} && is_record_type(eltype(T))
+        # A columnar batch written by `to_beve_columnar` or `beve::write_columnar`
+        return reconstruct_columns(T, parsed, ctx)
     elseif parsed isa Dict{String, Any}
         # Try to reconstruct the struct from the string dictionary
         return reconstruct_struct(T, parsed, ctx)
@@ -807,6 +1052,8 @@ function coerce_value(field_type::Type, value, ctx::ReconstructionContext = Reco
         return reconstruct_matrix(field_type, value, ctx)
     elseif field_type <: AbstractVector && value isa AbstractVector
         return reconstruct_vector(field_type, value, ctx)
+    elseif field_type <: AbstractVector && value isa Dict{String, Any} && is_record_type(eltype(field_type))
+        return reconstruct_columns(field_type, value, ctx)
     elseif field_type <: Tuple
         return reconstruct_tuple(field_type, value, ctx)
     elseif Base.isstructtype(field_type) && value isa Dict{String, Any}
@@ -859,6 +1106,10 @@ function reconstruct_vector(field_type::Type, data::AbstractVector, ctx::Reconst
     end
 
     element_type = eltype(field_type)
+    if element_type <: AbstractFloat && isconcretetype(element_type) && data isa Vector{<:AbstractFloat}
+        # e.g. an F16 array read into a Vector{Float32} field: one vectorized conversion
+        return Vector{element_type}(data)
+    end
     if element_type === Any
         if isconcretetype(field_type)
             try
@@ -928,6 +1179,66 @@ function reconstruct_tuple(field_type::Type, value, ctx::ReconstructionContext =
     end
 end
 
+# Structs that a columnar batch can be rebuilt into: concrete, with fields, and not a
+# number, string, collection or tuple that has a BEVE encoding of its own
+function is_record_type(T::Type)
+    return isconcretetype(T) && isstructtype(T) && fieldcount(T) > 0 &&
+           !(T <: Number) && !(T <: AbstractString) && !(T <: AbstractArray) &&
+           !(T <: AbstractDict) && !(T <: Tuple)
+end
+
+# Columnar batches: an object holding one equal-length array per field of the record type
+function reconstruct_columns(::Type{V}, data::Dict{String, Any}, ctx::ReconstructionContext = ReconstructionContext()) where V <: AbstractVector
+    T = eltype(V)
+    field_names = fieldnames(T)
+    field_types = fieldtypes(T)
+    columns = Vector{Any}(undef, length(field_names))
+    present = falses(length(field_names))
+    rows = -1
+
+    for i in eachindex(field_names)
+        key = string(field_names[i])
+        if !haskey(data, key)
+            ctx.error_on_missing && throw(BeveError("Missing column '$key' for type $T"))
+            continue
+        end
+        column = data[key]
+        column isa AbstractVector || throw(BeveError("Column '$key' for type $T is not an array"))
+        if rows < 0
+            rows = length(column)
+        elseif length(column) != rows
+            throw(BeveError("Column '$key' has $(length(column)) rows, expected $rows"))
+        end
+        columns[i] = reconstruct_vector(Vector{field_types[i]}, column, ctx)
+        present[i] = true
+    end
+
+    result = Vector{T}(undef, max(rows, 0))
+    if all(present)
+        assemble_rows!(result, Tuple(columns))
+    else
+        present_indices = findall(present)
+        for row in eachindex(result)
+            try
+                result[row] = T(; (field_names[i] => columns[i][row] for i in present_indices)...)
+            catch err
+                missing_list = join(string.(field_names[.!present]), ", ")
+                throw(BeveError("Missing column(s): $missing_list for type $T. No compatible keyword constructor found. Original error: $(err)"))
+            end
+        end
+    end
+    return result isa V ? result : convert(V, result)
+end
+
+# Function barrier: with the column types known, each row is a direct constructor call
+function assemble_rows!(result::Vector{T}, columns::Tuple) where T
+    @inbounds for row in eachindex(result)
+        values = map(column -> column[row], columns)
+        result[row] = T <: NamedTuple ? T(values) : T(values...)
+    end
+    return result
+end
+
 # Optimized struct reconstruction with pre-allocated arrays
 function reconstruct_struct(::Type{T}, data::Dict{String, Any}, ctx::ReconstructionContext = ReconstructionContext()) where T
     field_names = fieldnames(T)
@@ -70,6 +70,15 @@ const DELIMITER = 0x06
 const TAG = 0x0e
 const MATRIX = 0x16
 const COMPLEX = 0x1e
+const COMPLEX_PLANAR = 0x02  # component byte bit 1: every real part, then every imaginary part
+const PACKED_ARRAY = 0x26  # delta/XOR block-packed numeric array (see `write_packed_array` in Ser.jl)
+const KEY_TABLE = 0x2e     # object keys written once: count, keys, then the value they cover
+const KEYED_OBJECT = 0x36  # object whose keys are indices into the preceding KEY_TABLE
+
+# Packed array codecs and block length, shared with beve_validation/beve_packed.hpp
+const PACK_XOR = 0x00    # each value's bits XORed with the previous value's (floats)
+const PACK_DELTA = 0x01  # zigzagged wrapping difference from the previous value (integers)
+const PACK_BLOCK = 128
 
 const RESERVED = 0x07
 
@@ -137,6 +146,12 @@ function header_name(header::UInt8)
         return "matrix"
     elseif header == COMPLEX
         return "complex number"
+    elseif header == PACKED_ARRAY
+        return "packed numeric array"
+    elseif header == KEY_TABLE
+        return "key table"
+    elseif header == KEYED_OBJECT
+        return "keyed object"
     elseif header == RESERVED
         return "reserved"
     else
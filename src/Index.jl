@@ -0,0 +1,329 @@
+# Sidecar indexes for random access into large typed arrays
+#
+# BEVE typed arrays are fixed stride, so an element range can be read straight from the file
+# once the byte offset of the array payload is known. `write_beve_index` walks a file (headers
+# and sizes only; payloads are skipped with `seek`) and stores the offsets of its large typed
+# arrays, complex arrays and matrices in `<file>.index`, itself a BEVE object. The layout is
+# shared with `beve_validation/beve_index.hpp`, so either language can index a file and
+# either can slice it.
+
+"""
+    BeveIndexEntry
+
+Location of one typed array, complex array or matrix payload inside a BEVE file.
+`pointer` is the JSON pointer of the value (e.g. `"/large_float_vec"`; generic array
+elements use 0-based indices), `offset` the 0-based byte offset of its first element and
+`count` its element count. `extents` and `column_major` are only meaningful for matrices.
+"""
+struct BeveIndexEntry
+    pointer::String
+    offset::UInt64
+    count::UInt64
+    header::UInt8
+    complex_header::UInt8
+    element_size::UInt64
+    extents::Vector{Int64}
+    column_major::Bool
+end
+
+"""
+    BeveIndex
+
+Contents of a `.index` sidecar: a format `version`, the `file_size` of the indexed file
+(used to detect a stale index) and one [`BeveIndexEntry`](@ref) per indexed value.
+"""
+struct BeveIndex
+    version::UInt32
+    file_size::UInt64
+    entries::Vector{BeveIndexEntry}
+end
+
+const BEVE_INDEX_VERSION = UInt32(1)
+const DEFAULT_INDEX_MIN_BYTES = 1 << 20
+
+beve_index_path(path::AbstractString) = string(path, ".index")
+
+# bf16 takes the otherwise unused one-byte float slot
+@inline index_byte_count(header::UInt8) =
+    header == BF16 || header == BF16_ARRAY ? 2 : 1 << ((header >> 5) & 0x07)
+
+function index_read_size(io::IO)::Int
+    first = read(io, UInt8)
+    n_bytes = 1 << (first & 0x03)
+    val = UInt64(first)
+    for i in 1:(n_bytes - 1)
+        val |= UInt64(read(io, UInt8)) << (8 * i)
+    end
+    return Int(val >> 2)
+end
+
+# RFC 6901 escaping of one reference token
+escape_pointer_token(key::AbstractString) = replace(key, "~" => "~0", "/" => "~1")
+
+function index_record!(entries, io::IO, pointer::String, count::Int, header::UInt8,
+                       complex_header::UInt8, element_size::Int, min_bytes::Integer;
+                       extents::Vector{Int64} = Int64[], column_major::Bool = false)
+    if count * element_size >= min_bytes
+        push!(entries, BeveIndexEntry(pointer, UInt64(position(io)), UInt64(count), header,
+                                      complex_header, UInt64(element_size), extents, column_major))
+    end
+    Base.skip(io, count * element_size)
+    return nothing
+end
+
+# `keys` is the key table in effect for keyed objects (see `to_beve(...; dict_keys = true)`)
+function index_value!(entries, io::IO, pointer::String, min_bytes::Integer, depth::Int;
+                      keys::Vector{String} = String[])
+    depth > 512 && throw(BeveError("Maximum nesting depth exceeded at byte $(position(io))"))
+    header = read(io, UInt8)
+    kind = header & 0x07
+    if kind == 0x00                                     # null and booleans
+        return nothing
+    elseif kind == 0x01                                 # numbers
+        Base.skip(io, index_byte_count(header))
+    elseif kind == 0x02                                 # strings
+        Base.skip(io, index_read_size(io))
+    elseif kind == 0x03                                 # objects
+        count = index_read_size(io)
+        for _ in 1:count
+            key = if header == STRING_OBJECT
+                String(read(io, index_read_size(io)))
+            else
+                width = index_byte_count(header)
+                raw = UInt64(0)
+                for i in 0:(width - 1)
+                    raw |= UInt64(read(io, UInt8)) << (8 * i)
+                end
+                if (header >> 3) & 0x03 == 0x01 && width < 8 && (raw >> (8 * width - 1)) != 0
+                    raw |= typemax(UInt64) << (8 * width)   # sign extend
+                    string(reinterpret(Int64, raw))
+                else
+                    (header >> 3) & 0x03 == 0x01 ? string(reinterpret(Int64, raw)) : string(raw)
+                end
+            end
+            index_value!(entries, io, string(pointer, "/", escape_pointer_token(key)), min_bytes, depth + 1; keys)
+        end
+    elseif kind == 0x04                                 # typed arrays
+        count = index_read_size(io)
+        if header == BOOL_ARRAY
+            Base.skip(io, cld(count, 8))
+        elseif header == STRING_ARRAY
+            for _ in 1:count
+                Base.skip(io, index_read_size(io))
+            end
+        else
+            index_record!(entries, io, pointer, count, header, 0x00, index_byte_count(header), min_bytes)
+        end
+    elseif kind == 0x05                                 # generic arrays
+        count = index_read_size(io)
+        for i in 0:(count - 1)
+            index_value!(entries, io, string(pointer, "/", i), min_bytes, depth + 1; keys)
+        end
+    elseif header == TAG
+        index_read_size(io)
+        index_value!(entries, io, pointer, min_bytes, depth + 1; keys)
+    elseif header == KEY_TABLE
+        table = [String(read(io, index_read_size(io))) for _ in 1:index_read_size(io)]
+        index_value!(entries, io, pointer, min_bytes, depth + 1; keys = table)
+    elseif header == KEYED_OBJECT
+        count = index_read_size(io)
+        for _ in 1:count
+            i = index_read_size(io)
+            i < length(keys) || throw(BeveError("Key index $i outside the key table at byte $(position(io))"))
+            index_value!(entries, io, string(pointer, "/", escape_pointer_token(keys[i + 1])), min_bytes, depth + 1; keys)
+        end
+    elseif header == COMPLEX
+        complex_header = read(io, UInt8)
+        width = 2 * index_byte_count(complex_header)
+        if complex_header & 0x07 == 0x00
+            Base.skip(io, width)
+        else
+            index_record!(entries, io, pointer, index_read_size(io), header, complex_header, width, min_bytes)
+        end
+    elseif header == PACKED_ARRAY
+        # Variable-width blocks cannot be sliced by offset; skip the payload by its length
+        Base.skip(io, 2)
+        index_read_size(io)
+        Base.skip(io, index_read_size(io))
+    elseif header == MATRIX
+        column_major = read(io, UInt8) & 0x01 == 0x01
+        extents_header = read(io, UInt8)
+        (extents_header & 0x07 == 0x04 && (extents_header >> 3) & 0x03 in (0x01, 0x02)) ||
+            throw(BeveError("Matrix extents must be a typed integer array at byte $(position(io))"))
+        n_extents = index_read_size(io)
+        extent_width = index_byte_count(extents_header)
+        extents = Vector{Int64}(undef, n_extents)
+        for i in 1:n_extents
+            raw = UInt64(0)
+            for j in 0:(extent_width - 1)
+                raw |= UInt64(read(io, UInt8)) << (8 * j)
+            end
+            extents[i] = reinterpret(Int64, raw)
+        end
+        value_header = read(io, UInt8)
+        if value_header == COMPLEX
+            complex_header = read(io, UInt8)
+            index_record!(entries, io, pointer, index_read_size(io), value_header, complex_header,
+                          2 * index_byte_count(complex_header), min_bytes;
+                          extents = extents, column_major = column_major)
+        elseif value_header & 0x07 == 0x04 && (value_header >> 3) & 0x03 != 0x03
+            index_record!(entries, io, pointer, index_read_size(io), value_header, 0x00,
+                          index_byte_count(value_header), min_bytes;
+                          extents = extents, column_major = column_major)
+        else
+            throw(BeveError("Matrix value must be a numeric typed array at byte $(position(io))"))
+        end
+    else
+        throw(BeveError("Unsupported header: $(header_name(header)) (0x$(string(header, base=16))) at byte $(position(io) - 1)"))
+    end
+    return nothing
+end
+
+"""
+    build_beve_index(io::IO, file_size::Integer; min_bytes::Integer = 1 << 20) -> BeveIndex
+
+Walk the BEVE value that spans `io` and record every numeric typed array, complex array and
+matrix whose payload is at least `min_bytes` long. Payloads are skipped, not read.
+"""
+function build_beve_index(io::IO, file_size::Integer; min_bytes::Integer = DEFAULT_INDEX_MIN_BYTES)::BeveIndex
+    entries = BeveIndexEntry[]
+    try
+        index_value!(entries, io, "", min_bytes, 0)
+    catch err
+        err isa EOFError || rethrow()
+        throw(BeveError("Unexpected end of data while indexing"))
+    end
+    position(io) == file_size ||
+        throw(BeveError("Indexed value ends at byte $(position(io)) of a $(file_size) byte file"))
+    return BeveIndex(BEVE_INDEX_VERSION, UInt64(file_size), entries)
+end
+
+"""
+    write_beve_index(path::AbstractString; min_bytes::Integer = 1 << 20) -> BeveIndex
+
+Index the BEVE file at `path` and write the result to `path * ".index"`. Only arrays and
+matrices with at least `min_bytes` of payload are recorded.
+
+## Examples
+
+```julia
+julia> write_beve_file("capture.beve", data; index = true)   # or, for an existing file:
+
+julia> write_beve_index("capture.beve")
+```
+"""
+function write_beve_index(path::AbstractString; min_bytes::Integer = DEFAULT_INDEX_MIN_BYTES)::BeveIndex
+    index = open(path, "r") do io
+        build_beve_index(io, filesize(path); min_bytes = min_bytes)
+    end
+    write(beve_index_path(path), to_beve(index))
+    return index
+end
+
+"""
+    read_beve_index(path::AbstractString) -> BeveIndex
+
+Load the sidecar index of the BEVE file at `path`. Throws a `BeveError` when the index is
+missing or was built for a file of a different size.
+"""
+function read_beve_index(path::AbstractString)::BeveIndex
+    index_file = beve_index_path(path)
+    isfile(index_file) || throw(BeveError("No index at $index_file; create one with write_beve_index"))
+    raw = from_beve(read(index_file))
+    entries = BeveIndexEntry[BeveIndexEntry(String(e["pointer"]), UInt64(e["offset"]), UInt64(e["count"]),
+                                            UInt8(e["header"]), UInt8(e["complex_header"]),
+                                            UInt64(e["element_size"]), Vector{Int64}(e["extents"]),
+                                            Bool(e["column_major"]))
+                             for e in raw["entries"]]
+    index = BeveIndex(UInt32(raw["version"]), UInt64(raw["file_size"]), entries)
+    index.file_size == filesize(path) ||
+        throw(BeveError("Index for $path is stale: the file changed size since it was indexed"))
+    return index
+end
+
+# bfloat16 has no Julia type, so BF16 entries are read as their raw UInt16 bits and widened to
+# Float32 afterwards, as parse_bf16_array does
+function index_element_type(entry::BeveIndexEntry)::Type
+    header = entry.header
+    if header == COMPLEX
+        component = (entry.complex_header & ~0x07) | 0x04
+        component == F32_ARRAY && return ComplexF32
+        component == F64_ARRAY && return ComplexF64
+    else
+        header == BF16_ARRAY && return UInt16
+        header == F16_ARRAY && return Float16
+        header == F32_ARRAY && return Float32
+        header == F64_ARRAY && return Float64
+        header == I8_ARRAY && return Int8
+        header == I16_ARRAY && return Int16
+        header == I32_ARRAY && return Int32
+        header == I64_ARRAY && return Int64
+        header == U8_ARRAY && return UInt8
+        header == U16_ARRAY && return UInt16
+        header == U32_ARRAY && return UInt32
+        header == U64_ARRAY && return UInt64
+    end
+    throw(BeveError("Unsupported indexed element type at $(entry.pointer): $(header_name(header))"))
+end
+
+"""
+    read_beve_slice(path::AbstractString, pointer::AbstractString, range::AbstractUnitRange{<:Integer};
+                    index::BeveIndex = read_beve_index(path)) -> Vector
+
+Read elements `range` (1-based) of the typed array at JSON pointer `pointer` with a single
+positioned read, using the sidecar index written by [`write_beve_index`](@ref). Matrices
+are sliced in their storage order, and bf16 arrays are widened to `Float32`; planar complex
+arrays take one read from each half. Pass a previously loaded `index` to avoid re-reading
+the sidecar on every call.
+
+## Examples
+
+```julia
+julia> write_beve_index("large_arrays.beve")
+
+julia> read_beve_slice("large_arrays.beve", "/large_float_vec", 500_001:600_000)
+```
+"""
+function read_beve_slice(path::AbstractString, pointer::AbstractString, range::AbstractUnitRange{<:Integer};
+                         index::BeveIndex = read_beve_index(path))
+    i = findfirst(e -> e.pointer == pointer, index.entries)
+    i === nothing && throw(BeveError("No indexed array at $pointer in $path"))
+    entry = index.entries[i]
+    T = index_element_type(entry)
+    if !isempty(range) && (first(range) < 1 || last(range) > entry.count)
+        throw(BeveError("Range $range exceeds the $(entry.count) elements at $pointer"))
+    end
+    result = Vector{T}(undef, length(range))
+    isempty(result) && return result
+    if entry.header == COMPLEX && entry.complex_header & COMPLEX_PLANAR != 0
+        return read_planar_slice!(result, path, entry, first(range))
+    end
+    open(path, "r") do io
+        seek(io, entry.offset + (first(range) - 1) * entry.element_size)
+        read!(io, result)
+    end
+    if ENDIAN_BOM != 0x04030201
+        result .= ltoh.(result)
+    end
+    entry.header == BF16_ARRAY && return bf16_to_float32.(result)
+    return result
+end
+
+# A planar complex array stores every real part, then every imaginary part: one positioned
+# read from each half, interleaved into `result`
+function read_planar_slice!(result::Vector{Complex{T}}, path::AbstractString, entry::BeveIndexEntry,
+                            first::Integer) where T
+    n = length(result)
+    re = Vector{T}(undef, n)
+    im = Vector{T}(undef, n)
+    open(path, "r") do io
+        seek(io, entry.offset + (first - 1) * sizeof(T))
+        read!(io, re)
+        seek(io, entry.offset + entry.count * sizeof(T) + (first - 1) * sizeof(T))
+        read!(io, im)
+    end
+    @inbounds @simd for i in 1:n
+        result[i] = Complex{T}(ltoh(re[i]), ltoh(im[i]))
+    end
+    return result
+end
@@ -0,0 +1,144 @@
+# In-place updates of encoded BEVE buffers
+#
+# `patch_beve!` replaces the value a JSON pointer selects (see `resolve_beve_pointer`) inside an
+# encoded buffer without decoding or re-serializing anything else. A value with the same encoded
+# size (numbers, booleans, equal-length strings) is copied over the old bytes; any other size is
+# one `splice!`. A missing last key of an object is appended to it, and `-` appends to a generic
+# array; only then is a count rewritten (the parent's), since BEVE containers store element
+# counts rather than byte lengths. The rules match `beve::patch_value` in
+# `beve_validation/beve_patch.hpp`.
+
+"""
+    BeveBuffer(data::Vector{UInt8})
+
+An encoded BEVE value kept as bytes. Registered with the HTTP server, a `BeveBuffer` is served
+by slicing the bytes a pointer selects and updated with [`patch_beve_encoded!`](@ref), so
+neither a GET nor a POST to one field re-serializes the whole value.
+"""
+struct BeveBuffer
+    data::Vector{UInt8}
+end
+
+# Overwrites or splices `range` of `data` with `bytes`
+function patch_beve_range!(data::Vector{UInt8}, range::UnitRange{Int}, bytes::AbstractVector{UInt8})
+    if length(range) == length(bytes)
+        copyto!(data, first(range), bytes, firstindex(bytes), length(bytes))
+    else
+        splice!(data, range, bytes)
+    end
+    return data
+end
+
+# Element `i` of the typed array at `container`, resolved to `target`, takes `encoded` when it
+# has the element's own type; boolean elements are single bits
+function patch_beve_element!(data::Vector{UInt8}, container::Int, i::Int, target::BevePointerTarget,
+                             encoded::AbstractVector{UInt8}, pointer::AbstractString)
+    header = encoded[firstindex(encoded)]
+    if data[container] == BOOL_ARRAY
+        (length(encoded) == 1 && (header == TRUE || header == FALSE)) ||
+            throw(BeveError("The value does not match the array element type at $pointer"))
+        byte = first(target.range) + i ÷ 8
+        mask = 0x01 << (i % 8)
+        data[byte] = header == TRUE ? data[byte] | mask : data[byte] & ~mask
+        return data
+    end
+    body = @view encoded[(firstindex(encoded) + 1):end]
+    (header == target.element_header && (header == STRING || length(body) == length(target.range))) ||
+        throw(BeveError("The value does not match the array element type at $pointer"))
+    return patch_beve_range!(data, target.range, body)
+end
+
+# The encoded key of a new member `token` for an object with `header`
+function patch_beve_key(header::UInt8, token::String, pointer::AbstractString)
+    if header == STRING_OBJECT
+        io = IOBuffer()
+        write_size(io, ncodeunits(token))
+        write(io, token)
+        return take!(io)
+    end
+    width = index_byte_count(header)
+    width <= 8 || throw(BeveError("128-bit object keys are not supported in JSON pointers"))
+    key = tryparse(Int128, token)
+    signed = (header >> 3) & 0x03 == 0x01
+    lo, hi = signed ? (-(Int128(1) << (8 * width - 1)), (Int128(1) << (8 * width - 1)) - 1) :
+                      (Int128(0), (Int128(1) << (8 * width)) - 1)
+    (key !== nothing && lo <= key <= hi) || throw(BeveError("Key '$token' does not fit the object's keys at $pointer"))
+    raw = key % UInt64
+    return [(raw >> (8 * k)) % UInt8 for k in 0:(width - 1)]
+end
+
+# Appends `key` and `encoded` at `at`, the end of the container whose header is at `container`,
+# and rewrites its count
+function append_beve_entry!(data::Vector{UInt8}, container::Int, at::Int, key::Vector{UInt8},
+                            encoded::AbstractVector{UInt8})
+    count, count_end = pointer_size(data, container + 1)
+    splice!(data, at:(at - 1), vcat(key, encoded))
+    io = IOBuffer()
+    write_size(io, count + 1)
+    patch_beve_range!(data, (container + 1):(count_end - 1), take!(io))
+    return data
+end
+
+"""
+    patch_beve_encoded!(data::Vector{UInt8}, pointer::AbstractString, encoded::AbstractVector{UInt8}) -> data
+
+Replace the value `pointer` selects in the BEVE bytes `data` with `encoded`, exactly one encoded
+BEVE value. Same-size values are overwritten in place, others are spliced in. If the last token
+names a missing key of an object the member is appended, and `-` appends to a generic array.
+Elements of typed arrays only take a value of their own element type. Throws a `BeveError`
+(leaving `data` untouched) when the pointer does not resolve.
+"""
+function patch_beve_encoded!(data::Vector{UInt8}, pointer::AbstractString, encoded::AbstractVector{UInt8})
+    (!isempty(encoded) && pointer_skip(encoded, firstindex(encoded)) == lastindex(encoded) + 1) ||
+        throw(BeveError("A patch must be exactly one BEVE value"))
+    rest = pointer == "/" ? "" : pointer
+    isempty(rest) && return patch_beve_range!(data, resolve_beve_pointer(data, "").range, encoded)
+    startswith(rest, "/") || throw(BeveError("JSON pointer must start with '/': $pointer"))
+
+    # Resolve the parent, then find (or make room for) the last token
+    slash = findlast('/', rest)
+    parent = resolve_beve_pointer(data, rest[1:prevind(rest, slash)])
+    parent.element_header == 0x00 || throw(BeveError("Cannot descend into a typed array element at $pointer"))
+    token = String(unescape_pointer_token(rest[nextind(rest, slash):end]))
+    container = first(parent.range)
+    while data[container] == TAG
+        _, container = pointer_size(data, container + 1)
+    end
+    header = data[container]
+    kind = header & 0x07
+    if kind == 0x04
+        i = pointer_index(token, pointer)
+        target = pointer_typed_element(data, container, i, pointer)
+        return patch_beve_element!(data, container, i, target, encoded, pointer)
+    elseif kind == 0x05
+        token == "-" && return append_beve_entry!(data, container, last(parent.range) + 1, UInt8[], encoded)
+        i = pointer_index(token, pointer)
+        count, pos = pointer_size(data, container + 1)
+        i < count || throw(BeveError("Array index $i out of bounds (length $count) at $pointer"))
+        for _ in 1:i
+            pos = pointer_skip(data, pos)
+        end
+    elseif kind == 0x03
+        pos, found = pointer_find_member(data, container, token)
+        found || return append_beve_entry!(data, container, pos, patch_beve_key(header, token, pointer), encoded)
+    else
+        throw(BeveError("Cannot resolve '$token' in a $(header_name(header)) value at $pointer"))
+    end
+    return patch_beve_range!(data, pos:(pointer_skip(data, pos) - 1), encoded)
+end
+
+"""
+    patch_beve!(data::Vector{UInt8}, pointer::AbstractString, value; float32_as = :f32) -> data
+
+Encode `value` with [`to_beve`](@ref) and patch it into `data` at `pointer` (see
+[`patch_beve_encoded!`](@ref)). Updating a counter in a large state buffer is an overwrite of
+its bytes:
+
+```julia
+state = to_beve(Dict("samples" => rand(10^7), "requests" => 0))
+patch_beve!(state, "/requests", 41)
+from_beve_at(state, "/requests")  # 41
+```
+"""
+patch_beve!(data::Vector{UInt8}, pointer::AbstractString, value; float32_as::Symbol = :f32) =
+    patch_beve_encoded!(data, pointer, to_beve(value; float32_as = float32_as))
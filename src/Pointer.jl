@@ -0,0 +1,290 @@
+# JSON pointers over encoded bytes
+#
+# `resolve_beve_pointer` finds the value an RFC 6901 pointer selects without decoding
+# anything else: at each level it reads object keys (or counts array elements) until it
+# reaches the next reference token and steps over every value it passes by its length
+# prefixes, so strings and typed array payloads are never read. `from_beve_at` and
+# `deser_beve_at` then decode only the target. The rules match `beve::resolve_pointer` in
+# `beve_validation/beve_pointer.hpp`: tokens select keys of string-keyed objects, keys of
+# integer-keyed objects (the token is parsed as an integer) and 0-based indices of generic and
+# typed arrays, and type tags are transparent.
+
+"""
+    BevePointerTarget
+
+The bytes `range` (1-based, into the buffer that was resolved) of the value a JSON pointer
+selects. Elements of typed arrays are not standalone values; for them `element_header` is the
+header their bytes lack (the scalar, string or boolean header), otherwise it is `0x00`.
+"""
+struct BevePointerTarget
+    range::UnitRange{Int}
+    element_header::UInt8
+end
+
+@inline function pointer_byte(data::AbstractVector{UInt8}, pos::Int)
+    pos <= length(data) || throw(BeveError("Unexpected end of BEVE data at byte $(pos - 1)"))
+    return @inbounds data[pos]
+end
+
+# Compressed size at `pos`; returns the size and the position after it
+@inline function pointer_size(data::AbstractVector{UInt8}, pos::Int)
+    first = pointer_byte(data, pos)
+    n_bytes = 1 << (first & 0x03)
+    pos + n_bytes - 1 <= length(data) || throw(BeveError("Unexpected end of BEVE data at byte $(pos - 1)"))
+    val = UInt64(first)
+    for i in 1:(n_bytes - 1)
+        val |= UInt64(@inbounds data[pos + i]) << (8 * i)
+    end
+    return Int(val >> 2), pos + n_bytes
+end
+
+@inline function pointer_advance(data::AbstractVector{UInt8}, pos::Int, n::Int)
+    (n >= 0 && n <= length(data) - pos + 1) ||
+        throw(BeveError("Length $n at byte $(pos - 1) runs past the end of the BEVE data"))
+    return pos + n
+end
+
+function pointer_string_end(data::AbstractVector{UInt8}, pos::Int)
+    n, pos = pointer_size(data, pos)
+    return pointer_advance(data, pos, n)
+end
+
+# Position one past the end of the value whose header is at `pos`
+function pointer_skip(data::AbstractVector{UInt8}, pos::Int, depth::Int = 0)
+    depth > 512 && throw(BeveError("Maximum nesting depth exceeded at byte $(pos - 1)"))
+    header = pointer_byte(data, pos)
+    kind = header & 0x07
+    pos += 1
+    if kind == 0x00                                     # null and booleans
+        return pos
+    elseif kind == 0x01                                 # numbers
+        return pointer_advance(data, pos, index_byte_count(header))
+    elseif kind == 0x02                                 # strings
+        return pointer_string_end(data, pos)
+    elseif kind == 0x03                                 # objects
+        count, pos = pointer_size(data, pos)
+        for _ in 1:count
+            pos = header == STRING_OBJECT ? pointer_string_end(data, pos) :
+                  pointer_advance(data, pos, index_byte_count(header))
+            pos = pointer_skip(data, pos, depth + 1)
+        end
+        return pos
+    elseif kind == 0x04                                 # typed arrays
+        count, pos = pointer_size(data, pos)
+        if header == BOOL_ARRAY
+            return pointer_advance(data, pos, cld(count, 8))
+        elseif header == STRING_ARRAY
+            for _ in 1:count
+                pos = pointer_string_end(data, pos)
+            end
+            return pos
+        end
+        width = index_byte_count(header)
+        count <= (length(data) - pos + 1) ÷ width ||
+            throw(BeveError("Typed array at byte $(pos - 1) runs past the end of the BEVE data"))
+        return pos + count * width
+    elseif kind == 0x05                                 # generic arrays
+        count, pos = pointer_size(data, pos)
+        for _ in 1:count
+            pos = pointer_skip(data, pos, depth + 1)
+        end
+        return pos
+    elseif header == TAG
+        _, pos = pointer_size(data, pos)
+        return pointer_skip(data, pos, depth + 1)
+    elseif header == COMPLEX
+        complex_header = pointer_byte(data, pos)
+        width = 2 * index_byte_count(complex_header)
+        complex_header & 0x07 == 0x00 && return pointer_advance(data, pos + 1, width)
+        count, pos = pointer_size(data, pos + 1)
+        count <= (length(data) - pos + 1) ÷ width ||
+            throw(BeveError("Complex array at byte $(pos - 1) runs past the end of the BEVE data"))
+        return pos + count * width
+    elseif header == PACKED_ARRAY
+        _, pos = pointer_size(data, pointer_advance(data, pos, 2))
+        return pointer_string_end(data, pos)
+    elseif header == KEY_TABLE
+        count, pos = pointer_size(data, pos)
+        for _ in 1:count
+            pos = pointer_string_end(data, pos)
+        end
+        return pointer_skip(data, pos, depth + 1)
+    elseif header == KEYED_OBJECT
+        count, pos = pointer_size(data, pos)
+        for _ in 1:count
+            _, pos = pointer_size(data, pos)                # key index
+            pos = pointer_skip(data, pos, depth + 1)
+        end
+        return pos
+    elseif header == MATRIX
+        pos = pointer_skip(data, pointer_advance(data, pos, 1), depth + 1)   # layout byte, extents
+        return pointer_skip(data, pos, depth + 1)
+    elseif header == DELIMITER
+        return pos
+    end
+    throw(BeveError("Unsupported header: $(header_name(header)) (0x$(string(header, base=16))) at byte $(pos - 2)"))
+end
+
+# RFC 6901 unescaping of one reference token
+unescape_pointer_token(token::AbstractString) = replace(token, "~1" => "/", "~0" => "~")
+
+# Compares the string key at data[pos:pos+n-1] with `token` without allocating
+function pointer_key_equals(data::AbstractVector{UInt8}, pos::Int, n::Int, token::String)
+    ncodeunits(token) == n || return false
+    for i in 1:n
+        @inbounds data[pos + i - 1] == codeunit(token, i) || return false
+    end
+    return true
+end
+
+function pointer_integer_key(data::AbstractVector{UInt8}, pos::Int, header::UInt8)
+    width = index_byte_count(header)
+    raw = UInt64(0)
+    for i in 0:(width - 1)
+        raw |= UInt64(@inbounds data[pos + i]) << (8 * i)
+    end
+    if (header >> 3) & 0x03 == 0x01
+        width < 8 && (raw >> (8 * width - 1)) != 0 && (raw |= typemax(UInt64) << (8 * width))
+        return Int128(reinterpret(Int64, raw))
+    end
+    return Int128(raw)
+end
+
+# Moves from an object header at `pos` to the value of the key `token`; returns that position and
+# `true`, or the end of the object and `false` when the key is missing
+function pointer_find_member(data::AbstractVector{UInt8}, pos::Int, token::String)
+    header = data[pos]
+    count, pos = pointer_size(data, pos + 1)
+    wanted = nothing
+    if header != STRING_OBJECT
+        index_byte_count(header) <= 8 || throw(BeveError("128-bit object keys are not supported in JSON pointers"))
+        wanted = tryparse(Int128, token)
+    end
+    for _ in 1:count
+        if header == STRING_OBJECT
+            n, pos = pointer_size(data, pos)
+            key_end = pointer_advance(data, pos, n)
+            found = pointer_key_equals(data, pos, n, token)
+            pos = key_end
+        else
+            key_end = pointer_advance(data, pos, index_byte_count(header))
+            found = wanted !== nothing && pointer_integer_key(data, pos, header) == wanted
+            pos = key_end
+        end
+        found && return pos, true
+        pos = pointer_skip(data, pos)
+    end
+    return pos, false
+end
+
+function pointer_member(data::AbstractVector{UInt8}, pos::Int, token::String, pointer::AbstractString)
+    pos, found = pointer_find_member(data, pos, token)
+    found || throw(BeveError("Key '$token' not found at $pointer"))
+    return pos
+end
+
+function pointer_index(token::String, pointer::AbstractString)
+    i = all(isdigit, token) ? tryparse(Int, token) : nothing
+    i === nothing && throw(BeveError("Array index '$token' is not a number at $pointer"))
+    return i
+end
+
+# Element `i` (0-based) of the typed array whose header is at `pos`
+function pointer_typed_element(data::AbstractVector{UInt8}, pos::Int, i::Int, pointer::AbstractString)
+    header = data[pos]
+    count, pos = pointer_size(data, pos + 1)
+    i < count || throw(BeveError("Array index $i out of bounds (length $count) at $pointer"))
+    if header == STRING_ARRAY
+        for _ in 1:i
+            pos = pointer_string_end(data, pos)
+        end
+        return BevePointerTarget(pos:(pointer_string_end(data, pos) - 1), STRING)
+    elseif header == BOOL_ARRAY
+        byte = pointer_byte(data, pos + i ÷ 8)
+        return BevePointerTarget(pos:(pos - 1), (byte >> (i % 8)) & 0x01 == 0x01 ? TRUE : FALSE)
+    end
+    width = index_byte_count(header)
+    count <= (length(data) - pos + 1) ÷ width ||
+        throw(BeveError("Typed array at byte $(pos - 1) runs past the end of the BEVE data"))
+    start = pos + i * width
+    # Numeric typed array headers are their scalar header plus 3
+    return BevePointerTarget(start:(start + width - 1), header - 0x03)
+end
+
+"""
+    resolve_beve_pointer(data::AbstractVector{UInt8}, pointer::AbstractString) -> BevePointerTarget
+
+Find the value `pointer` selects (`""` or `"/"` for the whole value) in the BEVE bytes `data`,
+skipping every value in the way by its encoded size instead of decoding it. Throws a
+`BeveError` when the pointer does not resolve.
+"""
+function resolve_beve_pointer(data::AbstractVector{UInt8}, pointer::AbstractString)
+    rest = pointer == "/" ? "" : pointer
+    isempty(rest) || startswith(rest, "/") || throw(BeveError("JSON pointer must start with '/': $pointer"))
+    tokens = isempty(rest) ? String[] : [unescape_pointer_token(t) for t in split(rest[2:end], '/')]
+    pos = firstindex(data)
+    for (k, token) in enumerate(tokens)
+        header = pointer_byte(data, pos)
+        while header == TAG
+            # Descend into the tagged value; a pointer that ends here keeps the tag
+            _, pos = pointer_size(data, pos + 1)
+            header = pointer_byte(data, pos)
+        end
+        kind = header & 0x07
+        if kind == 0x03
+            pos = pointer_member(data, pos, token, pointer)
+        elseif kind == 0x05
+            i = pointer_index(token, pointer)
+            count, pos = pointer_size(data, pos + 1)
+            i < count || throw(BeveError("Array index $i out of bounds (length $count) at $pointer"))
+            for _ in 1:i
+                pos = pointer_skip(data, pos)
+            end
+        elseif kind == 0x04
+            k == length(tokens) || throw(BeveError("Cannot descend into a typed array element at $pointer"))
+            return pointer_typed_element(data, pos, pointer_index(token, pointer), pointer)
+        else
+            throw(BeveError("Cannot resolve '$token' in a $(header_name(header)) value at $pointer"))
+        end
+    end
+    return BevePointerTarget(pos:(pointer_skip(data, pos) - 1), 0x00)
+end
+
+# Decodes the resolved target: in place through an IOBuffer when it is a whole value, from a
+# few copied bytes when it is a typed array element
+function decode_pointer_target(data::Vector{UInt8}, target::BevePointerTarget, preserve_matrices::Bool)
+    if target.element_header == 0x00
+        io = IOBuffer(data)
+        seek(io, first(target.range) - 1)
+        return parse_value(BeveDeserializer(io; preserve_matrices = preserve_matrices))
+    end
+    return from_beve(vcat(target.element_header, data[target.range]))
+end
+
+"""
+    from_beve_at(data::Vector{UInt8}, pointer::AbstractString; preserve_matrices = false) -> Any
+
+Decode only the value `pointer` selects in `data` (see [`resolve_beve_pointer`](@ref)), as
+`from_beve` would decode it on its own.
+
+```julia
+bytes = to_beve(company)
+from_beve_at(bytes, "/employees/3/salary")
+```
+"""
+from_beve_at(data::Vector{UInt8}, pointer::AbstractString; preserve_matrices::Bool = false) =
+    decode_pointer_target(data, resolve_beve_pointer(data, pointer), preserve_matrices)
+
+"""
+    deser_beve_at(::Type{T}, data::Vector{UInt8}, pointer::AbstractString;
+                  error_on_missing_fields = false, preserve_matrices = false) -> T
+
+Like [`from_beve_at`](@ref), but reconstructs the selected value as a `T` the way
+[`deser_beve`](@ref) does.
+"""
+function deser_beve_at(::Type{T}, data::Vector{UInt8}, pointer::AbstractString;
+                       error_on_missing_fields::Bool = false,
+                       preserve_matrices::Bool = false) where T
+    parsed = from_beve_at(data, pointer; preserve_matrices = preserve_matrices)
+    return reconstruct_parsed(T, parsed, ReconstructionContext(; error_on_missing = error_on_missing_fields))
+end
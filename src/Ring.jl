@@ -0,0 +1,248 @@
+# Shared-memory frame rings
+#
+# A single-producer/single-consumer ring of BEVE frames in a POSIX shared-memory segment,
+# for handing messages between processes on one machine. The layout is shared with
+# `beve_validation/beve_shm_ring.hpp` (see there for the full description):
+#
+#    0    magic "BEVERNG1"      64   head (bytes published)      192  closed flag
+#    8    capacity              128  tail (bytes released)       256  data region
+#
+# Frames are an 8-byte length and the BEVE bytes, padded to 8 bytes, and never wrap: a frame
+# that does not fit before the end of the region is preceded by RING_WRAP and starts at 0.
+# Segments are the files under /dev/shm, so rings are only available on Linux.
+
+const RING_MAGIC = 0x31474e5245564542  # "BEVERNG1" read little endian
+const RING_HEADER_BYTES = 256
+const RING_HEAD = 64
+const RING_TAIL = 128
+const RING_CLOSED = 192
+const RING_WRAP = typemax(UInt64)
+
+"""
+    BeveRing
+
+A mapped shared-memory ring of BEVE frames, from [`create_beve_ring`](@ref) or
+[`open_beve_ring`](@ref). One process writes frames with [`write_beve_frame`](@ref), one
+reads them with [`read_beve_frame`](@ref) or [`deser_beve_frame`](@ref).
+"""
+mutable struct BeveRing
+    name::String
+    map::Vector{UInt8}
+    capacity::UInt64
+    head::UInt64  # producer's next write position
+    tail::UInt64  # consumer's next read position
+end
+
+function ring_path(name::AbstractString)
+    Sys.islinux() || throw(BeveError("Shared-memory BEVE rings are only supported on Linux"))
+    return joinpath("/dev/shm", lstrip(name, '/'))
+end
+
+# Header words are shared with the other process; head, tail and the closed flag are
+# published with release stores and read with acquire loads
+@inline ring_word(ring::BeveRing, offset::Int) = Ptr{UInt64}(pointer(ring.map) + offset)
+@inline ring_load(ring::BeveRing, offset::Int) =
+    GC.@preserve ring Core.Intrinsics.atomic_pointerref(ring_word(ring, offset), :acquire)
+@inline ring_store!(ring::BeveRing, offset::Int, value::UInt64) =
+    GC.@preserve ring Core.Intrinsics.atomic_pointerset(ring_word(ring, offset), value, :release)
+
+@inline ring_frame_bytes(length::UInt64) = 8 + ((length + 7) & ~UInt64(7))
+@inline ring_data(ring::BeveRing) = pointer(ring.map) + RING_HEADER_BYTES
+
+"""
+    create_beve_ring(name::AbstractString; capacity::Integer = 1 << 24) -> BeveRing
+
+Create (or replace) the shared-memory segment `name` with `capacity` bytes of frame
+storage, rounded up to a power of two. Frames may be up to half the capacity, less 8 bytes.
+The same segment is opened by `beve::shm_ring::open` in C++.
+"""
+function create_beve_ring(name::AbstractString; capacity::Integer = 1 << 24)
+    rounded = UInt64(64)
+    while rounded < capacity
+        rounded <<= 1
+    end
+    map = open(ring_path(name), "w+") do io
+        Mmap.mmap(io, Vector{UInt8}, RING_HEADER_BYTES + Int(rounded))
+    end
+    ring = BeveRing(String(name), map, rounded, 0, 0)
+    GC.@preserve ring unsafe_store!(ring_word(ring, 8), htol(rounded))
+    # Publishing the magic last tells a reader racing with creation that the header is whole
+    ring_store!(ring, 0, RING_MAGIC)
+    return ring
+end
+
+"""
+    open_beve_ring(name::AbstractString) -> BeveRing
+
+Map an existing ring created by either language. The reader and writer positions are taken
+from the segment, so a restarted consumer resumes where the previous one stopped.
+"""
+function open_beve_ring(name::AbstractString)
+    path = ring_path(name)
+    isfile(path) || throw(BeveError("No BEVE ring named $name"))
+    map = open(path, "r+") do io
+        filesize(io) >= RING_HEADER_BYTES || throw(BeveError("Segment $name is too small to hold a ring header"))
+        Mmap.mmap(io, Vector{UInt8}, filesize(io))
+    end
+    ring = BeveRing(String(name), map, 0, 0, 0)
+    capacity = GC.@preserve ring ltoh(unsafe_load(ring_word(ring, 8)))
+    if ring_load(ring, 0) != RING_MAGIC || capacity < 64 || !ispow2(capacity) ||
+       RING_HEADER_BYTES + capacity > length(map)
+        throw(BeveError("Segment $name is not a BEVE ring"))
+    end
+    ring.capacity = capacity
+    ring.head = ring_load(ring, RING_HEAD)
+    ring.tail = ring_load(ring, RING_TAIL)
+    return ring
+end
+
+"""
+    unlink_beve_ring(name::AbstractString)
+
+Remove the segment `name`. Rings that already map it stay usable until closed.
+"""
+unlink_beve_ring(name::AbstractString) = rm(ring_path(name); force = true)
+
+"""
+    close(ring::BeveRing)
+
+Unmap the ring. The segment itself lives on until [`unlink_beve_ring`](@ref).
+"""
+function Base.close(ring::BeveRing)
+    finalize(ring.map)
+    ring.map = UInt8[]
+    return nothing
+end
+
+"""
+    finish_beve_ring(ring::BeveRing)
+
+Tell the consumer that no more frames will be written. Once it has read every frame already
+in the ring, [`read_beve_frame`](@ref) returns `nothing`.
+"""
+finish_beve_ring(ring::BeveRing) = ring_store!(ring, RING_CLOSED, UInt64(1))
+
+ring_max_frame(ring::BeveRing) = ring.capacity ÷ 2 - 8
+
+# Spin briefly (a handoff is usually well under a microsecond away), then yield so other
+# tasks can run. Returns false once `deadline` (a time_ns value) has passed.
+@inline function ring_backoff(spins::Int, deadline::UInt64)
+    if spins < 64
+        ccall(:jl_cpu_pause, Cvoid, ())
+        return true
+    end
+    yield()
+    return time_ns() < deadline
+end
+
+ring_deadline(timeout::Real) = isinf(timeout) ? typemax(UInt64) : time_ns() + round(UInt64, timeout * 1e9)
+
+# Copies one frame into the ring, or returns false when it is too full
+function ring_try_push!(ring::BeveRing, bytes::Vector{UInt8})
+    n = UInt64(length(bytes))
+    need = ring_frame_bytes(n)
+    at = ring.head & (ring.capacity - 1)
+    skip = ring.capacity - at < need ? ring.capacity - at : UInt64(0)
+    ring.head + skip + need - ring_load(ring, RING_TAIL) > ring.capacity && return false
+    GC.@preserve ring bytes begin
+        data = ring_data(ring)
+        if skip > 0
+            unsafe_store!(Ptr{UInt64}(data + at), htol(RING_WRAP))
+            ring.head += skip
+        end
+        start = ring.head & (ring.capacity - 1)
+        unsafe_store!(Ptr{UInt64}(data + start), htol(n))
+        n > 0 && unsafe_copyto!(data + start + 8, pointer(bytes), n)
+    end
+    ring.head += need
+    ring_store!(ring, RING_HEAD, ring.head)
+    return true
+end
+
+"""
+    write_beve_frame(ring::BeveRing, data; float32_as = :f32, pack_arrays = false,
+                     timeout = Inf) -> Bool
+
+Serialize `data` (as [`to_beve`](@ref) would) and append it to the ring as one frame,
+waiting for the consumer to make room. Returns `false` if `timeout` seconds pass first.
+Throws a `BeveError` for a frame that could never fit.
+"""
+function write_beve_frame(ring::BeveRing, data; float32_as::Symbol = :f32, pack_arrays::Bool = false,
+                          timeout::Real = Inf)
+    bytes = to_beve(data; float32_as = float32_as, pack_arrays = pack_arrays)
+    if length(bytes) > ring_max_frame(ring)
+        throw(BeveError("Frame of $(length(bytes)) bytes exceeds the ring's maximum of $(ring_max_frame(ring))"))
+    end
+    deadline = ring_deadline(timeout)
+    spins = 0
+    while !ring_try_push!(ring, bytes)
+        ring_backoff(spins += 1, deadline) || return false
+    end
+    return true
+end
+
+# Offset (into the data region) and length of the oldest unread frame, or nothing
+function ring_front(ring::BeveRing)
+    ring.tail == ring_load(ring, RING_HEAD) && return nothing
+    GC.@preserve ring begin
+        data = ring_data(ring)
+        at = ring.tail & (ring.capacity - 1)
+        n = ltoh(unsafe_load(Ptr{UInt64}(data + at)))
+        if n == RING_WRAP
+            # The marker and the frame after it were published together
+            ring.tail += ring.capacity - at
+            at = UInt64(0)
+            n = ltoh(unsafe_load(Ptr{UInt64}(data)))
+        end
+    end
+    return at, n
+end
+
+"""
+    read_beve_frame(f, ring::BeveRing; timeout = Inf)
+    read_beve_frame(ring::BeveRing; preserve_matrices = false, timeout = Inf)
+
+Wait for the next frame and decode it straight from shared memory. The first form passes
+the frame bytes (a `Vector{UInt8}` wrapping the mapping, valid only during the call) to `f`
+and returns its result; the second returns `from_beve` of the frame. The frame is released
+to the producer afterwards. Returns `nothing` once the producer has called
+[`finish_beve_ring`](@ref) and every frame has been read, or when `timeout` seconds pass.
+"""
+function read_beve_frame(f, ring::BeveRing; timeout::Real = Inf)
+    deadline = ring_deadline(timeout)
+    spins = 0
+    frame = ring_front(ring)
+    while frame === nothing
+        if ring_load(ring, RING_CLOSED) != 0
+            # A frame published just before the closed flag is still delivered
+            frame = ring_front(ring)
+            frame === nothing && return nothing
+            break
+        end
+        ring_backoff(spins += 1, deadline) || return nothing
+        frame = ring_front(ring)
+    end
+    at, n = frame
+    try
+        bytes = unsafe_wrap(Array, ring_data(ring) + at + 8, Int(n))
+        return GC.@preserve ring f(bytes)
+    finally
+        ring.tail += ring_frame_bytes(n)
+        ring_store!(ring, RING_TAIL, ring.tail)
+    end
+end
+
+read_beve_frame(ring::BeveRing; preserve_matrices::Bool = false, timeout::Real = Inf) =
+    read_beve_frame(bytes -> from_beve(bytes; preserve_matrices = preserve_matrices), ring; timeout = timeout)
+
+"""
+    deser_beve_frame(::Type{T}, ring::BeveRing; error_on_missing_fields = false,
+                     preserve_matrices = false, timeout = Inf)
+
+Like [`read_beve_frame`](@ref), but reconstructs the frame as a `T` with [`deser_beve`](@ref).
+"""
+deser_beve_frame(::Type{T}, ring::BeveRing; error_on_missing_fields::Bool = false,
+                 preserve_matrices::Bool = false, timeout::Real = Inf) where T =
+    read_beve_frame(bytes -> deser_beve(T, bytes; error_on_missing_fields = error_on_missing_fields,
+                                        preserve_matrices = preserve_matrices),
+                    ring; timeout = timeout)
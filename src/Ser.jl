@@ -46,14 +46,30 @@ mutable struct BeveSerializer{IOType<:IO}
     io::IOType
     work_buffer::Vector{UInt8}  # Pre-allocated working buffer for conversions
     temp_buffer::Vector{UInt8}  # Temporary buffer for small operations
+    float32_array::UInt8        # Header Vector{Float32} is written as: F32_ARRAY, BF16_ARRAY or F16_ARRAY
+    pack_arrays::Bool           # Write 16 to 64-bit numeric vectors as PACKED_ARRAY
+    key_dict::Union{Nothing, Dict{String, Int}}  # Key indices when writing KEYED_OBJECTs
+    planar_complex::Bool        # Write complex vectors as every real part, then every imaginary part
     
-    function BeveSerializer(io::IO)
-        new{typeof(io)}(io, Vector{UInt8}(undef, 8192), Vector{UInt8}(undef, 64))
+    function BeveSerializer(io::IO; float32_as::Symbol = :f32, pack_arrays::Bool = false,
+                            dict_keys::Bool = false, planar_complex::Bool = false)
+        header = float32_array_header(float32_as)
+        pack_arrays && header != F32_ARRAY &&
+            throw(ArgumentError("pack_arrays and float32_as = :$float32_as cannot be combined"))
+        new{typeof(io)}(io, Vector{UInt8}(undef, 8192), Vector{UInt8}(undef, 64), header, pack_arrays,
+                        dict_keys ? Dict{String, Int}() : nothing, planar_complex)
     end
 end
 
+function float32_array_header(float32_as::Symbol)::UInt8
+    float32_as === :f32 && return F32_ARRAY
+    float32_as === :bf16 && return BF16_ARRAY
+    float32_as === :f16 && return F16_ARRAY
+    throw(ArgumentError("float32_as must be :f32, :bf16 or :f16, got :$float32_as"))
+end
+
 # Helper function for bulk endianness conversion
-@inline function convert_endianness!(dest::Vector{T}, src::Vector{T}) where T <: Union{Int16, Int32, Int64, UInt16, UInt32, UInt64, Float32, Float64}
+@inline function convert_endianness!(dest::Vector{T}, src::Vector{T}) where T <: Union{Int16, Int32, Int64, UInt16, UInt32, UInt64, Float16, Float32, Float64}
     if ENDIAN_BOM == 0x04030201  # Little endian system
         # Most systems are little endian, so this is the fast path
         return src
@@ -74,7 +90,7 @@ end
     end
 end
 
-@inline function write_array_data(io::IO, data::Vector{T}) where T <: Union{Int16, Int32, Int64, UInt16, UInt32, UInt64, Float32, Float64}
+@inline function write_array_data(io::IO, data::Vector{T}) where T <: Union{Int16, Int32, Int64, UInt16, UInt32, UInt64, Float16, Float32, Float64}
     if length(data) == 0
         return
     end
@@ -97,7 +113,7 @@ end
     end
 end
 
-@inline function write_array_data(ser::BeveSerializer, data::Vector{T}) where T <: Union{Int16, Int32, Int64, UInt16, UInt32, UInt64, Float32, Float64}
+@inline function write_array_data(ser::BeveSerializer, data::Vector{T}) where T <: Union{Int16, Int32, Int64, UInt16, UInt32, UInt64, Float16, Float32, Float64}
     if length(data) == 0
         return
     end
@@ -135,6 +151,113 @@ end
     end
 end
 
+# Round to nearest even bfloat16 (the top half of a Float32); NaNs stay quiet NaNs
+@inline function float32_to_bf16(x::Float32)::UInt16
+    bits = reinterpret(UInt32, x)
+    rounded = ((bits + 0x00007fff + ((bits >> 16) & 0x00000001)) >> 16) % UInt16
+    quiet_nan = ((bits >> 16) % UInt16) | 0x0040
+    return ifelse((bits & 0x7fffffff) > 0x7f800000, quiet_nan, rounded)
+end
+
+@inline bf16_to_float32(h::UInt16)::Float32 = reinterpret(Float32, UInt32(h) << 16)
+
+# Narrow Float32 data to bf16 or f16 through the working buffer, one block at a time, so the
+# array is never copied whole. Both loops are branch-free and vectorize (Float16 conversion
+# compiles to F16C instructions where the CPU has them).
+function write_half_array_data(ser::BeveSerializer, data::Vector{Float32}, header::UInt8)
+    buffer = ser.work_buffer
+    block = length(buffer) ÷ 2
+    GC.@preserve buffer begin
+        out = reinterpret(Ptr{UInt16}, pointer(buffer))
+        for start in 1:block:length(data)
+            n = min(block, length(data) - start + 1)
+            if header == BF16_ARRAY
+                @inbounds @simd for i in 1:n
+                    unsafe_store!(out, htol(float32_to_bf16(data[start + i - 1])), i)
+                end
+            else
+                @inbounds @simd for i in 1:n
+                    unsafe_store!(out, htol(reinterpret(UInt16, Float16(data[start + i - 1]))), i)
+                end
+            end
+            unsafe_write(ser.io, out, 2 * n)
+        end
+    end
+end
+
+# Packed arrays compare bit patterns, as unsigned integers of the element width
+packed_uint(::Type{T}) where T = sizeof(T) == 1 ? UInt8 : sizeof(T) == 2 ? UInt16 : sizeof(T) == 4 ? UInt32 : UInt64
+
+function packed_element_header(::Type{T})::UInt8 where T
+    T === Float32 && return F32_ARRAY
+    T === Float64 && return F64_ARRAY
+    T === Int16 && return I16_ARRAY
+    T === Int32 && return I32_ARRAY
+    T === Int64 && return I64_ARRAY
+    T === UInt16 && return U16_ARRAY
+    T === UInt32 && return U32_ARRAY
+    return U64_ARRAY
+end
+
+@inline function pack_residual(value::U, previous::U, codec::UInt8)::U where U <: Unsigned
+    codec == PACK_XOR && return value ⊻ previous
+    d = value - previous
+    return (d << 1) ⊻ (reinterpret(signed(U), d) >> (8 * sizeof(U) - 1)) % U
+end
+
+# Width in bits of the widest residual in values `first:last` of a block
+@inline function packed_block_width(bits::AbstractVector{U}, first::Int, last::Int, codec::UInt8)::Int where U
+    mask = zero(U)
+    @inbounds for i in (first + 1):last
+        mask |= pack_residual(bits[i], bits[i - 1], codec)
+    end
+    return 8 * sizeof(U) - leading_zeros(mask)
+end
+
+# PACKED_ARRAY: blocks of PACK_BLOCK values, each a width byte, the block's first value and
+# the residuals of the rest at that width, LSB first (layout in beve_validation/beve_packed.hpp).
+# Floats use the XOR codec and integers the delta codec.
+function write_packed_array(ser::BeveSerializer, data::Vector{T}) where T
+    U = packed_uint(T)
+    bits = reinterpret(U, data)
+    codec = T <: AbstractFloat ? PACK_XOR : PACK_DELTA
+    n = length(bits)
+    widths = Vector{UInt8}(undef, cld(n, PACK_BLOCK))
+    payload = 0
+    for (b, first) in enumerate(1:PACK_BLOCK:n)
+        last = min(first + PACK_BLOCK - 1, n)
+        widths[b] = packed_block_width(bits, first, last, codec)
+        payload += 1 + sizeof(T) + cld((last - first) * widths[b], 8)
+    end
+
+    write(ser.io, PACKED_ARRAY)
+    write(ser.io, codec)
+    write(ser.io, packed_element_header(T))
+    write_size(ser, n)
+    write_size(ser, payload)
+    for (b, first) in enumerate(1:PACK_BLOCK:n)
+        last = min(first + PACK_BLOCK - 1, n)
+        width = Int(widths[b])
+        write(ser.io, widths[b])
+        write(ser.io, htol(bits[first]))
+        acc = UInt64(0)
+        filled = 0
+        @inbounds for i in (first + 1):last
+            residual = UInt64(pack_residual(bits[i], bits[i - 1], codec))
+            acc |= residual << filled
+            filled += width
+            if filled >= 64
+                write(ser.io, htol(acc))
+                filled -= 64
+                acc = residual >> (width - filled)  # shifts of 64 or more give 0
+            end
+        end
+        for k in 0:(cld(filled, 8) - 1)
+            write(ser.io, (acc >> (8 * k)) % UInt8)
+        end
+    end
+end
+
 # Compressed size encoding as per BEVE spec - optimized
 @inline function write_size(io::IO, size::Int)
     if size >= 2^62
@@ -199,6 +322,35 @@ function write_string_data(ser::BeveSerializer, str::String)
     write(ser.io, bytes)
 end
 
+# String-keyed objects: STRING_OBJECT with the keys inline, or with `dict_keys` a KEYED_OBJECT
+# whose keys are indices into the table `finish_beve!` writes ahead of the value
+@inline object_header(ser::BeveSerializer)::UInt8 = ser.key_dict === nothing ? STRING_OBJECT : KEYED_OBJECT
+
+@inline function write_object_key(ser::BeveSerializer, key::String)
+    key_dict = ser.key_dict
+    key_dict === nothing && return write_string_data(ser, key)
+    write_size(ser, get!(key_dict, key, length(key_dict)))
+end
+
+# The bytes of the value written to `io` (an IOBuffer), preceded by its KEY_TABLE when the
+# serializer encodes keys
+function finish_beve!(ser::BeveSerializer, io::IOBuffer)::Vector{UInt8}
+    body = take!(io)
+    key_dict = ser.key_dict
+    key_dict === nothing && return body
+    table = Vector{String}(undef, length(key_dict))
+    for (key, i) in key_dict
+        table[i + 1] = key
+    end
+    write(io, KEY_TABLE)
+    write_size(ser, length(table))
+    for key in table
+        write_string_data(ser, key)
+    end
+    write(io, body)
+    return take!(io)
+end
+
 function beve_value!(ser::BeveSerializer, val::Nothing)
     write(ser.io, NULL)
 end
@@ -274,6 +426,11 @@ function beve_value!(ser::BeveSerializer, val::UInt128)
 end
 
 # Optimized float serialization with combined writes
+function beve_value!(ser::BeveSerializer, val::Float16)
+    write(ser.io, F16)
+    write(ser.io, htol(val))
+end
+
 function beve_value!(ser::BeveSerializer, val::Float32)
     # Combine header and value write for better performance
     if length(ser.temp_buffer) >= 5
@@ -481,13 +638,26 @@ function beve_value!(ser::BeveSerializer, val::Vector{String})
 end
 
 # Typed numeric arrays - optimized versions
-function beve_value!(ser::BeveSerializer, val::Vector{Float32})
-    write(ser.io, F32_ARRAY)
+function beve_value!(ser::BeveSerializer, val::Vector{Float16})
+    write(ser.io, F16_ARRAY)
     write_size(ser, length(val))
     write_array_data(ser, val)
 end
 
+function beve_value!(ser::BeveSerializer, val::Vector{Float32})
+    ser.pack_arrays && return write_packed_array(ser, val)
+    header = ser.float32_array
+    write(ser.io, header)
+    write_size(ser, length(val))
+    if header == F32_ARRAY
+        write_array_data(ser, val)
+    else
+        write_half_array_data(ser, val, header)
+    end
+end
+
 function beve_value!(ser::BeveSerializer, val::Vector{Float64})
+    ser.pack_arrays && return write_packed_array(ser, val)
     write(ser.io, F64_ARRAY)
     write_size(ser, length(val))
     write_array_data(ser, val)
@@ -500,18 +670,21 @@ function beve_value!(ser::BeveSerializer, val::Vector{Int8})
 end
 
 function beve_value!(ser::BeveSerializer, val::Vector{Int16})
+    ser.pack_arrays && return write_packed_array(ser, val)
     write(ser.io, I16_ARRAY)
     write_size(ser, length(val))
     write_array_data(ser, val)
 end
 
 function beve_value!(ser::BeveSerializer, val::Vector{Int32})
+    ser.pack_arrays && return write_packed_array(ser, val)
     write(ser.io, I32_ARRAY)
     write_size(ser, length(val))
     write_array_data(ser, val)
 end
 
 function beve_value!(ser::BeveSerializer, val::Vector{Int64})
+    ser.pack_arrays && return write_packed_array(ser, val)
     write(ser.io, I64_ARRAY)
     write_size(ser, length(val))
     write_array_data(ser, val)
@@ -524,18 +697,21 @@ function beve_value!(ser::BeveSerializer, val::Vector{UInt8})
 end
 
 function beve_value!(ser::BeveSerializer, val::Vector{UInt16})
+    ser.pack_arrays && return write_packed_array(ser, val)
     write(ser.io, U16_ARRAY)
     write_size(ser, length(val))
     write_array_data(ser, val)
 end
 
 function beve_value!(ser::BeveSerializer, val::Vector{UInt32})
+    ser.pack_arrays && return write_packed_array(ser, val)
     write(ser.io, U32_ARRAY)
     write_size(ser, length(val))
     write_array_data(ser, val)
 end
 
 function beve_value!(ser::BeveSerializer, val::Vector{UInt64})
+    ser.pack_arrays && return write_packed_array(ser, val)
     write(ser.io, U64_ARRAY)
     write_size(ser, length(val))
     write_array_data(ser, val)
@@ -587,6 +763,23 @@ end
     end
 end
 
+# Planar complex array data: every real part, then every imaginary part, gathered through the
+# working buffer a chunk at a time
+function write_planar_complex_data(ser::BeveSerializer, data::Vector{Complex{T}}) where T <: Union{Float32, Float64}
+    chunk = length(ser.work_buffer) ÷ sizeof(T)
+    parts = reinterpret(reshape, T, data)  # 2 x n: row 1 real parts, row 2 imaginary parts
+    GC.@preserve ser begin
+        buffer_ptr = reinterpret(Ptr{T}, pointer(ser.work_buffer))
+        for part in 1:2, first in 1:chunk:length(data)
+            m = min(chunk, length(data) - first + 1)
+            @inbounds @simd for j in 1:m
+                unsafe_store!(buffer_ptr, htol(parts[part, first + j - 1]), j)
+            end
+            unsafe_write(ser.io, pointer(ser.work_buffer), m * sizeof(T))
+        end
+    end
+end
+
 # Complex arrays - optimized
 function beve_value!(ser::BeveSerializer, val::Vector{ComplexF32})
     write(ser.io, COMPLEX)
@@ -595,6 +788,13 @@ function beve_value!(ser::BeveSerializer, val::Vector{ComplexF32})
     # - Bits 3-4: type (0 = floating point)
     # - Bits 5-7: byte count index (2 = 4 bytes for Float32)
     # Result: 0b010'00'001 = 0x41
+    # With planar_complex, bit 1 is set too (see COMPLEX_PLANAR)
+    if ser.planar_complex
+        write(ser.io, UInt8(0x41) | COMPLEX_PLANAR)
+        write_size(ser, length(val))
+        write_planar_complex_data(ser, val)
+        return
+    end
     write(ser.io, UInt8(0x41))
     write_size(ser, length(val))
     write_complex_array_data(ser, val)
@@ -607,6 +807,13 @@ function beve_value!(ser::BeveSerializer, val::Vector{ComplexF64})
     # - Bits 3-4: type (0 = floating point)
     # - Bits 5-7: byte count index (3 = 8 bytes for Float64)
     # Result: 0b011'00'001 = 0x61
+    # With planar_complex, bit 1 is set too (see COMPLEX_PLANAR)
+    if ser.planar_complex
+        write(ser.io, UInt8(0x61) | COMPLEX_PLANAR)
+        write_size(ser, length(val))
+        write_planar_complex_data(ser, val)
+        return
+    end
     write(ser.io, UInt8(0x61))
     write_size(ser, length(val))
     write_complex_array_data(ser, val)
@@ -667,8 +874,14 @@ function beve_value!(ser::BeveSerializer, val::BEVE.BeveMatrix)
         end
     end
     
-    # Write the data as a typed array
-    beve_value!(ser, val.data)
+    # Write the data as a typed array; matrix readers expect one, so packing is suspended
+    pack_arrays = ser.pack_arrays
+    ser.pack_arrays = false
+    try
+        beve_value!(ser, val.data)
+    finally
+        ser.pack_arrays = pack_arrays
+    end
 end
 
 # Handle generic arrays (mixed types)
@@ -682,16 +895,16 @@ end
 
 # Handle dictionaries as objects - optimized
 function beve_value!(ser::BeveSerializer, val::Dict{String, T}) where T
-    write(ser.io, STRING_OBJECT)
+    write(ser.io, object_header(ser))
     write_size(ser, length(val))
     for (k, v) in val
-        write_string_data(ser, k)
+        write_object_key(ser, k)
         beve_value!(ser, v)
     end
 end
 
-# Handle integer-keyed dictionaries
-function beve_value!(ser::BeveSerializer, val::Dict{K, V}) where {K <: Integer, V}
+# Handle integer-keyed dictionaries; a BeveSortedDict is written in key order
+function beve_value!(ser::BeveSerializer, val::Union{Dict{K, V}, BeveSortedDict{K, V}}) where {K <: Integer, V}
     # Select appropriate header based on key type
     header = if K == Int8
         I8_OBJECT
@@ -782,7 +995,7 @@ function beve_value!(ser::BeveSerializer, val::T) where T
         end
     elseif !isempty(fieldnames(T))
         # Serialize as a string-keyed object
-        write(ser.io, STRING_OBJECT)
+        write(ser.io, object_header(ser))
         fields = fieldnames(T)
         declared_skipped = normalize_skip_fields(skip(T))
         serialized_fields = Pair{String, Any}[]
@@ -806,7 +1019,7 @@ function beve_value!(ser::BeveSerializer, val::T) where T
         write_size(ser, length(serialized_fields))
 
         for field_entry in serialized_fields
-            write_string_data(ser, field_entry.first)
+            write_object_key(ser, field_entry.first)
             beve_value!(ser, field_entry.second)
         end
     else
@@ -814,14 +1027,64 @@ function beve_value!(ser::BeveSerializer, val::T) where T
     end
 end
 
+# An IOBuffer to write `data` into. A typed array or matrix is sized in O(1), so its buffer
+# always has room for exactly the encoded bytes (see `beve_size_of`) and writing never grows
+# it; other values only get that pre-pass with `exact_size`, since it walks them (and calls
+# their `ser_value`/`ser_type` hooks) a second time. Packed arrays and key tables are only
+# sized by writing them, so those start empty.
+function presized_buffer(data, float32_as::Symbol, pack_arrays::Bool, dict_keys::Bool,
+                         exact_size::Bool)::IOBuffer
+    (pack_arrays || dict_keys) && return IOBuffer()
+    (exact_size || sized_from_length(data)) || return IOBuffer()
+    return IOBuffer(; sizehint = beve_size_of(data; float32_as = float32_as))
+end
+
+sized_from_length(data) = false
+sized_from_length(data::Union{Vector{T}, AbstractMatrix{T}})::Bool where T = T in SIZED_ARRAY_ELEMENTS
+
 """
-    to_beve([f::Function], data) -> Vector{UInt8}
-    to_beve!(io::IOBuffer, data) -> Vector{UInt8}
+    to_beve([f::Function], data; float32_as::Symbol = :f32, pack_arrays::Bool = false,
+            dict_keys::Bool = false, planar_complex::Bool = false,
+            exact_size::Bool = false) -> Vector{UInt8}
+    to_beve!(io::IOBuffer, data; float32_as::Symbol = :f32, pack_arrays::Bool = false,
+             dict_keys::Bool = false, planar_complex::Bool = false) -> Vector{UInt8}
 
 Serializes any `data` into a BEVE binary format.
 
-The `to_beve!` variant accepts a pre-allocated IOBuffer for better performance
-when serializing multiple objects. The buffer is reset before use.
+A typed array or matrix is written into output allocated once, at the size
+[`beve_size_of`](@ref) computes from its length. Other values are written into a growing
+buffer, unless `exact_size = true`: that sizes them up front, walking them (and calling their
+`ser_value`/`ser_type` hooks) twice, which pays off for values holding large arrays rather
+than for small messages. The `to_beve!` variant accepts a pre-allocated IOBuffer for better
+performance when serializing multiple objects. The buffer is reset before use.
+
+`float32_as = :bf16` or `:f16` stores every `Vector{Float32}` as a BF16 or F16 typed
+array, half the size, rounding to nearest even. Float32 scalars are unaffected. Reading
+back gives `Vector{Float32}` for bf16 and `Vector{Float16}` for f16; struct fields typed
+`Vector{Float32}` accept either. `Vector{Float16}` is always written as an F16 array.
+
+`pack_arrays = true` writes every 16-, 32- and 64-bit numeric vector as a packed array, a
+lossless BEVE extension for time series (header `0x26`): blocks of 128 values, each storing
+its first value and then, at one bit width, the XOR with the previous value (floats) or the
+zigzagged difference from it (integers). Slowly changing or regularly spaced series shrink
+severalfold; noisy data costs one extra byte per block. Packed arrays are read back
+as ordinary vectors by `from_beve` and by `beve::read_packed_array` in
+`beve_validation/beve_packed.hpp`, but not by other BEVE readers. Matrix data is never
+packed, and `pack_arrays` cannot be combined with `float32_as`.
+
+`dict_keys = true` writes each distinct object key once, in a key table ahead of the value
+(header `0x2e`), and every string-keyed object as a keyed object (header `0x36`) that refers
+to its keys by index, one byte each for the first 16 keys. Arrays of records and other
+payloads that repeat the same keys shrink by the size of those keys. `from_beve` and
+`deser_beve` read it; in C++, `beve::expand_keys` in `beve_validation/beve_keys.hpp`
+rewrites it as plain BEVE for `glz::read_beve`.
+
+`planar_complex = true` writes every `Vector{ComplexF32}` and `Vector{ComplexF64}`, and the
+data of complex matrices, in planar layout: all real parts, then all imaginary parts, at the
+same size as the interleaved layout (the component byte after `COMPLEX` has bit 1 set). FFT
+and SIMD code that keeps split buffers reads it without a deinterleave pass. `from_beve`,
+`read_beve_slice` and `beve::read_split_complex` in `beve_validation/beve_planar.hpp` read it;
+glaze does not.
 
 ## Examples
 
@@ -838,24 +1101,35 @@ julia> beve_data = to_beve(person)
 # Using pre-allocated buffer for better performance
 julia> buffer = IOBuffer()
 julia> beve_data = to_beve!(buffer, person)
+
+# Reduced-precision feature dump
+julia> length(to_beve(rand(Float32, 1000); float32_as = :bf16))
+2003
 ```
 """
-function to_beve(data)::Vector{UInt8}
-    io = IOBuffer()
-    ser = BeveSerializer(io)
+function to_beve(data; float32_as::Symbol = :f32, pack_arrays::Bool = false,
+                 dict_keys::Bool = false, planar_complex::Bool = false,
+                 exact_size::Bool = false)::Vector{UInt8}
+    io = presized_buffer(data, float32_as, pack_arrays, dict_keys, exact_size)
+    ser = BeveSerializer(io; float32_as = float32_as, pack_arrays = pack_arrays, dict_keys = dict_keys,
+                         planar_complex = planar_complex)
     beve_value!(ser, data)
-    return take!(io)
+    return finish_beve!(ser, io)
 end
 
-function to_beve(f::Function, data)::Vector{UInt8}
-    io = IOBuffer()
-    ser = BeveSerializer(io)
+function to_beve(f::Function, data; float32_as::Symbol = :f32, pack_arrays::Bool = false,
+                 dict_keys::Bool = false, planar_complex::Bool = false,
+                 exact_size::Bool = false)::Vector{UInt8}
+    io = presized_buffer(data, float32_as, pack_arrays, dict_keys, exact_size)
+    ser = BeveSerializer(io; float32_as = float32_as, pack_arrays = pack_arrays, dict_keys = dict_keys,
+                         planar_complex = planar_complex)
     beve_value!(ser, data)
-    return take!(io)
+    return finish_beve!(ser, io)
 end
 
 """
-    to_beve!(io::IOBuffer, data) -> Vector{UInt8}
+    to_beve!(io::IOBuffer, data; float32_as::Symbol = :f32, pack_arrays::Bool = false,
+             dict_keys::Bool = false, planar_complex::Bool = false) -> Vector{UInt8}
 
 Serializes data into a BEVE binary format using a pre-allocated IOBuffer.
 The buffer is reset to the beginning before serialization.
@@ -863,33 +1137,125 @@ The buffer is reset to the beginning before serialization.
 This method is more efficient for repeated serializations as it reuses
 the buffer allocation.
 """
-function to_beve!(io::IOBuffer, data)::Vector{UInt8}
+function to_beve!(io::IOBuffer, data; float32_as::Symbol = :f32, pack_arrays::Bool = false,
+                  dict_keys::Bool = false, planar_complex::Bool = false)::Vector{UInt8}
     seekstart(io)
     truncate(io, 0)  # Clear any existing data
-    ser = BeveSerializer(io)
+    ser = BeveSerializer(io; float32_as = float32_as, pack_arrays = pack_arrays, dict_keys = dict_keys,
+                         planar_complex = planar_complex)
     beve_value!(ser, data)
-    return take!(io)
+    return finish_beve!(ser, io)
 end
 
 """
-    write_beve_file(path::AbstractString, data; buffer::Union{Nothing, IOBuffer} = nothing) -> Vector{UInt8}
+    to_beve_columnar(records::AbstractVector{T}; buffer::Union{Nothing, IOBuffer} = nothing) -> Vector{UInt8}
 
-Serialize `data` into BEVE binary form and persist it to `path`.
+Serialize a batch of structs column by column: one object with a key per field whose
+value is the array of that field across all records (a typed array for numeric fields,
+a string array for strings). Keys and headers are written once per batch instead of
+once per record. Read the result back with `deser_beve(Vector{T}, bytes)`, or in C++
+with `beve::read_columnar` from `beve_validation/beve_columnar.hpp`.
+
+Fields declared skipped with `@skip` and the `ser_value`/`ser_type` hooks are honored;
+value-dependent skipping is not, since a column has to hold every record.
+
+## Examples
 
-The function first writes into an intermediate contiguous `IOBuffer` to avoid
-streaming directly to disk, then flushes the resulting bytes with a single
-`write`. Pass a reusable `IOBuffer` via the `buffer` keyword to amortize
-allocations across repeated calls. The serialized bytes are returned.
+```julia
+julia> struct Reading
+           id::Int32
+           value::Float64
+           name::String
+       end
+
+julia> bytes = to_beve_columnar([Reading(i, i / 2, "r\$i") for i in 1:1000])
+
+julia> deser_beve(Vector{Reading}, bytes)[10]
+Reading(10, 5.0, "r10")
+```
 """
-function write_beve_file(path::AbstractString, data; buffer::Union{Nothing, IOBuffer} = nothing)::Vector{UInt8}
+function to_beve_columnar(records::AbstractVector{T};
+                          buffer::Union{Nothing, IOBuffer} = nothing)::Vector{UInt8} where T
+    (isstructtype(T) && !isempty(fieldnames(T))) ||
+        throw(ArgumentError("to_beve_columnar requires a vector of structs, got $(typeof(records))"))
     io = buffer === nothing ? IOBuffer() : buffer
     seekstart(io)
     truncate(io, 0)
     ser = BeveSerializer(io)
+    declared_skipped = normalize_skip_fields(skip(T))
+    fields = [f for f in fieldnames(T) if declared_skipped === nothing || !(f in declared_skipped)]
+
+    write(io, STRING_OBJECT)
+    write_size(ser, length(fields))
+    for field_name in fields
+        write_string_data(ser, string(ser_name(T, Val(field_name))))
+        column = map(r -> ser_type(T, ser_value(T, Val(field_name), getfield(r, field_name))), records)
+        beve_value!(ser, column)
+    end
+    return take!(io)
+end
+
+"""
+    write_beve_file(path::AbstractString, data; buffer::Union{Nothing, IOBuffer} = nothing,
+                    index::Bool = false, float32_as::Symbol = :f32,
+                    pack_arrays::Bool = false, dict_keys::Bool = false,
+                    planar_complex::Bool = false, exact_size::Bool = false,
+                    mmap::Bool = false) -> Vector{UInt8}
+
+Serialize `data` into BEVE binary form and persist it to `path`.
+
+The function first writes into an intermediate contiguous `IOBuffer`, to avoid
+streaming directly to disk, then flushes the resulting bytes with a single `write`.
+As in [`to_beve`](@ref), the buffer is allocated once at the size
+[`beve_size_of`](@ref) computes for typed arrays and matrices, or for any value
+with `exact_size = true`. Pass a reusable
+`IOBuffer` via the `buffer` keyword to amortize allocations across repeated calls.
+With `mmap = true` there is no intermediate buffer: the file is created at its
+final size, mapped, and `data` is encoded straight into the mapping, which is
+returned (it cannot be combined with `pack_arrays` or `dict_keys`). With
+`index = true` a sidecar index is written next to the file (see
+[`write_beve_index`](@ref)) so large arrays can later be sliced with
+`read_beve_slice` (packed arrays are not indexed). `float32_as`, `pack_arrays`,
+`dict_keys` and `planar_complex` are passed on as in [`to_beve`](@ref). The serialized bytes are returned.
+"""
+function write_beve_file(path::AbstractString, data; buffer::Union{Nothing, IOBuffer} = nothing,
+                         index::Bool = false, float32_as::Symbol = :f32,
+                         pack_arrays::Bool = false, dict_keys::Bool = false,
+                         planar_complex::Bool = false, exact_size::Bool = false,
+                         mmap::Bool = false)::Vector{UInt8}
+    if mmap
+        bytes = write_beve_file_mmap(path, data, float32_as, pack_arrays, dict_keys, planar_complex)
+        index && write_beve_index(path)
+        return bytes
+    end
+    io = buffer === nothing ? presized_buffer(data, float32_as, pack_arrays, dict_keys, exact_size) : buffer
+    seekstart(io)
+    truncate(io, 0)
+    ser = BeveSerializer(io; float32_as = float32_as, pack_arrays = pack_arrays, dict_keys = dict_keys,
+                         planar_complex = planar_complex)
     beve_value!(ser, data)
-    bytes = take!(io)
+    bytes = finish_beve!(ser, io)
     open(path, "w") do file_io
         write(file_io, bytes)
     end
+    index && write_beve_index(path)
     return bytes
 end
+
+# Encodes `data` into `path` mapped at its exact encoded size; returns the mapping
+function write_beve_file_mmap(path::AbstractString, data, float32_as::Symbol, pack_arrays::Bool,
+                              dict_keys::Bool, planar_complex::Bool)::Vector{UInt8}
+    (pack_arrays || dict_keys) &&
+        throw(ArgumentError("mmap = true cannot be combined with pack_arrays or dict_keys"))
+    n = beve_size_of(data; float32_as = float32_as)
+    return open(path, "w+") do file_io
+        region = Mmap.mmap(file_io, Vector{UInt8}, n)
+        io = IOBuffer(region; write = true, truncate = true)
+        beve_value!(BeveSerializer(io; float32_as = float32_as, planar_complex = planar_complex), data)
+        position(io) == n || throw(BeveError("Encoded $(position(io)) bytes into a $n-byte mapping of $path"))
+        # IOBuffer writes into the vector it wraps; copy if this Julia version wrapped a copy
+        io.data === region || copyto!(region, 1, io.data, 1, n)
+        Mmap.sync!(region)
+        region
+    end
+end
@@ -0,0 +1,185 @@
+# Exact encoded sizes
+#
+# `beve_size_of` returns the number of bytes `to_beve` produces for a value without writing
+# any of them: headers, size prefixes and payloads are added up, and a typed array costs O(1)
+# whatever its length. The methods below mirror the `beve_value!` methods in Ser.jl one for one
+# (same signatures, so the same method is chosen for every value), which is what lets `to_beve`
+# and `write_beve_file` allocate their output once at its final size. The C++ counterpart is
+# `beve::size_of` in `beve_validation/beve_size.hpp`.
+
+# Bytes `write_size` uses for `n`; it compares `n << 2` against the 1/2/4-byte limits
+@inline size_prefix_bytes(n::Int)::Int = n < 16 ? 1 : n < 4096 ? 2 : n < 2^28 ? 4 : 8
+
+@inline string_data_size(str::String)::Int = size_prefix_bytes(ncodeunits(str)) + ncodeunits(str)
+
+# Element types whose vectors are written as typed arrays, sized from their length alone
+const SIZED_ARRAY_ELEMENTS = (Bool, Float16, Float32, Float64, Int8, Int16, Int32, Int64,
+                              UInt8, UInt16, UInt32, UInt64, ComplexF32, ComplexF64)
+
+function typed_array_size(float32_array::UInt8, ::Type{T}, n::Int)::Int where T
+    T === Bool && return 1 + size_prefix_bytes(n) + cld(n, 8)
+    T <: Complex && return 2 + size_prefix_bytes(n) + n * sizeof(T)
+    width = T === Float32 && float32_array != F32_ARRAY ? 2 : sizeof(T)
+    return 1 + size_prefix_bytes(n) + n * width
+end
+
+function generic_array_size(float32_array::UInt8, val)::Int
+    total = 1 + size_prefix_bytes(length(val))
+    for item in val
+        total += beve_size(float32_array, item)
+    end
+    return total
+end
+
+# Size of `val` (any vector or matrix of T) written as a Vector{T}, without collecting it
+# unless its elements need their own sizes
+function vector_size(float32_array::UInt8, ::Type{T}, val)::Int where T
+    T in SIZED_ARRAY_ELEMENTS && return typed_array_size(float32_array, T, length(val))
+    if T === String
+        total = 1 + size_prefix_bytes(length(val))
+        for str in val
+            total += string_data_size(str)
+        end
+        return total
+    end
+    return generic_array_size(float32_array, val)
+end
+
+beve_size(float32_array::UInt8, val::Nothing)::Int = 1
+beve_size(float32_array::UInt8, val::Bool)::Int = 1
+beve_size(float32_array::UInt8, val::Union{Int8, Int16, Int32, Int64, Int128, UInt8, UInt16, UInt32,
+                                           UInt64, UInt128, Float16, Float32, Float64})::Int = 1 + sizeof(val)
+beve_size(float32_array::UInt8, val::String)::Int = 1 + string_data_size(val)
+beve_size(float32_array::UInt8, val::Symbol)::Int = beve_size(float32_array, string(val))
+beve_size(float32_array::UInt8, val::AbstractString)::Int = beve_size(float32_array, String(val))
+
+# COMPLEX, the component header, then the two parts
+beve_size(float32_array::UInt8, val::ComplexF32)::Int = 10
+beve_size(float32_array::UInt8, val::ComplexF64)::Int = 18
+beve_size(float32_array::UInt8, val::Complex{T}) where T = error("Unsupported complex type: Complex{$T}")
+
+function beve_size(float32_array::UInt8, val::AbstractMatrix{T})::Int where T
+    rows, cols = size(val)
+    if rows == 0 || cols == 0
+        throw(ArgumentError("Matrix dimensions cannot be zero"))
+    end
+    # MATRIX, layout byte, the I64_ARRAY of two extents, then the data in either order
+    return 2 + (1 + size_prefix_bytes(2) + 16) + vector_size(float32_array, T, val)
+end
+
+beve_size(float32_array::UInt8, val::SubArray{T, 1, <:AbstractVector})::Int where T =
+    vector_size(float32_array, T, val)
+
+beve_size(float32_array::UInt8, val::Vector{T})::Int where T = vector_size(float32_array, T, val)
+
+beve_size(float32_array::UInt8, val::BEVE.BeveTypeTag)::Int =
+    1 + size_prefix_bytes(val.index) + beve_size(float32_array, val.value)
+
+function beve_size(float32_array::UInt8, val::BEVE.BeveMatrix{T})::Int where T
+    n = length(val.extents)
+    extent_width = if n == 2
+        8
+    else
+        max_extent = maximum(val.extents)
+        max_extent <= typemax(UInt8) ? 1 : max_extent <= typemax(UInt16) ? 2 :
+            max_extent <= typemax(UInt32) ? 4 : 8
+    end
+    return 2 + (1 + size_prefix_bytes(n) + n * extent_width) + beve_size(float32_array, val.data)
+end
+
+function beve_size(float32_array::UInt8, val::Dict{String, T})::Int where T
+    total = 1 + size_prefix_bytes(length(val))
+    for (k, v) in val
+        total += string_data_size(k) + beve_size(float32_array, v)
+    end
+    return total
+end
+
+beve_size(float32_array::UInt8, val::Union{Dict{K, V}, BeveSortedDict{K, V}})::Int where {K <: Integer, V} =
+    integer_object_size(float32_array, K, val)
+
+# Members of `val`, whose keys are all of type K, written as an integer-keyed object
+function integer_object_size(float32_array::UInt8, ::Type{K}, val)::Int where K
+    # Key types without an integer object header are written with string keys
+    raw_keys = K in (Int8, Int16, Int32, Int64, Int128, UInt8, UInt16, UInt32, UInt64, UInt128)
+    total = 1 + size_prefix_bytes(length(val))
+    for (k, v) in val
+        total += (raw_keys ? sizeof(K) : string_data_size(string(k))) + beve_size(float32_array, v)
+    end
+    return total
+end
+
+# The writer converts other dictionaries before writing them; their sizes are summed from the
+# original pairs instead of from a converted copy
+function beve_size(float32_array::UInt8, val::AbstractDict)::Int
+    if !isempty(val)
+        key_type = typeof(first(keys(val)))
+        if key_type <: Integer && all(k -> typeof(k) == key_type, keys(val))
+            return integer_object_size(float32_array, key_type, val)
+        end
+    end
+    if keytype(val) <: AbstractString || keytype(val) === Symbol
+        # Distinct strings print differently, as do distinct symbols, so every pair is a member.
+        # A mixed key type such as Union{String, Symbol} can hold "a" and :a, which collide.
+        total = 1 + size_prefix_bytes(length(val))
+        for (k, v) in val
+            total += string_data_size(string(k)) + beve_size(float32_array, v)
+        end
+        return total
+    end
+    # Keys that print alike collapse into one member, the last one written, as when writing
+    member_sizes = Dict{String, Int}()
+    for (k, v) in val
+        member_sizes[string(k)] = beve_size(float32_array, v)
+    end
+    total = 1 + size_prefix_bytes(length(member_sizes))
+    for (k, n) in member_sizes
+        total += string_data_size(k) + n
+    end
+    return total
+end
+
+beve_size(float32_array::UInt8, val::Tuple)::Int = generic_array_size(float32_array, val)
+
+function beve_size(float32_array::UInt8, val::T)::Int where T
+    isempty(fieldnames(T)) && error("Cannot serialize type $T to BEVE")
+    declared_skipped = normalize_skip_fields(skip(T))
+    count = 0
+    total = 0
+    for field_name in fieldnames(T)
+        if declared_skipped !== nothing && field_name in declared_skipped
+            continue
+        end
+        key = ser_name(T, Val(field_name))
+        value = ser_type(T, ser_value(T, Val(field_name), getfield(val, field_name)))
+        skip(T, Val(field_name), value) && continue
+        count += 1
+        total += string_data_size(string(key)) + beve_size(float32_array, value)
+    end
+    return 1 + size_prefix_bytes(count) + total
+end
+
+"""
+    beve_size_of(data; float32_as::Symbol = :f32) -> Int
+
+The exact number of bytes `to_beve(data; float32_as)` produces, computed without writing
+them. Typed arrays are sized from their length, so a value holding gigabytes of numeric
+vectors is sized in microseconds; structs, dictionaries and generic arrays are walked (and
+their `ser_value`/`ser_type` hooks called) as when writing. Throws the error writing would
+throw for a value that cannot be serialized.
+
+`to_beve` and `write_beve_file` use it to allocate their output once when `data` is a
+typed array or matrix, or when given `exact_size = true`; with
+`write_beve_file(path, data; mmap = true)` the value is encoded straight into the file
+mapped at this size. Packed arrays (`pack_arrays`) and key tables (`dict_keys`) are sized
+only by writing them, so those are not covered.
+
+```julia
+julia> beve_size_of(rand(Float64, 1000))
+8003
+
+julia> beve_size_of(rand(Float32, 1000); float32_as = :bf16)
+2003
+```
+"""
+beve_size_of(data; float32_as::Symbol = :f32)::Int = beve_size(float32_array_header(float32_as), data)
@@ -198,6 +198,41 @@ using BEVE
         @test result[4] ≈ 3.14
     end
 
+    @testset "Compressed Sizes" begin
+        # Lengths on both sides of the 1/2/4-byte size boundaries
+        for n in (0, 1, 15, 16, 63, 64, 1000, 16383, 16384, 100_000)
+            str = "x"^n
+            @test from_beve(to_beve(str)) == str
+            @test from_beve(to_beve(fill(Int32(7), n))) == fill(Int32(7), n)
+        end
+
+        # Every width decodes, including non-minimal encodings of a small size
+        abc = UInt8['a', 'b', 'c']
+        @test from_beve(UInt8[0x02, 0x0c, abc...]) == "abc"
+        @test from_beve(UInt8[0x02, 0x0d, 0x00, abc...]) == "abc"
+        @test from_beve(UInt8[0x02, 0x0e, 0x00, 0x00, 0x00, abc...]) == "abc"
+        @test from_beve(UInt8[0x02, 0x0f, zeros(UInt8, 7)..., abc...]) == "abc"
+
+        # Streams without a known length take the byte-at-a-time path
+        mktemp() do path, io
+            write(io, UInt8[0x02, 0x0e, 0x00, 0x00, 0x00, abc...])
+            close(io)
+            open(path) do file
+                @test BEVE.parse_value(BEVE.BeveDeserializer(file)) == "abc"
+            end
+        end
+
+        # A multi-byte size cut short is reported as truncated data
+        err = nothing
+        try
+            from_beve(UInt8[0x02, 0x0d])
+        catch e
+            err = e
+        end
+        @test err isa BEVE.BeveError
+        @test startswith(err.msg, "Unexpected end of data")
+    end
+
     @testset "Matrices" begin
         @testset "Column-major defaults" begin
             matrix = Float32[1 2 3; 4 5 6]
@@ -1082,6 +1117,524 @@ using BEVE
         @test err_company.msg == "Missing field 'longitude' for type ErrGeoCoordinates"
     end
 
+    @testset "Sidecar Index" begin
+        path = tempname() * ".beve"
+        data = Dict(
+            "name" => "capture",
+            "large_float_vec" => Float32.(1:100_000) ./ 4,
+            "channels" => Any[Int16.(1:50_000), "skip/me"],
+            "iq" => ComplexF64.(1:20_000, -(1:20_000)),
+            "small" => [1.0, 2.0]
+        )
+        write_beve_file(path, data; index = false)
+        index = write_beve_index(path; min_bytes = 64 * 1024)
+        @test isfile(path * ".index")
+        @test sort([e.pointer for e in index.entries]) == ["/channels/0", "/iq", "/large_float_vec"]
+
+        loaded = read_beve_index(path)
+        @test loaded.file_size == filesize(path)
+        @test [e.offset for e in loaded.entries] == [e.offset for e in index.entries]
+
+        full = from_beve(read(path))
+        @test read_beve_slice(path, "/large_float_vec", 500:1_499; index = loaded) == full["large_float_vec"][500:1_499]
+        @test read_beve_slice(path, "/channels/0", 49_001:50_000; index = loaded) == full["channels"][1][49_001:50_000]
+        @test read_beve_slice(path, "/iq", 1:10; index = loaded) == full["iq"][1:10]
+        @test isempty(read_beve_slice(path, "/iq", 1:0; index = loaded))
+
+        @test_throws BEVE.BeveError read_beve_slice(path, "/large_float_vec", 99_999:100_001; index = loaded)
+        @test_throws BEVE.BeveError read_beve_slice(path, "/small", 1:1; index = loaded)
+
+        # Rewriting the file without re-indexing leaves a stale sidecar
+        write_beve_file(path, Dict("large_float_vec" => Float32[1, 2, 3]))
+        @test_throws BEVE.BeveError read_beve_index(path)
+        write_beve_file(path, data; index = true)
+        @test read_beve_slice(path, "/large_float_vec", 1:4) == Float32[0.25, 0.5, 0.75, 1.0]
+
+        rm(path; force = true)
+        rm(path * ".index"; force = true)
+    end
+
+    @testset "Columnar Batches" begin
+        struct ColumnRecord
+            id::Int32
+            value::Float64
+            name::String
+        end
+
+        struct ColumnBatch
+            label::String
+            records::Vector{ColumnRecord}
+        end
+
+        records = [ColumnRecord(Int32(i), i * 0.25, "record $i") for i in 1:1000]
+        columnar = to_beve_columnar(records)
+        row_wise = to_beve(records)
+        @test length(columnar) < length(row_wise) ÷ 2
+
+        parsed = from_beve(columnar)
+        @test parsed["id"] isa Vector{Int32}
+        @test parsed["value"] isa Vector{Float64}
+        @test parsed["name"] isa Vector{String}
+
+        @test deser_beve(Vector{ColumnRecord}, columnar) == records
+        @test deser_beve(Vector{ColumnRecord}, to_beve_columnar(ColumnRecord[])) == ColumnRecord[]
+
+        # A columnar batch nested inside a struct field
+        nested = Dict("label" => "batch", "records" => parsed)
+        @test deser_beve(ColumnBatch, to_beve(nested)).records == records
+
+        ragged = Dict("id" => Int32[1, 2], "value" => [1.0], "name" => ["a", "b"])
+        @test_throws BEVE.BeveError deser_beve(Vector{ColumnRecord}, to_beve(ragged))
+        partial = Dict("id" => Int32[1, 2], "value" => [1.0, 2.0])
+        @test_throws BEVE.BeveError deser_beve(Vector{ColumnRecord}, to_beve(partial); error_on_missing_fields = true)
+    end
+
+    @testset "Reduced Precision Arrays" begin
+        struct HalfFeatures
+            label::String
+            values::Vector{Float32}
+        end
+
+        # i * 0.25 for i < 256 is exact in both formats
+        exact = Float32[i * 0.25f0 for i in 0:255]
+        f32 = to_beve(exact)
+        bf16 = to_beve(exact; float32_as = :bf16)
+        f16 = to_beve(exact; float32_as = :f16)
+        @test bf16[1] == BEVE.BF16_ARRAY
+        @test f16[1] == BEVE.F16_ARRAY
+        @test length(bf16) == length(f16) == length(f32) - 2 * length(exact)
+
+        @test from_beve(bf16) isa Vector{Float32}
+        @test from_beve(bf16) == exact
+        @test from_beve(f16) isa Vector{Float16}
+        @test from_beve(f16) == exact
+        @test to_beve(Float16.(exact)) == f16
+
+        # Rounding to nearest even, and values that do not fit
+        @test BEVE.float32_to_bf16(1.00390625f0) == 0x3f80
+        @test BEVE.float32_to_bf16(nextfloat(1.00390625f0)) == 0x3f81
+        @test isnan(from_beve(to_beve(Float32[NaN32]; float32_as = :bf16))[1])
+        @test from_beve(to_beve(Float32[1f5, -1f5]; float32_as = :f16)) == Float16[Inf16, -Inf16]
+
+        # Larger than the serializer's working buffer, with a partial last block
+        values = Float32[sin(i / 100) for i in 1:10_001]
+        @test from_beve(to_beve(values; float32_as = :bf16)) == BEVE.bf16_to_float32.(BEVE.float32_to_bf16.(values))
+        @test from_beve(to_beve(values; float32_as = :f16)) == Float16.(values)
+
+        features = HalfFeatures("features", exact)
+        @test deser_beve(HalfFeatures, to_beve(features; float32_as = :bf16)) == features
+        @test deser_beve(HalfFeatures, to_beve(features; float32_as = :f16)) == features
+
+        # Float32 scalars stay F32, and Float16 scalars are written as F16
+        @test to_beve(1.5f0; float32_as = :bf16) == to_beve(1.5f0)
+        @test from_beve(to_beve(Float16(1.5))) === Float16(1.5)
+
+        matrix = Float32[1 2; 3 4]
+        @test from_beve(to_beve(matrix; float32_as = :bf16)) == matrix
+        @test from_beve(to_beve(Float16.(matrix))) == Float16.(matrix)
+
+        @test_throws ArgumentError to_beve(exact; float32_as = :f8)
+
+        mktempdir() do tmp
+            path = joinpath(tmp, "half.beve")
+            bytes = write_beve_file(path, Dict("bf16" => exact, "tail" => [1, 2, 3]); float32_as = :bf16,
+                                    index = true)
+            @test length(bytes) < length(to_beve(Dict("bf16" => exact, "tail" => [1, 2, 3])))
+            @test read_beve_file(path)["tail"] == [1, 2, 3]
+            # The index walker steps over bf16 payloads at 2 bytes per value
+            @test read_beve_index(path) isa BeveIndex
+            # bf16 slices are read raw and widened to Float32, like a full decode
+            loaded = write_beve_index(path; min_bytes = 0)
+            @test read_beve_slice(path, "/bf16", 5:8; index = loaded) == exact[5:8]
+        end
+    end
+
+    @testset "Packed Arrays" begin
+        struct PackedSeries
+            name::String
+            times::Vector{Int64}
+            values::Vector{Float64}
+        end
+
+        # Sizes around the 128-value block exercise empty, single-value and partial last blocks
+        for n in (0, 1, 127, 128, 129, 1_000)
+            for data in (Float32[i * 0.1f0 for i in 0:n - 1], [sin(i / 10) * 1e6 for i in 0:n - 1],
+                         Int64[1_700_000_000_000 + 1000i for i in 0:n - 1], Int32[i * i - 5000 for i in 0:n - 1],
+                         Int16[1000 - 3i for i in 0:n - 1], UInt16[i % 7 == 0 ? 0xffff : i for i in 0:n - 1],
+                         UInt64[UInt64(i) << 40 for i in 0:n - 1])
+                bytes = to_beve(data; pack_arrays = true)
+                @test bytes[1] == BEVE.PACKED_ARRAY
+                @test from_beve(bytes) isa typeof(data)
+                @test from_beve(bytes) == data
+            end
+        end
+
+        # Bit patterns survive, including NaN, signed zero and extremes
+        specials = [0.0, -0.0, NaN, Inf, -Inf, nextfloat(0.0), 1.0]
+        @test reinterpret(UInt64, from_beve(to_beve(specials; pack_arrays = true))) == reinterpret(UInt64, specials)
+        extremes = Int64[0, typemax(Int64), typemin(Int64), -1, 1]
+        @test from_beve(to_beve(extremes; pack_arrays = true)) == extremes
+
+        floats = Float32[i * 0.1f0 for i in 0:99_999]
+        timestamps = Int64[1_700_000_000_000 + 1000i + i % 3 for i in 0:99_999]
+        @test length(to_beve(floats; pack_arrays = true)) < length(to_beve(floats))
+        @test 4 * length(to_beve(timestamps; pack_arrays = true)) < length(to_beve(timestamps))
+
+        series = PackedSeries("sensor", timestamps[1:500], [round(sin(i / 50) * 1e4) / 100 for i in 1:500])
+        @test deser_beve(PackedSeries, to_beve(series; pack_arrays = true)) == series
+
+        # Matrices and byte vectors keep their typed array layout
+        matrix = [1.0 2.0; 3.0 4.0]
+        @test to_beve(matrix; pack_arrays = true) == to_beve(matrix)
+        @test to_beve(UInt8[1, 2, 3]; pack_arrays = true) == to_beve(UInt8[1, 2, 3])
+
+        @test_throws ArgumentError to_beve(floats; pack_arrays = true, float32_as = :bf16)
+
+        truncated = to_beve(timestamps[1:1_000]; pack_arrays = true)
+        @test_throws BEVE.BeveError from_beve(truncated[1:end - 10])
+
+        mktempdir() do tmp
+            path = joinpath(tmp, "packed.beve")
+            write_beve_file(path, Dict("times" => timestamps, "tail" => [1, 2, 3]); pack_arrays = true, index = true)
+            @test read_beve_file(path)["tail"] == [1, 2, 3]
+            @test read_beve_file(path)["times"] == timestamps
+            # The index walker steps over the payload by its stored length
+            @test read_beve_index(path) isa BeveIndex
+        end
+    end
+
+    @testset "Shared-Memory Rings" begin
+        struct RingMessage
+            id::Int32
+            value::Float64
+            name::String
+        end
+
+        if Sys.islinux()
+            name = "beve_test_ring_$(getpid())"
+            producer = create_beve_ring(name; capacity = 1000)
+            consumer = open_beve_ring(name)
+            @test producer.capacity == 1024
+            @test read_beve_frame(consumer; timeout = 0) === nothing
+
+            @test write_beve_frame(producer, "hello")
+            @test write_beve_frame(producer, RingMessage(1, 0.5, "one"))
+            @test read_beve_frame(consumer) == "hello"
+            @test deser_beve_frame(RingMessage, consumer) == RingMessage(1, 0.5, "one")
+            # The frame bytes are handed over in place, without a copy
+            @test write_beve_frame(producer, "in place")
+            offset = read_beve_frame(bytes -> Int(pointer(bytes) - pointer(consumer.map)), consumer)
+            @test BEVE.RING_HEADER_BYTES < offset < length(consumer.map)
+            @test read_beve_frame(length, consumer; timeout = 0) === nothing
+
+            # Frames of many sizes go around the 1 KiB region repeatedly without splitting
+            for i in 1:2_000
+                values = Float32.(1:(i % 100))
+                @test write_beve_frame(producer, values)
+                @test read_beve_frame(consumer) == values
+            end
+
+            # A full ring refuses frames until the consumer releases one
+            pushed = 0
+            while write_beve_frame(producer, fill(Int64(pushed), 10); timeout = 0)
+                pushed += 1
+            end
+            @test 0 < pushed <= 1024 ÷ 96
+            @test read_beve_frame(consumer) == fill(Int64(0), 10)
+            @test write_beve_frame(producer, fill(Int64(pushed), 10); timeout = 0)
+            @test_throws BEVE.BeveError write_beve_frame(producer, zeros(UInt8, 600))
+
+            finish_beve_ring(producer)
+            drained = Any[]
+            while (frame = read_beve_frame(consumer)) !== nothing
+                push!(drained, frame)
+            end
+            @test drained == [fill(Int64(i), 10) for i in 1:pushed]
+
+            close(consumer)
+            close(producer)
+            unlink_beve_ring(name)
+            @test_throws BEVE.BeveError open_beve_ring(name)
+        else
+            @test_throws BEVE.BeveError create_beve_ring("beve_test_ring")
+        end
+    end
+
+    @testset "Pointer Resolution" begin
+        struct PointerEmployee
+            name::String
+            salary::Float64
+        end
+        struct PointerCompany
+            name::String
+            blob::Vector{UInt8}
+            employees::Vector{PointerEmployee}
+            tags::Vector{String}
+            flags::Vector{Bool}
+            by_id::Dict{Int16, String}
+            nested::Dict{String, Any}
+        end
+
+        company = PointerCompany("Acme", zeros(UInt8, 1 << 20),
+                                 [PointerEmployee("employee $i", 1000.0 + i) for i in 0:999],
+                                 ["a", "bc"], [true, false, true], Dict(Int16(-5) => "minus five", Int16(300) => "three hundred"),
+                                 Dict{String, Any}("a/b" => 1, "t~" => 2, "list" => Any[7, "x"]))
+        bytes = to_beve(company)
+
+        @test from_beve_at(bytes, "") == from_beve(bytes)
+        @test from_beve_at(bytes, "/") == from_beve(bytes)
+        @test from_beve_at(bytes, "/name") == "Acme"
+        @test from_beve_at(bytes, "/employees/999/salary") == 1999.0
+        @test deser_beve_at(PointerEmployee, bytes, "/employees/3") == PointerEmployee("employee 3", 1003.0)
+        @test from_beve_at(bytes, "/blob/7") === 0x00
+        @test from_beve_at(bytes, "/tags/1") == "bc"
+        @test from_beve_at(bytes, "/flags/0") === true
+        @test from_beve_at(bytes, "/flags/1") === false
+        @test from_beve_at(bytes, "/by_id/-5") == "minus five"
+        @test from_beve_at(bytes, "/by_id/300") == "three hundred"
+        @test from_beve_at(bytes, "/nested/a~1b") == 1
+        @test from_beve_at(bytes, "/nested/t~0") == 2
+        @test from_beve_at(bytes, "/nested/list/1") == "x"
+
+        # The target is located by byte range, without decoding what precedes it
+        target = resolve_beve_pointer(bytes, "/employees/3/name")
+        @test target.element_header == 0x00
+        @test from_beve(bytes[target.range]) == "employee 3"
+        element = resolve_beve_pointer(bytes, "/employees/3/salary")
+        @test length(element.range) == 9
+
+        for bad in ("/nope", "/nam", "/employees/1000", "/employees/x", "/by_id/7", "/name/0", "/blob/0/x", "name")
+            @test_throws BEVE.BeveError from_beve_at(bytes, bad)
+        end
+        @test_throws BEVE.BeveError from_beve_at(bytes[1:end - 5], "/nested")
+    end
+
+    @testset "Buffer Patching" begin
+        state = Dict{String, Any}("status" => "ok", "count" => 0, "samples" => collect(1.0:1000.0),
+                                  "flags" => [true, false, true], "tags" => ["a", "bc"],
+                                  "by_id" => Dict(Int16(-5) => "minus five"), "list" => Any[7, "x"])
+        bytes = to_beve(state)
+        n = length(bytes)
+
+        # Same-size values overwrite their bytes
+        patch_beve!(bytes, "/count", 41)
+        patch_beve!(bytes, "/status", "OK")
+        patch_beve!(bytes, "/samples/10", 99.0)
+        patch_beve!(bytes, "/flags/1", true)
+        patch_beve!(bytes, "/flags/0", false)
+        @test length(bytes) == n
+        @test from_beve_at(bytes, "/count") == 41
+        @test from_beve_at(bytes, "/status") == "OK"
+        @test from_beve_at(bytes, "/samples/10") == 99.0
+        @test from_beve_at(bytes, "/samples/11") == 12.0
+        @test from_beve_at(bytes, "/flags") == [false, true, true]
+
+        # Other sizes are spliced in; new keys and "-" are appended
+        patch_beve!(bytes, "/status", "degraded after a long outage")
+        patch_beve!(bytes, "/tags/0", "abcdef")
+        patch_beve!(bytes, "/list/1", "y"^100)
+        patch_beve!(bytes, "/list/-", 8)
+        patch_beve!(bytes, "/by_id/300", "three hundred")
+        patch_beve!(bytes, "/unit", "kelvin")
+        patch_beve!(bytes, "/a~1b", 1)
+        expected = merge(state, Dict{String, Any}("count" => 41, "status" => "degraded after a long outage",
+                                                  "unit" => "kelvin", "a/b" => 1))
+        expected["samples"][11] = 99.0
+        expected["flags"] = [false, true, true]
+        expected["tags"] = ["abcdef", "bc"]
+        expected["list"] = Any[7, "y"^100, 8]
+        expected["by_id"] = Dict(Int16(-5) => "minus five", Int16(300) => "three hundred")
+        @test from_beve(bytes) == expected
+
+        # A count that needs a wider encoding is rewritten
+        wide = to_beve(Dict("k$i" => i for i in 1:63))
+        patch_beve!(wide, "/k64", 64)
+        @test from_beve(wide) == Dict("k$i" => i for i in 1:64)
+
+        patch_beve_encoded!(bytes, "", to_beve(3))
+        @test from_beve(bytes) == 3
+
+        bytes = to_beve(state)
+        for (pointer, value) in (("/samples/0", Int32(1)), ("/samples/1000", 1.0), ("/flags/0", 1),
+                                 ("/missing/child", 1), ("/by_id/70000", "x"), ("/status/0", 1), ("status", 1))
+            @test_throws BEVE.BeveError patch_beve!(bytes, pointer, value)
+        end
+        @test_throws BEVE.BeveError patch_beve_encoded!(bytes, "/count", vcat(to_beve(1), 0x00))
+        @test bytes == to_beve(state)
+    end
+
+    @testset "Dictionary-Encoded Keys" begin
+        struct KeyedRecord
+            id::Int32
+            name::String
+            value::Float64
+            active::Bool
+        end
+
+        records = [KeyedRecord(i, "item$i", i / 2, iseven(i)) for i in 1:1000]
+        plain = to_beve(records)
+        keyed = to_beve(records; dict_keys = true)
+        @test keyed[1] == BEVE.KEY_TABLE
+        # Each of the four keys costs one index byte instead of its size byte and name
+        table_bytes = 2 + sum(k -> 1 + ncodeunits(k), ("id", "name", "value", "active"))
+        @test length(plain) - length(keyed) == 1000 * (2 + 4 + 5 + 6) - table_bytes
+        @test deser_beve(Vector{KeyedRecord}, keyed) == records
+        @test from_beve(keyed) == from_beve(plain)
+
+        # Nested objects, integer keys and tags share the one table
+        nested = Dict{String, Any}("lookup" => Dict("a" => 1, "b" => 2), "ids" => Dict(UInt32(7) => Dict("a" => 3)),
+                                   "variant" => BeveTypeTag(2, Dict("b" => [1.5, 2.5])), "list" => Any[Dict("a" => nothing), "a"])
+        bytes = to_beve(nested; dict_keys = true)
+        decoded = from_beve(bytes)
+        @test decoded["lookup"] == nested["lookup"]
+        @test decoded["ids"] == nested["ids"]
+        @test decoded["variant"].index == 2 && decoded["variant"].value == Dict("b" => [1.5, 2.5])
+        @test decoded["list"] == nested["list"]
+        @test BEVE.pointer_skip(bytes, 1) == length(bytes) + 1
+
+        # Values without objects still carry an (empty) table
+        @test to_beve(2.5; dict_keys = true) == vcat(BEVE.KEY_TABLE, 0x00, to_beve(2.5))
+        @test from_beve(to_beve(2.5; dict_keys = true)) == 2.5
+
+        mktempdir() do dir
+            path = joinpath(dir, "keyed.beve")
+            write_beve_file(path, Dict("records" => records, "samples" => rand(20_000)); dict_keys = true, index = true)
+            @test read_beve_file(path)["records"] == from_beve(plain)
+            @test read_beve_slice(path, "/samples", 1:10) == read_beve_file(path)["samples"][1:10]
+        end
+
+        # An index past the table is an error, not a silent miss
+        bad = copy(keyed)
+        bad[table_bytes + 6] = 0x04 << 2   # array header and count, record header and count, then key index 4
+        @test_throws BEVE.BeveError from_beve(bad)
+        @test_throws BEVE.BeveError from_beve(keyed[table_bytes + 1:end])
+    end
+
+    @testset "Exact Encoded Sizes" begin
+        struct SizedRecord
+            id::Int32
+            name::String
+            note::Union{String, Nothing}
+            samples::Vector{Float32}
+        end
+        BEVE.skip(::Type{SizedRecord}, ::Val{:note}, v) = v === nothing
+
+        values = Any[nothing, true, Int8(-1), 42, UInt128(7), Float16(1.5), 2.5f0, 3.5, "", "x"^15, "x"^16,
+                     "x"^4096, :symbol, SubString("substring", 4), ComplexF32(1, 2), ComplexF64(3, 4),
+                     Bool[true, false, true], zeros(Int16, 15), zeros(Int16, 16), zeros(UInt8, 4095), zeros(UInt8, 4096),
+                     ComplexF64[1 + 2im, 3 - 4im], ["a", "bc", ""], Int128[1, 2], Any[1, "two", 3.0, nothing],
+                     (1, "two"), view(collect(1.0:10.0), 2:5), view(["a", "b", "c"], 1:2),
+                     reshape(collect(1:6), 2, 3), transpose(rand(Float32, 3, 4)),
+                     BeveMatrix(LayoutRight, [2, 3, 300], collect(1.0:1800.0)), BeveTypeTag(70, [1, 2]),
+                     Dict("a" => 1, "b" => [1.0, 2.0]), Dict(Int16(1) => "one"), Dict(big(1) => 1.0),
+                     Dict{Any, Any}(:a => 1, "a" => 2, 3 => 4), Dict{Any, Any}(UInt8(1) => 2),
+                     Dict(:x => 1.0, :y => [1, 2]), Dict{AbstractString, Int}("a" => 1, SubString("bcd", 2) => 2),
+                     Dict{Union{String, Symbol}, Int}("a" => 1, :a => 2),
+                     SizedRecord(1, "with note", "note", rand(Float32, 100)),
+                     [SizedRecord(i, "r$i", nothing, Float32[i]) for i in 1:100], 1:10]
+        for v in values
+            @test beve_size_of(v) == length(to_beve(v))
+        end
+        @test beve_size_of(rand(Float32, 1000); float32_as = :bf16) == length(to_beve(rand(Float32, 1000); float32_as = :bf16)) == 2003
+        @test beve_size_of(SizedRecord(1, "n", nothing, rand(Float32, 64)); float32_as = :f16) ==
+              length(to_beve(SizedRecord(1, "n", nothing, rand(Float32, 64)); float32_as = :f16))
+        @test_throws ErrorException beve_size_of(Complex{Float16}(1, 2))
+        @test_throws ArgumentError beve_size_of(zeros(0, 3))
+
+        # The pre-pass is opt-in for values that are not typed arrays or matrices
+        record = SizedRecord(1, "with note", "note", rand(Float32, 100))
+        @test to_beve(record; exact_size = true) == to_beve(record)
+        @test to_beve(Dict("a" => 1); exact_size = true) == to_beve(Dict("a" => 1))
+        @test BEVE.sized_from_length(rand(10)) && BEVE.sized_from_length(rand(Float32, 2, 2))
+        @test !BEVE.sized_from_length(record) && !BEVE.sized_from_length(["a", "b"])
+
+        mktempdir() do dir
+            path = joinpath(dir, "exact.beve")
+            data = Dict("records" => [SizedRecord(i, "r$i", "n", rand(Float32, 10)) for i in 1:100], "samples" => rand(50_000))
+            mapped = write_beve_file(path, data; mmap = true, index = true)
+            @test length(mapped) == filesize(path) == beve_size_of(data)
+            @test read(path) == mapped == to_beve(data)
+            @test write_beve_file(path, data; exact_size = true) == mapped
+            @test read_beve_slice(path, "/samples", 1:10) == data["samples"][1:10]
+            @test write_beve_file(path, 1.5; mmap = true) == to_beve(1.5) && filesize(path) == 9
+            @test_throws ArgumentError write_beve_file(path, data; mmap = true, dict_keys = true)
+        end
+    end
+
+    @testset "Sorted Integer Objects" begin
+        # Sorted input, as glaze writes a std::map: typed values, no re-sort
+        d = Dict(UInt32(k) => Float64(k) / 4 for k in 1:1000)
+        sorted_bytes = to_beve(BeveSortedDict(d))
+        @test sorted_bytes[1] == BEVE.U32_OBJECT
+        table = from_beve(sorted_bytes; sorted_int_keys = true)
+        @test table isa BeveSortedDict{UInt32, Float64}
+        @test issorted(keys(table)) && length(table) == 1000
+        @test table == d
+        @test table[UInt32(500)] == 125.0 && get(table, UInt32(5000), nothing) === nothing
+        @test haskey(table, UInt32(1)) && !haskey(table, UInt32(0))
+        @test_throws KeyError table[UInt32(0)]
+        @test to_beve(table) == sorted_bytes
+        @test beve_size_of(table) == length(sorted_bytes)
+
+        # Hash-ordered input, as a Dict writes it
+        hashed = from_beve(to_beve(d); sorted_int_keys = true)
+        @test hashed isa BeveSortedDict{UInt32, Float64} && collect(keys(hashed)) == sort(collect(keys(d)))
+        @test hashed == d
+
+        # Mixed values fall back to boxed storage; strings and empty objects
+        mixed = from_beve(to_beve(Dict(Int16(3) => 1.5, Int16(-2) => "two", Int16(7) => [1, 2])); sorted_int_keys = true)
+        @test mixed isa BeveSortedDict{Int16, Any} && collect(keys(mixed)) == Int16[-2, 3, 7]
+        @test mixed[Int16(-2)] == "two" && mixed[Int16(3)] == 1.5 && mixed[Int16(7)] == [1, 2]
+        late = from_beve(to_beve(BeveSortedDict(Int8[1, 2, 3], Any[1.0, 2.0, "three"])); sorted_int_keys = true)
+        @test late isa BeveSortedDict{Int8, Any} && late[Int8(1)] == 1.0 && late[Int8(3)] == "three"
+        @test length(from_beve(to_beve(Dict{Int64, Float64}()); sorted_int_keys = true)) == 0
+        @test from_beve(to_beve(Dict(Int64(1) => 2.0))) isa Dict{Int64, Any}
+
+        # Constructors sort; the last of a repeated key wins
+        dup = BeveSortedDict(Int32[5, 1, 5, 3], ["a", "b", "c", "d"])
+        @test collect(dup) == [Int32(1) => "b", Int32(3) => "d", Int32(5) => "c"]
+        @test_throws ArgumentError BeveSortedDict(Int32[1, 2], [1.0])
+
+        # Nested, and a count the data cannot hold
+        nested = from_beve(to_beve(Dict("lut" => Dict(UInt16(2) => 4.0f0, UInt16(1) => 1.0f0))); sorted_int_keys = true)
+        @test nested["lut"] isa BeveSortedDict{UInt16, Float32} && collect(values(nested["lut"])) == Float32[1, 4]
+        @test_throws BEVE.BeveError from_beve(UInt8[BEVE.U32_OBJECT, 0xfe, 0xff, 0xff, 0x0f]; sorted_int_keys = true)
+    end
+
+    @testset "Planar Complex Arrays" begin
+        # Odd lengths and more than one working-buffer chunk of parts
+        for T in (ComplexF32, ComplexF64), n in (0, 1, 7, 3000)
+            values = [T(i / 2, 1 - i) for i in 1:n]
+            interleaved = to_beve(values)
+            planar = to_beve(values; planar_complex = true)
+            @test length(planar) == length(interleaved) == beve_size_of(values)
+            @test planar[2] == interleaved[2] | BEVE.COMPLEX_PLANAR
+            roundtrip = from_beve(planar)
+            @test roundtrip isa Vector{T} && roundtrip == values
+        end
+        # Real parts first, then imaginary parts
+        planar = to_beve(ComplexF32[1 + 2im, 3 + 4im]; planar_complex = true)
+        @test planar[1:3] == UInt8[BEVE.COMPLEX, 0x43, 0x08]
+        @test reinterpret(Float32, planar[4:end]) == Float32[1, 3, 2, 4]
+
+        # Matrix data, members after it, and a planar flag on a single number
+        matrix = reshape(ComplexF64[ComplexF64(i, -i) for i in 1:6], 2, 3)
+        @test from_beve(to_beve(matrix; planar_complex = true)) == matrix
+        record = from_beve(to_beve(Dict("iq" => ComplexF32[1 - 1im, 2 + 0im], "rate" => 48000.0); planar_complex = true))
+        @test record["iq"] == ComplexF32[1 - 1im, 2 + 0im] && record["rate"] == 48000.0
+        @test_throws BEVE.BeveError from_beve(UInt8[BEVE.COMPLEX, 0x42, zeros(UInt8, 8)...])
+
+        # Sliced through the sidecar index: one read from each half
+        path = tempname() * ".beve"
+        iq = ComplexF64.(1:20_000, -(1:20_000))
+        write_beve_file(path, Dict("iq" => iq); planar_complex = true)
+        write_beve_index(path; min_bytes = 64 * 1024)
+        @test read_beve_slice(path, "/iq", 501:1500) == iq[501:1500]
+        @test read_beve_slice(path, "/iq", 20_000:20_000) == iq[end:end]
+        rm(path; force = true)
+        rm(path * ".index"; force = true)
+    end
+
     @testset "HTTP Extension Loading" begin
         # Test that HTTP functions work when HTTP.jl is loaded
         using HTTP